@@ -0,0 +1,65 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "gl-matrix.h"
+
+static glm_alloc_fn glm_alloc_hook = NULL;
+static glm_free_fn glm_free_hook = NULL;
+static void *glm_alloc_user = NULL;
+
+void glm_set_allocator(glm_alloc_fn alloc, glm_free_fn release, void *user) {
+    glm_alloc_hook = alloc;
+    glm_free_hook = alloc ? release : NULL;
+    glm_alloc_user = alloc ? user : NULL;
+}
+
+void *glm_alloc(size_t size) {
+    void *ptr;
+
+    if (!glm_alloc_hook) {
+#ifdef GL_MATRIX_NO_MALLOC
+        fprintf(stderr, "gl-matrix: allocation of %lu bytes with no allocator installed\n", (unsigned long)size);
+        abort();
+#else
+        return calloc(1, size);
+#endif
+    }
+
+    ptr = glm_alloc_hook(size, glm_alloc_user);
+    if (ptr) { memset(ptr, 0, size); }
+    return ptr;
+}
+
+void glm_free(void *ptr) {
+    if (!ptr) { return; }
+
+    if (!glm_alloc_hook) {
+        free(ptr);
+    } else if (glm_free_hook) {
+        glm_free_hook(ptr, glm_alloc_user);
+    }
+}
+
+void *glm_alloc_aligned(size_t size, size_t align) {
+    unsigned char *block, *ptr;
+
+    if (align < sizeof(void *)) { align = sizeof(void *); }
+    // Sizes so large that the padding would wrap around can't be allocated
+    if (size > SIZE_MAX - (align - 1) - sizeof(void *)) { return NULL; }
+
+    // Room to move the start up to the next multiple of align, with the
+    // pointer glm_free needs stored just below it
+    block = glm_alloc(size + align - 1 + sizeof(void *));
+    if (!block) { return NULL; }
+
+    ptr = (unsigned char *)(((size_t)block + sizeof(void *) + align - 1) & ~(size_t)(align - 1));
+    ((void **)ptr)[-1] = block;
+    return ptr;
+}
+
+void glm_free_aligned(void *ptr) {
+    if (!ptr) { return; }
+    glm_free(((void **)ptr)[-1]);
+}
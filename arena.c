@@ -0,0 +1,52 @@
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "gl-matrix.h"
+
+glm_arena *glm_arena_init(glm_arena *arena, size_t size) {
+    unsigned char *block;
+
+    if (size > SIZE_MAX - GL_MATRIX_ARENA_ALIGNMENT) { return NULL; }
+    block = malloc(size + GL_MATRIX_ARENA_ALIGNMENT);
+    if (!block) { return NULL; }
+
+    glm_arena_initBuffer(arena, block + (GL_MATRIX_ARENA_ALIGNMENT - (size_t)block % GL_MATRIX_ARENA_ALIGNMENT) % GL_MATRIX_ARENA_ALIGNMENT, size);
+    arena->block = block;
+    return arena;
+}
+
+glm_arena *glm_arena_initBuffer(glm_arena *arena, void *buffer, size_t size) {
+    arena->base = buffer;
+    arena->size = size;
+    arena->used = 0;
+    arena->block = NULL;
+    return arena;
+}
+
+void glm_arena_destroy(glm_arena *arena) {
+    free(arena->block);
+    arena->base = NULL;
+    arena->block = NULL;
+    arena->size = arena->used = 0;
+}
+
+void *glm_arena_alloc(glm_arena *arena, size_t size, size_t align) {
+    unsigned char *ptr;
+    size_t pad;
+
+    if (!align) { align = 16; }
+    pad = (align - (size_t)(arena->base + arena->used) % align) % align;
+    if (pad > arena->size - arena->used || size > arena->size - arena->used - pad) { return NULL; }
+
+    ptr = arena->base + arena->used + pad;
+    arena->used += pad + size;
+    return ptr;
+}
+
+void glm_arena_reset(glm_arena *arena) {
+    arena->used = 0;
+}
+
+void *glm_arena_allocHook(size_t size, void *user) {
+    return glm_arena_alloc(user, size, 16);
+}
@@ -0,0 +1,768 @@
+/*
+ * Microbenchmarks for gl-matrix.c
+ *
+ * Every public function apart from setup and teardown is timed at several
+ * working-set sizes, chosen to be resident in L1, in L3 and in main memory.
+ * Each benchmark walks arrays of 16-element slots (A and B are inputs, D
+ * receives results) so the size of the working set, not the function,
+ * decides which level of the memory hierarchy is exercised.
+ *
+ * Usage: bench [-t seconds] [-s size] [-f filter] [-j file.json]
+ *
+ * -t  minimum measuring time per function and size (default 0.05)
+ * -s  only run one working-set size: l1, l3 or dram
+ * -f  only run functions whose name contains the filter
+ * -j  also write the results as JSON to the given file ("-" for stdout)
+ *
+ * Built with BENCH_SINGLE_HEADER and GL_MATRIX_STATIC_INLINE (`make
+ * bench-inline`), the functions come from glmatrix.h and can be inlined into
+ * the benchmark loops, which shows what the calls cost.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef BENCH_SINGLE_HEADER
+#define GL_MATRIX_IMPLEMENTATION
+#include "glmatrix.h"
+#else
+#include "gl-matrix.h"
+#endif
+
+#define SLOT 16
+
+// Stream files of the A slots as mat4, written by setup() into the current
+// directory
+#define STREAM_RAW "bench-stream-raw.bin"
+#define STREAM_TRS "bench-stream-trs.bin"
+#define STREAM_QUAT32 "bench-stream-quat32.bin"
+
+#ifdef GL_MATRIX_STATIC_INLINE
+#define BENCH_STATIC_INLINE 1
+#else
+#define BENCH_STATIC_INLINE 0
+#endif
+
+typedef size_t (*bench_fn)(size_t n);
+
+typedef struct {
+    const char *name;
+    bench_fn fn;
+} bench_t;
+
+typedef struct {
+    const char *name;
+    size_t bytes;
+} bench_size_t;
+
+static const bench_size_t sizes[] = {
+    { "l1", 16 * 1024 },
+    { "l3", 4 * 1024 * 1024 },
+    { "dram", 128 * 1024 * 1024 },
+};
+
+static numeric_t *A, *B, *D;
+static numeric_t *QA, *QB; // packed unit quaternions for the quat_*_array functions
+static numeric_t skinBones[64 * 16], skinDQ[64 * 8], *skinWeights;
+static unsigned short *skinIndices;
+static numeric_t view[16], proj[16], viewport[4] = { 0, 0, 1280, 720 };
+static numeric_t frustum[24];
+static unsigned char *cullMask;
+static unsigned char *packed; // output of the pack functions, input of the unpack ones
+static hierarchy_t hier;
+static vec3_soa_t soa3a, soa3b, soa3d;
+static vec4_soa_t soa4a, soa4b, soa4d;
+static numeric_t *soaResult;
+static float *narrow; // the A slots in both precisions, for the glm_*To* conversions
+static double *wide;
+static glm_arena arena;
+static char strbuf[512];
+static char parsebuf[GL_MATRIX_STR_SIZE(16)]; // mat4_str output, input of the parse functions
+static char parse2[GL_MATRIX_STR_SIZE(2)], parse3[GL_MATRIX_STR_SIZE(3)], parse4[GL_MATRIX_STR_SIZE(4)];
+static char parse8[GL_MATRIX_STR_SIZE(8)], parse9[GL_MATRIX_STR_SIZE(9)];
+static char *textbuf; // mat4_str_array of the A slots, input of mat4_parse_array
+static size_t textlen;
+static volatile numeric_t sink;
+
+/*
+ * BENCH defines a benchmark that calls the body once per slot. `a`, `b` and
+ * `d` point at the current slot of A, B and D.
+ */
+#define BENCH(name, ...) \
+static size_t bench_##name(size_t n) { \
+    size_t i; \
+    for (i = 0; i < n; i++) { \
+        numeric_t *a = A + i * SLOT, *b = B + i * SLOT, *d = D + i * SLOT; \
+        (void)a; (void)b; (void)d; \
+        __VA_ARGS__; \
+    } \
+    return n; \
+}
+
+/*
+ * BENCH_BATCH defines a benchmark for a function that processes the whole
+ * working set in one call. One op is one element.
+ */
+#define BENCH_BATCH(name, ...) \
+static size_t bench_##name(size_t n) { \
+    __VA_ARGS__; \
+    return n; \
+}
+
+// Opens a stream file and reads the first number of every element, so the
+// mapping is paged in like an array the caller goes on to use
+static numeric_t load_stream(const char *path, size_t components) {
+    stream_t stream;
+    numeric_t sum = 0;
+    size_t i;
+
+    if (!stream_open(&stream, path)) {
+        fprintf(stderr, "bench: can't open %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < stream.count; i++) { sum += stream.data[i * components]; }
+    stream_close(&stream);
+    return sum;
+}
+
+// Writes a mat4 in the mat4_str layout with snprintf, the baseline for
+// mat4_str_n. "%.9g" is what round-trips a float.
+static int snprintf_mat4(const numeric_t *m, char *buffer, size_t size) {
+    return snprintf(buffer, size, "[%.9g, %.9g, %.9g, %.9g, %.9g, %.9g, %.9g, %.9g, "
+                    "%.9g, %.9g, %.9g, %.9g, %.9g, %.9g, %.9g, %.9g]",
+                    m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7],
+                    m[8], m[9], m[10], m[11], m[12], m[13], m[14], m[15]);
+}
+
+// Reads a mat4 written by mat4_str with sscanf, the baseline for mat4_parse
+#ifdef GL_MATRIX_DOUBLE
+#define SCAN4 "%lf,%lf,%lf,%lf"
+#else
+#define SCAN4 "%f,%f,%f,%f"
+#endif
+static void sscanf_mat4(const char *str, numeric_t *m) {
+    if (sscanf(str, " [" SCAN4 "," SCAN4 "," SCAN4 "," SCAN4 " ]", m, m + 1, m + 2, m + 3, m + 4, m + 5,
+               m + 6, m + 7, m + 8, m + 9, m + 10, m + 11, m + 12, m + 13, m + 14, m + 15) != 16) {
+        fprintf(stderr, "bench: sscanf failed\n");
+        exit(EXIT_FAILURE);
+    }
+}
+#undef SCAN4
+
+// Reads the numbers of a mat4_str_array string with strtof, the baseline
+// for numbers_parse. sscanf would take the length of the whole string for
+// every call.
+static void strtof_numbers(const char *str, numeric_t *dest, size_t max) {
+    char *end;
+    size_t i = 0;
+
+    while (i < max && *str) {
+        if (*str == '[' || *str == ']' || *str == ',' || *str == ' ') {
+            str++;
+            continue;
+        }
+        dest[i++] = strtof(str, &end);
+        str = end;
+    }
+}
+
+BENCH(glm_alloc, glm_free(glm_alloc(16 * sizeof(numeric_t))))
+BENCH(glm_formatFloat, sink += glm_formatFloat((float)a[0], strbuf))
+BENCH(glm_formatFloat_snprintf, sink += snprintf(strbuf, sizeof strbuf, "%.9g", a[0]))
+BENCH(glm_formatDouble, sink += glm_formatDouble(a[0], strbuf))
+BENCH(glm_parseFloat, float f; glm_parseFloat(parsebuf + 1, &f); sink += f)
+BENCH(glm_parseFloat_strtof, sink += strtof(parsebuf + 1, NULL))
+BENCH(glm_parseDouble, double f; glm_parseDouble(parsebuf + 1, &f); sink += (numeric_t)f)
+BENCH(glm_arena_alloc, if (!glm_arena_alloc(&arena, 16 * sizeof(numeric_t), 0)) { glm_arena_reset(&arena); })
+BENCH(glm_arena_allocHook, if (!glm_arena_allocHook(16 * sizeof(numeric_t), &arena)) { glm_arena_reset(&arena); })
+BENCH(glm_arena_reset, glm_arena_reset(&arena))
+BENCH(glm_alloc_aligned, glm_free_aligned(glm_alloc_aligned(16 * sizeof(numeric_t), 64)))
+BENCH(glm_mat4ToFloat, glm_mat4ToFloat(wide + i * SLOT, narrow + i * SLOT))
+BENCH(glm_mat4ToDouble, glm_mat4ToDouble(narrow + i * SLOT, wide + i * SLOT))
+BENCH_BATCH(glm_doubleToFloat, glm_doubleToFloat(wide, narrow, n * SLOT))
+BENCH_BATCH(glm_floatToDouble, glm_floatToDouble(narrow, wide, n * SLOT))
+
+BENCH(vec2_create, glm_free(vec2_create(a)))
+BENCH(vec2_create_in, if (!vec2_create_in(&arena, a)) { glm_arena_reset(&arena); })
+BENCH(vec2_set, vec2_set(a, d))
+BENCH(vec2_zeroes, vec2_zeroes(d))
+BENCH(vec2_ones, vec2_ones(d))
+BENCH(vec2_add, vec2_add(a, b, d))
+BENCH(vec2_subtract, vec2_subtract(a, b, d))
+BENCH(vec2_negate, vec2_negate(a, d))
+BENCH(vec2_scale, vec2_scale(a, 1.5f, d))
+BENCH(vec2_normalize, vec2_normalize(a, d))
+BENCH(vec2_length, sink += vec2_length(a))
+BENCH(vec2_dot, sink += vec2_dot(a, b))
+BENCH(vec2_direction, vec2_direction(a, b, d))
+BENCH(vec2_lerp, vec2_lerp(a, b, 0.25f, d))
+BENCH(vec2_dist, sink += vec2_dist(a, b))
+BENCH(vec2_str, vec2_str(a, strbuf))
+BENCH(vec2_str_n, sink += vec2_str_n(a, strbuf, sizeof strbuf))
+BENCH(vec2_parse, vec2_parse(parse2, d))
+
+BENCH(vec3_create, glm_free(vec3_create(a)))
+BENCH(vec3_create_in, if (!vec3_create_in(&arena, a)) { glm_arena_reset(&arena); })
+BENCH(vec3_set, vec3_set(a, d))
+BENCH(vec3_zeroes, vec3_zeroes(d))
+BENCH(vec3_ones, vec3_ones(d))
+BENCH(vec3_add, vec3_add(a, b, d))
+BENCH(vec3_subtract, vec3_subtract(a, b, d))
+BENCH(vec3_multiply, vec3_multiply(a, b, d))
+BENCH(vec3_negate, vec3_negate(a, d))
+BENCH(vec3_scale, vec3_scale(a, 1.5f, d))
+BENCH(vec3_normalize, vec3_normalize(a, d))
+BENCH(vec3_cross, vec3_cross(a, b, d))
+BENCH(vec3_cross_noalias, vec3_cross_noalias(a, b, d))
+BENCH(vec3_length, sink += vec3_length(a))
+BENCH(vec3_dot, sink += vec3_dot(a, b))
+BENCH(vec3_direction, vec3_direction(a, b, d))
+BENCH(vec3_lerp, vec3_lerp(a, b, 0.25f, d))
+BENCH(vec3_dist, sink += vec3_dist(a, b))
+BENCH(vec3_unproject, vec3_unproject(a, view, proj, viewport, d))
+BENCH_BATCH(vec3_unproject_array, vec3_unproject_array(A, n, view, proj, viewport, NULL, D))
+BENCH(vec3_str, vec3_str(a, strbuf))
+BENCH(vec3_str_n, sink += vec3_str_n(a, strbuf, sizeof strbuf))
+BENCH(vec3_parse, vec3_parse(parse3, d))
+
+BENCH(vec4_create, glm_free(vec4_create(a)))
+BENCH(vec4_create_aligned, glm_free_aligned(vec4_create_aligned(a, 16)))
+BENCH(vec4_create_in, if (!vec4_create_in(&arena, a)) { glm_arena_reset(&arena); })
+BENCH(vec4_set, vec4_set(a, d))
+BENCH(vec4_zeroes, vec4_zeroes(d))
+BENCH(vec4_ones, vec4_ones(d))
+BENCH(vec4_add, vec4_add(a, b, d))
+BENCH(vec4_subtract, vec4_subtract(a, b, d))
+BENCH(vec4_negate, vec4_negate(a, d))
+BENCH(vec4_scale, vec4_scale(a, 1.5f, d))
+BENCH(vec4_normalize, vec4_normalize(a, d))
+BENCH(vec4_length, sink += vec4_length(a))
+BENCH(vec4_dot, sink += vec4_dot(a, b))
+BENCH(vec4_direction, vec4_direction(a, b, d))
+BENCH(vec4_lerp, vec4_lerp(a, b, 0.25f, d))
+BENCH(vec4_dist, sink += vec4_dist(a, b))
+BENCH(vec4_str, vec4_str(a, strbuf))
+BENCH(vec4_str_n, sink += vec4_str_n(a, strbuf, sizeof strbuf))
+BENCH(vec4_parse, vec4_parse(parse4, d))
+
+BENCH(mat3_create, glm_free(mat3_create(a)))
+BENCH(mat3_create_in, if (!mat3_create_in(&arena, a)) { glm_arena_reset(&arena); })
+BENCH(mat3_set, mat3_set(a, d))
+BENCH(mat3_identity, mat3_identity(d))
+BENCH(mat3_transpose, mat3_transpose(a, d))
+BENCH(mat3_toMat4, mat3_toMat4(a, d))
+BENCH(mat3_multiplyVec3, mat3_multiplyVec3(a, b, d))
+BENCH(mat3_str, mat3_str(a, strbuf))
+BENCH(mat3_str_n, sink += mat3_str_n(a, strbuf, sizeof strbuf))
+BENCH(mat3_parse, mat3_parse(parse9, d))
+
+BENCH(mat4_create, glm_free(mat4_create(a)))
+BENCH(mat4_create_aligned, glm_free_aligned(mat4_create_aligned(a, 64)))
+BENCH(mat4_create_in, if (!mat4_create_in(&arena, a)) { glm_arena_reset(&arena); })
+BENCH(mat4_set, mat4_set(a, d))
+BENCH(mat4_identity, mat4_identity(d))
+BENCH(mat4_transpose, mat4_transpose(a, d))
+BENCH(mat4_determinant, sink += mat4_determinant(a))
+BENCH(mat4_inverse, mat4_inverse(a, d))
+BENCH(mat4_inverse_noalias, mat4_inverse_noalias(a, d))
+BENCH(mat4_inverseAffine, mat4_inverseAffine(a, d))
+BENCH(mat4_inverseRigid, mat4_inverseRigid(a, d))
+BENCH(mat4_toRotationMat, mat4_toRotationMat(a, d))
+BENCH(mat4_toMat3, mat4_toMat3(a, d))
+BENCH(mat4_toInverseMat3, mat4_toInverseMat3(a, d))
+BENCH(mat4_multiply, mat4_multiply(a, b, d))
+BENCH(mat4_multiply_noalias, mat4_multiply_noalias(a, b, d))
+BENCH(mat4_multiplyAffine, mat4_multiplyAffine(a, b, d))
+BENCH(mat4_multiplyVec3, mat4_multiplyVec3(a, b, d))
+BENCH(mat4_multiplyVec4, mat4_multiplyVec4(a, b, d))
+BENCH_BATCH(mat4_multiplyVec3_array, mat4_multiplyVec3_array(view, A, n, SLOT * sizeof(numeric_t), D))
+BENCH_BATCH(mat4_multiplyVec4_array, mat4_multiplyVec4_array(view, A, n, SLOT * sizeof(numeric_t), D))
+// The same batch shifted off 16 byte alignment, taking the unaligned path
+BENCH_BATCH(mat4_multiplyVec4_array_unaligned, mat4_multiplyVec4_array(view, A + 1, n, SLOT * sizeof(numeric_t), D + 1))
+BENCH(mat4_translate, mat4_translate(a, b, d))
+BENCH(mat4_scale, mat4_scale(a, b, d))
+BENCH(mat4_scale_scalar, mat4_scale_scalar(a, 1.5f, d))
+BENCH(mat4_rotate, mat4_rotate(a, 0.5f, b, d))
+BENCH(mat4_rotateX, mat4_rotateX(a, 0.5f, d))
+BENCH(mat4_rotateY, mat4_rotateY(a, 0.5f, d))
+BENCH(mat4_rotateZ, mat4_rotateZ(a, 0.5f, d))
+BENCH(mat4_frustum, mat4_frustum(-a[0], a[0], -a[1], a[1], 0.1f, 100, d))
+BENCH(mat4_perspective, mat4_perspective(60, a[0] + 1, 0.1f, 100, d))
+BENCH(mat4_ortho, mat4_ortho(-a[0], a[0], -a[1], a[1], 0.1f, 100, d))
+BENCH(mat4_lookAt, mat4_lookAt(a, b, a + 4, d))
+BENCH(mat4_fromRotationTranslation, mat4_fromRotationTranslation(a, b, d))
+BENCH(mat4_alignVectors, mat4_alignVectors(a, b, d))
+BENCH(mat4_str, mat4_str(a, strbuf))
+BENCH(mat4_str_n, sink += mat4_str_n(a, strbuf, sizeof strbuf))
+BENCH(mat4_str_snprintf, sink += snprintf_mat4(a, strbuf, sizeof strbuf))
+BENCH(mat4_parse, mat4_parse(parsebuf, d))
+BENCH(mat4_parse_sscanf, sscanf_mat4(parsebuf, d))
+
+BENCH(quat_create, glm_free(quat_create(a)))
+BENCH(quat_create_aligned, glm_free_aligned(quat_create_aligned(a, 16)))
+BENCH(quat_create_in, if (!quat_create_in(&arena, a)) { glm_arena_reset(&arena); })
+BENCH(quat_set, quat_set(a, d))
+BENCH(quat_calculateW, quat_calculateW(a, d))
+BENCH(quat_dot, sink += quat_dot(a, b))
+BENCH(quat_inverse, quat_inverse(a, d))
+BENCH(quat_conjugate, quat_conjugate(a, d))
+BENCH(quat_length, sink += quat_length(a))
+BENCH(quat_normalize, quat_normalize(a, d))
+BENCH(quat_multiply, quat_multiply(a, b, d))
+BENCH(quat_multiply_noalias, quat_multiply_noalias(a, b, d))
+BENCH(quat_multiplyVec3, quat_multiplyVec3(a, b, d))
+BENCH(quat_toMat3, quat_toMat3(a, d))
+BENCH(quat_toMat4, quat_toMat4(a, d))
+BENCH(quat_slerp, quat_slerp(a, b, 0.25f, d))
+BENCH(quat_slerpFast, quat_slerpFast(a, b, 0.25f, d))
+BENCH(quat_axisFromAngle, quat_axisFromAngle(a, 0.5f, d))
+BENCH(quat_rotate, quat_rotate(a, b, d))
+BENCH(quat_str, quat_str(a, strbuf))
+BENCH(quat_str_n, sink += quat_str_n(a, strbuf, sizeof strbuf))
+BENCH(quat_parse, quat_parse(parse4, d))
+BENCH(dquat_create, glm_free(dquat_create(a)))
+BENCH(dquat_create_in, if (!dquat_create_in(&arena, a)) { glm_arena_reset(&arena); })
+BENCH(dquat_set, dquat_set(a, d))
+BENCH(dquat_identity, dquat_identity(d))
+BENCH(dquat_getTranslation, dquat_getTranslation(a, d))
+BENCH(dquat_fromRotationTranslation, dquat_fromRotationTranslation(a, b + 4, d))
+BENCH(dquat_multiply, dquat_multiply(a, b, d))
+BENCH(dquat_normalize, dquat_normalize(a, d))
+BENCH(dquat_toMat4, dquat_toMat4(a, d))
+BENCH(dquat_transformPoint, dquat_transformPoint(a, b, d))
+BENCH(dquat_str, dquat_str(a, strbuf))
+BENCH(dquat_str_n, sink += dquat_str_n(a, strbuf, sizeof strbuf))
+BENCH(dquat_parse, dquat_parse(parse8, d))
+BENCH_BATCH(quat_multiply_array, quat_multiply_array(QA, QB, n, D))
+BENCH_BATCH(quat_multiply_array_unaligned, quat_multiply_array(QA + 1, QB + 1, n - 1, D + 1))
+BENCH_BATCH(quat_slerp_array, quat_slerp_array(QA, QB, 0.25f, n, D))
+BENCH_BATCH(quat_multiplyVec3_array, quat_multiplyVec3_array(QA, A, n, D))
+
+BENCH_BATCH(quat_pack32_array, quat_pack32_array(QA, n, (uint32_t *)packed))
+BENCH_BATCH(quat_unpack32_array, quat_unpack32_array((uint32_t *)packed, n, D))
+BENCH_BATCH(quat_pack48_array, quat_pack48_array(QA, n, (uint16_t *)packed))
+BENCH_BATCH(quat_unpack48_array, quat_unpack48_array((uint16_t *)packed, n, D))
+BENCH_BATCH(half_pack, half_pack(A, n, (uint16_t *)packed))
+BENCH_BATCH(half_unpack, half_unpack((uint16_t *)packed, n, D))
+BENCH(mat4_packTRS, mat4_packTRS(a, (mat4_trs_t *)packed + i))
+BENCH(mat4_unpackTRS, mat4_unpackTRS((mat4_trs_t *)packed + i, d))
+BENCH_BATCH(mat4_packTRS_array, mat4_packTRS_array(A, n, (mat4_trs_t *)packed))
+BENCH_BATCH(mat4_unpackTRS_array, mat4_unpackTRS_array((mat4_trs_t *)packed, n, D))
+BENCH(quat_pack32, ((uint32_t *)packed)[i] = quat_pack32(a))
+BENCH(quat_unpack32, quat_unpack32(((uint32_t *)packed)[i], d))
+BENCH(quat_pack48, quat_pack48(a, (uint16_t *)packed + i * 3))
+BENCH(quat_unpack48, quat_unpack48((uint16_t *)packed + i * 3, d))
+
+// Loading n matrices from a stream file, with mat4_parse_array reading the
+// same matrices from text as the baseline
+BENCH_BATCH(stream_write, stream_write(STREAM_RAW, GL_MATRIX_STREAM_MAT4, A, n))
+BENCH_BATCH(stream_writeEncoded_quat32, stream_writeEncoded(STREAM_QUAT32, GL_MATRIX_STREAM_QUAT, GL_MATRIX_STREAM_QUAT32, QA, n))
+BENCH_BATCH(stream_open, sink += load_stream(STREAM_RAW, 16))
+BENCH_BATCH(stream_open_trs, sink += load_stream(STREAM_TRS, 16))
+BENCH_BATCH(stream_open_quat32, sink += load_stream(STREAM_QUAT32, 4))
+BENCH_BATCH(mat4_str_array, sink += mat4_str_array(A, n, textbuf, GL_MATRIX_STR_SIZE(16) * n + 2))
+BENCH_BATCH(mat4_parse_array, mat4_parse_array(textbuf, n, D); sink += D[12])
+BENCH_BATCH(numbers_parse, size_t count; numbers_parse(textbuf, textlen, D, n * 16, &count); sink += D[12])
+BENCH_BATCH(numbers_parse_strtof, strtof_numbers(textbuf, D, n * 16); sink += D[12])
+
+// Value types, and the same lookAt -> multiply -> multiplyVec4 chain through
+// the pointer and the value API
+BENCH(vec2s_make, *(vec2s *)d = vec2s_make(a[0], a[1]))
+BENCH(vec2s_load, *(vec2s *)d = vec2s_load(a))
+BENCH(vec2s_add, *(vec2s *)d = vec2s_add(*(vec2s *)a, *(vec2s *)b))
+BENCH(vec2s_subtract, *(vec2s *)d = vec2s_subtract(*(vec2s *)a, *(vec2s *)b))
+BENCH(vec2s_scale, *(vec2s *)d = vec2s_scale(*(vec2s *)a, 1.5f))
+BENCH(vec2s_dot, sink += vec2s_dot(*(vec2s *)a, *(vec2s *)b))
+BENCH(vec2s_length, sink += vec2s_length(*(vec2s *)a))
+BENCH(vec2s_normalize, *(vec2s *)d = vec2s_normalize(*(vec2s *)a))
+BENCH(vec2s_lerp, *(vec2s *)d = vec2s_lerp(*(vec2s *)a, *(vec2s *)b, 0.25f))
+BENCH(vec3s_make, *(vec3s *)d = vec3s_make(a[0], a[1], a[2]))
+BENCH(vec3s_load, *(vec3s *)d = vec3s_load(a))
+BENCH(vec3s_add, *(vec3s *)d = vec3s_add(*(vec3s *)a, *(vec3s *)b))
+BENCH(vec3s_subtract, *(vec3s *)d = vec3s_subtract(*(vec3s *)a, *(vec3s *)b))
+BENCH(vec3s_multiply, *(vec3s *)d = vec3s_multiply(*(vec3s *)a, *(vec3s *)b))
+BENCH(vec3s_negate, *(vec3s *)d = vec3s_negate(*(vec3s *)a))
+BENCH(vec3s_scale, *(vec3s *)d = vec3s_scale(*(vec3s *)a, 1.5f))
+BENCH(vec3s_dot, sink += vec3s_dot(*(vec3s *)a, *(vec3s *)b))
+BENCH(vec3s_cross, *(vec3s *)d = vec3s_cross(*(vec3s *)a, *(vec3s *)b))
+BENCH(vec3s_length, sink += vec3s_length(*(vec3s *)a))
+BENCH(vec3s_normalize, *(vec3s *)d = vec3s_normalize(*(vec3s *)a))
+BENCH(vec3s_lerp, *(vec3s *)d = vec3s_lerp(*(vec3s *)a, *(vec3s *)b, 0.25f))
+BENCH(vec3s_dist, sink += vec3s_dist(*(vec3s *)a, *(vec3s *)b))
+BENCH(vec4s_make, *(vec4s *)d = vec4s_make(a[0], a[1], a[2], a[3]))
+BENCH(vec4s_load, *(vec4s *)d = vec4s_load(a))
+BENCH(vec4s_add, *(vec4s *)d = vec4s_add(*(vec4s *)a, *(vec4s *)b))
+BENCH(vec4s_subtract, *(vec4s *)d = vec4s_subtract(*(vec4s *)a, *(vec4s *)b))
+BENCH(vec4s_scale, *(vec4s *)d = vec4s_scale(*(vec4s *)a, 1.5f))
+BENCH(vec4s_dot, sink += vec4s_dot(*(vec4s *)a, *(vec4s *)b))
+BENCH(vec4s_length, sink += vec4s_length(*(vec4s *)a))
+BENCH(vec4s_normalize, *(vec4s *)d = vec4s_normalize(*(vec4s *)a))
+BENCH(vec4s_lerp, *(vec4s *)d = vec4s_lerp(*(vec4s *)a, *(vec4s *)b, 0.25f))
+BENCH(quats_make, *(quats *)d = quats_make(a[0], a[1], a[2], a[3]))
+BENCH(quats_load, *(quats *)d = quats_load(a))
+BENCH(quats_identity, *(quats *)d = quats_identity())
+BENCH(quats_conjugate, *(quats *)d = quats_conjugate(*(quats *)a))
+BENCH(quats_normalize, *(quats *)d = quats_normalize(*(quats *)a))
+BENCH(quats_multiply, *(quats *)d = quats_multiply(*(quats *)a, *(quats *)b))
+BENCH(quats_multiplyVec3, *(vec3s *)d = quats_multiplyVec3(*(quats *)a, *(vec3s *)b))
+BENCH(quats_axisFromAngle, *(quats *)d = quats_axisFromAngle(*(vec3s *)a, 0.5f))
+BENCH(quats_toMat4, *(mat4s *)d = quats_toMat4(*(quats *)a))
+BENCH(mat4s_load, *(mat4s *)d = mat4s_load(a))
+BENCH(mat4s_identity, *(mat4s *)d = mat4s_identity())
+BENCH(mat4s_transpose, *(mat4s *)d = mat4s_transpose(*(mat4s *)a))
+BENCH(mat4s_multiply, *(mat4s *)d = mat4s_multiply(*(mat4s *)a, *(mat4s *)b))
+BENCH(mat4s_multiplyVec3, *(vec3s *)d = mat4s_multiplyVec3(*(mat4s *)a, *(vec3s *)b))
+BENCH(mat4s_multiplyVec4, *(vec4s *)d = mat4s_multiplyVec4(*(mat4s *)a, *(vec4s *)b))
+BENCH(mat4s_translate, *(mat4s *)d = mat4s_translate(*(mat4s *)a, *(vec3s *)b))
+BENCH(mat4s_scale, *(mat4s *)d = mat4s_scale(*(mat4s *)a, *(vec3s *)b))
+BENCH(mat4s_inverse, *(mat4s *)d = mat4s_inverse(*(mat4s *)a))
+BENCH(mat4s_fromRotationTranslation, *(mat4s *)d = mat4s_fromRotationTranslation(*(quats *)a, *(vec3s *)b))
+BENCH(mat4s_frustum, *(mat4s *)d = mat4s_frustum(-a[0], a[0], -a[1], a[1], 0.1f, 100))
+BENCH(mat4s_perspective, *(mat4s *)d = mat4s_perspective(60, a[0] + 1, 0.1f, 100))
+BENCH(mat4s_lookAt, *(mat4s *)d = mat4s_lookAt(*(vec3s *)a, *(vec3s *)b, *(vec3s *)(a + 4)))
+BENCH(chain_pointer, numeric_t m[16]; mat4_lookAt(a, b, a + 4, m); mat4_multiply(proj, m, m); mat4_multiplyVec4(m, b + 4, d))
+BENCH(chain_value, *(vec4s *)d = mat4s_multiplyVec4(mat4s_multiply(*(mat4s *)proj,
+    mat4s_lookAt(*(vec3s *)a, *(vec3s *)b, *(vec3s *)(a + 4))), *(vec4s *)(b + 4)))
+
+BENCH(frustum_fromMat4, numeric_t planes[24]; sink += frustum_fromMat4(a, planes)[0])
+BENCH_BATCH(frustum_cullSpheres, sink += frustum_cullSpheres(frustum, &soa4a, cullMask))
+BENCH_BATCH(frustum_cullBoxes, sink += frustum_cullBoxes(frustum, &soa3a, &soa3b, cullMask))
+
+BENCH(hierarchy_markDirty, hierarchy_markDirty(&hier, i))
+BENCH(hierarchy_setLocal, hierarchy_setLocal(&hier, i, a + 4, a, NULL))
+BENCH_BATCH(hierarchy_update, hierarchy_markDirty(&hier, 0); hierarchy_update(&hier))
+BENCH_BATCH(hierarchy_updateParallel_1, hierarchy_markDirty(&hier, 0); hierarchy_updateParallel(&hier, 1))
+BENCH_BATCH(hierarchy_updateParallel_2, hierarchy_markDirty(&hier, 0); hierarchy_updateParallel(&hier, 2))
+BENCH_BATCH(hierarchy_updateParallel_4, hierarchy_markDirty(&hier, 0); hierarchy_updateParallel(&hier, 4))
+BENCH_BATCH(hierarchy_updateParallel_8, hierarchy_markDirty(&hier, 0); hierarchy_updateParallel(&hier, 8))
+
+BENCH_BATCH(skin_linearBlend, skin_linearBlend(skinBones, skinIndices, skinWeights, A, B, n, D, D + n * 3))
+BENCH_BATCH(skin_dualQuaternion, skin_dualQuaternion(skinDQ, skinIndices, skinWeights, A, B, n, D, D + n * 3))
+BENCH_BATCH(skin_linearBlendParallel, skin_linearBlendParallel(skinBones, skinIndices, skinWeights, A, B, n, D, D + n * 3, 4))
+BENCH_BATCH(skin_dualQuaternionParallel, skin_dualQuaternionParallel(skinDQ, skinIndices, skinWeights, A, B, n, D, D + n * 3, 4))
+
+BENCH_BATCH(vec3_soa_fromAoS, vec3_soa_fromAoS(A, &soa3d))
+BENCH_BATCH(vec3_soa_toAoS, vec3_soa_toAoS(&soa3a, D))
+BENCH_BATCH(vec3_soa_add, vec3_soa_add(&soa3a, &soa3b, &soa3d))
+BENCH_BATCH(vec3_soa_subtract, vec3_soa_subtract(&soa3a, &soa3b, &soa3d))
+BENCH_BATCH(vec3_soa_scale, vec3_soa_scale(&soa3a, 1.5f, &soa3d))
+BENCH_BATCH(vec3_soa_normalize, vec3_soa_normalize(&soa3a, &soa3d))
+BENCH_BATCH(vec3_soa_cross, vec3_soa_cross(&soa3a, &soa3b, &soa3d))
+BENCH_BATCH(vec3_soa_lerp, vec3_soa_lerp(&soa3a, &soa3b, 0.25f, &soa3d))
+BENCH_BATCH(vec3_soa_dot, vec3_soa_dot(&soa3a, &soa3b, soaResult))
+BENCH_BATCH(vec3_soa_length, vec3_soa_length(&soa3a, soaResult))
+BENCH_BATCH(vec4_soa_fromAoS, vec4_soa_fromAoS(A, &soa4d))
+BENCH_BATCH(vec4_soa_toAoS, vec4_soa_toAoS(&soa4a, D))
+BENCH_BATCH(vec4_soa_add, vec4_soa_add(&soa4a, &soa4b, &soa4d))
+BENCH_BATCH(vec4_soa_subtract, vec4_soa_subtract(&soa4a, &soa4b, &soa4d))
+BENCH_BATCH(vec4_soa_scale, vec4_soa_scale(&soa4a, 1.5f, &soa4d))
+BENCH_BATCH(vec4_soa_normalize, vec4_soa_normalize(&soa4a, &soa4d))
+BENCH_BATCH(vec4_soa_lerp, vec4_soa_lerp(&soa4a, &soa4b, 0.25f, &soa4d))
+BENCH_BATCH(vec4_soa_dot, vec4_soa_dot(&soa4a, &soa4b, soaResult))
+BENCH_BATCH(vec4_soa_length, vec4_soa_length(&soa4a, soaResult))
+
+#define ENTRY(name) { #name, bench_##name }
+
+static const bench_t benches[] = {
+    ENTRY(glm_alloc), ENTRY(glm_alloc_aligned), ENTRY(glm_arena_alloc), ENTRY(glm_arena_allocHook),
+    ENTRY(glm_arena_reset), ENTRY(glm_mat4ToFloat), ENTRY(glm_mat4ToDouble), ENTRY(glm_doubleToFloat),
+    ENTRY(glm_floatToDouble), ENTRY(glm_formatFloat), ENTRY(glm_formatFloat_snprintf),
+    ENTRY(glm_formatDouble), ENTRY(glm_parseFloat), ENTRY(glm_parseFloat_strtof),
+    ENTRY(glm_parseDouble),
+
+    ENTRY(vec2_create), ENTRY(vec2_create_in), ENTRY(vec2_set), ENTRY(vec2_zeroes),
+    ENTRY(vec2_ones), ENTRY(vec2_add), ENTRY(vec2_subtract), ENTRY(vec2_negate),
+    ENTRY(vec2_scale), ENTRY(vec2_normalize), ENTRY(vec2_length), ENTRY(vec2_dot),
+    ENTRY(vec2_direction), ENTRY(vec2_lerp), ENTRY(vec2_dist), ENTRY(vec2_str), ENTRY(vec2_str_n), ENTRY(vec2_parse),
+
+    ENTRY(vec3_create), ENTRY(vec3_create_in), ENTRY(vec3_set), ENTRY(vec3_zeroes),
+    ENTRY(vec3_ones), ENTRY(vec3_add), ENTRY(vec3_subtract), ENTRY(vec3_multiply),
+    ENTRY(vec3_negate), ENTRY(vec3_scale), ENTRY(vec3_normalize), ENTRY(vec3_cross), ENTRY(vec3_cross_noalias),
+    ENTRY(vec3_length), ENTRY(vec3_dot), ENTRY(vec3_direction), ENTRY(vec3_lerp),
+    ENTRY(vec3_dist), ENTRY(vec3_unproject), ENTRY(vec3_unproject_array), ENTRY(vec3_str), ENTRY(vec3_str_n), ENTRY(vec3_parse),
+
+    ENTRY(vec4_create), ENTRY(vec4_create_aligned), ENTRY(vec4_create_in), ENTRY(vec4_set), ENTRY(vec4_zeroes),
+    ENTRY(vec4_ones), ENTRY(vec4_add), ENTRY(vec4_subtract), ENTRY(vec4_negate),
+    ENTRY(vec4_scale), ENTRY(vec4_normalize), ENTRY(vec4_length), ENTRY(vec4_dot),
+    ENTRY(vec4_direction), ENTRY(vec4_lerp), ENTRY(vec4_dist), ENTRY(vec4_str), ENTRY(vec4_str_n), ENTRY(vec4_parse),
+
+    ENTRY(mat3_create), ENTRY(mat3_create_in), ENTRY(mat3_set), ENTRY(mat3_identity),
+    ENTRY(mat3_transpose), ENTRY(mat3_toMat4), ENTRY(mat3_multiplyVec3), ENTRY(mat3_str), ENTRY(mat3_str_n), ENTRY(mat3_parse),
+
+    ENTRY(mat4_create), ENTRY(mat4_create_aligned), ENTRY(mat4_create_in), ENTRY(mat4_set), ENTRY(mat4_identity),
+    ENTRY(mat4_transpose), ENTRY(mat4_determinant), ENTRY(mat4_inverse), ENTRY(mat4_inverse_noalias), ENTRY(mat4_inverseAffine), ENTRY(mat4_inverseRigid),
+    ENTRY(mat4_toRotationMat), ENTRY(mat4_toMat3), ENTRY(mat4_toInverseMat3),
+    ENTRY(mat4_multiply), ENTRY(mat4_multiply_noalias), ENTRY(mat4_multiplyAffine), ENTRY(mat4_multiplyVec3), ENTRY(mat4_multiplyVec4),
+    ENTRY(mat4_multiplyVec3_array), ENTRY(mat4_multiplyVec4_array),
+    ENTRY(mat4_multiplyVec4_array_unaligned),
+    ENTRY(mat4_translate), ENTRY(mat4_scale), ENTRY(mat4_scale_scalar), ENTRY(mat4_rotate),
+    ENTRY(mat4_rotateX), ENTRY(mat4_rotateY), ENTRY(mat4_rotateZ), ENTRY(mat4_frustum),
+    ENTRY(mat4_perspective), ENTRY(mat4_ortho), ENTRY(mat4_lookAt),
+    ENTRY(mat4_fromRotationTranslation), ENTRY(mat4_alignVectors), ENTRY(mat4_str),
+    ENTRY(mat4_str_n), ENTRY(mat4_str_snprintf), ENTRY(mat4_parse), ENTRY(mat4_parse_sscanf),
+
+    ENTRY(quat_create), ENTRY(quat_create_aligned), ENTRY(quat_create_in), ENTRY(quat_set), ENTRY(quat_calculateW),
+    ENTRY(quat_dot), ENTRY(quat_inverse), ENTRY(quat_conjugate), ENTRY(quat_length),
+    ENTRY(quat_normalize), ENTRY(quat_multiply), ENTRY(quat_multiply_noalias), ENTRY(quat_multiplyVec3), ENTRY(quat_toMat3),
+    ENTRY(quat_toMat4), ENTRY(quat_slerp), ENTRY(quat_slerpFast), ENTRY(quat_axisFromAngle), ENTRY(quat_rotate),
+    ENTRY(quat_str), ENTRY(quat_str_n), ENTRY(quat_parse), ENTRY(quat_multiply_array), ENTRY(quat_multiply_array_unaligned), ENTRY(quat_slerp_array),
+    ENTRY(quat_multiplyVec3_array),
+
+    ENTRY(quat_pack32_array), ENTRY(quat_unpack32_array), ENTRY(quat_pack48_array),
+    ENTRY(quat_unpack48_array), ENTRY(half_pack), ENTRY(half_unpack), ENTRY(mat4_packTRS),
+    ENTRY(mat4_unpackTRS), ENTRY(mat4_packTRS_array), ENTRY(mat4_unpackTRS_array), ENTRY(quat_pack32),
+    ENTRY(quat_unpack32), ENTRY(quat_pack48), ENTRY(quat_unpack48),
+    ENTRY(stream_write), ENTRY(stream_writeEncoded_quat32), ENTRY(stream_open), ENTRY(stream_open_trs),
+    ENTRY(stream_open_quat32), ENTRY(mat4_str_array), ENTRY(mat4_parse_array), ENTRY(numbers_parse),
+    ENTRY(numbers_parse_strtof),
+
+    ENTRY(dquat_create), ENTRY(dquat_create_in), ENTRY(dquat_set), ENTRY(dquat_identity),
+    ENTRY(dquat_getTranslation), ENTRY(dquat_fromRotationTranslation), ENTRY(dquat_multiply),
+    ENTRY(dquat_normalize), ENTRY(dquat_toMat4), ENTRY(dquat_transformPoint), ENTRY(dquat_str), ENTRY(dquat_str_n), ENTRY(dquat_parse),
+
+    ENTRY(vec2s_make), ENTRY(vec2s_load), ENTRY(vec2s_add), ENTRY(vec2s_subtract), ENTRY(vec2s_scale),
+    ENTRY(vec2s_dot), ENTRY(vec2s_length), ENTRY(vec2s_normalize), ENTRY(vec2s_lerp),
+    ENTRY(vec3s_make), ENTRY(vec3s_load), ENTRY(vec3s_add), ENTRY(vec3s_subtract), ENTRY(vec3s_multiply),
+    ENTRY(vec3s_negate), ENTRY(vec3s_scale), ENTRY(vec3s_dot), ENTRY(vec3s_cross), ENTRY(vec3s_length),
+    ENTRY(vec3s_normalize), ENTRY(vec3s_lerp), ENTRY(vec3s_dist),
+    ENTRY(vec4s_make), ENTRY(vec4s_load), ENTRY(vec4s_add), ENTRY(vec4s_subtract), ENTRY(vec4s_scale),
+    ENTRY(vec4s_dot), ENTRY(vec4s_length), ENTRY(vec4s_normalize), ENTRY(vec4s_lerp),
+    ENTRY(quats_make), ENTRY(quats_load), ENTRY(quats_identity), ENTRY(quats_conjugate),
+    ENTRY(quats_normalize), ENTRY(quats_multiply), ENTRY(quats_multiplyVec3), ENTRY(quats_axisFromAngle),
+    ENTRY(quats_toMat4),
+    ENTRY(mat4s_load), ENTRY(mat4s_identity), ENTRY(mat4s_transpose), ENTRY(mat4s_multiply),
+    ENTRY(mat4s_multiplyVec3), ENTRY(mat4s_multiplyVec4), ENTRY(mat4s_translate), ENTRY(mat4s_scale),
+    ENTRY(mat4s_inverse), ENTRY(mat4s_fromRotationTranslation), ENTRY(mat4s_frustum),
+    ENTRY(mat4s_perspective), ENTRY(mat4s_lookAt),
+    ENTRY(chain_pointer), ENTRY(chain_value),
+
+    ENTRY(frustum_fromMat4), ENTRY(frustum_cullSpheres), ENTRY(frustum_cullBoxes),
+
+    ENTRY(hierarchy_markDirty), ENTRY(hierarchy_setLocal), ENTRY(hierarchy_update), ENTRY(hierarchy_updateParallel_1),
+    ENTRY(hierarchy_updateParallel_2), ENTRY(hierarchy_updateParallel_4), ENTRY(hierarchy_updateParallel_8),
+
+    ENTRY(skin_linearBlend), ENTRY(skin_dualQuaternion), ENTRY(skin_linearBlendParallel), ENTRY(skin_dualQuaternionParallel),
+
+    ENTRY(vec3_soa_fromAoS), ENTRY(vec3_soa_toAoS), ENTRY(vec3_soa_add),
+    ENTRY(vec3_soa_subtract), ENTRY(vec3_soa_scale), ENTRY(vec3_soa_normalize),
+    ENTRY(vec3_soa_cross), ENTRY(vec3_soa_lerp), ENTRY(vec3_soa_dot), ENTRY(vec3_soa_length),
+    ENTRY(vec4_soa_fromAoS), ENTRY(vec4_soa_toAoS), ENTRY(vec4_soa_add),
+    ENTRY(vec4_soa_subtract), ENTRY(vec4_soa_scale), ENTRY(vec4_soa_normalize),
+    ENTRY(vec4_soa_lerp), ENTRY(vec4_soa_dot), ENTRY(vec4_soa_length),
+};
+
+static double now(void) {
+#ifdef CLOCK_MONOTONIC
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static numeric_t randf(void) {
+    return (numeric_t)rand() / RAND_MAX * 2 - 1;
+}
+
+// Fills a slot with values every function accepts: the first four elements
+// form a unit quaternion, and nothing is zero.
+static void fill_slot(numeric_t *slot) {
+    int i;
+    for (i = 0; i < SLOT; i++) {
+        slot[i] = randf();
+        if (slot[i] > -0.01f && slot[i] < 0.01f) { slot[i] = 0.5f; }
+    }
+    quat_normalize(slot, NULL);
+}
+
+// Allocates the slot arrays and streams for a working set of `n` slots
+static void setup(size_t n) {
+    size_t i, j;
+
+    A = malloc(n * SLOT * sizeof(numeric_t));
+    B = malloc(n * SLOT * sizeof(numeric_t));
+    D = malloc(n * SLOT * sizeof(numeric_t));
+    QA = malloc(n * 4 * sizeof(numeric_t));
+    QB = malloc(n * 4 * sizeof(numeric_t));
+    skinWeights = malloc(n * 4 * sizeof(numeric_t));
+    skinIndices = malloc(n * 4 * sizeof(unsigned short));
+    soaResult = malloc(n * sizeof(numeric_t));
+    cullMask = malloc(n / 8 + 1);
+    packed = calloc(n, sizeof(mat4_trs_t));
+    textbuf = malloc(GL_MATRIX_STR_SIZE(16) * n + 2);
+    narrow = malloc(n * SLOT * sizeof(float));
+    wide = malloc(n * SLOT * sizeof(double));
+    if (!cullMask || !packed || !textbuf || !narrow || !wide || !hierarchy_create(&hier, n) || !A || !B || !D || !QA || !QB || !skinWeights || !skinIndices || !soaResult ||
+        !vec3_soa_create(&soa3a, n) || !vec3_soa_create(&soa3b, n) || !vec3_soa_create(&soa3d, n) ||
+        !vec4_soa_create(&soa4a, n) || !vec4_soa_create(&soa4b, n) || !vec4_soa_create(&soa4d, n)) {
+        fprintf(stderr, "bench: out of memory for %lu slots\n", (unsigned long)n);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < n; i++) {
+        fill_slot(A + i * SLOT);
+        fill_slot(B + i * SLOT);
+        fill_slot(D + i * SLOT);
+        quat_set(A + i * SLOT, QA + i * 4);
+        quat_set(B + i * SLOT, QB + i * 4);
+        // A tree with four children per node
+        hierarchy_add(&hier, i ? (i - 1) / 4 : GL_MATRIX_HIERARCHY_NONE, A + i * SLOT + 4, A + i * SLOT, NULL);
+        for (j = 0; j < 4; j++) {
+            skinIndices[i * 4 + j] = (unsigned short)(rand() % 64);
+            skinWeights[i * 4 + j] = 0.25f;
+        }
+    }
+    for (i = 0; i < 64 && i < n; i++) {
+        mat4_fromRotationTranslation(A + i * SLOT, A + i * SLOT + 4, skinBones + i * 16);
+        dquat_fromRotationTranslation(A + i * SLOT, A + i * SLOT + 4, skinDQ + i * 8);
+    }
+    for (i = 0; i < n * SLOT; i++) {
+        narrow[i] = (float)A[i];
+        wide[i] = A[i];
+    }
+    vec3_soa_fromAoS(A, &soa3a);
+    vec3_soa_fromAoS(B, &soa3b);
+    vec4_soa_fromAoS(A, &soa4a);
+    vec4_soa_fromAoS(B, &soa4b);
+    mat4_str(A, parsebuf);
+    vec2_str(A, parse2);
+    vec3_str(A, parse3);
+    vec4_str(A, parse4);
+    dquat_str(A, parse8);
+    mat3_str(A, parse9);
+
+    // The TRS encoding needs affine matrices, D is scratch space until the
+    // benchmarks run
+    for (i = 0; i < n; i++) { mat4_fromRotationTranslation(A + i * SLOT, A + i * SLOT + 4, D + i * SLOT); }
+    textlen = mat4_str_array(A, n, textbuf, GL_MATRIX_STR_SIZE(16) * n + 2);
+    if (!stream_write(STREAM_RAW, GL_MATRIX_STREAM_MAT4, A, n) ||
+        !stream_writeEncoded(STREAM_TRS, GL_MATRIX_STREAM_MAT4, GL_MATRIX_STREAM_TRS, D, n) ||
+        !stream_writeEncoded(STREAM_QUAT32, GL_MATRIX_STREAM_QUAT, GL_MATRIX_STREAM_QUAT32, QA, n)) {
+        fprintf(stderr, "bench: can't write the stream files\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void teardown(void) {
+    free(A);
+    free(B);
+    free(D);
+    free(packed);
+    free(textbuf);
+    free(narrow);
+    free(wide);
+    remove(STREAM_RAW);
+    remove(STREAM_TRS);
+    remove(STREAM_QUAT32);
+    free(QA);
+    free(QB);
+    free(skinWeights);
+    free(skinIndices);
+    free(soaResult);
+    free(cullMask);
+    hierarchy_free(&hier);
+    vec3_soa_free(&soa3a);
+    vec3_soa_free(&soa3b);
+    vec3_soa_free(&soa3d);
+    vec4_soa_free(&soa4a);
+    vec4_soa_free(&soa4b);
+    vec4_soa_free(&soa4d);
+}
+
+// Runs `fn` until at least `min_time` seconds have passed and returns ns/op
+static double measure(bench_fn fn, size_t n, double min_time) {
+    double start, elapsed;
+    size_t ops = 0;
+
+    fn(n); // warm up caches and branch predictors
+
+    start = now();
+    do {
+        ops += fn(n);
+        elapsed = now() - start;
+    } while (elapsed < min_time);
+
+    return elapsed * 1e9 / ops;
+}
+
+int main(int argc, char *argv[]) {
+    const char *size_filter = NULL, *filter = NULL, *json_path = NULL;
+    double min_time = 0.05;
+    FILE *json = NULL, *table = stdout;
+    int first = 1;
+    size_t s, b, n;
+    numeric_t eye[3] = { 0, 2, 5 }, center[3] = { 0, 0, 0 }, up[3] = { 0, 1, 0 };
+
+    for (s = 1; s < (size_t)argc; s++) {
+        if (!strcmp(argv[s], "-t") && s + 1 < (size_t)argc) {
+            min_time = atof(argv[++s]);
+        } else if (!strcmp(argv[s], "-s") && s + 1 < (size_t)argc) {
+            size_filter = argv[++s];
+        } else if (!strcmp(argv[s], "-f") && s + 1 < (size_t)argc) {
+            filter = argv[++s];
+        } else if (!strcmp(argv[s], "-j") && s + 1 < (size_t)argc) {
+            json_path = argv[++s];
+        } else {
+            fprintf(stderr, "usage: %s [-t seconds] [-s l1|l3|dram] [-f filter] [-j file.json]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (json_path) {
+        json = strcmp(json_path, "-") ? fopen(json_path, "w") : stdout;
+        if (!json) {
+            perror(json_path);
+            return EXIT_FAILURE;
+        }
+        if (json == stdout) { table = stderr; }
+        fprintf(json, "{\n  \"version\": \"%s\",\n  \"simd\": %d,\n  \"numeric_size\": %d,\n  \"static_inline\": %d,\n  \"results\": [\n",
+            GL_MATRIX_VERSION, GL_MATRIX_SIMD, (int)sizeof(numeric_t), BENCH_STATIC_INLINE);
+    }
+
+    srand(1);
+    mat4_lookAt(eye, center, up, view);
+    mat4_perspective(60, 16.0f / 9.0f, 0.1f, 100, proj);
+    frustum_fromMat4(mat4_multiply(proj, view, frustum), frustum);
+    if (!glm_arena_init(&arena, 1024 * 1024)) {
+        fprintf(stderr, "bench: out of memory for arena\n");
+        return EXIT_FAILURE;
+    }
+
+    fprintf(table, "%-32s %-5s %12s %14s\n", "function", "size", "ns/op", "ops/sec");
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        if (size_filter && strcmp(size_filter, sizes[s].name)) { continue; }
+
+        n = sizes[s].bytes / (3 * SLOT * sizeof(numeric_t));
+        setup(n);
+
+        for (b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+            double ns;
+
+            if (filter && !strstr(benches[b].name, filter)) { continue; }
+
+            ns = measure(benches[b].fn, n, min_time);
+            fprintf(table, "%-32s %-5s %12.2f %14.0f\n", benches[b].name, sizes[s].name, ns, 1e9 / ns);
+            fflush(table);
+
+            if (json) {
+                fprintf(json, "%s    {\"name\": \"%s\", \"size\": \"%s\", \"bytes\": %lu, \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f}",
+                    first ? "" : ",\n", benches[b].name, sizes[s].name, (unsigned long)sizes[s].bytes, ns, 1e9 / ns);
+                first = 0;
+            }
+        }
+
+        teardown();
+    }
+
+    if (json) {
+        fprintf(json, "\n  ]\n}\n");
+        if (json != stdout) { fclose(json); }
+    }
+
+    glm_arena_destroy(&arena);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,27 @@
+#include <stdlib.h>
+
+#include "gl-matrix.h"
+
+float *glm_doubleToFloat(const double *src, float *dest, size_t count) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = (float)src[i];
+    }
+    return dest;
+}
+
+double *glm_floatToDouble(const float *src, double *dest, size_t count) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = src[i];
+    }
+    return dest;
+}
+
+float *glm_mat4ToFloat(const double *mat, float *dest) {
+    return glm_doubleToFloat(mat, dest, 16);
+}
+
+double *glm_mat4ToDouble(const float *mat, double *dest) {
+    return glm_floatToDouble(mat, dest, 16);
+}
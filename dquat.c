@@ -0,0 +1,169 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "gl-matrix.h"
+
+GL_MATRIX_API dquat_t dquat_create(dquat_t dquat) {
+    dquat_t dest = glm_alloc(8 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (dquat) {
+        memcpy(dest, dquat, 8 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_create_in(glm_arena *arena, dquat_t dquat) {
+    dquat_t dest = glm_arena_alloc(arena, 8 * sizeof(numeric_t), 32);
+    if (!dest) { return NULL; }
+
+    if (dquat) {
+        memcpy(dest, dquat, 8 * sizeof(numeric_t));
+    } else {
+        memset(dest, 0, 8 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_set(dquat_t dquat, dquat_t dest) {
+    dest[0] = dquat[0];
+    dest[1] = dquat[1];
+    dest[2] = dquat[2];
+    dest[3] = dquat[3];
+    dest[4] = dquat[4];
+    dest[5] = dquat[5];
+    dest[6] = dquat[6];
+    dest[7] = dquat[7];
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_identity(dquat_t dest) {
+    if (!dest) { dest = dquat_create(NULL); }
+    dest[0] = 0;
+    dest[1] = 0;
+    dest[2] = 0;
+    dest[3] = 1;
+    dest[4] = 0;
+    dest[5] = 0;
+    dest[6] = 0;
+    dest[7] = 0;
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_fromRotationTranslation(quat_t quat, vec3_t vec, dquat_t dest) {
+    numeric_t qx = quat[0], qy = quat[1], qz = quat[2], qw = quat[3],
+        tx = vec[0] * 0.5f, ty = vec[1] * 0.5f, tz = vec[2] * 0.5f;
+
+    if (!dest) { dest = dquat_create(NULL); }
+
+    dest[0] = qx;
+    dest[1] = qy;
+    dest[2] = qz;
+    dest[3] = qw;
+
+    // dual = (t / 2) * real, with t as a quaternion with w = 0
+    dest[4] = tx * qw + ty * qz - tz * qy;
+    dest[5] = ty * qw + tz * qx - tx * qz;
+    dest[6] = tz * qw + tx * qy - ty * qx;
+    dest[7] = -tx * qx - ty * qy - tz * qz;
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t dquat_getTranslation(dquat_t dquat, vec3_t dest) {
+    numeric_t rx = dquat[0], ry = dquat[1], rz = dquat[2], rw = dquat[3],
+        dx = dquat[4], dy = dquat[5], dz = dquat[6], dw = dquat[7];
+
+    if (!dest) { dest = vec3_create(NULL); }
+
+    // t = 2 * dual * conjugate(real)
+    dest[0] = 2 * (rw * dx - dw * rx + ry * dz - rz * dy);
+    dest[1] = 2 * (rw * dy - dw * ry + rz * dx - rx * dz);
+    dest[2] = 2 * (rw * dz - dw * rz + rx * dy - ry * dx);
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_multiply(dquat_t dquat, dquat_t dquat2, dquat_t dest) {
+    if (!dest) { dest = dquat; }
+
+    numeric_t ax = dquat[0], ay = dquat[1], az = dquat[2], aw = dquat[3],
+        adx = dquat[4], ady = dquat[5], adz = dquat[6], adw = dquat[7],
+        bx = dquat2[0], by = dquat2[1], bz = dquat2[2], bw = dquat2[3],
+        bdx = dquat2[4], bdy = dquat2[5], bdz = dquat2[6], bdw = dquat2[7];
+
+    // real = a.real * b.real
+    dest[0] = ax * bw + aw * bx + ay * bz - az * by;
+    dest[1] = ay * bw + aw * by + az * bx - ax * bz;
+    dest[2] = az * bw + aw * bz + ax * by - ay * bx;
+    dest[3] = aw * bw - ax * bx - ay * by - az * bz;
+
+    // dual = a.real * b.dual + a.dual * b.real
+    dest[4] = ax * bdw + aw * bdx + ay * bdz - az * bdy + adx * bw + adw * bx + ady * bz - adz * by;
+    dest[5] = ay * bdw + aw * bdy + az * bdx - ax * bdz + ady * bw + adw * by + adz * bx - adx * bz;
+    dest[6] = az * bdw + aw * bdz + ax * bdy - ay * bdx + adz * bw + adw * bz + adx * by - ady * bx;
+    dest[7] = aw * bdw - ax * bdx - ay * bdy - az * bdz + adw * bw - adx * bx - ady * by - adz * bz;
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_normalize(dquat_t dquat, dquat_t dest) {
+    if (!dest) { dest = dquat; }
+
+    numeric_t len = glm_sqrt(dquat[0] * dquat[0] + dquat[1] * dquat[1] +
+                             dquat[2] * dquat[2] + dquat[3] * dquat[3]);
+
+    if (!len) {
+        dest[0] = 0;
+        dest[1] = 0;
+        dest[2] = 0;
+        dest[3] = 0;
+        dest[4] = 0;
+        dest[5] = 0;
+        dest[6] = 0;
+        dest[7] = 0;
+        return dest;
+    }
+
+    len = 1 / len;
+    dest[0] = dquat[0] * len;
+    dest[1] = dquat[1] * len;
+    dest[2] = dquat[2] * len;
+    dest[3] = dquat[3] * len;
+    dest[4] = dquat[4] * len;
+    dest[5] = dquat[5] * len;
+    dest[6] = dquat[6] * len;
+    dest[7] = dquat[7] * len;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t dquat_toMat4(dquat_t dquat, mat4_t dest) {
+    numeric_t t[3];
+
+    dquat_getTranslation(dquat, t);
+    dest = quat_toMat4(dquat, dest);
+    dest[12] = t[0];
+    dest[13] = t[1];
+    dest[14] = t[2];
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t dquat_transformPoint(dquat_t dquat, vec3_t vec, vec3_t dest) {
+    numeric_t t[3];
+
+    if (!dest) { dest = vec; }
+
+    dquat_getTranslation(dquat, t);
+    quat_multiplyVec3(dquat, vec, dest);
+    dest[0] += t[0];
+    dest[1] += t[1];
+    dest[2] += t[2];
+
+    return dest;
+}
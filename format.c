@@ -0,0 +1,306 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "gl-matrix.h"
+
+/*
+ * Shortest round-trip number formatting, with the Grisu2 algorithm from
+ * Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+ * with Integers" (PLDI 2010).
+ *
+ * A number is scaled by a cached power of ten into a 64 bit fixed point
+ * window, and digits are generated until they identify the number among its
+ * neighbours. The result always parses back to the same float or double; it
+ * is the shortest such string for all but a tiny fraction of inputs.
+ */
+
+typedef struct {
+    uint64_t f;
+    int e;
+} glm_diyfp;
+
+// 10^(8i - 348), normalized to a 64 bit significand and binary exponent
+static const uint64_t glm_format_powF[] = {
+    0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL,
+    0xCF42894A5DCE35EAULL, 0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL,
+    0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL, 0xBE5691EF416BD60CULL,
+    0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+    0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL,
+    0xC21094364DFB5637ULL, 0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL,
+    0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL, 0xB23867FB2A35B28EULL,
+    0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+    0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL,
+    0xB5B5ADA8AAFF80B8ULL, 0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL,
+    0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL, 0xA6DFBD9FB8E5B88FULL,
+    0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+    0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL,
+    0xAA242499697392D3ULL, 0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL,
+    0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL, 0x9C40000000000000ULL,
+    0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+    0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL,
+    0x9F4F2726179A2245ULL, 0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL,
+    0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL, 0x924D692CA61BE758ULL,
+    0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+    0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL,
+    0x952AB45CFA97A0B3ULL, 0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL,
+    0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL, 0x88FCF317F22241E2ULL,
+    0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+    0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL,
+    0x8BAB8EEFB6409C1AULL, 0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL,
+    0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL, 0x80444B5E7AA7CF85ULL,
+    0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+    0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL, 0xAF87023B9BF0EE6BULL
+};
+
+static const short glm_format_powE[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066
+};
+
+static const uint64_t glm_format_pow10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static glm_diyfp glm_diyfp_make(uint64_t f, int e) {
+    glm_diyfp x;
+    x.f = f;
+    x.e = e;
+    return x;
+}
+
+// The upper 64 bits of the 128 bit product, rounded
+static glm_diyfp glm_diyfp_multiply(glm_diyfp x, glm_diyfp y) {
+    const uint64_t m32 = 0xFFFFFFFFULL;
+    uint64_t a = x.f >> 32, b = x.f & m32, c = y.f >> 32, d = y.f & m32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & m32) + (bc & m32) + (1ULL << 31);
+
+    return glm_diyfp_make(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64);
+}
+
+static glm_diyfp glm_diyfp_normalize(glm_diyfp x) {
+#if defined(__GNUC__) || defined(__clang__)
+    int shift = __builtin_clzll(x.f);
+    x.f <<= shift;
+    x.e -= shift;
+#else
+    while (!(x.f & (1ULL << 63))) {
+        x.f <<= 1;
+        x.e--;
+    }
+#endif
+    return x;
+}
+
+static int glm_format_countDigits(uint32_t n) {
+    int digits = 1;
+    while (digits < 10 && n >= glm_format_pow10[digits]) { digits++; }
+    return digits;
+}
+
+static void glm_format_round(char *buffer, int length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance) {
+    while (rest < distance && delta - rest >= tenKappa &&
+           (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance)) {
+        buffer[length - 1]--;
+        rest += tenKappa;
+    }
+}
+
+// Generates the digits of w, which lies in [upper - delta, upper]. Returns
+// the number of digits; the value is digits * 10^*k.
+static int glm_format_digits(glm_diyfp w, glm_diyfp upper, uint64_t delta, char *buffer, int *k) {
+    const glm_diyfp one = glm_diyfp_make(1ULL << -upper.e, upper.e);
+    const uint64_t distance = upper.f - w.f;
+    uint32_t p1 = (uint32_t)(upper.f >> -one.e);
+    uint64_t p2 = upper.f & (one.f - 1);
+    int kappa = glm_format_countDigits(p1), length = 0;
+
+    while (kappa > 0) {
+        uint32_t d;
+        uint64_t rest;
+
+        // Constant divisors, which compile to multiplications
+        switch (kappa) {
+        case 10: d = p1 / 1000000000; p1 %= 1000000000; break;
+        case 9: d = p1 / 100000000; p1 %= 100000000; break;
+        case 8: d = p1 / 10000000; p1 %= 10000000; break;
+        case 7: d = p1 / 1000000; p1 %= 1000000; break;
+        case 6: d = p1 / 100000; p1 %= 100000; break;
+        case 5: d = p1 / 10000; p1 %= 10000; break;
+        case 4: d = p1 / 1000; p1 %= 1000; break;
+        case 3: d = p1 / 100; p1 %= 100; break;
+        case 2: d = p1 / 10; p1 %= 10; break;
+        default: d = p1; p1 = 0; break;
+        }
+        if (d || length) { buffer[length++] = (char)('0' + d); }
+        kappa--;
+
+        rest = ((uint64_t)p1 << -one.e) + p2;
+        if (rest <= delta) {
+            *k += kappa;
+            glm_format_round(buffer, length, delta, rest, glm_format_pow10[kappa] << -one.e, distance);
+            return length;
+        }
+    }
+
+    for (;;) {
+        char d;
+
+        p2 *= 10;
+        delta *= 10;
+        d = (char)(p2 >> -one.e);
+        if (d || length) { buffer[length++] = (char)('0' + d); }
+        p2 &= one.f - 1;
+        kappa--;
+
+        if (p2 < delta) {
+            *k += kappa;
+            glm_format_round(buffer, length, delta, p2, one.f,
+                             -kappa < 20 ? distance * glm_format_pow10[-kappa] : 0);
+            return length;
+        }
+    }
+}
+
+// f * 2^e is a positive finite number whose significand has the hidden bit
+// `hidden` (0 for subnormals). Writes its digits and returns their count.
+static int glm_format_grisu2(uint64_t f, int e, uint64_t hidden, char *buffer, int *k) {
+    glm_diyfp v = glm_diyfp_make(f, e), upper, lower, w, c;
+    int index;
+    double dk;
+
+    // The neighbourhood that still rounds to v. The gap below is half as
+    // wide when v is an exact power of two.
+    upper = glm_diyfp_normalize(glm_diyfp_make((f << 1) + 1, e - 1));
+    lower = f == hidden ? glm_diyfp_make((f << 2) - 1, e - 2) : glm_diyfp_make((f << 1) - 1, e - 1);
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    // Pick the cached power that brings upper's exponent into [-60, -32]
+    dk = (-61 - upper.e) * 0.30102999566398114 + 347;
+    index = (int)dk;
+    if (dk - index > 0.0) { index++; }
+    index = (index >> 3) + 1;
+    *k = -(-348 + index * 8);
+    c = glm_diyfp_make(glm_format_powF[index], glm_format_powE[index]);
+
+    w = glm_diyfp_multiply(glm_diyfp_normalize(v), c);
+    upper = glm_diyfp_multiply(upper, c);
+    lower = glm_diyfp_multiply(lower, c);
+    // Shrink the interval by the multiplication error so that every digit
+    // string inside it is still safe
+    lower.f++;
+    upper.f--;
+    return glm_format_digits(w, upper, upper.f - lower.f, buffer, k);
+}
+
+// Lays out digits * 10^k the way JavaScript's Number.prototype.toString does:
+// plain notation from 1e-6 up to 1e21, exponent notation outside of it
+static size_t glm_format_layout(char *buffer, int length, int k) {
+    int point = length + k, i;
+
+    if (length <= point && point <= 21) {
+        for (i = length; i < point; i++) { buffer[i] = '0'; }
+        buffer[point] = '\0';
+        return (size_t)point;
+    }
+
+    if (0 < point && point <= 21) {
+        memmove(buffer + point + 1, buffer + point, (size_t)(length - point));
+        buffer[point] = '.';
+        buffer[length + 1] = '\0';
+        return (size_t)length + 1;
+    }
+
+    if (-6 < point && point <= 0) {
+        int offset = 2 - point;
+        memmove(buffer + offset, buffer, (size_t)length);
+        buffer[0] = '0';
+        buffer[1] = '.';
+        for (i = 2; i < offset; i++) { buffer[i] = '0'; }
+        buffer[length + offset] = '\0';
+        return (size_t)(length + offset);
+    }
+
+    {
+        int exponent = point - 1, end = length;
+        unsigned int digits;
+
+        if (length > 1) {
+            memmove(buffer + 2, buffer + 1, (size_t)(length - 1));
+            buffer[1] = '.';
+            end++;
+        }
+        buffer[end++] = 'e';
+        buffer[end++] = exponent < 0 ? '-' : '+';
+        digits = (unsigned int)(exponent < 0 ? -exponent : exponent);
+        if (digits >= 100) { buffer[end++] = (char)('0' + digits / 100); digits %= 100; buffer[end++] = (char)('0' + digits / 10); }
+        else if (digits >= 10) { buffer[end++] = (char)('0' + digits / 10); }
+        buffer[end++] = (char)('0' + digits % 10);
+        buffer[end] = '\0';
+        return (size_t)end;
+    }
+}
+
+// Handles the sign, zero, infinities and NaN, and formats the rest
+static size_t glm_format(int negative, int special, uint64_t f, int e, uint64_t hidden, char *buffer) {
+    char *start = buffer;
+    int length, k;
+
+    if (special) {
+        // f is the significand of an infinity or a NaN
+        if (f) { memcpy(buffer, "nan", 4); return 3; }
+        if (negative) { *buffer++ = '-'; }
+        memcpy(buffer, "inf", 4);
+        return (size_t)(buffer - start) + 3;
+    }
+
+    if (negative) { *buffer++ = '-'; }
+    if (!f) {
+        memcpy(buffer, "0", 2);
+        return (size_t)(buffer - start) + 1;
+    }
+
+    length = glm_format_grisu2(f, e, hidden, buffer, &k);
+    return (size_t)(buffer - start) + glm_format_layout(buffer, length, k);
+}
+
+size_t glm_formatFloat(float x, char *buffer) {
+    uint32_t bits, biased, significand;
+
+    memcpy(&bits, &x, sizeof bits);
+    biased = (bits >> 23) & 0xFF;
+    significand = bits & 0x7FFFFF;
+
+    if (biased == 0xFF) { return glm_format(bits >> 31, 1, significand, 0, 0, buffer); }
+    if (biased) {
+        return glm_format(bits >> 31, 0, significand | 0x800000, (int)biased - 150, 0x800000, buffer);
+    }
+    return glm_format(bits >> 31, 0, significand, -149, 0, buffer);
+}
+
+size_t glm_formatDouble(double x, char *buffer) {
+    const uint64_t hidden = 1ULL << 52;
+    uint64_t bits, significand;
+    int biased;
+
+    memcpy(&bits, &x, sizeof bits);
+    biased = (int)((bits >> 52) & 0x7FF);
+    significand = bits & (hidden - 1);
+
+    if (biased == 0x7FF) { return glm_format((int)(bits >> 63), 1, significand, 0, 0, buffer); }
+    if (biased) {
+        return glm_format((int)(bits >> 63), 0, significand | hidden, biased - 1075, hidden, buffer);
+    }
+    return glm_format((int)(bits >> 63), 0, significand, -1074, 0, buffer);
+}
@@ -0,0 +1,175 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "gl-matrix.h"
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+#include <immintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+// Objects tested per iteration; the SoA streams are padded to a multiple of
+// this, so there is no scalar tail
+#define FRUSTUM_LANES GL_MATRIX_SOA_LANES
+
+GL_MATRIX_API frustum_t frustum_fromMat4(mat4_t mat, frustum_t dest) {
+    int i;
+
+    if (!dest) { dest = glm_alloc(24 * sizeof(numeric_t)); }
+
+    // Gribb/Hartmann: each plane is the fourth row of the matrix plus or
+    // minus one of the others. mat is column-major, so row r is
+    // mat[r], mat[4 + r], mat[8 + r], mat[12 + r].
+    for (i = 0; i < 3; i++) {
+        numeric_t *lo = dest + i * 8, *hi = dest + i * 8 + 4;
+        lo[0] = mat[3] + mat[i];
+        lo[1] = mat[7] + mat[4 + i];
+        lo[2] = mat[11] + mat[8 + i];
+        lo[3] = mat[15] + mat[12 + i];
+        hi[0] = mat[3] - mat[i];
+        hi[1] = mat[7] - mat[4 + i];
+        hi[2] = mat[11] - mat[8 + i];
+        hi[3] = mat[15] - mat[12 + i];
+    }
+
+    for (i = 0; i < 6; i++) {
+        numeric_t *p = dest + i * 4,
+            len = glm_sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (len) {
+            len = 1 / len;
+            p[0] *= len;
+            p[1] *= len;
+            p[2] *= len;
+            p[3] *= len;
+        }
+    }
+
+    return dest;
+}
+
+// Number of set bits in each 4 bit value
+static const unsigned char frustum_bitCount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+// Writes the visibility bits of one block of FRUSTUM_LANES objects to the
+// mask, dropping the padding lanes past `valid`, and returns how many of the
+// objects are visible
+static size_t frustum_store(unsigned int bits, unsigned char *mask, size_t valid) {
+    size_t j, n = 0;
+
+    if (valid < FRUSTUM_LANES) { bits &= (1u << valid) - 1; }
+    for (j = 0; j < FRUSTUM_LANES && j < valid; j += 8) {
+        mask[j / 8] = (unsigned char)(bits >> j);
+    }
+    for (j = 0; j < FRUSTUM_LANES; j += 4) {
+        n += frustum_bitCount[(bits >> j) & 15];
+    }
+    return n;
+}
+
+GL_MATRIX_API size_t frustum_cullSpheres(frustum_t frustum, vec4_soa_t *spheres, unsigned char *mask) {
+    size_t i, j, count = spheres->count, visible = 0;
+    int p;
+
+    for (i = 0; i < count; i += FRUSTUM_LANES) {
+        unsigned int bits = 0;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+        // The streams are GL_MATRIX_SOA_ALIGNMENT aligned, so aligned loads are safe
+        for (j = 0; j < FRUSTUM_LANES; j += 4) {
+            __m128 x = _mm_load_ps(spheres->x + i + j), y = _mm_load_ps(spheres->y + i + j),
+                z = _mm_load_ps(spheres->z + i + j),
+                r = _mm_sub_ps(_mm_setzero_ps(), _mm_load_ps(spheres->w + i + j)),
+                in = _mm_cmpeq_ps(x, x);
+
+            // A sphere is culled if it lies entirely behind any plane
+            for (p = 0; p < 6; p++) {
+                const numeric_t *pl = frustum + p * 4;
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(pl[0]), x),
+                    _mm_mul_ps(_mm_set1_ps(pl[1]), y)),
+                    _mm_mul_ps(_mm_set1_ps(pl[2]), z)),
+                    _mm_set1_ps(pl[3]));
+                in = _mm_and_ps(in, _mm_cmpge_ps(d, r));
+            }
+            bits |= (unsigned int)_mm_movemask_ps(in) << j;
+        }
+#else
+        for (j = 0; j < FRUSTUM_LANES; j++) {
+            numeric_t x = spheres->x[i + j], y = spheres->y[i + j],
+                z = spheres->z[i + j], r = -spheres->w[i + j];
+            unsigned int in = 1;
+
+            // A sphere is culled if it lies entirely behind any plane
+            for (p = 0; p < 6; p++) {
+                const numeric_t *pl = frustum + p * 4;
+                in &= pl[0] * x + pl[1] * y + pl[2] * z + pl[3] >= r;
+            }
+            bits |= in << j;
+        }
+#endif
+
+        visible += frustum_store(bits, mask + i / 8, count - i);
+    }
+
+    return visible;
+}
+
+GL_MATRIX_API size_t frustum_cullBoxes(frustum_t frustum, vec3_soa_t *centers, vec3_soa_t *extents, unsigned char *mask) {
+    size_t i, j, count = centers->count, visible = 0;
+    numeric_t absPlanes[18];
+    int p;
+
+    // The box's extent along a plane normal acts as the radius
+    for (p = 0; p < 18; p++) {
+        absPlanes[p] = glm_fabs(frustum[p / 3 * 4 + p % 3]);
+    }
+
+    for (i = 0; i < count; i += FRUSTUM_LANES) {
+        unsigned int bits = 0;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+        for (j = 0; j < FRUSTUM_LANES; j += 4) {
+            __m128 x = _mm_load_ps(centers->x + i + j), y = _mm_load_ps(centers->y + i + j),
+                z = _mm_load_ps(centers->z + i + j),
+                ex = _mm_load_ps(extents->x + i + j), ey = _mm_load_ps(extents->y + i + j),
+                ez = _mm_load_ps(extents->z + i + j),
+                in = _mm_cmpeq_ps(x, x);
+
+            for (p = 0; p < 6; p++) {
+                const numeric_t *pl = frustum + p * 4, *ap = absPlanes + p * 3;
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(pl[0]), x),
+                    _mm_mul_ps(_mm_set1_ps(pl[1]), y)),
+                    _mm_mul_ps(_mm_set1_ps(pl[2]), z)),
+                    _mm_set1_ps(pl[3])),
+                    r = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(ap[0]), ex),
+                    _mm_mul_ps(_mm_set1_ps(ap[1]), ey)),
+                    _mm_mul_ps(_mm_set1_ps(ap[2]), ez));
+                in = _mm_and_ps(in, _mm_cmpge_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+            }
+            bits |= (unsigned int)_mm_movemask_ps(in) << j;
+        }
+#else
+        for (j = 0; j < FRUSTUM_LANES; j++) {
+            numeric_t x = centers->x[i + j], y = centers->y[i + j], z = centers->z[i + j],
+                ex = extents->x[i + j], ey = extents->y[i + j], ez = extents->z[i + j];
+            unsigned int in = 1;
+
+            for (p = 0; p < 6; p++) {
+                const numeric_t *pl = frustum + p * 4, *ap = absPlanes + p * 3;
+                in &= pl[0] * x + pl[1] * y + pl[2] * z + pl[3] + (ap[0] * ex + ap[1] * ey + ap[2] * ez) >= 0;
+            }
+            bits |= in << j;
+        }
+#endif
+
+        visible += frustum_store(bits, mask + i / 8, count - i);
+    }
+
+    return visible;
+}
+
+#undef FRUSTUM_LANES
@@ -9,6 +9,10 @@ from JavaScript to C.
 #ifndef GL_MATRIX_H
 #define GL_MATRIX_H
 
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -30,7 +34,170 @@ extern "C" {
                               (GL_MATRIX_MINOR_VERSION << 8) | \
                               (GL_MATRIX_MICRO_VERSION))
 
+/*
+ * Precision selection
+ *
+ * By default numeric_t is float. Define GL_MATRIX_DOUBLE before including
+ * this header (and when compiling the library) to make it double instead.
+ *
+ * The double build renames every function that takes or returns numeric_t
+ * by appending _d (vec3_add becomes vec3_add_d, and so on), so that
+ * libgl-matrix.a and libgl-matrix-d.a can be linked into the same program.
+ * Code using the library is written the same way for both precisions; the
+ * renaming is done by the macros below. The allocator, arena and conversion
+ * functions don't depend on numeric_t and are only in libgl-matrix.a, so
+ * programs using the double library link with both:
+ *
+ *     cc -DGL_MATRIX_DOUBLE world.c -lgl-matrix-d -lgl-matrix -lm
+ *
+ * The SIMD backends are float only; the double build always uses the scalar
+ * code.
+ */
+#ifdef GL_MATRIX_DOUBLE
+typedef double numeric_t;
+#else
 typedef float numeric_t;
+#endif
+
+/*
+ * Math functions matching numeric_t
+ *
+ * The library calls these instead of sqrt(), sin(), cos() etc. so that the
+ * float versions are used and values are never promoted to double. Compared
+ * with the double functions, each call may differ by at most 1 ULP of the
+ * float result. Composite functions (mat4_rotate, mat4_perspective,
+ * mat4_lookAt, quat_axisFromAngle, ...) stay within 8 * FLT_EPSILON of what
+ * libgl-matrix-d.a computes from the same inputs, relative to the largest
+ * element of the result. Elements much smaller than that may differ by more
+ * ULPs of their own value, as they come from cancellation. quat_slerp and
+ * quat_slerp_array stay within 8 * FLT_EPSILON / sin^2(theta / 2), theta being the angle between
+ * the quaternions; below sin(theta / 2) = 0.002 the two builds can take
+ * different branches. `make test` checks these bounds.
+ */
+#ifdef GL_MATRIX_DOUBLE
+#define glm_sqrt sqrt
+#define glm_sin sin
+#define glm_cos cos
+#define glm_tan tan
+#define glm_acos acos
+#define glm_fabs fabs
+#else
+#define glm_sqrt sqrtf
+#define glm_sin sinf
+#define glm_cos cosf
+#define glm_tan tanf
+#define glm_acos acosf
+#define glm_fabs fabsf
+#endif
+
+/*
+ * SIMD backend selection
+ *
+ * GL_MATRIX_SIMD selects the vectorized implementation used by the hot mat4
+ * functions (mat4_multiply, mat4_multiplyVec4 and the mat4_multiplyVec*_array
+ * batch transforms). If it is not defined before
+ * including this header it is chosen from the compiler's target flags, so
+ * e.g. building with -mavx2 -mfma picks the AVX2 backend automatically.
+ *
+ * The AVX2 backend fuses each multiply and add into one FMA instruction,
+ * which rounds once instead of twice, so its results can differ from the
+ * SSE and scalar backends in the last bits. On AArch64 the compiler may
+ * fuse NEON's vmla the same way. Compare results across builds with a
+ * tolerance rather than exactly.
+ *
+ * Define GL_MATRIX_SIMD to GL_MATRIX_SIMD_NONE to force the portable scalar
+ * code. The choice does not change any function signature.
+ */
+#define GL_MATRIX_SIMD_NONE 0
+#define GL_MATRIX_SIMD_SSE  1
+#define GL_MATRIX_SIMD_AVX2 2
+#define GL_MATRIX_SIMD_NEON 3
+
+#if defined(GL_MATRIX_DOUBLE) && defined(GL_MATRIX_SIMD)
+#  if GL_MATRIX_SIMD != GL_MATRIX_SIMD_NONE
+#    error "GL_MATRIX_SIMD backends are not available with GL_MATRIX_DOUBLE"
+#  endif
+#endif
+
+#ifndef GL_MATRIX_SIMD
+#  if defined(GL_MATRIX_DOUBLE)
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_NONE
+#  elif defined(__AVX2__) && defined(__FMA__)
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_AVX2
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_SSE
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_NEON
+#  else
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_NONE
+#  endif
+#endif
+
+/*
+ * Static inline build
+ *
+ * GL_MATRIX_API prefixes every function that depends on numeric_t. Defining
+ * GL_MATRIX_STATIC_INLINE before including the single header glmatrix.h
+ * makes them all static inline and compiles their definitions into every
+ * source file that includes it, so calls to small functions like vec3_dot
+ * can be inlined without link time optimization.
+ *
+ * The allocator, arena and conversion functions (glm_*) stay ordinary
+ * functions, so that there is only one installed allocator; one source file
+ * still needs GL_MATRIX_IMPLEMENTATION for them. GL_MATRIX_STATIC_INLINE is
+ * only meant for glmatrix.h, not for gl-matrix.h with libgl-matrix.a.
+ */
+#ifdef GL_MATRIX_STATIC_INLINE
+#define GL_MATRIX_API static inline
+#else
+#define GL_MATRIX_API
+#endif
+
+/*
+ * Non-aliasing variants
+ *
+ * The *_noalias functions declare their pointers GL_MATRIX_RESTRICT (C99
+ * restrict). Their dest is required and must not overlap any input, which
+ * lets the compiler keep the inputs in registers across the stores. Unless
+ * the library is built with NDEBUG, they assert that this holds.
+ *
+ * GL_MATRIX_DISJOINT(a, na, b, nb) is true if the na numbers at a and the nb
+ * numbers at b don't overlap.
+ */
+#ifdef __cplusplus
+#define GL_MATRIX_RESTRICT __restrict
+#else
+#define GL_MATRIX_RESTRICT restrict
+#endif
+
+#define GL_MATRIX_DISJOINT(a, na, b, nb) \
+    ((size_t)(a) + (na) * sizeof(numeric_t) <= (size_t)(b) || \
+     (size_t)(b) + (nb) * sizeof(numeric_t) <= (size_t)(a))
+
+/*
+ * Aligned storage
+ *
+ * GL_MATRIX_ALIGN(n) aligns a variable or struct member to n bytes. The
+ * storage macros declare arrays aligned so the SIMD batch functions can use
+ * aligned loads and stores:
+ *
+ *     GL_MATRIX_MAT4(view);          // numeric_t view[16], cache line aligned
+ *     GL_MATRIX_QUAT(rotations[64]); // 64 quaternions, 16 byte aligned
+ *
+ * Heap storage with the same guarantees comes from mat4_create_aligned,
+ * quat_create_aligned, vec4_create_aligned and glm_alloc_aligned.
+ */
+#if defined(_MSC_VER)
+#define GL_MATRIX_ALIGN(n) __declspec(align(n))
+#elif defined(__GNUC__) || defined(__clang__)
+#define GL_MATRIX_ALIGN(n) __attribute__((aligned(n)))
+#else
+#define GL_MATRIX_ALIGN(n)
+#endif
+
+#define GL_MATRIX_MAT4(name) GL_MATRIX_ALIGN(64) numeric_t name[16]
+#define GL_MATRIX_QUAT(name) GL_MATRIX_ALIGN(16) numeric_t name[4]
+#define GL_MATRIX_VEC4(name) GL_MATRIX_ALIGN(16) numeric_t name[4]
 
 typedef numeric_t *vec2_t;
 typedef numeric_t *vec3_t;
@@ -38,6 +205,397 @@ typedef numeric_t *vec4_t;
 typedef numeric_t *mat3_t;
 typedef numeric_t *mat4_t;
 typedef numeric_t *quat_t;
+typedef numeric_t *dquat_t;
+typedef numeric_t *frustum_t;
+
+/* Symbol renaming for the double build. Every function declared below that
+   uses numeric_t needs an entry here. */
+#ifdef GL_MATRIX_DOUBLE
+#define vec2_add vec2_add_d
+#define vec2_create vec2_create_d
+#define vec2_create_in vec2_create_in_d
+#define vec2_direction vec2_direction_d
+#define vec2_dist vec2_dist_d
+#define vec2_dot vec2_dot_d
+#define vec2_length vec2_length_d
+#define vec2_lerp vec2_lerp_d
+#define vec2_negate vec2_negate_d
+#define vec2_normalize vec2_normalize_d
+#define vec2_ones vec2_ones_d
+#define vec2_scale vec2_scale_d
+#define vec2_set vec2_set_d
+#define vec2_subtract vec2_subtract_d
+#define vec2_zeroes vec2_zeroes_d
+#define vec3_add vec3_add_d
+#define vec3_create vec3_create_d
+#define vec3_create_in vec3_create_in_d
+#define vec3_cross vec3_cross_d
+#define vec3_cross_noalias vec3_cross_noalias_d
+#define vec3_direction vec3_direction_d
+#define vec3_dist vec3_dist_d
+#define vec3_dot vec3_dot_d
+#define vec3_length vec3_length_d
+#define vec3_lerp vec3_lerp_d
+#define vec3_multiply vec3_multiply_d
+#define vec3_negate vec3_negate_d
+#define vec3_normalize vec3_normalize_d
+#define vec3_ones vec3_ones_d
+#define vec3_scale vec3_scale_d
+#define vec3_set vec3_set_d
+#define vec3_subtract vec3_subtract_d
+#define vec3_unproject vec3_unproject_d
+#define vec3_unproject_array vec3_unproject_array_d
+#define vec3_zeroes vec3_zeroes_d
+#define vec4_add vec4_add_d
+#define vec4_create vec4_create_d
+#define vec4_create_in vec4_create_in_d
+#define vec4_create_aligned vec4_create_aligned_d
+#define vec4_direction vec4_direction_d
+#define vec4_dist vec4_dist_d
+#define vec4_dot vec4_dot_d
+#define vec4_length vec4_length_d
+#define vec4_lerp vec4_lerp_d
+#define vec4_negate vec4_negate_d
+#define vec4_normalize vec4_normalize_d
+#define vec4_ones vec4_ones_d
+#define vec4_scale vec4_scale_d
+#define vec4_set vec4_set_d
+#define vec4_subtract vec4_subtract_d
+#define vec4_zeroes vec4_zeroes_d
+#define mat3_create mat3_create_d
+#define mat3_create_in mat3_create_in_d
+#define mat3_identity mat3_identity_d
+#define mat3_multiplyVec3 mat3_multiplyVec3_d
+#define mat3_set mat3_set_d
+#define mat3_toMat4 mat3_toMat4_d
+#define mat3_transpose mat3_transpose_d
+#define mat4_alignVectors mat4_alignVectors_d
+#define mat4_create mat4_create_d
+#define mat4_create_in mat4_create_in_d
+#define mat4_create_aligned mat4_create_aligned_d
+#define mat4_determinant mat4_determinant_d
+#define mat4_fromRotationTranslation mat4_fromRotationTranslation_d
+#define mat4_frustum mat4_frustum_d
+#define mat4_identity mat4_identity_d
+#define mat4_inverse mat4_inverse_d
+#define mat4_inverse_noalias mat4_inverse_noalias_d
+#define mat4_inverseAffine mat4_inverseAffine_d
+#define mat4_inverseRigid mat4_inverseRigid_d
+#define mat4_lookAt mat4_lookAt_d
+#define mat4_multiply mat4_multiply_d
+#define mat4_multiply_noalias mat4_multiply_noalias_d
+#define mat4_multiplyAffine mat4_multiplyAffine_d
+#define mat4_multiplyVec3 mat4_multiplyVec3_d
+#define mat4_multiplyVec3_array mat4_multiplyVec3_array_d
+#define mat4_multiplyVec4 mat4_multiplyVec4_d
+#define mat4_multiplyVec4_array mat4_multiplyVec4_array_d
+#define mat4_ortho mat4_ortho_d
+#define mat4_perspective mat4_perspective_d
+#define mat4_rotate mat4_rotate_d
+#define mat4_rotateX mat4_rotateX_d
+#define mat4_rotateY mat4_rotateY_d
+#define mat4_rotateZ mat4_rotateZ_d
+#define mat4_scale mat4_scale_d
+#define mat4_scale_scalar mat4_scale_scalar_d
+#define mat4_set mat4_set_d
+#define mat4_toInverseMat3 mat4_toInverseMat3_d
+#define mat4_toMat3 mat4_toMat3_d
+#define mat4_toRotationMat mat4_toRotationMat_d
+#define mat4_translate mat4_translate_d
+#define mat4_transpose mat4_transpose_d
+#define quat_axisFromAngle quat_axisFromAngle_d
+#define quat_calculateW quat_calculateW_d
+#define quat_conjugate quat_conjugate_d
+#define quat_create quat_create_d
+#define quat_create_in quat_create_in_d
+#define quat_create_aligned quat_create_aligned_d
+#define quat_dot quat_dot_d
+#define quat_inverse quat_inverse_d
+#define quat_length quat_length_d
+#define quat_multiply quat_multiply_d
+#define quat_multiply_noalias quat_multiply_noalias_d
+#define quat_multiply_array quat_multiply_array_d
+#define quat_multiplyVec3 quat_multiplyVec3_d
+#define quat_multiplyVec3_array quat_multiplyVec3_array_d
+#define quat_normalize quat_normalize_d
+#define quat_rotate quat_rotate_d
+#define quat_set quat_set_d
+#define quat_slerp quat_slerp_d
+#define quat_slerpFast quat_slerpFast_d
+#define quat_slerp_array quat_slerp_array_d
+#define quat_toMat3 quat_toMat3_d
+#define quat_toMat4 quat_toMat4_d
+#define mat3_str mat3_str_d
+#define mat3_str_n mat3_str_n_d
+#define mat4_str mat4_str_d
+#define mat4_str_n mat4_str_n_d
+#define mat4_str_array mat4_str_array_d
+#define quat_str quat_str_d
+#define quat_str_n quat_str_n_d
+#define vec2_str vec2_str_d
+#define vec2_str_n vec2_str_n_d
+#define vec3_str vec3_str_d
+#define vec3_str_n vec3_str_n_d
+#define vec4_str vec4_str_d
+#define vec4_str_n vec4_str_n_d
+#define vec2_parse vec2_parse_d
+#define vec3_parse vec3_parse_d
+#define vec4_parse vec4_parse_d
+#define mat3_parse mat3_parse_d
+#define mat4_parse mat4_parse_d
+#define mat4_parse_array mat4_parse_array_d
+#define quat_parse quat_parse_d
+#define numbers_parse numbers_parse_d
+#define vec3_soa_add vec3_soa_add_d
+#define vec3_soa_create vec3_soa_create_d
+#define vec3_soa_cross vec3_soa_cross_d
+#define vec3_soa_dot vec3_soa_dot_d
+#define vec3_soa_free vec3_soa_free_d
+#define vec3_soa_fromAoS vec3_soa_fromAoS_d
+#define vec3_soa_length vec3_soa_length_d
+#define vec3_soa_lerp vec3_soa_lerp_d
+#define vec3_soa_normalize vec3_soa_normalize_d
+#define vec3_soa_scale vec3_soa_scale_d
+#define vec3_soa_subtract vec3_soa_subtract_d
+#define vec3_soa_toAoS vec3_soa_toAoS_d
+#define vec4_soa_add vec4_soa_add_d
+#define vec4_soa_create vec4_soa_create_d
+#define vec4_soa_dot vec4_soa_dot_d
+#define vec4_soa_free vec4_soa_free_d
+#define vec4_soa_fromAoS vec4_soa_fromAoS_d
+#define vec4_soa_length vec4_soa_length_d
+#define vec4_soa_lerp vec4_soa_lerp_d
+#define vec4_soa_normalize vec4_soa_normalize_d
+#define vec4_soa_scale vec4_soa_scale_d
+#define vec4_soa_subtract vec4_soa_subtract_d
+#define vec4_soa_toAoS vec4_soa_toAoS_d
+#define dquat_create dquat_create_d
+#define dquat_create_in dquat_create_in_d
+#define dquat_set dquat_set_d
+#define dquat_identity dquat_identity_d
+#define dquat_fromRotationTranslation dquat_fromRotationTranslation_d
+#define dquat_getTranslation dquat_getTranslation_d
+#define dquat_multiply dquat_multiply_d
+#define dquat_normalize dquat_normalize_d
+#define dquat_toMat4 dquat_toMat4_d
+#define dquat_transformPoint dquat_transformPoint_d
+#define dquat_str dquat_str_d
+#define dquat_str_n dquat_str_n_d
+#define dquat_parse dquat_parse_d
+#define frustum_fromMat4 frustum_fromMat4_d
+#define frustum_cullSpheres frustum_cullSpheres_d
+#define frustum_cullBoxes frustum_cullBoxes_d
+#define hierarchy_create hierarchy_create_d
+#define hierarchy_free hierarchy_free_d
+#define hierarchy_add hierarchy_add_d
+#define hierarchy_setLocal hierarchy_setLocal_d
+#define hierarchy_markDirty hierarchy_markDirty_d
+#define hierarchy_update hierarchy_update_d
+#define hierarchy_updateParallel hierarchy_updateParallel_d
+#define stream_write stream_write_d
+#define stream_writeEncoded stream_writeEncoded_d
+#define stream_open stream_open_d
+#define stream_data stream_data_d
+#define stream_close stream_close_d
+#define quat_pack32 quat_pack32_d
+#define quat_unpack32 quat_unpack32_d
+#define quat_pack48 quat_pack48_d
+#define quat_unpack48 quat_unpack48_d
+#define quat_pack32_array quat_pack32_array_d
+#define quat_unpack32_array quat_unpack32_array_d
+#define quat_pack48_array quat_pack48_array_d
+#define quat_unpack48_array quat_unpack48_array_d
+#define half_pack half_pack_d
+#define half_unpack half_unpack_d
+#define mat4_packTRS mat4_packTRS_d
+#define mat4_unpackTRS mat4_unpackTRS_d
+#define mat4_packTRS_array mat4_packTRS_array_d
+#define mat4_unpackTRS_array mat4_unpackTRS_array_d
+#define skin_linearBlend skin_linearBlend_d
+#define skin_linearBlendParallel skin_linearBlendParallel_d
+#define skin_dualQuaternion skin_dualQuaternion_d
+#define skin_dualQuaternionParallel skin_dualQuaternionParallel_d
+#endif /* GL_MATRIX_DOUBLE */
+
+/*
+ * Memory allocation
+ *
+ * Everything the library allocates - the *_create functions, and functions
+ * such as mat4_identity, mat4_lookAt or quat_toMat4 when they are given a NULL
+ * dest - is allocated through glm_alloc. By default that is calloc(), so the
+ * results can be released with either free() or glm_free().
+ *
+ * glm_set_allocator routes those allocations through a user supplied
+ * allocator instead, such as an arena or a per-thread pool (the hook itself
+ * is global, so a per-thread pool should look up its thread's pool inside the
+ * alloc function). Install it during startup, before any other thread uses
+ * the library, and release memory with glm_free while it is installed.
+ *
+ * If the library is built with GL_MATRIX_NO_MALLOC defined, glm_alloc never
+ * falls back to calloc(): without an installed allocator it prints a message
+ * and calls abort(). This makes any hidden allocation on a hot path fail
+ * loudly instead of silently hitting malloc.
+ */
+
+/*
+ * glm_alloc_fn
+ * Allocator hook. Returns `size` bytes aligned at least as well as malloc()
+ * would, or NULL on failure. The memory does not need to be zeroed.
+ */
+typedef void *(*glm_alloc_fn)(size_t size, void *user);
+
+/*
+ * glm_free_fn
+ * Deallocator hook. Releases memory returned by the matching glm_alloc_fn.
+ * May be NULL if the allocator never frees individual blocks (e.g. an arena).
+ */
+typedef void (*glm_free_fn)(void *ptr, void *user);
+
+/*
+ * glm_set_allocator
+ * Installs the allocator used by glm_alloc and glm_free
+ *
+ * Params:
+ * alloc - Allocator hook. If NULL, the default allocator is restored
+ * release - Optional, deallocator hook
+ * user - Pointer passed unchanged to both hooks
+ */
+void glm_set_allocator(glm_alloc_fn alloc, glm_free_fn release, void *user);
+
+/*
+ * glm_alloc
+ * Allocates zero-initialized memory through the installed allocator
+ *
+ * Params:
+ * size - number of bytes to allocate
+ *
+ * Returns:
+ * Pointer to the memory, NULL if it could not be allocated
+ */
+void *glm_alloc(size_t size);
+
+/*
+ * glm_free
+ * Releases memory obtained from glm_alloc (or any *_create function)
+ *
+ * Params:
+ * ptr - memory to release. May be NULL
+ */
+void glm_free(void *ptr);
+
+/*
+ * glm_alloc_aligned
+ * Allocates zeroed memory through glm_alloc, aligned to align bytes
+ *
+ * Params:
+ * size - number of bytes to allocate
+ * align - alignment in bytes, a power of two
+ *
+ * Returns:
+ * Pointer to the memory, NULL if it could not be allocated. Release it with
+ * glm_free_aligned, not glm_free.
+ */
+void *glm_alloc_aligned(size_t size, size_t align);
+
+/*
+ * glm_free_aligned
+ * Releases memory obtained from glm_alloc_aligned (or any *_create_aligned
+ * function)
+ *
+ * Params:
+ * ptr - memory to release. May be NULL
+ */
+void glm_free_aligned(void *ptr);
+
+/*
+ * glm_arena - Bump allocator
+ *
+ * An arena hands out memory from one contiguous buffer by advancing an
+ * offset, and releases everything at once with glm_arena_reset. Creating a
+ * frame's temporaries with the *_create_in functions lays them out next to
+ * each other and frees them in O(1) at the end of the frame.
+ *
+ * An arena can also serve every library allocation by installing it with
+ * glm_set_allocator(glm_arena_allocHook, NULL, &arena).
+ *
+ * Arenas are not thread safe; use one per thread.
+ */
+#define GL_MATRIX_ARENA_ALIGNMENT 64
+
+typedef struct {
+    unsigned char *base;
+    size_t size, used;
+    void *block;
+} glm_arena;
+
+/*
+ * glm_arena_init
+ * Initializes an arena with a newly allocated buffer
+ * The buffer is allocated with malloc() (not glm_alloc), and is aligned to
+ * GL_MATRIX_ARENA_ALIGNMENT bytes
+ *
+ * Params:
+ * arena - glm_arena to initialize
+ * size - capacity of the arena in bytes
+ *
+ * Returns:
+ * arena, NULL if the buffer could not be allocated
+ */
+glm_arena *glm_arena_init(glm_arena *arena, size_t size);
+
+/*
+ * glm_arena_initBuffer
+ * Initializes an arena that allocates from memory owned by the caller
+ *
+ * Params:
+ * arena - glm_arena to initialize
+ * buffer - memory to allocate from. It must outlive the arena
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * arena
+ */
+glm_arena *glm_arena_initBuffer(glm_arena *arena, void *buffer, size_t size);
+
+/*
+ * glm_arena_destroy
+ * Releases the buffer of an arena created with glm_arena_init
+ * Everything allocated from the arena becomes invalid
+ *
+ * Params:
+ * arena - glm_arena to destroy
+ */
+void glm_arena_destroy(glm_arena *arena);
+
+/*
+ * glm_arena_alloc
+ * Allocates memory from an arena. The memory is not initialized
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * size - number of bytes to allocate
+ * align - alignment of the result in bytes, a power of two. If 0, the
+ * result is aligned to 16 bytes
+ *
+ * Returns:
+ * Pointer to the memory, NULL if the arena does not have enough space left
+ */
+void *glm_arena_alloc(glm_arena *arena, size_t size, size_t align);
+
+/*
+ * glm_arena_reset
+ * Releases everything allocated from an arena at once
+ *
+ * Params:
+ * arena - glm_arena to reset
+ */
+void glm_arena_reset(glm_arena *arena);
+
+/*
+ * glm_arena_allocHook
+ * glm_alloc_fn that allocates from the glm_arena passed as `user`
+ */
+void *glm_arena_allocHook(size_t size, void *user);
 
 /*
  * vec2_t - 2 Dimensional Vector
@@ -52,9 +610,23 @@ typedef numeric_t *quat_t;
  * vector will be initialized with zeroes.
  *
  * Returns:
- * New vec2
+ * New vec2, NULL if it could not be allocated
+ */
+GL_MATRIX_API vec2_t vec2_create(vec2_t vec);
+
+/*
+ * vec2_create_in
+ * Creates a new instance of a vec2_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * vec - Optional, vec2_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New vec2, NULL if the arena is full
  */
-vec2_t vec2_create(vec2_t vec);
+GL_MATRIX_API vec2_t vec2_create_in(glm_arena *arena, vec2_t vec);
 
 /*
  * vec2_set
@@ -67,7 +639,7 @@ vec2_t vec2_create(vec2_t vec);
  * Returns:
  * dest
  */
-vec2_t vec2_set(vec2_t vec, vec2_t dest);
+GL_MATRIX_API vec2_t vec2_set(vec2_t vec, vec2_t dest);
 
 /*
  * vec2_zeroes
@@ -79,7 +651,7 @@ vec2_t vec2_set(vec2_t vec, vec2_t dest);
  * Returns:
  * vec
  */
-vec2_t vec2_zeroes(vec2_t vec);
+GL_MATRIX_API vec2_t vec2_zeroes(vec2_t vec);
 
 /*
  * vec2_ones
@@ -91,7 +663,7 @@ vec2_t vec2_zeroes(vec2_t vec);
  * Returns:
  * vec
  */
-vec2_t vec2_ones(vec2_t vec);
+GL_MATRIX_API vec2_t vec2_ones(vec2_t vec);
 
 /*
  * vec2_add
@@ -105,7 +677,7 @@ vec2_t vec2_ones(vec2_t vec);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec2_t vec2_add(vec2_t vec, vec2_t vec2, vec2_t dest);
+GL_MATRIX_API vec2_t vec2_add(vec2_t vec, vec2_t vec2, vec2_t dest);
 
 /*
  * vec2_subtract
@@ -119,7 +691,7 @@ vec2_t vec2_add(vec2_t vec, vec2_t vec2, vec2_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec2_t vec2_subtract(vec2_t vec, vec2_t vec2, vec2_t dest);
+GL_MATRIX_API vec2_t vec2_subtract(vec2_t vec, vec2_t vec2, vec2_t dest);
 
 /*
  * vec2_negate
@@ -132,7 +704,7 @@ vec2_t vec2_subtract(vec2_t vec, vec2_t vec2, vec2_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec2_t vec2_negate(vec2_t vec, vec2_t dest);
+GL_MATRIX_API vec2_t vec2_negate(vec2_t vec, vec2_t dest);
 
 /*
  * vec2_scale
@@ -146,7 +718,7 @@ vec2_t vec2_negate(vec2_t vec, vec2_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec2_t vec2_scale(vec2_t vec, numeric_t val, vec2_t dest);
+GL_MATRIX_API vec2_t vec2_scale(vec2_t vec, numeric_t val, vec2_t dest);
 
 /*
  * vec2_normalize
@@ -160,7 +732,7 @@ vec2_t vec2_scale(vec2_t vec, numeric_t val, vec2_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec2_t vec2_normalize(vec2_t vec, vec2_t dest);
+GL_MATRIX_API vec2_t vec2_normalize(vec2_t vec, vec2_t dest);
 
 /*
  * vec2_length
@@ -172,7 +744,7 @@ vec2_t vec2_normalize(vec2_t vec, vec2_t dest);
  * Returns:
  * Length of vec
  */
-numeric_t vec2_length(vec2_t vec);
+GL_MATRIX_API numeric_t vec2_length(vec2_t vec);
 
 /*
  * vec2_dot
@@ -185,7 +757,7 @@ numeric_t vec2_length(vec2_t vec);
  * Returns:
  * Dot product of vec and vec2
  */
-numeric_t vec2_dot(vec2_t vec, vec2_t vec2);
+GL_MATRIX_API numeric_t vec2_dot(vec2_t vec, vec2_t vec2);
 
 /*
  * vec2_direction
@@ -199,7 +771,7 @@ numeric_t vec2_dot(vec2_t vec, vec2_t vec2);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec2_t vec2_direction (vec2_t vec, vec2_t vec2, vec2_t dest);
+GL_MATRIX_API vec2_t vec2_direction (vec2_t vec, vec2_t vec2, vec2_t dest);
 
 /*
  * vec2_lerp
@@ -214,7 +786,7 @@ vec2_t vec2_direction (vec2_t vec, vec2_t vec2, vec2_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec2_t vec2_lerp(vec2_t vec, vec2_t vec2, numeric_t lerp, vec2_t dest);
+GL_MATRIX_API vec2_t vec2_lerp(vec2_t vec, vec2_t vec2, numeric_t lerp, vec2_t dest);
 
 /*
  * vec2_dist
@@ -227,17 +799,53 @@ vec2_t vec2_lerp(vec2_t vec, vec2_t vec2, numeric_t lerp, vec2_t dest);
  * Returns:
  * distance between vec and vec2
  */
-numeric_t vec2_dist(vec2_t vec, vec2_t vec2);
+GL_MATRIX_API numeric_t vec2_dist(vec2_t vec, vec2_t vec2);
 
 /*
  * vec2_str
- * Writes a string representation of a vector
+ * Writes a string representation of a vector, formatted as for vec2_str_n
+ *
+ * Params:
+ * vec - vec2_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(2) bytes
+ */
+GL_MATRIX_API void vec2_str(vec2_t vec, char *buffer);
+
+/*
+ * vec2_str_n
+ * Writes a string representation of a vector into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
  *
  * Params:
  * vec - vec2_t to represent as a string
- * buffer - char * to store the results
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t vec2_str_n(vec2_t vec, char *buffer, size_t size);
+
+/*
+ * vec2_parse
+ * Reads a vector written by vec2_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the vector
+ * dest - vec2_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a vector
  */
-void vec2_str(vec2_t vec, char *buffer);
+GL_MATRIX_API const char *vec2_parse(const char *str, vec2_t dest);
 
 /*
  * vec3_t - 3 Dimensional Vector
@@ -252,9 +860,23 @@ void vec2_str(vec2_t vec, char *buffer);
  * vector will be initialized with zeroes.
  *
  * Returns:
- * New vec3
+ * New vec3, NULL if it could not be allocated
  */
-vec3_t vec3_create(vec3_t vec);
+GL_MATRIX_API vec3_t vec3_create(vec3_t vec);
+
+/*
+ * vec3_create_in
+ * Creates a new instance of a vec3_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * vec - Optional, vec3_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New vec3, NULL if the arena is full
+ */
+GL_MATRIX_API vec3_t vec3_create_in(glm_arena *arena, vec3_t vec);
 
 /*
  * vec3_set
@@ -267,7 +889,7 @@ vec3_t vec3_create(vec3_t vec);
  * Returns:
  * dest
  */
-vec3_t vec3_set(vec3_t vec, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_set(vec3_t vec, vec3_t dest);
 
 /*
  * vec3_zeroes
@@ -279,7 +901,7 @@ vec3_t vec3_set(vec3_t vec, vec3_t dest);
  * Returns:
  * vec
  */
-vec3_t vec3_zeroes(vec3_t vec);
+GL_MATRIX_API vec3_t vec3_zeroes(vec3_t vec);
 
 /*
  * vec3_ones
@@ -291,7 +913,7 @@ vec3_t vec3_zeroes(vec3_t vec);
  * Returns:
  * vec
  */
-vec3_t vec3_ones(vec3_t vec);
+GL_MATRIX_API vec3_t vec3_ones(vec3_t vec);
 
 /*
  * vec3_add
@@ -305,7 +927,7 @@ vec3_t vec3_ones(vec3_t vec);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t vec3_add(vec3_t vec, vec3_t vec2, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_add(vec3_t vec, vec3_t vec2, vec3_t dest);
 
 /*
  * vec3_subtract
@@ -319,7 +941,7 @@ vec3_t vec3_add(vec3_t vec, vec3_t vec2, vec3_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t vec3_subtract(vec3_t vec, vec3_t vec2, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_subtract(vec3_t vec, vec3_t vec2, vec3_t dest);
 
 /*
  * vec3_multiply
@@ -333,7 +955,7 @@ vec3_t vec3_subtract(vec3_t vec, vec3_t vec2, vec3_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t vec3_multiply(vec3_t vec, vec3_t vec2, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_multiply(vec3_t vec, vec3_t vec2, vec3_t dest);
 
 /*
  * vec3_negate
@@ -346,7 +968,7 @@ vec3_t vec3_multiply(vec3_t vec, vec3_t vec2, vec3_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t vec3_negate(vec3_t vec, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_negate(vec3_t vec, vec3_t dest);
 
 /*
  * vec3_scale
@@ -360,7 +982,7 @@ vec3_t vec3_negate(vec3_t vec, vec3_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t vec3_scale(vec3_t vec, numeric_t val, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_scale(vec3_t vec, numeric_t val, vec3_t dest);
 
 /*
  * vec3_normalize
@@ -374,7 +996,7 @@ vec3_t vec3_scale(vec3_t vec, numeric_t val, vec3_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t vec3_normalize(vec3_t vec, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_normalize(vec3_t vec, vec3_t dest);
 
 /*
  * vec3_cross
@@ -388,7 +1010,20 @@ vec3_t vec3_normalize(vec3_t vec, vec3_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t vec3_cross (vec3_t vec, vec3_t vec2, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_cross (vec3_t vec, vec3_t vec2, vec3_t dest);
+
+/*
+ * vec3_cross_noalias
+ * Generates the cross product of two vec3s into a separate vec3
+ *
+ * Params:
+ * vec, vec2 - as for vec3_cross
+ * dest - vec3_t receiving the result. Must not overlap vec or vec2
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec3_t vec3_cross_noalias(vec3_t GL_MATRIX_RESTRICT vec, vec3_t GL_MATRIX_RESTRICT vec2, vec3_t GL_MATRIX_RESTRICT dest);
 
 /*
  * vec3_length
@@ -400,7 +1035,7 @@ vec3_t vec3_cross (vec3_t vec, vec3_t vec2, vec3_t dest);
  * Returns:
  * Length of vec
  */
-numeric_t vec3_length(vec3_t vec);
+GL_MATRIX_API numeric_t vec3_length(vec3_t vec);
 
 /*
  * vec3_dot
@@ -413,7 +1048,7 @@ numeric_t vec3_length(vec3_t vec);
  * Returns:
  * Dot product of vec and vec2
  */
-numeric_t vec3_dot(vec3_t vec, vec3_t vec2);
+GL_MATRIX_API numeric_t vec3_dot(vec3_t vec, vec3_t vec2);
 
 /*
  * vec3_direction
@@ -427,7 +1062,7 @@ numeric_t vec3_dot(vec3_t vec, vec3_t vec2);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t vec3_direction (vec3_t vec, vec3_t vec2, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_direction (vec3_t vec, vec3_t vec2, vec3_t dest);
 
 /*
  * vec3_lerp
@@ -443,7 +1078,7 @@ vec3_t vec3_direction (vec3_t vec, vec3_t vec2, vec3_t dest);
  * dest if not NULL, vec otherwise
  */
 
-vec3_t vec3_lerp(vec3_t vec, vec3_t vec2, numeric_t lerp, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_lerp(vec3_t vec, vec3_t vec2, numeric_t lerp, vec3_t dest);
 
 /*
  * vec3_dist
@@ -456,7 +1091,7 @@ vec3_t vec3_lerp(vec3_t vec, vec3_t vec2, numeric_t lerp, vec3_t dest);
  * Returns:
  * distance between vec and vec2
  */
-numeric_t vec3_dist(vec3_t vec, vec3_t vec2);
+GL_MATRIX_API numeric_t vec3_dist(vec3_t vec, vec3_t vec2);
 
 /*
  * vec3_unproject
@@ -474,17 +1109,77 @@ numeric_t vec3_dist(vec3_t vec, vec3_t vec2);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t vec3_unproject(vec3_t vec, mat4_t view, mat4_t proj, vec4_t viewport, vec3_t dest);
+GL_MATRIX_API vec3_t vec3_unproject(vec3_t vec, mat4_t view, mat4_t proj, vec4_t viewport, vec3_t dest);
+
+/*
+ * vec3_unproject_array
+ * Projects an array of vec3_t from screen space into object space
+ * The inverse view-projection matrix is calculated once for the whole array
+ * (or passed in precomputed), which makes this much faster than calling
+ * vec3_unproject for every point.
+ *
+ * Params:
+ * vec - first vec3_t of a packed array of screen-space vectors to project
+ * count - number of vectors to project
+ * view - mat4, View matrix. Ignored if invViewProj is given
+ * proj - mat4, Projection matrix. Ignored if invViewProj is given
+ * viewport - vec4, Viewport as given to gl.viewport [x, y, width, height]
+ * invViewProj - Optional, mat4 containing the inverse of (proj * view). If NULL,
+ * it is calculated from view and proj
+ * dest - Optional, first vec3_t of the array receiving unprojected results.
+ * If NULL, results are written to vec. Points that unproject to infinity are
+ * left unchanged
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise, NULL if proj * view cannot be inverted
+ */
+GL_MATRIX_API vec3_t vec3_unproject_array(vec3_t vec, size_t count, mat4_t view, mat4_t proj, vec4_t viewport, mat4_t invViewProj, vec3_t dest);
 
 /*
  * vec3_str
- * Writes a string representation of a vector
+ * Writes a string representation of a vector, formatted as for vec3_str_n
  *
  * Params:
  * vec - vec3_t to represent as a string
- * buffer - char * to store the results
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(3) bytes
+ */
+GL_MATRIX_API void vec3_str(vec3_t vec, char *buffer);
+
+/*
+ * vec3_str_n
+ * Writes a string representation of a vector into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * vec - vec3_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t vec3_str_n(vec3_t vec, char *buffer, size_t size);
+
+/*
+ * vec3_parse
+ * Reads a vector written by vec3_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the vector
+ * dest - vec3_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a vector
  */
-void vec3_str(vec3_t vec, char *buffer);
+GL_MATRIX_API const char *vec3_parse(const char *str, vec3_t dest);
 
 /*
  * vec4_t - 4 Dimensional Vector
@@ -499,9 +1194,39 @@ void vec3_str(vec3_t vec, char *buffer);
  * vector will be initialized with zeroes.
  *
  * Returns:
- * New vec4
+ * New vec4, NULL if it could not be allocated
+ */
+GL_MATRIX_API vec4_t vec4_create(vec4_t vec);
+
+/*
+ * vec4_create_in
+ * Creates a new instance of a vec4_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * vec - Optional, vec4_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New vec4, NULL if the arena is full
+ */
+GL_MATRIX_API vec4_t vec4_create_in(glm_arena *arena, vec4_t vec);
+
+/*
+ * vec4_create_aligned
+ * Creates a new instance of a vec4_t aligned to align bytes
+ *
+ * Params:
+ * vec - Optional, vec4_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ * align - alignment in bytes, a power of two: 16 for SSE and NEON, 32 for
+ * AVX, 64 for a cache line
+ *
+ * Returns:
+ * New vec4, NULL if it could not be allocated. Release it with
+ * glm_free_aligned.
  */
-vec4_t vec4_create(vec4_t vec);
+GL_MATRIX_API vec4_t vec4_create_aligned(vec4_t vec, size_t align);
 
 /*
  * vec4_set
@@ -514,7 +1239,7 @@ vec4_t vec4_create(vec4_t vec);
  * Returns:
  * dest
  */
-vec4_t vec4_set(vec4_t vec, vec4_t dest);
+GL_MATRIX_API vec4_t vec4_set(vec4_t vec, vec4_t dest);
 
 /*
  * vec4_zeroes
@@ -526,7 +1251,7 @@ vec4_t vec4_set(vec4_t vec, vec4_t dest);
  * Returns:
  * vec
  */
-vec4_t vec4_zeroes(vec4_t vec);
+GL_MATRIX_API vec4_t vec4_zeroes(vec4_t vec);
 
 /*
  * vec4_ones
@@ -538,7 +1263,7 @@ vec4_t vec4_zeroes(vec4_t vec);
  * Returns:
  * vec
  */
-vec4_t vec4_ones(vec4_t vec);
+GL_MATRIX_API vec4_t vec4_ones(vec4_t vec);
 
 /*
  * vec4_add
@@ -552,7 +1277,7 @@ vec4_t vec4_ones(vec4_t vec);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec4_t vec4_add(vec4_t vec, vec4_t vec2, vec4_t dest);
+GL_MATRIX_API vec4_t vec4_add(vec4_t vec, vec4_t vec2, vec4_t dest);
 
 /*
  * vec4_subtract
@@ -566,7 +1291,7 @@ vec4_t vec4_add(vec4_t vec, vec4_t vec2, vec4_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec4_t vec4_subtract(vec4_t vec, vec4_t vec2, vec4_t dest);
+GL_MATRIX_API vec4_t vec4_subtract(vec4_t vec, vec4_t vec2, vec4_t dest);
 
 /*
  * vec4_negate
@@ -579,7 +1304,7 @@ vec4_t vec4_subtract(vec4_t vec, vec4_t vec2, vec4_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec4_t vec4_negate(vec4_t vec, vec4_t dest);
+GL_MATRIX_API vec4_t vec4_negate(vec4_t vec, vec4_t dest);
 
 /*
  * vec4_scale
@@ -593,7 +1318,7 @@ vec4_t vec4_negate(vec4_t vec, vec4_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec4_t vec4_scale(vec4_t vec, numeric_t val, vec4_t dest);
+GL_MATRIX_API vec4_t vec4_scale(vec4_t vec, numeric_t val, vec4_t dest);
 
 /*
  * vec4_normalize
@@ -607,7 +1332,7 @@ vec4_t vec4_scale(vec4_t vec, numeric_t val, vec4_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec4_t vec4_normalize(vec4_t vec, vec4_t dest);
+GL_MATRIX_API vec4_t vec4_normalize(vec4_t vec, vec4_t dest);
 
 /*
  * vec4_length
@@ -619,7 +1344,7 @@ vec4_t vec4_normalize(vec4_t vec, vec4_t dest);
  * Returns:
  * Length of vec
  */
-numeric_t vec4_length(vec4_t vec);
+GL_MATRIX_API numeric_t vec4_length(vec4_t vec);
 
 /*
  * vec4_dot
@@ -632,7 +1357,7 @@ numeric_t vec4_length(vec4_t vec);
  * Returns:
  * Dot product of vec and vec2
  */
-numeric_t vec4_dot(vec4_t vec, vec4_t vec2);
+GL_MATRIX_API numeric_t vec4_dot(vec4_t vec, vec4_t vec2);
 
 /*
  * vec4_direction
@@ -646,7 +1371,7 @@ numeric_t vec4_dot(vec4_t vec, vec4_t vec2);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec4_t vec4_direction (vec4_t vec, vec4_t vec2, vec4_t dest);
+GL_MATRIX_API vec4_t vec4_direction (vec4_t vec, vec4_t vec2, vec4_t dest);
 
 /*
  * vec4_lerp
@@ -661,7 +1386,7 @@ vec4_t vec4_direction (vec4_t vec, vec4_t vec2, vec4_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec4_t vec4_lerp(vec4_t vec, vec4_t vec2, numeric_t lerp, vec4_t dest);
+GL_MATRIX_API vec4_t vec4_lerp(vec4_t vec, vec4_t vec2, numeric_t lerp, vec4_t dest);
 
 /*
  * vec4_dist
@@ -674,17 +1399,53 @@ vec4_t vec4_lerp(vec4_t vec, vec4_t vec2, numeric_t lerp, vec4_t dest);
  * Returns:
  * distance between vec and vec2
  */
-numeric_t vec4_dist(vec4_t vec, vec4_t vec2);
+GL_MATRIX_API numeric_t vec4_dist(vec4_t vec, vec4_t vec2);
 
 /*
  * vec4_str
- * Writes a string representation of a vector
+ * Writes a string representation of a vector, formatted as for vec4_str_n
+ *
+ * Params:
+ * vec - vec4_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(4) bytes
+ */
+GL_MATRIX_API void vec4_str(vec4_t vec, char *buffer);
+
+/*
+ * vec4_str_n
+ * Writes a string representation of a vector into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
  *
  * Params:
  * vec - vec4_t to represent as a string
- * buffer - char * to store the results
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t vec4_str_n(vec4_t vec, char *buffer, size_t size);
+
+/*
+ * vec4_parse
+ * Reads a vector written by vec4_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the vector
+ * dest - vec4_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a vector
  */
-void vec4_str(vec4_t vec, char *buffer);
+GL_MATRIX_API const char *vec4_parse(const char *str, vec4_t dest);
 
 /*
  * mat3_t - 3x3 Matrix
@@ -699,9 +1460,23 @@ void vec4_str(vec4_t vec, char *buffer);
  * will be initialized with zeroes.
  *
  * Returns:
- * New mat3
+ * New mat3, NULL if it could not be allocated
+ */
+GL_MATRIX_API mat3_t mat3_create(mat3_t mat);
+
+/*
+ * mat3_create_in
+ * Creates a new instance of a mat3_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * mat - Optional, mat3_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New mat3, NULL if the arena is full
  */
-mat3_t mat3_create(mat3_t mat);
+GL_MATRIX_API mat3_t mat3_create_in(glm_arena *arena, mat3_t mat);
 
 /*
  * mat3_set
@@ -714,7 +1489,7 @@ mat3_t mat3_create(mat3_t mat);
  * Returns:
  * dest
  */
-mat3_t mat3_set(mat3_t mat, mat3_t dest);
+GL_MATRIX_API mat3_t mat3_set(mat3_t mat, mat3_t dest);
 
 /*
  * mat3_identity
@@ -726,7 +1501,7 @@ mat3_t mat3_set(mat3_t mat, mat3_t dest);
  * Returns:
  * dest
  */
- mat3_t mat3_identity(mat3_t dest);
+GL_MATRIX_API mat3_t mat3_identity(mat3_t dest);
 
 /*
  * mat4.transpose
@@ -739,7 +1514,7 @@ mat3_t mat3_set(mat3_t mat, mat3_t dest);
  * Returns:
  * dest is specified, mat otherwise
  */
-mat3_t mat3_transpose(mat3_t mat, mat3_t dest);
+GL_MATRIX_API mat3_t mat3_transpose(mat3_t mat, mat3_t dest);
 
 /*
  * mat3_toMat4
@@ -752,7 +1527,7 @@ mat3_t mat3_transpose(mat3_t mat, mat3_t dest);
  * Returns:
  * dest if not NULL, a new mat4_t otherwise
  */
-mat4_t mat3_toMat4(mat3_t mat, mat4_t dest);
+GL_MATRIX_API mat4_t mat3_toMat4(mat3_t mat, mat4_t dest);
 
 /*
  * mat3_multiplyVec3
@@ -766,17 +1541,53 @@ mat4_t mat3_toMat4(mat3_t mat, mat4_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t mat3_multiplyVec3(mat3_t mat, vec3_t vec, vec3_t dest);
+GL_MATRIX_API vec3_t mat3_multiplyVec3(mat3_t mat, vec3_t vec, vec3_t dest);
 
 /*
  * mat3_str
- * Writes a string representation of a mat3
+ * Writes a string representation of a mat3, formatted as for mat3_str_n
+ *
+ * Params:
+ * mat - mat3_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(9) bytes
+ */
+GL_MATRIX_API void mat3_str(mat3_t mat, char *buffer);
+
+/*
+ * mat3_str_n
+ * Writes a string representation of a mat3 into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
  *
  * Params:
  * mat - mat3_t to represent as a string
- * buffer - char * to store the results
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t mat3_str_n(mat3_t mat, char *buffer, size_t size);
+
+/*
+ * mat3_parse
+ * Reads a mat3 written by mat3_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the mat3
+ * dest - mat3_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a mat3
  */
-void mat3_str(mat3_t mat, char *buffer);
+GL_MATRIX_API const char *mat3_parse(const char *str, mat3_t dest);
 
 /*
  * mat4_t - 4x4 Matrix
@@ -790,9 +1601,41 @@ void mat3_str(mat3_t mat, char *buffer);
  * mat - Optional, mat4_t containing values to initialize with
  *
  * Returns:
- * New mat4
+ * New mat4, NULL if it could not be allocated
+ */
+GL_MATRIX_API mat4_t mat4_create(mat4_t mat);
+
+/*
+ * mat4_create_in
+ * Creates a new instance of a mat4_t in an arena
+ * The matrix is aligned to GL_MATRIX_ARENA_ALIGNMENT bytes, so it occupies
+ * exactly one cache line
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * mat - Optional, mat4_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New mat4, NULL if the arena is full
+ */
+GL_MATRIX_API mat4_t mat4_create_in(glm_arena *arena, mat4_t mat);
+
+/*
+ * mat4_create_aligned
+ * Creates a new instance of a mat4_t aligned to align bytes
+ *
+ * Params:
+ * mat - Optional, mat4_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ * align - alignment in bytes, a power of two: 16 for SSE and NEON, 32 for
+ * AVX, 64 for a cache line
+ *
+ * Returns:
+ * New mat4, NULL if it could not be allocated. Release it with
+ * glm_free_aligned.
  */
-mat4_t mat4_create(mat4_t mat);
+GL_MATRIX_API mat4_t mat4_create_aligned(mat4_t mat, size_t align);
 
 /*
  * mat4_set
@@ -805,7 +1648,7 @@ mat4_t mat4_create(mat4_t mat);
  * Returns:
  * dest
  */
-mat4_t mat4_set(mat4_t mat, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_set(mat4_t mat, mat4_t dest);
 
 /*
  * mat4_identity
@@ -817,7 +1660,7 @@ mat4_t mat4_set(mat4_t mat, mat4_t dest);
  * Returns:
  * dest
  */
-mat4_t mat4_identity(mat4_t dest);
+GL_MATRIX_API mat4_t mat4_identity(mat4_t dest);
 
 /*
  * mat4_transpose
@@ -830,7 +1673,7 @@ mat4_t mat4_identity(mat4_t dest);
  * Returns:
  * dest is specified, mat otherwise
  */
-mat4_t mat4_transpose(mat4_t mat, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_transpose(mat4_t mat, mat4_t dest);
 
 /*
  * mat4_determinant
@@ -842,7 +1685,7 @@ mat4_t mat4_transpose(mat4_t mat, mat4_t dest);
  * Returns:
  * determinant of mat
  */
-numeric_t mat4_determinant(mat4_t mat);
+GL_MATRIX_API numeric_t mat4_determinant(mat4_t mat);
 
 /*
  * mat4_inverse
@@ -855,7 +1698,52 @@ numeric_t mat4_determinant(mat4_t mat);
  * Returns:
  * dest is specified, mat otherwise, NULL if matrix cannot be inverted
  */
-mat4_t mat4_inverse(mat4_t mat, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_inverse(mat4_t mat, mat4_t dest);
+
+/*
+ * mat4_inverse_noalias
+ * Calculates the inverse matrix of a mat4 into a separate mat4
+ *
+ * Params:
+ * mat - mat4_t to calculate inverse of
+ * dest - mat4_t receiving inverse matrix. Must not overlap mat
+ *
+ * Returns:
+ * dest, NULL if matrix cannot be inverted
+ */
+GL_MATRIX_API mat4_t mat4_inverse_noalias(mat4_t GL_MATRIX_RESTRICT mat, mat4_t GL_MATRIX_RESTRICT dest);
+
+/*
+ * mat4_inverseAffine
+ * Calculates the inverse of an affine mat4
+ * The bottom row of mat is assumed to be (0, 0, 0, 1) and is not read. Only
+ * the upper 3x3 is inverted, and the translation is back-substituted, which
+ * is much cheaper than mat4_inverse.
+ *
+ * Params:
+ * mat - mat4_t to calculate inverse of
+ * dest - Optional, mat4_t receiving inverse matrix. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest is specified, mat otherwise, NULL if matrix cannot be inverted
+ */
+GL_MATRIX_API mat4_t mat4_inverseAffine(mat4_t mat, mat4_t dest);
+
+/*
+ * mat4_inverseRigid
+ * Calculates the inverse of a rigid body transform
+ * mat must contain only a rotation and a translation (no scale or shear) with
+ * a bottom row of (0, 0, 0, 1). The inverse is then the transposed rotation
+ * with the rotated, negated translation.
+ *
+ * Params:
+ * mat - mat4_t to calculate inverse of
+ * dest - Optional, mat4_t receiving inverse matrix. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_inverseRigid(mat4_t mat, mat4_t dest);
 
 /*
  * mat4_toRotationMat
@@ -868,7 +1756,7 @@ mat4_t mat4_inverse(mat4_t mat, mat4_t dest);
  * Returns:
  * dest is specified, a new mat4_t otherwise
  */
-mat4_t mat4_toRotationMat(mat4_t mat, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_toRotationMat(mat4_t mat, mat4_t dest);
 
 /*
  * mat4_toMat3
@@ -881,7 +1769,7 @@ mat4_t mat4_toRotationMat(mat4_t mat, mat4_t dest);
  * Returns:
  * dest is specified, a new mat3_t otherwise
  */
-mat3_t mat4_toMat3(mat4_t mat, mat3_t dest);
+GL_MATRIX_API mat3_t mat4_toMat3(mat4_t mat, mat3_t dest);
 
 /*
  * mat4_toInverseMat3
@@ -895,7 +1783,7 @@ mat3_t mat4_toMat3(mat4_t mat, mat3_t dest);
  * Returns:
  * dest is specified, a new mat3_t otherwise, NULL if the matrix cannot be inverted
  */
-mat3_t mat4_toInverseMat3(mat4_t mat, mat3_t dest);
+GL_MATRIX_API mat3_t mat4_toInverseMat3(mat4_t mat, mat3_t dest);
 
 /*
  * mat4_multiply
@@ -909,7 +1797,39 @@ mat3_t mat4_toInverseMat3(mat4_t mat, mat3_t dest);
  * Returns:
  * dest if not NULL, mat otherwise
  */
-mat4_t mat4_multiply(mat4_t mat, mat4_t mat2, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_multiply(mat4_t mat, mat4_t mat2, mat4_t dest);
+
+/*
+ * mat4_multiply_noalias
+ * Performs a matrix multiplication into a separate mat4
+ * Gives the same result as mat4_multiply's scalar code.
+ *
+ * Params:
+ * mat, mat2 - as for mat4_multiply
+ * dest - mat4_t receiving operation result. Must not overlap mat or mat2
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_t mat4_multiply_noalias(mat4_t GL_MATRIX_RESTRICT mat, mat4_t GL_MATRIX_RESTRICT mat2, mat4_t GL_MATRIX_RESTRICT dest);
+
+/*
+ * mat4_multiplyAffine
+ * Performs a matrix multiplication of two affine matrices
+ * The bottom rows of mat and mat2 are assumed to be (0, 0, 0, 1); the result
+ * is the same as mat4_multiply for such matrices, with fewer operations.
+ * The bottom rows aren't read, and the result's is always exactly
+ * (0, 0, 0, 1), with every SIMD backend.
+ *
+ * Params:
+ * mat - mat4, first operand
+ * mat2 - mat4, second operand
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_multiplyAffine(mat4_t mat, mat4_t mat2, mat4_t dest);
 
 /*
  * mat4_multiplyVec3
@@ -924,7 +1844,7 @@ mat4_t mat4_multiply(mat4_t mat, mat4_t mat2, mat4_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec3_t mat4_multiplyVec3(mat4_t mat, vec3_t vec, vec3_t dest);
+GL_MATRIX_API vec3_t mat4_multiplyVec3(mat4_t mat, vec3_t vec, vec3_t dest);
 
 /*
  * mat4_multiplyVec4
@@ -938,7 +1858,51 @@ vec3_t mat4_multiplyVec3(mat4_t mat, vec3_t vec, vec3_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-vec4_t mat4_multiplyVec4(mat4_t mat, vec4_t vec, vec4_t dest);
+GL_MATRIX_API vec4_t mat4_multiplyVec4(mat4_t mat, vec4_t vec, vec4_t dest);
+
+/*
+ * mat4_multiplyVec3_array
+ * Transforms an array of vec3_t with the given matrix
+ * 4th vector component is implicitly '1'
+ *
+ * The matrix is loaded once for the whole batch, so this is much faster than
+ * calling mat4_multiplyVec3 in a loop. Vectors are read from and written to
+ * `stride` bytes apart, which allows transforming positions in place inside
+ * an interleaved vertex buffer.
+ *
+ * Params:
+ * mat - mat4_t to transform the vectors with
+ * vec - first vec3_t to transform
+ * count - number of vectors to transform
+ * stride - distance in bytes between consecutive vectors. If 0, the vectors
+ * are tightly packed (3 * sizeof(numeric_t))
+ * dest - Optional, first vec3_t receiving operation results, using the same
+ * stride as vec. If NULL, results are written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t mat4_multiplyVec3_array(mat4_t mat, vec3_t vec, size_t count, size_t stride, vec3_t dest);
+
+/*
+ * mat4_multiplyVec4_array
+ * Transforms an array of vec4_t with the given matrix
+ *
+ * See mat4_multiplyVec3_array for how the batch is laid out.
+ *
+ * Params:
+ * mat - mat4_t to transform the vectors with
+ * vec - first vec4_t to transform
+ * count - number of vectors to transform
+ * stride - distance in bytes between consecutive vectors. If 0, the vectors
+ * are tightly packed (4 * sizeof(numeric_t))
+ * dest - Optional, first vec4_t receiving operation results, using the same
+ * stride as vec. If NULL, results are written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t mat4_multiplyVec4_array(mat4_t mat, vec4_t vec, size_t count, size_t stride, vec4_t dest);
 
 /*
  * mat4_translate
@@ -952,7 +1916,7 @@ vec4_t mat4_multiplyVec4(mat4_t mat, vec4_t vec, vec4_t dest);
  * Returns:
  * dest if not NULL, mat otherwise
  */
-mat4_t mat4_translate(mat4_t mat, vec3_t vec, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_translate(mat4_t mat, vec3_t vec, mat4_t dest);
 
 /*
  * mat4_scale
@@ -966,7 +1930,7 @@ mat4_t mat4_translate(mat4_t mat, vec3_t vec, mat4_t dest);
  * Returns:
  * dest if not NULL, mat otherwise
  */
-mat4_t mat4_scale(mat4_t mat, vec3_t vec, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_scale(mat4_t mat, vec3_t vec, mat4_t dest);
 
 /*
  * mat4_scale_scalar
@@ -980,7 +1944,7 @@ mat4_t mat4_scale(mat4_t mat, vec3_t vec, mat4_t dest);
  * Returns:
  * dest if not NULL, mat otherwise
  */
-mat4_t mat4_scale_scalar(mat4_t mat, numeric_t scalar, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_scale_scalar(mat4_t mat, numeric_t scalar, mat4_t dest);
 
 /*
  * mat4_rotate
@@ -996,7 +1960,7 @@ mat4_t mat4_scale_scalar(mat4_t mat, numeric_t scalar, mat4_t dest);
  * Returns:
  * dest if not NULL, mat otherwise
  */
-mat4_t mat4_rotate(mat4_t mat, numeric_t angle, vec3_t axis, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_rotate(mat4_t mat, numeric_t angle, vec3_t axis, mat4_t dest);
 
 /*
  * mat4_rotateX
@@ -1010,7 +1974,7 @@ mat4_t mat4_rotate(mat4_t mat, numeric_t angle, vec3_t axis, mat4_t dest);
  * Returns:
  * dest if not NULL, mat otherwise
  */
-mat4_t mat4_rotateX(mat4_t mat, numeric_t angle, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_rotateX(mat4_t mat, numeric_t angle, mat4_t dest);
 
 /*
  * mat4_rotateY
@@ -1024,7 +1988,7 @@ mat4_t mat4_rotateX(mat4_t mat, numeric_t angle, mat4_t dest);
  * Returns:
  * dest if not NULL, mat otherwise
  */
-mat4_t mat4_rotateY(mat4_t mat, numeric_t angle, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_rotateY(mat4_t mat, numeric_t angle, mat4_t dest);
 
 /*
  * mat4_rotateZ
@@ -1038,7 +2002,7 @@ mat4_t mat4_rotateY(mat4_t mat, numeric_t angle, mat4_t dest);
  * Returns:
  * dest if not NULL, mat otherwise
  */
-mat4_t mat4_rotateZ(mat4_t mat, numeric_t angle, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_rotateZ(mat4_t mat, numeric_t angle, mat4_t dest);
 
 /*
  * mat4_frustum
@@ -1053,7 +2017,7 @@ mat4_t mat4_rotateZ(mat4_t mat, numeric_t angle, mat4_t dest);
  * Returns:
  * dest if not NULL, a new mat4_t otherwise
  */
-mat4_t mat4_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest);
 
 /*
  * mat4_perspective
@@ -1068,7 +2032,7 @@ mat4_t mat4_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t
  * Returns:
  * dest if not NULL, a new mat4_t otherwise
  */
-mat4_t mat4_perspective(numeric_t fovy, numeric_t aspect, numeric_t near, numeric_t far, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_perspective(numeric_t fovy, numeric_t aspect, numeric_t near, numeric_t far, mat4_t dest);
 
 /*
  * mat4_ortho
@@ -1083,7 +2047,7 @@ mat4_t mat4_perspective(numeric_t fovy, numeric_t aspect, numeric_t near, numeri
  * Returns:
  * dest if not NULL, a new mat4_t otherwise
  */
-mat4_t mat4_ortho(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_ortho(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest);
 
 /*
  * mat4_lookAt
@@ -1098,7 +2062,7 @@ mat4_t mat4_ortho(numeric_t left, numeric_t right, numeric_t bottom, numeric_t t
  * Returns:
  * dest if not NULL, a new mat4_t otherwise
  */
-mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest);
 
 /*
  * mat4_fromRotationTranslation
@@ -1119,7 +2083,7 @@ mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest);
  * Returns:
  * dest if not NULL, a new mat4_t otherwise
  */
-mat4_t mat4_fromRotationTranslation(quat_t quat, vec3_t vec, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_fromRotationTranslation(quat_t quat, vec3_t vec, mat4_t dest);
 
 /*
  * mat4_alignVectors
@@ -1136,17 +2100,86 @@ mat4_t mat4_fromRotationTranslation(quat_t quat, vec3_t vec, mat4_t dest);
  * Returns:
  * dest
  */
-mat4_t mat4_alignVectors(vec3_t source, vec3_t target, mat4_t dest);
+GL_MATRIX_API mat4_t mat4_alignVectors(vec3_t source, vec3_t target, mat4_t dest);
 
 /*
  * mat4_str
- * Writes a string representation of a mat4
+ * Writes a string representation of a mat4, formatted as for mat4_str_n
+ *
+ * Params:
+ * mat - mat4_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(16) bytes
+ */
+GL_MATRIX_API void mat4_str(mat4_t mat, char *buffer);
+
+/*
+ * mat4_str_n
+ * Writes a string representation of a mat4 into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
  *
  * Params:
  * mat - mat4_t to represent as a string
- * buffer - char * to store the results
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t mat4_str_n(mat4_t mat, char *buffer, size_t size);
+
+/*
+ * mat4_str_array
+ * Writes a string representation of an array of mat4 into one buffer, as a
+ * list of the matrices formatted by mat4_str_n: "[[...], [...]]"
+ *
+ * Params:
+ * mat - first of count consecutive mat4_t
+ * count - number of matrices
+ * buffer - char * to store the results. May be NULL if size is 0. At most
+ * GL_MATRIX_STR_SIZE(16) * count + 2 bytes are needed.
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t mat4_str_array(mat4_t mat, size_t count, char *buffer, size_t size);
+
+/*
+ * mat4_parse
+ * Reads a mat4 written by mat4_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the mat4
+ * dest - mat4_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a mat4
+ */
+GL_MATRIX_API const char *mat4_parse(const char *str, mat4_t dest);
+
+/*
+ * mat4_parse_array
+ * Reads an array of mat4 written by mat4_str_array, "[[...], [...]]"
+ *
+ * Params:
+ * str - NUL terminated text starting with the array
+ * count - number of matrices in the array
+ * dest - count consecutive mat4_t receiving the values. May be partly
+ * written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with an array of count matrices
  */
-void mat4_str(mat4_t mat, char *buffer);
+GL_MATRIX_API const char *mat4_parse_array(const char *str, size_t count, mat4_t dest);
 
 /*
  * quat - Quaternions
@@ -1160,9 +2193,39 @@ void mat4_str(mat4_t mat, char *buffer);
  * quat - Optional, quat_t containing values to initialize with
  *
  * Returns:
- * New quat_t
+ * New quat_t, NULL if it could not be allocated
+ */
+GL_MATRIX_API quat_t quat_create(quat_t quat);
+
+/*
+ * quat_create_in
+ * Creates a new instance of a quat_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * quat - Optional, quat_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New quat, NULL if the arena is full
  */
-quat_t quat_create(quat_t quat);
+GL_MATRIX_API quat_t quat_create_in(glm_arena *arena, quat_t quat);
+
+/*
+ * quat_create_aligned
+ * Creates a new instance of a quat_t aligned to align bytes
+ *
+ * Params:
+ * quat - Optional, quat_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ * align - alignment in bytes, a power of two: 16 for SSE and NEON, 32 for
+ * AVX, 64 for a cache line
+ *
+ * Returns:
+ * New quat, NULL if it could not be allocated. Release it with
+ * glm_free_aligned.
+ */
+GL_MATRIX_API quat_t quat_create_aligned(quat_t quat, size_t align);
 
 /*
  * quat_set
@@ -1175,7 +2238,7 @@ quat_t quat_create(quat_t quat);
  * Returns:
  * dest
  */
-quat_t quat_set(quat_t quat, quat_t dest);
+GL_MATRIX_API quat_t quat_set(quat_t quat, quat_t dest);
 
 /*
  * quat_calculateW
@@ -1190,7 +2253,7 @@ quat_t quat_set(quat_t quat, quat_t dest);
  * Returns:
  * dest if not NULL, quat otherwise
  */
-quat_t quat_calculateW(quat_t quat, quat_t dest);
+GL_MATRIX_API quat_t quat_calculateW(quat_t quat, quat_t dest);
 
 /**
  * quat_dot
@@ -1201,7 +2264,7 @@ quat_t quat_calculateW(quat_t quat, quat_t dest);
  *
  * @return {number} Dot product of quat and quat2
  */
-numeric_t quat_dot(quat_t quat, quat_t quat2);
+GL_MATRIX_API numeric_t quat_dot(quat_t quat, quat_t quat2);
 
 /*
  * quat_inverse
@@ -1214,7 +2277,7 @@ numeric_t quat_dot(quat_t quat, quat_t quat2);
  * Returns:
  * dest if not NULL, quat otherwise
  */
-quat_t quat_inverse(quat_t quat, quat_t dest);
+GL_MATRIX_API quat_t quat_inverse(quat_t quat, quat_t dest);
 
 /*
  * quat_conjugate
@@ -1227,7 +2290,7 @@ quat_t quat_inverse(quat_t quat, quat_t dest);
  * Returns:
  * dest if not NULL, quat otherwise
  */
-quat_t quat_conjugate(quat_t quat, quat_t dest);
+GL_MATRIX_API quat_t quat_conjugate(quat_t quat, quat_t dest);
 
 /*
  * quat_length
@@ -1239,7 +2302,7 @@ quat_t quat_conjugate(quat_t quat, quat_t dest);
  * Returns:
  * Length of quat
  */
-numeric_t quat_length(quat_t quat);
+GL_MATRIX_API numeric_t quat_length(quat_t quat);
 
 /*
  * quat_normalize
@@ -1253,7 +2316,7 @@ numeric_t quat_length(quat_t quat);
  * Returns:
  * dest if not NULL, quat otherwise
  */
-quat_t quat_normalize(quat_t quat, quat_t dest);
+GL_MATRIX_API quat_t quat_normalize(quat_t quat, quat_t dest);
 
 /*
  * quat_multiply
@@ -1267,7 +2330,20 @@ quat_t quat_normalize(quat_t quat, quat_t dest);
  * Returns:
  * dest if not NULL, quat otherwise
  */
-quat_t quat_multiply(quat_t quat, quat_t quat2, quat_t dest);
+GL_MATRIX_API quat_t quat_multiply(quat_t quat, quat_t quat2, quat_t dest);
+
+/*
+ * quat_multiply_noalias
+ * Performs a quaternion multiplication into a separate quat
+ *
+ * Params:
+ * quat, quat2 - as for quat_multiply
+ * dest - quat_t receiving operation result. Must not overlap quat or quat2
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_multiply_noalias(quat_t GL_MATRIX_RESTRICT quat, quat_t GL_MATRIX_RESTRICT quat2, quat_t GL_MATRIX_RESTRICT dest);
 
 /*
  * quat_multiplyVec3
@@ -1281,7 +2357,24 @@ quat_t quat_multiply(quat_t quat, quat_t quat2, quat_t dest);
  * Returns:
  * dest if not NULL, vec otherwise
  */
-quat_t quat_multiplyVec3(quat_t quat, vec3_t vec, vec3_t dest);
+GL_MATRIX_API quat_t quat_multiplyVec3(quat_t quat, vec3_t vec, vec3_t dest);
+
+/*
+ * quat_multiplyVec3_array
+ * Transforms each vec3_t of an array with the corresponding quat_t
+ * The quaternions must be normalized. This uses a cheaper formula than
+ * quat_multiplyVec3, so results can differ from it in the last bits.
+ *
+ * Params:
+ * quat - first of count tightly packed quat_t
+ * vec - first of count tightly packed vec3_t to transform
+ * count - number of vectors
+ * dest - Optional, array of count vec3_t receiving operation results. If NULL, results are written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t quat_multiplyVec3_array(quat_t quat, vec3_t vec, size_t count, vec3_t dest);
 
 /*
  * quat_toMat3
@@ -1294,7 +2387,7 @@ quat_t quat_multiplyVec3(quat_t quat, vec3_t vec, vec3_t dest);
  * Returns:
  * dest if not NULL, a new mat3_t otherwise
  */
-mat3_t quat_toMat3(quat_t quat, mat3_t dest);
+GL_MATRIX_API mat3_t quat_toMat3(quat_t quat, mat3_t dest);
 
 /*
  * quat_toMat4
@@ -1307,7 +2400,7 @@ mat3_t quat_toMat3(quat_t quat, mat3_t dest);
  * Returns:
  * dest if not NULL, a new mat4_t otherwise
  */
-quat_t quat_toMat4(quat_t quat, mat4_t dest);
+GL_MATRIX_API quat_t quat_toMat4(quat_t quat, mat4_t dest);
 
 /*
  * quat_slerp
@@ -1322,7 +2415,68 @@ quat_t quat_toMat4(quat_t quat, mat4_t dest);
  * Returns:
  * dest if not NULL, quat otherwise
  */
-quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest);
+GL_MATRIX_API quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest);
+
+/*
+ * quat_slerpFast
+ * Approximates a spherical linear interpolation between two quat_t
+ * This is a normalized linear interpolation with a polynomial correction of
+ * the interpolation amount, so it has no trigonometric calls and no branches.
+ * Unlike quat_slerp it always takes the shortest path, flipping quat2 when
+ * the quaternions are more than 180 degrees apart. Compared with the exact
+ * shortest-path slerp of unit quaternions, the rotation is off by at most
+ * 0.0008 radians (0.045 degrees), which happens between rotations 180 degrees
+ * apart. For rotations up to 90 degrees apart it is off by at most 0.00008
+ * radians.
+ *
+ * Params:
+ * quat - quat_t, first quaternion, normalized
+ * quat2 - quat_t, second quaternion, normalized
+ * slerp - interpolation amount between the two inputs, 0 to 1
+ * dest - Optional, quat_t receiving operation result. If NULL, result is written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_slerpFast(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest);
+
+/*
+ * quat_multiply_array
+ * Multiplies two arrays of quat_t element by element
+ * Gives the same results as calling quat_multiply for each element
+ *
+ * Params:
+ * quat - first of count tightly packed quat_t, first operands
+ * quat2 - first of count tightly packed quat_t, second operands
+ * count - number of quaternions
+ * dest - Optional, array of count quat_t receiving operation results. If NULL, results are written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_multiply_array(quat_t quat, quat_t quat2, size_t count, quat_t dest);
+
+/*
+ * quat_slerp_array
+ * Performs a spherical linear interpolation between two arrays of quat_t
+ * Interpolates like calling quat_slerp for each element; use it to blend
+ * whole poses. With the SSE and AVX2 backends, four elements are done at a
+ * time, with acos and sin evaluated by polynomials and the special cases
+ * selected without branches, so the results can differ from quat_slerp's in
+ * the last bits while staying within the same error bound (see Math
+ * functions above). The other backends give exactly quat_slerp's results.
+ *
+ * Params:
+ * quat - first of count tightly packed quat_t, first quaternions
+ * quat2 - first of count tightly packed quat_t, second quaternions
+ * slerp - interpolation amount between the two inputs, used for every element
+ * count - number of quaternions
+ * dest - Optional, array of count quat_t receiving operation results. If NULL, results are written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_slerp_array(quat_t quat, quat_t quat2, numeric_t slerp, size_t count, quat_t dest);
 
 /*
  * quat_axisFromAngle
@@ -1336,7 +2490,7 @@ quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest);
  * Returns:
  * dest
  */
-quat_t quat_axisFromAngle(vec3_t axis, numeric_t angle, quat_t dest);
+GL_MATRIX_API quat_t quat_axisFromAngle(vec3_t axis, numeric_t angle, quat_t dest);
 
 /*
  * quat_rotate
@@ -1355,17 +2509,1765 @@ quat_t quat_axisFromAngle(vec3_t axis, numeric_t angle, quat_t dest);
  * Returns:
  * dest if not NULL, quat otherwise
  */
-quat_t quat_rotate(quat_t quat, vec3_t p, quat_t dest);
+GL_MATRIX_API quat_t quat_rotate(quat_t quat, vec3_t p, quat_t dest);
 
 /*
  * quat_str
- * Writes a string representation of a quaternion
+ * Writes a string representation of a quaternion, formatted as for quat_str_n
  *
  * Params:
  * quat - quat_t to represent as a string
- * buffer - char * to store the results
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(4) bytes
+ */
+GL_MATRIX_API void quat_str(quat_t quat, char *buffer);
+
+/*
+ * quat_str_n
+ * Writes a string representation of a quaternion into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * quat - quat_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t quat_str_n(quat_t quat, char *buffer, size_t size);
+
+/*
+ * quat_parse
+ * Reads a quaternion written by quat_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the quaternion
+ * dest - quat_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a quaternion
+ */
+GL_MATRIX_API const char *quat_parse(const char *str, quat_t dest);
+
+/*
+ * dquat_t - Dual quaternions
+ *
+ * A dual quaternion stores a rigid transform (rotation and translation) in 8
+ * numbers: the rotation quaternion in elements 0-3 (the real part, in the
+ * same x, y, z, w order as quat_t) followed by the dual part in elements 4-7.
+ * The real part of a dquat_t can be passed to the quat_* functions directly.
+ *
+ * Like mat4_multiply, dquat_multiply(a, b) gives the transform that applies b
+ * first and then a.
+ */
+
+/*
+ * dquat_create
+ * Creates a new instance of a dquat_t
+ *
+ * Params:
+ * dquat - Optional, dquat_t containing values to initialize with
+ *
+ * Returns:
+ * New dquat_t, NULL if it could not be allocated
+ */
+GL_MATRIX_API dquat_t dquat_create(dquat_t dquat);
+
+/*
+ * dquat_create_in
+ * Creates a new instance of a dquat_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * dquat - Optional, dquat_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New dquat, NULL if the arena is full
+ */
+GL_MATRIX_API dquat_t dquat_create_in(glm_arena *arena, dquat_t dquat);
+
+/*
+ * dquat_set
+ * Copies the values of one dquat_t to another
+ *
+ * Params:
+ * dquat - dquat_t containing values to copy
+ * dest - dquat_t receiving copied values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API dquat_t dquat_set(dquat_t dquat, dquat_t dest);
+
+/*
+ * dquat_identity
+ * Sets a dquat_t to the identity transform
+ *
+ * Params:
+ * dest - Optional, dquat_t to set. If NULL, a new dquat_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new dquat otherwise
+ */
+GL_MATRIX_API dquat_t dquat_identity(dquat_t dest);
+
+/*
+ * dquat_fromRotationTranslation
+ * Creates a dual quaternion from a rotation and a translation
+ * The result is the same transform as mat4_fromRotationTranslation gives
+ *
+ * Params:
+ * quat - quat_t, normalized rotation
+ * vec - vec3_t, translation
+ * dest - Optional, dquat_t receiving operation result. If NULL, a new dquat_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new dquat otherwise
+ */
+GL_MATRIX_API dquat_t dquat_fromRotationTranslation(quat_t quat, vec3_t vec, dquat_t dest);
+
+/*
+ * dquat_getTranslation
+ * Extracts the translation of a normalized dual quaternion
+ *
+ * Params:
+ * dquat - dquat_t to read the translation of
+ * dest - Optional, vec3_t receiving the translation. If NULL, a new vec3_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new vec3 otherwise
+ */
+GL_MATRIX_API vec3_t dquat_getTranslation(dquat_t dquat, vec3_t dest);
+
+/*
+ * dquat_multiply
+ * Performs a dual quaternion multiplication
+ *
+ * Params:
+ * dquat - dquat_t, first operand
+ * dquat2 - dquat_t, second operand
+ * dest - Optional, dquat_t receiving operation result. If NULL, result is written to dquat
+ *
+ * Returns:
+ * dest if not NULL, dquat otherwise
  */
-void quat_str(quat_t quat, char *buffer);
+GL_MATRIX_API dquat_t dquat_multiply(dquat_t dquat, dquat_t dquat2, dquat_t dest);
+
+/*
+ * dquat_normalize
+ * Divides both parts of a dual quaternion by the length of its real part
+ * If the real part has length 0, the result is all zeroes
+ *
+ * Params:
+ * dquat - dquat_t to normalize
+ * dest - Optional, dquat_t receiving operation result. If NULL, result is written to dquat
+ *
+ * Returns:
+ * dest if not NULL, dquat otherwise
+ */
+GL_MATRIX_API dquat_t dquat_normalize(dquat_t dquat, dquat_t dest);
+
+/*
+ * dquat_toMat4
+ * Calculates a 4x4 matrix from the given normalized dual quaternion
+ *
+ * Params:
+ * dquat - dquat_t to create matrix from
+ * dest - Optional, mat4_t receiving operation result. If NULL, a new mat4_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new mat4 otherwise
+ */
+GL_MATRIX_API mat4_t dquat_toMat4(dquat_t dquat, mat4_t dest);
+
+/*
+ * dquat_transformPoint
+ * Transforms a point with the given normalized dual quaternion
+ *
+ * Params:
+ * dquat - dquat_t to transform the point with
+ * vec - vec3_t, the point to transform
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t dquat_transformPoint(dquat_t dquat, vec3_t vec, vec3_t dest);
+
+/*
+ * dquat_str
+ * Writes a string representation of a dual quaternion, formatted as for dquat_str_n
+ *
+ * Params:
+ * dquat - dquat_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(8) bytes
+ */
+GL_MATRIX_API void dquat_str(dquat_t dquat, char *buffer);
+
+/*
+ * dquat_str_n
+ * Writes a string representation of a dual quaternion into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * dquat - dquat_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t dquat_str_n(dquat_t dquat, char *buffer, size_t size);
+
+/*
+ * dquat_parse
+ * Reads a dual quaternion written by dquat_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the dual quaternion
+ * dest - dquat_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a dual quaternion
+ */
+GL_MATRIX_API const char *dquat_parse(const char *str, dquat_t dest);
+
+/*
+ * vec3_soa_t, vec4_soa_t - Structure-of-arrays vector streams
+ *
+ * Each component is stored in its own array (x[], y[], z[], w[]) so that the
+ * stream kernels below operate on GL_MATRIX_SOA_LANES vectors at a time with
+ * plain vector loads and stores. Streams created with vec3_soa_create and
+ * vec4_soa_create have every component array aligned to
+ * GL_MATRIX_SOA_ALIGNMENT bytes and padded with zeroes to a multiple of
+ * GL_MATRIX_SOA_LANES, so the kernels never need a scalar tail loop. The
+ * kernels rely on that padding, so only pass them streams created that way.
+ *
+ * The kernels follow the same conventions as their vec3_t/vec4_t
+ * counterparts: if dest is NULL, the result is written to the first operand.
+ * All operands must have the same count.
+ */
+#define GL_MATRIX_SOA_LANES 16
+#define GL_MATRIX_SOA_ALIGNMENT 64
+
+typedef struct {
+    numeric_t *x, *y, *z;
+    size_t count;
+    void *block;
+} vec3_soa_t;
+
+typedef struct {
+    numeric_t *x, *y, *z, *w;
+    size_t count;
+    void *block;
+} vec4_soa_t;
+
+/*
+ * vec3_soa_create
+ * Allocates the component arrays of a vec3_soa_t, initialized with zeroes
+ *
+ * Params:
+ * soa - vec3_soa_t to initialize
+ * count - number of vectors in the stream
+ *
+ * Returns:
+ * soa, NULL if the memory could not be allocated
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_create(vec3_soa_t *soa, size_t count);
+
+/*
+ * vec3_soa_free
+ * Releases the component arrays of a vec3_soa_t created with vec3_soa_create
+ *
+ * Params:
+ * soa - vec3_soa_t to release
+ */
+GL_MATRIX_API void vec3_soa_free(vec3_soa_t *soa);
+
+/*
+ * vec3_soa_fromAoS
+ * Copies an array of vec3_t (x, y, z, x, y, z, ...) into a stream
+ *
+ * Params:
+ * vec - first element of the packed vec3_t array
+ * dest - vec3_soa_t receiving the values. Its count is the number of
+ * vectors copied
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_fromAoS(vec3_t vec, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_toAoS
+ * Copies a stream into an array of vec3_t (x, y, z, x, y, z, ...)
+ *
+ * Params:
+ * soa - vec3_soa_t containing the values to copy
+ * dest - first element of the packed vec3_t array receiving the values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec3_t vec3_soa_toAoS(vec3_soa_t *soa, vec3_t dest);
+
+/*
+ * vec3_soa_add
+ * Performs a vector addition on every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first operand
+ * soa2 - vec3_soa_t, second operand
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_add(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_subtract
+ * Performs a vector subtraction on every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first operand
+ * soa2 - vec3_soa_t, second operand
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_subtract(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_scale
+ * Multiplies every element of a stream by a scalar value
+ *
+ * Params:
+ * soa - vec3_soa_t to scale
+ * val - Numeric value to scale by
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_scale(vec3_soa_t *soa, numeric_t val, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_normalize
+ * Normalizes every element of a stream
+ * Elements of length 0 become [0, 0, 0]
+ *
+ * Params:
+ * soa - vec3_soa_t to normalize
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_normalize(vec3_soa_t *soa, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_cross
+ * Generates the cross product of every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first operand
+ * soa2 - vec3_soa_t, second operand
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_cross(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_lerp
+ * Performs a linear interpolation between every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first stream
+ * soa2 - vec3_soa_t, second stream
+ * lerp - interpolation amount between the two inputs
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_lerp(vec3_soa_t *soa, vec3_soa_t *soa2, numeric_t lerp, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_dot
+ * Calculates the dot product of every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first operand
+ * soa2 - vec3_soa_t, second operand
+ * dest - array of soa->count numeric_t receiving the dot products
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *vec3_soa_dot(vec3_soa_t *soa, vec3_soa_t *soa2, numeric_t *dest);
+
+/*
+ * vec3_soa_length
+ * Calculates the length of every element of a stream
+ *
+ * Params:
+ * soa - vec3_soa_t to calculate the lengths of
+ * dest - array of soa->count numeric_t receiving the lengths
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *vec3_soa_length(vec3_soa_t *soa, numeric_t *dest);
+
+/*
+ * vec4_soa_create
+ * Allocates the component arrays of a vec4_soa_t, initialized with zeroes
+ *
+ * Params:
+ * soa - vec4_soa_t to initialize
+ * count - number of vectors in the stream
+ *
+ * Returns:
+ * soa, NULL if the memory could not be allocated
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_create(vec4_soa_t *soa, size_t count);
+
+/*
+ * vec4_soa_free
+ * Releases the component arrays of a vec4_soa_t created with vec4_soa_create
+ *
+ * Params:
+ * soa - vec4_soa_t to release
+ */
+GL_MATRIX_API void vec4_soa_free(vec4_soa_t *soa);
+
+/*
+ * vec4_soa_fromAoS
+ * Copies an array of vec4_t (x, y, z, w, x, y, z, w, ...) into a stream
+ *
+ * Params:
+ * vec - first element of the packed vec4_t array
+ * dest - vec4_soa_t receiving the values. Its count is the number of
+ * vectors copied
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_fromAoS(vec4_t vec, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_toAoS
+ * Copies a stream into an array of vec4_t (x, y, z, w, x, y, z, w, ...)
+ *
+ * Params:
+ * soa - vec4_soa_t containing the values to copy
+ * dest - first element of the packed vec4_t array receiving the values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec4_t vec4_soa_toAoS(vec4_soa_t *soa, vec4_t dest);
+
+/*
+ * vec4_soa_add
+ * Performs a vector addition on every element of two streams
+ *
+ * Params:
+ * soa - vec4_soa_t, first operand
+ * soa2 - vec4_soa_t, second operand
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_add(vec4_soa_t *soa, vec4_soa_t *soa2, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_subtract
+ * Performs a vector subtraction on every element of two streams
+ *
+ * Params:
+ * soa - vec4_soa_t, first operand
+ * soa2 - vec4_soa_t, second operand
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_subtract(vec4_soa_t *soa, vec4_soa_t *soa2, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_scale
+ * Multiplies every element of a stream by a scalar value
+ *
+ * Params:
+ * soa - vec4_soa_t to scale
+ * val - Numeric value to scale by
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_scale(vec4_soa_t *soa, numeric_t val, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_normalize
+ * Normalizes every element of a stream
+ * Elements of length 0 become [0, 0, 0, 0]
+ *
+ * Params:
+ * soa - vec4_soa_t to normalize
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_normalize(vec4_soa_t *soa, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_lerp
+ * Performs a linear interpolation between every element of two streams
+ *
+ * Params:
+ * soa - vec4_soa_t, first stream
+ * soa2 - vec4_soa_t, second stream
+ * lerp - interpolation amount between the two inputs
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_lerp(vec4_soa_t *soa, vec4_soa_t *soa2, numeric_t lerp, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_dot
+ * Calculates the dot product of every element of two streams
+ *
+ * Params:
+ * soa - vec4_soa_t, first operand
+ * soa2 - vec4_soa_t, second operand
+ * dest - array of soa->count numeric_t receiving the dot products
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *vec4_soa_dot(vec4_soa_t *soa, vec4_soa_t *soa2, numeric_t *dest);
+
+/*
+ * vec4_soa_length
+ * Calculates the length of every element of a stream
+ *
+ * Params:
+ * soa - vec4_soa_t to calculate the lengths of
+ * dest - array of soa->count numeric_t receiving the lengths
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *vec4_soa_length(vec4_soa_t *soa, numeric_t *dest);
+
+/*
+ * frustum_t - View frustum culling
+ *
+ * A frustum_t is 24 numbers: six planes (a, b, c, d) in the order left,
+ * right, bottom, top, near, far. The plane normals (a, b, c) are normalized
+ * and point into the frustum, so a point p is inside a plane when
+ * a * p[0] + b * p[1] + c * p[2] + d >= 0.
+ *
+ * The culling functions test whole SoA streams (see vec3_soa_t) and write a
+ * visibility bitmask: bit i % 8 of mask[i / 8] is set if object i may be
+ * visible. mask must hold (count + 7) / 8 bytes. The tests are conservative;
+ * objects near the frustum's corners can be reported visible when they are
+ * not.
+ */
+
+/*
+ * frustum_fromMat4
+ * Extracts the planes of a view frustum from a projection or
+ * view-projection matrix
+ * The planes of a projection matrix are in view space; those of a
+ * view-projection matrix (e.g. mat4_multiply(proj, view)) are in world space.
+ *
+ * Params:
+ * mat - mat4_t to extract the frustum planes of
+ * dest - Optional, frustum_t receiving the planes. If NULL, a new frustum_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new frustum otherwise
+ */
+GL_MATRIX_API frustum_t frustum_fromMat4(mat4_t mat, frustum_t dest);
+
+/*
+ * frustum_cullSpheres
+ * Tests a stream of bounding spheres against a frustum
+ *
+ * Params:
+ * frustum - frustum_t to test against
+ * spheres - vec4_soa_t of spheres: x, y and z hold the centers and w the radii
+ * mask - receives one bit per sphere, set if the sphere is visible
+ *
+ * Returns:
+ * The number of visible spheres
+ */
+GL_MATRIX_API size_t frustum_cullSpheres(frustum_t frustum, vec4_soa_t *spheres, unsigned char *mask);
+
+/*
+ * frustum_cullBoxes
+ * Tests a stream of axis aligned bounding boxes against a frustum
+ *
+ * Params:
+ * frustum - frustum_t to test against
+ * centers - vec3_soa_t of box centers
+ * extents - vec3_soa_t of box half sizes, with the same count as centers
+ * mask - receives one bit per box, set if the box is visible
+ *
+ * Returns:
+ * The number of visible boxes
+ */
+GL_MATRIX_API size_t frustum_cullBoxes(frustum_t frustum, vec3_soa_t *centers, vec3_soa_t *extents, unsigned char *mask);
+
+/*
+ * hierarchy_t - Transform hierarchy
+ *
+ * A scene graph of nodes, each with a local translation, rotation and scale
+ * relative to its parent, flattened into arrays. Nodes are numbered in the
+ * order they are added and a node's parent must be added before it, so the
+ * arrays are always topologically sorted and the world matrices can be
+ * computed in one forward pass.
+ *
+ * Changing a node marks it dirty. hierarchy_update recomputes the world
+ * matrices of the dirty nodes and their descendants only, and leaves the
+ * rest untouched.
+ *
+ * The arrays can be read directly: node i's world matrix is
+ * worlds + i * 16, its local translation translations + i * 3, its rotation
+ * (a quat_t) rotations + i * 4 and its scale scales + i * 3. Call
+ * hierarchy_markDirty after writing to the local arrays directly.
+ *
+ * hierarchy_updateParallel uses pthreads unless the library is built with
+ * GL_MATRIX_NO_THREADS, as the skinning functions do.
+ */
+
+/* Parent of root nodes, and the result of a failed hierarchy_add */
+#define GL_MATRIX_HIERARCHY_NONE ((size_t)-1)
+
+/* Upper limit on the threads used by one hierarchy_updateParallel call */
+#ifndef GL_MATRIX_HIERARCHY_MAX_THREADS
+#define GL_MATRIX_HIERARCHY_MAX_THREADS 64
+#endif
+
+typedef struct {
+    numeric_t *worlds;
+    numeric_t *translations, *rotations, *scales;
+    size_t *parents;
+    unsigned char *dirty;
+    size_t count, capacity;
+    size_t firstDirty;
+    void *block;
+    /* Nodes sorted by depth for hierarchy_updateParallel */
+    size_t *order, *levelStarts;
+    size_t levels, ordered;
+    void *levelBlock;
+} hierarchy_t;
+
+/*
+ * hierarchy_create
+ * Allocates an empty hierarchy with room for capacity nodes
+ *
+ * Params:
+ * h - hierarchy_t to initialize
+ * capacity - maximum number of nodes
+ *
+ * Returns:
+ * h, NULL if the memory could not be allocated
+ */
+GL_MATRIX_API hierarchy_t *hierarchy_create(hierarchy_t *h, size_t capacity);
+
+/*
+ * hierarchy_free
+ * Releases the arrays of a hierarchy_t created with hierarchy_create
+ *
+ * Params:
+ * h - hierarchy_t to release
+ */
+GL_MATRIX_API void hierarchy_free(hierarchy_t *h);
+
+/*
+ * hierarchy_add
+ * Adds a node to a hierarchy
+ * Its world matrix is computed by the next hierarchy_update.
+ *
+ * Params:
+ * h - hierarchy_t to add to
+ * parent - index of the parent node, or GL_MATRIX_HIERARCHY_NONE for a root
+ * translation - Optional, vec3_t local translation. If NULL, (0, 0, 0)
+ * rotation - Optional, quat_t local rotation. If NULL, the identity
+ * scale - Optional, vec3_t local scale. If NULL, (1, 1, 1)
+ *
+ * Returns:
+ * the index of the new node, GL_MATRIX_HIERARCHY_NONE if the hierarchy is
+ * full or parent is not a node of it
+ */
+GL_MATRIX_API size_t hierarchy_add(hierarchy_t *h, size_t parent, vec3_t translation, quat_t rotation, vec3_t scale);
+
+/*
+ * hierarchy_setLocal
+ * Changes the local transform of a node and marks it dirty
+ *
+ * Params:
+ * h - hierarchy_t containing the node
+ * node - index of the node
+ * translation - Optional, vec3_t local translation. If NULL, it is unchanged
+ * rotation - Optional, quat_t local rotation. If NULL, it is unchanged
+ * scale - Optional, vec3_t local scale. If NULL, it is unchanged
+ */
+GL_MATRIX_API void hierarchy_setLocal(hierarchy_t *h, size_t node, vec3_t translation, quat_t rotation, vec3_t scale);
+
+/*
+ * hierarchy_markDirty
+ * Marks a node so that hierarchy_update recomputes the world matrices of it
+ * and its descendants
+ *
+ * Params:
+ * h - hierarchy_t containing the node
+ * node - index of the node
+ */
+GL_MATRIX_API void hierarchy_markDirty(hierarchy_t *h, size_t node);
+
+/*
+ * hierarchy_update
+ * Recomputes the world matrices of the dirty nodes and their descendants
+ * and clears the dirty marks
+ * A node's world matrix is its parent's world matrix multiplied by
+ * translation * rotation * scale. The pass starts at the lowest numbered
+ * dirty node, so returns at once if nothing has changed.
+ *
+ * Params:
+ * h - hierarchy_t to update
+ *
+ * Returns:
+ * The number of world matrices recomputed
+ */
+GL_MATRIX_API size_t hierarchy_update(hierarchy_t *h);
+
+/*
+ * hierarchy_updateParallel
+ * Recomputes the world matrices of the dirty nodes and their descendants
+ * using several threads
+ * The nodes are processed one depth level at a time. Threads claim chunks of
+ * 128 nodes of the current level until it is done, then wait for each other
+ * before starting the next. The first call after nodes were added sorts the
+ * nodes by depth, allocating an index array the size of the hierarchy's
+ * capacity. Every node is computed exactly as by hierarchy_update, so the
+ * results are identical. Small updates run on the calling thread only.
+ *
+ * Params:
+ * h - hierarchy_t to update
+ * threads - number of threads to use, including the calling thread. At most
+ * GL_MATRIX_HIERARCHY_MAX_THREADS.
+ *
+ * Returns:
+ * The number of world matrices recomputed
+ */
+GL_MATRIX_API size_t hierarchy_updateParallel(hierarchy_t *h, unsigned int threads);
+
+/*
+ * Skinning
+ *
+ * Linear blend skinning on the CPU. Each vertex has four bone influences:
+ * four indices into a palette of bone matrices and four weights, which
+ * should add up to 1. Unused influences can point at any bone with a weight
+ * of 0. The bone matrices are blended with the weights and the position (and
+ * optionally the normal) is transformed by the blended matrix.
+ *
+ * Normals are transformed by the upper 3x3 of the blended matrix and are not
+ * renormalized, so normalize them afterwards if the bones scale or the
+ * weights make the result shorter.
+ *
+ * Define GL_MATRIX_NO_THREADS when building the library to leave out the
+ * pthreads dependency; skin_linearBlendParallel then runs on the calling
+ * thread. Otherwise link with -pthread.
+ */
+
+/* Upper limit on the threads used by one skin_linearBlendParallel call */
+#ifndef GL_MATRIX_SKIN_MAX_THREADS
+#define GL_MATRIX_SKIN_MAX_THREADS 64
+#endif
+
+/*
+ * skin_linearBlend
+ * Skins the positions and normals of a mesh
+ *
+ * Params:
+ * bones - bone palette, an array of tightly packed mat4_t
+ * indices - 4 bone indices per vertex
+ * weights - 4 weights per vertex
+ * positions - first of count tightly packed vec3_t, bind pose positions
+ * normals - Optional, first of count tightly packed vec3_t, bind pose
+ * normals. If NULL, only positions are skinned.
+ * count - number of vertices
+ * destPositions - Optional, array of count vec3_t receiving skinned positions. If NULL, results are written to positions
+ * destNormals - Optional, array of count vec3_t receiving skinned normals. If NULL, results are written to normals
+ */
+GL_MATRIX_API void skin_linearBlend(mat4_t bones, unsigned short *indices, numeric_t *weights,
+                      vec3_t positions, vec3_t normals, size_t count,
+                      vec3_t destPositions, vec3_t destNormals);
+
+/*
+ * skin_linearBlendParallel
+ * Skins the positions and normals of a mesh using several threads
+ * The vertices are split into one contiguous range per thread, each a
+ * multiple of 64 vertices, and the calling thread works on the first range.
+ * Every thread gets at least 4096 vertices, since starting a thread costs
+ * about as much as skinning that many, so meshes under 8192 vertices run on
+ * the calling thread only. The results are identical to skin_linearBlend.
+ *
+ * Params:
+ * bones, indices, weights, positions, normals, count, destPositions,
+ * destNormals - as for skin_linearBlend
+ * threads - number of threads to use, including the calling thread. At most
+ * GL_MATRIX_SKIN_MAX_THREADS.
+ */
+GL_MATRIX_API void skin_linearBlendParallel(mat4_t bones, unsigned short *indices, numeric_t *weights,
+                              vec3_t positions, vec3_t normals, size_t count,
+                              vec3_t destPositions, vec3_t destNormals, unsigned int threads);
+
+/*
+ * skin_dualQuaternion
+ * Skins the positions and normals of a mesh with dual quaternion blending
+ * The four bone dual quaternions are blended (after flipping them into the
+ * same hemisphere as the first) and normalized, so the result is always a
+ * rigid transform. Joints keep their volume when twisted, unlike with
+ * skin_linearBlend, and each bone takes 8 numbers instead of 16.
+ *
+ * Normals are only rotated, so unit normals stay unit length.
+ *
+ * Params:
+ * bones - bone palette, an array of tightly packed, normalized dquat_t
+ * indices, weights, positions, normals, count, destPositions,
+ * destNormals - as for skin_linearBlend
+ */
+GL_MATRIX_API void skin_dualQuaternion(dquat_t bones, unsigned short *indices, numeric_t *weights,
+                         vec3_t positions, vec3_t normals, size_t count,
+                         vec3_t destPositions, vec3_t destNormals);
+
+/*
+ * skin_dualQuaternionParallel
+ * Skins the positions and normals of a mesh with dual quaternion blending
+ * using several threads, splitting the work like skin_linearBlendParallel.
+ * Meshes under 8192 vertices run on the calling thread only.
+ *
+ * Params:
+ * bones, indices, weights, positions, normals, count, destPositions,
+ * destNormals - as for skin_dualQuaternion
+ * threads - number of threads to use, including the calling thread. At most
+ * GL_MATRIX_SKIN_MAX_THREADS.
+ */
+GL_MATRIX_API void skin_dualQuaternionParallel(dquat_t bones, unsigned short *indices, numeric_t *weights,
+                                 vec3_t positions, vec3_t normals, size_t count,
+                                 vec3_t destPositions, vec3_t destNormals, unsigned int threads);
+
+/*
+ * Binary streams
+ *
+ * A stream file holds an array of one type of element (vectors, matrices or
+ * quaternions) behind a 64 byte header recording the type, count, precision
+ * and byte order. stream_write saves an array, and stream_open maps a file
+ * into memory. When the file was written with the same precision and byte
+ * order, stream_open doesn't copy or parse anything: stream.data points at
+ * the elements inside the mapping, so a file of mat4 can be used as an
+ * array of mat4_t right away. Files of the other precision or byte order are
+ * converted into a copy allocated with glm_alloc.
+ *
+ * The mapping is copy-on-write: the elements can be modified in place, but
+ * the changes never reach the file. Building with GL_MATRIX_NO_MMAP reads
+ * the file into memory instead of mapping it.
+ *
+ * stream_writeEncoded can store the elements quantized with the functions
+ * of pack.c instead (see Quantization below), with the same error bounds:
+ *
+ * GL_MATRIX_STREAM_HALF    every number as a half float, 2 bytes, any type
+ * GL_MATRIX_STREAM_QUAT32  quat_pack32, 4 bytes per GL_MATRIX_STREAM_QUAT
+ * GL_MATRIX_STREAM_QUAT48  quat_pack48, 6 bytes per GL_MATRIX_STREAM_QUAT
+ * GL_MATRIX_STREAM_TRS     mat4_packTRS, 24 bytes per affine
+ *                          GL_MATRIX_STREAM_MAT4
+ *
+ * The bounds of QUAT32 and QUAT48 hold up to sign: a quaternion can be read
+ * back as -q, the same rotation. stream_open decodes such files into a copy
+ * allocated with glm_alloc.
+ */
+#define GL_MATRIX_STREAM_VEC2 1
+#define GL_MATRIX_STREAM_VEC3 2
+#define GL_MATRIX_STREAM_VEC4 3
+#define GL_MATRIX_STREAM_MAT3 4
+#define GL_MATRIX_STREAM_MAT4 5
+#define GL_MATRIX_STREAM_QUAT 6
+#define GL_MATRIX_STREAM_DQUAT 7
+
+#define GL_MATRIX_STREAM_RAW 0
+#define GL_MATRIX_STREAM_HALF 1
+#define GL_MATRIX_STREAM_QUAT32 2
+#define GL_MATRIX_STREAM_QUAT48 3
+#define GL_MATRIX_STREAM_TRS 4
+
+typedef struct {
+    /* First element, consecutive elements follow without gaps */
+    numeric_t *data;
+    size_t count;
+    /* GL_MATRIX_STREAM_* type and encoding of the file */
+    int type;
+    int encoding;
+    /* The file mapping, or the converted copy */
+    void *mapping;
+    size_t size;
+    numeric_t *copy;
+} stream_t;
+
+/*
+ * stream_write
+ * Writes an array of elements to a stream file, replacing it if it exists
+ *
+ * Params:
+ * path - file to write
+ * type - GL_MATRIX_STREAM_* type of the elements
+ * data - first of count consecutive elements
+ * count - number of elements
+ *
+ * Returns:
+ * 1 on success, 0 if the type is unknown or the file could not be written
+ */
+GL_MATRIX_API int stream_write(const char *path, int type, const numeric_t *data, size_t count);
+
+/*
+ * stream_writeEncoded
+ * Writes an array of elements to a stream file in the given encoding
+ *
+ * Params:
+ * path - file to write
+ * type - GL_MATRIX_STREAM_* type of the elements
+ * encoding - GL_MATRIX_STREAM_RAW, as stream_write, or one of the quantized
+ * encodings that can hold the type
+ * data - first of count consecutive elements. Quaternions must be
+ * normalized and matrices affine.
+ * count - number of elements
+ *
+ * Returns:
+ * 1 on success, 0 if the type or encoding is unknown, the encoding can't
+ * hold the type, or the file could not be written
+ */
+GL_MATRIX_API int stream_writeEncoded(const char *path, int type, int encoding, const numeric_t *data, size_t count);
+
+/*
+ * stream_open
+ * Opens a stream file for reading, mapping it into memory
+ *
+ * Params:
+ * stream - stream_t to initialize
+ * path - file to open
+ *
+ * Returns:
+ * stream, NULL if the file could not be opened or is not a valid stream
+ */
+GL_MATRIX_API stream_t *stream_open(stream_t *stream, const char *path);
+
+/*
+ * stream_data
+ * Returns the elements of a stream if they have the expected type
+ *
+ * Params:
+ * stream - open stream_t
+ * type - GL_MATRIX_STREAM_* type the caller expects, e.g.
+ * GL_MATRIX_STREAM_MAT4 to use the result as mat4_t
+ *
+ * Returns:
+ * First of stream->count elements, NULL if the stream holds another type
+ */
+GL_MATRIX_API numeric_t *stream_data(stream_t *stream, int type);
+
+/*
+ * stream_close
+ * Unmaps a stream, invalidating pointers into its elements
+ *
+ * Params:
+ * stream - stream_t opened with stream_open
+ */
+GL_MATRIX_API void stream_close(stream_t *stream);
+
+/*
+ * Quantization
+ *
+ * Compact encodings of quaternions, vectors and transforms for network
+ * replication and animation caches. The packed forms are the same in the
+ * float and double libraries, in the machine's byte order.
+ *
+ * Quaternions use the smallest three encoding: the index of the largest
+ * component and the other three, which lie in [-1/sqrt(2), 1/sqrt(2)],
+ * quantized to 10 bits each (quat_pack32, 4 bytes) or 15 bits each
+ * (quat_pack48, 6 bytes). The largest component is recomputed from the unit
+ * length on unpacking. Input quaternions must be normalized. Packing makes
+ * the largest component positive, so about half of all quaternions unpack as
+ * -q, which is the same rotation. Up to that sign, measured over 10^7 random
+ * unit quaternions, the largest error of a component is 2.0e-3 with 32 bits
+ * and 5.8e-5 with 48 bits, and the rotations they represent differ by at
+ * most 0.26 and 0.008 degrees. To compare components with the original,
+ * first negate the unpacked quaternion when its dot product with the
+ * original is negative.
+ *
+ * half_pack and half_unpack convert numbers to and from IEEE 754 half
+ * precision, rounding to nearest. The relative error of a normal half is at
+ * most 2^-11 (4.9e-4), and the range ends at 65504.
+ *
+ * mat4_trs_t holds an affine matrix as a float translation, a 48 bit
+ * rotation and a half precision scale, in 24 bytes instead of 64. Matrices
+ * with shear are not representable. With scales in [0.1, 0.9], the upper 3x3
+ * elements of the unpacked matrices were off by at most 2.5e-4.
+ */
+typedef struct {
+    float translation[3];
+    uint16_t rotation[3];
+    uint16_t scale[3];
+} mat4_trs_t;
+
+/*
+ * quat_pack32
+ * Packs a unit quaternion into 32 bits
+ *
+ * Params:
+ * quat - quat_t to pack, normalized
+ *
+ * Returns:
+ * The packed quaternion
+ */
+GL_MATRIX_API uint32_t quat_pack32(quat_t quat);
+
+/*
+ * quat_unpack32
+ * Unpacks a quaternion packed by quat_pack32
+ *
+ * Params:
+ * packed - packed quaternion
+ * dest - quat_t receiving the unit quaternion
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_unpack32(uint32_t packed, quat_t dest);
+
+/*
+ * quat_pack48
+ * Packs a unit quaternion into 48 bits
+ *
+ * Params:
+ * quat - quat_t to pack, normalized
+ * dest - 3 uint16_t receiving the packed quaternion
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API uint16_t *quat_pack48(quat_t quat, uint16_t *dest);
+
+/*
+ * quat_unpack48
+ * Unpacks a quaternion packed by quat_pack48
+ *
+ * Params:
+ * packed - 3 uint16_t, the packed quaternion
+ * dest - quat_t receiving the unit quaternion
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_unpack48(const uint16_t *packed, quat_t dest);
+
+/*
+ * quat_pack32_array
+ * Packs an array of unit quaternions into 32 bits each
+ *
+ * Params:
+ * quat - first of count consecutive quat_t
+ * count - number of quaternions
+ * dest - count uint32_t receiving the packed quaternions
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API uint32_t *quat_pack32_array(quat_t quat, size_t count, uint32_t *dest);
+
+/*
+ * quat_unpack32_array
+ * Unpacks an array of quaternions packed by quat_pack32
+ *
+ * Params:
+ * packed - count packed quaternions
+ * count - number of quaternions
+ * dest - count consecutive quat_t receiving the quaternions
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_unpack32_array(const uint32_t *packed, size_t count, quat_t dest);
+
+/*
+ * quat_pack48_array
+ * Packs an array of unit quaternions into 48 bits each
+ *
+ * Params:
+ * quat - first of count consecutive quat_t
+ * count - number of quaternions
+ * dest - 3 * count uint16_t receiving the packed quaternions
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API uint16_t *quat_pack48_array(quat_t quat, size_t count, uint16_t *dest);
+
+/*
+ * quat_unpack48_array
+ * Unpacks an array of quaternions packed by quat_pack48
+ *
+ * Params:
+ * packed - 3 * count uint16_t, the packed quaternions
+ * count - number of quaternions
+ * dest - count consecutive quat_t receiving the quaternions
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_unpack48_array(const uint16_t *packed, size_t count, quat_t dest);
+
+/*
+ * half_pack
+ * Converts numbers to half precision
+ *
+ * Params:
+ * values - count numbers, e.g. 3 * n for an array of n vec3_t
+ * count - number of numbers
+ * dest - count uint16_t receiving the half precision numbers
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API uint16_t *half_pack(const numeric_t *values, size_t count, uint16_t *dest);
+
+/*
+ * half_unpack
+ * Converts half precision numbers back to numeric_t
+ *
+ * Params:
+ * packed - count half precision numbers
+ * count - number of numbers
+ * dest - count numbers receiving the result
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *half_unpack(const uint16_t *packed, size_t count, numeric_t *dest);
+
+/*
+ * mat4_packTRS
+ * Packs an affine matrix as translation, rotation and scale
+ *
+ * A matrix that mirrors is packed with a negative x scale.
+ *
+ * Params:
+ * mat - mat4_t to pack, an affine matrix without shear
+ * dest - mat4_trs_t receiving the packed matrix
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_trs_t *mat4_packTRS(mat4_t mat, mat4_trs_t *dest);
+
+/*
+ * mat4_unpackTRS
+ * Unpacks a matrix packed by mat4_packTRS
+ *
+ * Params:
+ * trs - packed matrix
+ * dest - mat4_t receiving the matrix
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_t mat4_unpackTRS(const mat4_trs_t *trs, mat4_t dest);
+
+/*
+ * mat4_packTRS_array
+ * Packs an array of affine matrices as translation, rotation and scale
+ *
+ * Params:
+ * mat - first of count consecutive mat4_t
+ * count - number of matrices
+ * dest - count mat4_trs_t receiving the packed matrices
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_trs_t *mat4_packTRS_array(mat4_t mat, size_t count, mat4_trs_t *dest);
+
+/*
+ * mat4_unpackTRS_array
+ * Unpacks an array of matrices packed by mat4_packTRS
+ *
+ * Params:
+ * trs - count packed matrices
+ * count - number of matrices
+ * dest - count consecutive mat4_t receiving the matrices
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_t mat4_unpackTRS_array(const mat4_trs_t *trs, size_t count, mat4_t dest);
+
+/*
+ * Precision conversion
+ *
+ * These convert between float and double data regardless of which precision
+ * numeric_t is, so world-space transforms computed with the double library
+ * can be handed to a float renderer. They are built into libgl-matrix.a only.
+ */
+
+/*
+ * glm_doubleToFloat
+ * Converts an array of doubles to floats
+ *
+ * Params:
+ * src - array of count doubles
+ * dest - array of count floats receiving the result
+ * count - number of values to convert
+ *
+ * Returns:
+ * dest
+ */
+float *glm_doubleToFloat(const double *src, float *dest, size_t count);
+
+/*
+ * glm_floatToDouble
+ * Converts an array of floats to doubles
+ *
+ * Params:
+ * src - array of count floats
+ * dest - array of count doubles receiving the result
+ * count - number of values to convert
+ *
+ * Returns:
+ * dest
+ */
+double *glm_floatToDouble(const float *src, double *dest, size_t count);
+
+/*
+ * glm_mat4ToFloat
+ * Converts a double precision 4x4 matrix to float
+ *
+ * Params:
+ * mat - 16 doubles, the matrix to convert
+ * dest - 16 floats receiving the result
+ *
+ * Returns:
+ * dest
+ */
+float *glm_mat4ToFloat(const double *mat, float *dest);
+
+/*
+ * glm_mat4ToDouble
+ * Converts a float 4x4 matrix to double precision
+ *
+ * Params:
+ * mat - 16 floats, the matrix to convert
+ * dest - 16 doubles receiving the result
+ *
+ * Returns:
+ * dest
+ */
+double *glm_mat4ToDouble(const float *mat, double *dest);
+
+/*
+ * Number formatting
+ *
+ * glm_formatFloat and glm_formatDouble write the shortest string that reads
+ * back as the same number, e.g. "0.1" rather than "0.100000001". They don't
+ * depend on the locale, and are about three times faster than printf's
+ * "%.9g". The layout follows JavaScript's Number.prototype.toString: plain
+ * notation from 1e-6 up to 1e21 ("1", "-0.25", "123456"), exponent notation
+ * outside it ("1e-7", "1.5e+30"), and "inf", "-inf" and "nan", all of which
+ * strtod accepts. They are built into libgl-matrix.a only.
+ *
+ * GL_MATRIX_FORMAT_MAX is the most a number can take, including the NUL.
+ * GL_MATRIX_STR_SIZE(n) is the most a *_str string of n numbers can take.
+ */
+#define GL_MATRIX_FORMAT_MAX 26
+#define GL_MATRIX_STR_SIZE(n) ((n) * (GL_MATRIX_FORMAT_MAX + 1) + 2)
+
+/*
+ * glm_formatFloat
+ * Writes the shortest round-trip representation of a float
+ *
+ * Params:
+ * x - number to format
+ * buffer - char * to store the results, at least GL_MATRIX_FORMAT_MAX bytes
+ *
+ * Returns:
+ * Length of the string written, not counting the terminating NUL
+ */
+size_t glm_formatFloat(float x, char *buffer);
+
+/*
+ * glm_formatDouble
+ * Writes the shortest round-trip representation of a double
+ *
+ * Params:
+ * x - number to format
+ * buffer - char * to store the results, at least GL_MATRIX_FORMAT_MAX bytes
+ *
+ * Returns:
+ * Length of the string written, not counting the terminating NUL
+ */
+size_t glm_formatDouble(double x, char *buffer);
+
+/*
+ * Number parsing
+ *
+ * glm_parseFloat and glm_parseDouble read numbers as written by
+ * glm_formatFloat/glm_formatDouble, and anything else strtod accepts in
+ * decimal: an optional sign, digits with an optional decimal point, an
+ * optional exponent, and inf, infinity or nan in any case. The decimal point
+ * is always '.', whatever the locale, and the result is correctly rounded.
+ * They don't call strtod, allocate or skip leading whitespace, and are
+ * thread-safe. They are built into libgl-matrix.a only.
+ */
+
+/*
+ * glm_parseFloat
+ * Parses a number into a float
+ *
+ * Params:
+ * str - text starting with the number
+ * dest - float receiving the number
+ *
+ * Returns:
+ * Pointer to the first character after the number, NULL if str doesn't
+ * start with a number
+ */
+const char *glm_parseFloat(const char *str, float *dest);
+
+/*
+ * glm_parseDouble
+ * Parses a number into a double
+ *
+ * Params:
+ * str - text starting with the number
+ * dest - double receiving the number
+ *
+ * Returns:
+ * Pointer to the first character after the number, NULL if str doesn't
+ * start with a number
+ */
+const char *glm_parseDouble(const char *str, double *dest);
+
+/*
+ * numbers_parse
+ * Reads the numbers from a chunk of a large text file, e.g. of *_str output
+ *
+ * Numbers are separated by any of '[', ']', ',' and whitespace, so the
+ * brackets are skipped rather than checked. The chunk needn't be NUL
+ * terminated. A number that runs up to the end of the chunk may continue in
+ * the next one, so it is left unread: the caller moves the rest of the chunk
+ * to the start of the next. The text should therefore end with a separator,
+ * as *_str output does.
+ *
+ * Params:
+ * str - chunk of text
+ * length - length of the chunk in bytes
+ * dest - numeric_t array receiving the numbers
+ * max - size of dest; reading stops after max numbers
+ * count - receives the number of numbers read
+ *
+ * Returns:
+ * Pointer to where reading stopped, at most str + length. NULL if the text
+ * holds something other than numbers and separators, in which case count
+ * isn't set.
+ */
+GL_MATRIX_API const char *numbers_parse(const char *str, size_t length, numeric_t *dest, size_t max, size_t *count);
+
+/*
+ * Value types
+ *
+ * vec2s, vec3s, vec4s, quats and mat4s wrap the same numbers as vec2_t,
+ * vec3_t, vec4_t, quat_t and mat4_t in a struct, so they can be passed and
+ * returned by value. The functions below are static inline and never
+ * allocate. Because their operands are copies, they cannot alias, so the
+ * compiler can keep whole chains of them (e.g. mat4s_lookAt, mat4s_multiply,
+ * mat4s_multiplyVec4) in registers.
+ *
+ * Each function computes the same result as the pointer function of the same
+ * name without the "s" built with GL_MATRIX_SIMD_NONE, and takes its
+ * operands in the same order. They are plain C, so with the AVX2 or NEON
+ * backend, whose mat4_multiply and mat4_multiplyVec4 fuse multiply-adds,
+ * mat4s_multiply and mat4s_multiplyVec4 can differ from the pointer
+ * functions in the last bits. The v
+ * member can be passed wherever the pointer API expects a vec3_t, mat4_t
+ * etc., and the *_load functions go the other way.
+ */
+typedef struct { numeric_t v[2]; } vec2s;
+typedef struct { numeric_t v[3]; } vec3s;
+typedef struct { numeric_t v[4]; } vec4s;
+typedef struct { numeric_t v[4]; } quats;
+typedef struct { numeric_t v[16]; } mat4s;
+
+static inline vec2s vec2s_make(numeric_t x, numeric_t y) {
+    vec2s r;
+    r.v[0] = x; r.v[1] = y;
+    return r;
+}
+
+static inline vec2s vec2s_load(vec2_t vec) {
+    return vec2s_make(vec[0], vec[1]);
+}
+
+static inline vec2s vec2s_add(vec2s a, vec2s b) {
+    return vec2s_make(a.v[0] + b.v[0], a.v[1] + b.v[1]);
+}
+
+static inline vec2s vec2s_subtract(vec2s a, vec2s b) {
+    return vec2s_make(a.v[0] - b.v[0], a.v[1] - b.v[1]);
+}
+
+static inline vec2s vec2s_scale(vec2s a, numeric_t val) {
+    return vec2s_make(a.v[0] * val, a.v[1] * val);
+}
+
+static inline numeric_t vec2s_dot(vec2s a, vec2s b) {
+    return a.v[0] * b.v[0] + a.v[1] * b.v[1];
+}
+
+static inline numeric_t vec2s_length(vec2s a) {
+    return glm_sqrt(vec2s_dot(a, a));
+}
+
+static inline vec2s vec2s_normalize(vec2s a) {
+    numeric_t len = vec2s_length(a);
+    if (!len) { return vec2s_make(0, 0); }
+    return len == 1 ? a : vec2s_scale(a, 1 / len);
+}
+
+static inline vec2s vec2s_lerp(vec2s a, vec2s b, numeric_t lerp) {
+    return vec2s_make(a.v[0] + lerp * (b.v[0] - a.v[0]), a.v[1] + lerp * (b.v[1] - a.v[1]));
+}
+
+static inline vec3s vec3s_make(numeric_t x, numeric_t y, numeric_t z) {
+    vec3s r;
+    r.v[0] = x; r.v[1] = y; r.v[2] = z;
+    return r;
+}
+
+static inline vec3s vec3s_load(vec3_t vec) {
+    return vec3s_make(vec[0], vec[1], vec[2]);
+}
+
+static inline vec3s vec3s_add(vec3s a, vec3s b) {
+    return vec3s_make(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2]);
+}
+
+static inline vec3s vec3s_subtract(vec3s a, vec3s b) {
+    return vec3s_make(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2]);
+}
+
+static inline vec3s vec3s_multiply(vec3s a, vec3s b) {
+    return vec3s_make(a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2]);
+}
+
+static inline vec3s vec3s_negate(vec3s a) {
+    return vec3s_make(-a.v[0], -a.v[1], -a.v[2]);
+}
+
+static inline vec3s vec3s_scale(vec3s a, numeric_t val) {
+    return vec3s_make(a.v[0] * val, a.v[1] * val, a.v[2] * val);
+}
+
+static inline numeric_t vec3s_dot(vec3s a, vec3s b) {
+    return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2];
+}
+
+static inline vec3s vec3s_cross(vec3s a, vec3s b) {
+    return vec3s_make(a.v[1] * b.v[2] - a.v[2] * b.v[1],
+                      a.v[2] * b.v[0] - a.v[0] * b.v[2],
+                      a.v[0] * b.v[1] - a.v[1] * b.v[0]);
+}
+
+static inline numeric_t vec3s_length(vec3s a) {
+    return glm_sqrt(vec3s_dot(a, a));
+}
+
+static inline vec3s vec3s_normalize(vec3s a) {
+    numeric_t len = vec3s_length(a);
+    if (!len) { return vec3s_make(0, 0, 0); }
+    return len == 1 ? a : vec3s_scale(a, 1 / len);
+}
+
+static inline vec3s vec3s_lerp(vec3s a, vec3s b, numeric_t lerp) {
+    return vec3s_make(a.v[0] + lerp * (b.v[0] - a.v[0]),
+                      a.v[1] + lerp * (b.v[1] - a.v[1]),
+                      a.v[2] + lerp * (b.v[2] - a.v[2]));
+}
+
+static inline numeric_t vec3s_dist(vec3s a, vec3s b) {
+    return vec3s_length(vec3s_subtract(b, a));
+}
+
+static inline vec4s vec4s_make(numeric_t x, numeric_t y, numeric_t z, numeric_t w) {
+    vec4s r;
+    r.v[0] = x; r.v[1] = y; r.v[2] = z; r.v[3] = w;
+    return r;
+}
+
+static inline vec4s vec4s_load(vec4_t vec) {
+    return vec4s_make(vec[0], vec[1], vec[2], vec[3]);
+}
+
+static inline vec4s vec4s_add(vec4s a, vec4s b) {
+    return vec4s_make(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]);
+}
+
+static inline vec4s vec4s_subtract(vec4s a, vec4s b) {
+    return vec4s_make(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]);
+}
+
+static inline vec4s vec4s_scale(vec4s a, numeric_t val) {
+    return vec4s_make(a.v[0] * val, a.v[1] * val, a.v[2] * val, a.v[3] * val);
+}
+
+static inline numeric_t vec4s_dot(vec4s a, vec4s b) {
+    return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3];
+}
+
+static inline numeric_t vec4s_length(vec4s a) {
+    return glm_sqrt(vec4s_dot(a, a));
+}
+
+static inline vec4s vec4s_normalize(vec4s a) {
+    numeric_t len = vec4s_length(a);
+    if (!len) { return vec4s_make(0, 0, 0, 0); }
+    return len == 1 ? a : vec4s_scale(a, 1 / len);
+}
+
+static inline vec4s vec4s_lerp(vec4s a, vec4s b, numeric_t lerp) {
+    return vec4s_make(a.v[0] + lerp * (b.v[0] - a.v[0]),
+                      a.v[1] + lerp * (b.v[1] - a.v[1]),
+                      a.v[2] + lerp * (b.v[2] - a.v[2]),
+                      a.v[3] + lerp * (b.v[3] - a.v[3]));
+}
+
+static inline quats quats_make(numeric_t x, numeric_t y, numeric_t z, numeric_t w) {
+    quats r;
+    r.v[0] = x; r.v[1] = y; r.v[2] = z; r.v[3] = w;
+    return r;
+}
+
+static inline quats quats_load(quat_t quat) {
+    return quats_make(quat[0], quat[1], quat[2], quat[3]);
+}
+
+static inline quats quats_identity(void) {
+    return quats_make(0, 0, 0, 1);
+}
+
+static inline quats quats_conjugate(quats q) {
+    return quats_make(-q.v[0], -q.v[1], -q.v[2], q.v[3]);
+}
+
+static inline quats quats_normalize(quats q) {
+    numeric_t x = q.v[0], y = q.v[1], z = q.v[2], w = q.v[3],
+        len = glm_sqrt(x * x + y * y + z * z + w * w);
+    if (len == 0) { return quats_make(0, 0, 0, 0); }
+    len = 1 / len;
+    return quats_make(x * len, y * len, z * len, w * len);
+}
+
+static inline quats quats_multiply(quats a, quats b) {
+    numeric_t qax = a.v[0], qay = a.v[1], qaz = a.v[2], qaw = a.v[3],
+        qbx = b.v[0], qby = b.v[1], qbz = b.v[2], qbw = b.v[3];
+
+    return quats_make(qax * qbw + qaw * qbx + qay * qbz - qaz * qby,
+                      qay * qbw + qaw * qby + qaz * qbx - qax * qbz,
+                      qaz * qbw + qaw * qbz + qax * qby - qay * qbx,
+                      qaw * qbw - qax * qbx - qay * qby - qaz * qbz);
+}
+
+static inline vec3s quats_multiplyVec3(quats q, vec3s vec) {
+    numeric_t x = vec.v[0], y = vec.v[1], z = vec.v[2],
+        qx = q.v[0], qy = q.v[1], qz = q.v[2], qw = q.v[3],
+
+        ix = qw * x + qy * z - qz * y,
+        iy = qw * y + qz * x - qx * z,
+        iz = qw * z + qx * y - qy * x,
+        iw = -qx * x - qy * y - qz * z;
+
+    return vec3s_make(ix * qw + iw * -qx + iy * -qz - iz * -qy,
+                      iy * qw + iw * -qy + iz * -qx - ix * -qz,
+                      iz * qw + iw * -qz + ix * -qy - iy * -qx);
+}
+
+static inline quats quats_axisFromAngle(vec3s axis, numeric_t angle) {
+    numeric_t s = glm_sin(angle / 2);
+    axis = vec3s_normalize(axis);
+    return quats_make(axis.v[0] * s, axis.v[1] * s, axis.v[2] * s, glm_cos(angle / 2));
+}
+
+static inline mat4s mat4s_load(mat4_t mat) {
+    mat4s r;
+    int i;
+    for (i = 0; i < 16; i++) { r.v[i] = mat[i]; }
+    return r;
+}
+
+static inline mat4s mat4s_identity(void) {
+    mat4s r;
+    int i;
+    for (i = 0; i < 16; i++) { r.v[i] = i % 5 == 0; }
+    return r;
+}
+
+static inline mat4s mat4s_transpose(mat4s m) {
+    mat4s r;
+    int i, j;
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < 4; j++) { r.v[i * 4 + j] = m.v[j * 4 + i]; }
+    }
+    return r;
+}
+
+static inline mat4s mat4s_multiply(mat4s a, mat4s b) {
+    mat4s r;
+    int i, j;
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 4; i++) {
+            r.v[j * 4 + i] = a.v[i] * b.v[j * 4] + a.v[4 + i] * b.v[j * 4 + 1] +
+                a.v[8 + i] * b.v[j * 4 + 2] + a.v[12 + i] * b.v[j * 4 + 3];
+        }
+    }
+    return r;
+}
+
+static inline vec3s mat4s_multiplyVec3(mat4s m, vec3s vec) {
+    numeric_t x = vec.v[0], y = vec.v[1], z = vec.v[2];
+    return vec3s_make(m.v[0] * x + m.v[4] * y + m.v[8] * z + m.v[12],
+                      m.v[1] * x + m.v[5] * y + m.v[9] * z + m.v[13],
+                      m.v[2] * x + m.v[6] * y + m.v[10] * z + m.v[14]);
+}
+
+static inline vec4s mat4s_multiplyVec4(mat4s m, vec4s vec) {
+    vec4s r;
+    int i;
+    for (i = 0; i < 4; i++) {
+        r.v[i] = m.v[i] * vec.v[0] + m.v[4 + i] * vec.v[1] + m.v[8 + i] * vec.v[2] + m.v[12 + i] * vec.v[3];
+    }
+    return r;
+}
+
+static inline mat4s mat4s_translate(mat4s m, vec3s vec) {
+    int i;
+    for (i = 0; i < 4; i++) {
+        m.v[12 + i] += m.v[i] * vec.v[0] + m.v[4 + i] * vec.v[1] + m.v[8 + i] * vec.v[2];
+    }
+    return m;
+}
+
+static inline mat4s mat4s_scale(mat4s m, vec3s vec) {
+    int i;
+    for (i = 0; i < 12; i++) { m.v[i] *= vec.v[i / 4]; }
+    return m;
+}
+
+/* Calls mat4_inverse. Like it, returns m unchanged if it is singular */
+static inline mat4s mat4s_inverse(mat4s m) {
+    mat4_inverse(m.v, NULL);
+    return m;
+}
+
+static inline mat4s mat4s_fromRotationTranslation(quats q, vec3s vec) {
+    mat4s r;
+    numeric_t x = q.v[0], y = q.v[1], z = q.v[2], w = q.v[3],
+        x2 = x + x, y2 = y + y, z2 = z + z,
+        xx = x * x2, xy = x * y2, xz = x * z2,
+        yy = y * y2, yz = y * z2, zz = z * z2,
+        wx = w * x2, wy = w * y2, wz = w * z2;
+
+    r.v[0] = 1 - (yy + zz); r.v[1] = xy + wz; r.v[2] = xz - wy; r.v[3] = 0;
+    r.v[4] = xy - wz; r.v[5] = 1 - (xx + zz); r.v[6] = yz + wx; r.v[7] = 0;
+    r.v[8] = xz + wy; r.v[9] = yz - wx; r.v[10] = 1 - (xx + yy); r.v[11] = 0;
+    r.v[12] = vec.v[0]; r.v[13] = vec.v[1]; r.v[14] = vec.v[2]; r.v[15] = 1;
+    return r;
+}
+
+static inline mat4s quats_toMat4(quats q) {
+    return mat4s_fromRotationTranslation(q, vec3s_make(0, 0, 0));
+}
+
+static inline mat4s mat4s_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far) {
+    mat4s r;
+    numeric_t rl = right - left, tb = top - bottom, fn = far - near;
+    int i;
+
+    for (i = 0; i < 16; i++) { r.v[i] = 0; }
+    r.v[0] = (near * 2) / rl;
+    r.v[5] = (near * 2) / tb;
+    r.v[8] = (right + left) / rl;
+    r.v[9] = (top + bottom) / tb;
+    r.v[10] = -(far + near) / fn;
+    r.v[11] = -1;
+    r.v[14] = -(far * near * 2) / fn;
+    return r;
+}
+
+static inline mat4s mat4s_perspective(numeric_t fovy, numeric_t aspect, numeric_t near, numeric_t far) {
+    numeric_t top = near * glm_tan(fovy * (numeric_t)(3.14159265358979323846 / 360.0)),
+        right = top * aspect;
+    return mat4s_frustum(-right, right, -top, top, near, far);
+}
+
+static inline mat4s mat4s_lookAt(vec3s eye, vec3s center, vec3s up) {
+    mat4s r;
+    vec3s x, y, z;
+
+    if (eye.v[0] == center.v[0] && eye.v[1] == center.v[1] && eye.v[2] == center.v[2]) {
+        return mat4s_identity();
+    }
+
+    z = vec3s_subtract(eye, center);
+    z = vec3s_scale(z, 1 / vec3s_length(z));
+    x = vec3s_normalize(vec3s_cross(up, z));
+    y = vec3s_normalize(vec3s_cross(z, x));
+
+    r.v[0] = x.v[0]; r.v[1] = y.v[0]; r.v[2] = z.v[0]; r.v[3] = 0;
+    r.v[4] = x.v[1]; r.v[5] = y.v[1]; r.v[6] = z.v[1]; r.v[7] = 0;
+    r.v[8] = x.v[2]; r.v[9] = y.v[2]; r.v[10] = z.v[2]; r.v[11] = 0;
+    r.v[12] = -vec3s_dot(x, eye);
+    r.v[13] = -vec3s_dot(y, eye);
+    r.v[14] = -vec3s_dot(z, eye);
+    r.v[15] = 1;
+    return r;
+}
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,10165 @@
+/* Single header library vector and matrix library.
+ * You need to `#define GL_MATRIX_IMPLEMENTATION` in one of your source files
+ * Single header version which can be obtained at <https://github.com/wernsey/gl-matrix.c>
+ * Modified from the original C port by Marco Buono <https://github.com/coreh/gl-matrix.c>
+ * Which was ported to C from Brandon Jones' original JavaScript version <https://github.com/toji/gl-matrix>
+
+Copyright (c) 2011 Brandon Jones
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+   1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+   2. Altered source versions must be plainly marked as such, and must not
+   be misrepresented as being the original software.
+
+   3. This notice may not be removed or altered from any source
+   distribution.
+ */
+/*
+https://github.com/wernsey/gl-matrix.c
+This was forked from https://github.com/coreh/gl-matrix.c
+with some additions for vec2_t and vec4_t types.
+
+This is a fairly straightforward port of gl-matrix.js (https://github.com/toji/gl-matrix)
+from JavaScript to C.
+*/
+#ifndef GL_MATRIX_H
+#define GL_MATRIX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * gl-matrix.c - High performance matrix and vector operations for OpenGL
+ * Version 1.2.3
+ */
+
+#define GL_MATRIX_MAJOR_VERSION 1
+#define GL_MATRIX_MINOR_VERSION 2
+#define GL_MATRIX_MICRO_VERSION 3
+
+#define GL_MATRIX_VERSION  "1.2.3"
+
+/* Hex version number. A value of 0x010203 means version 1.2.3.
+  useful for comparisons. e.g. GL_MATRIX_VERSION_HEX >= 0x010203 */
+#define GL_MATRIX_VERSION_HEX  ((GL_MATRIX_MAJOR_VERSION << 16) | \
+                              (GL_MATRIX_MINOR_VERSION << 8) | \
+                              (GL_MATRIX_MICRO_VERSION))
+
+/*
+ * Precision selection
+ *
+ * By default numeric_t is float. Define GL_MATRIX_DOUBLE before including
+ * this header (and when compiling the library) to make it double instead.
+ *
+ * The double build renames every function that takes or returns numeric_t
+ * by appending _d (vec3_add becomes vec3_add_d, and so on), so that
+ * libgl-matrix.a and libgl-matrix-d.a can be linked into the same program.
+ * Code using the library is written the same way for both precisions; the
+ * renaming is done by the macros below. The allocator, arena and conversion
+ * functions don't depend on numeric_t and are only in libgl-matrix.a, so
+ * programs using the double library link with both:
+ *
+ *     cc -DGL_MATRIX_DOUBLE world.c -lgl-matrix-d -lgl-matrix -lm
+ *
+ * The SIMD backends are float only; the double build always uses the scalar
+ * code.
+ */
+#ifdef GL_MATRIX_DOUBLE
+typedef double numeric_t;
+#else
+typedef float numeric_t;
+#endif
+
+/*
+ * Math functions matching numeric_t
+ *
+ * The library calls these instead of sqrt(), sin(), cos() etc. so that the
+ * float versions are used and values are never promoted to double. Compared
+ * with the double functions, each call may differ by at most 1 ULP of the
+ * float result. Composite functions (mat4_rotate, mat4_perspective,
+ * mat4_lookAt, quat_axisFromAngle, ...) stay within 8 * FLT_EPSILON of what
+ * libgl-matrix-d.a computes from the same inputs, relative to the largest
+ * element of the result. Elements much smaller than that may differ by more
+ * ULPs of their own value, as they come from cancellation. quat_slerp and
+ * quat_slerp_array stay within 8 * FLT_EPSILON / sin^2(theta / 2), theta being the angle between
+ * the quaternions; below sin(theta / 2) = 0.002 the two builds can take
+ * different branches. `make test` checks these bounds.
+ */
+#ifdef GL_MATRIX_DOUBLE
+#define glm_sqrt sqrt
+#define glm_sin sin
+#define glm_cos cos
+#define glm_tan tan
+#define glm_acos acos
+#define glm_fabs fabs
+#else
+#define glm_sqrt sqrtf
+#define glm_sin sinf
+#define glm_cos cosf
+#define glm_tan tanf
+#define glm_acos acosf
+#define glm_fabs fabsf
+#endif
+
+/*
+ * SIMD backend selection
+ *
+ * GL_MATRIX_SIMD selects the vectorized implementation used by the hot mat4
+ * functions (mat4_multiply, mat4_multiplyVec4 and the mat4_multiplyVec*_array
+ * batch transforms). If it is not defined before
+ * including this header it is chosen from the compiler's target flags, so
+ * e.g. building with -mavx2 -mfma picks the AVX2 backend automatically.
+ *
+ * The AVX2 backend fuses each multiply and add into one FMA instruction,
+ * which rounds once instead of twice, so its results can differ from the
+ * SSE and scalar backends in the last bits. On AArch64 the compiler may
+ * fuse NEON's vmla the same way. Compare results across builds with a
+ * tolerance rather than exactly.
+ *
+ * Define GL_MATRIX_SIMD to GL_MATRIX_SIMD_NONE to force the portable scalar
+ * code. The choice does not change any function signature.
+ */
+#define GL_MATRIX_SIMD_NONE 0
+#define GL_MATRIX_SIMD_SSE  1
+#define GL_MATRIX_SIMD_AVX2 2
+#define GL_MATRIX_SIMD_NEON 3
+
+#if defined(GL_MATRIX_DOUBLE) && defined(GL_MATRIX_SIMD)
+#  if GL_MATRIX_SIMD != GL_MATRIX_SIMD_NONE
+#    error "GL_MATRIX_SIMD backends are not available with GL_MATRIX_DOUBLE"
+#  endif
+#endif
+
+#ifndef GL_MATRIX_SIMD
+#  if defined(GL_MATRIX_DOUBLE)
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_NONE
+#  elif defined(__AVX2__) && defined(__FMA__)
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_AVX2
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_SSE
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_NEON
+#  else
+#    define GL_MATRIX_SIMD GL_MATRIX_SIMD_NONE
+#  endif
+#endif
+
+/*
+ * Static inline build
+ *
+ * GL_MATRIX_API prefixes every function that depends on numeric_t. Defining
+ * GL_MATRIX_STATIC_INLINE before including the single header glmatrix.h
+ * makes them all static inline and compiles their definitions into every
+ * source file that includes it, so calls to small functions like vec3_dot
+ * can be inlined without link time optimization.
+ *
+ * The allocator, arena and conversion functions (glm_*) stay ordinary
+ * functions, so that there is only one installed allocator; one source file
+ * still needs GL_MATRIX_IMPLEMENTATION for them. GL_MATRIX_STATIC_INLINE is
+ * only meant for glmatrix.h, not for gl-matrix.h with libgl-matrix.a.
+ */
+#ifdef GL_MATRIX_STATIC_INLINE
+#define GL_MATRIX_API static inline
+#else
+#define GL_MATRIX_API
+#endif
+
+/*
+ * Non-aliasing variants
+ *
+ * The *_noalias functions declare their pointers GL_MATRIX_RESTRICT (C99
+ * restrict). Their dest is required and must not overlap any input, which
+ * lets the compiler keep the inputs in registers across the stores. Unless
+ * the library is built with NDEBUG, they assert that this holds.
+ *
+ * GL_MATRIX_DISJOINT(a, na, b, nb) is true if the na numbers at a and the nb
+ * numbers at b don't overlap.
+ */
+#ifdef __cplusplus
+#define GL_MATRIX_RESTRICT __restrict
+#else
+#define GL_MATRIX_RESTRICT restrict
+#endif
+
+#define GL_MATRIX_DISJOINT(a, na, b, nb) \
+    ((size_t)(a) + (na) * sizeof(numeric_t) <= (size_t)(b) || \
+     (size_t)(b) + (nb) * sizeof(numeric_t) <= (size_t)(a))
+
+/*
+ * Aligned storage
+ *
+ * GL_MATRIX_ALIGN(n) aligns a variable or struct member to n bytes. The
+ * storage macros declare arrays aligned so the SIMD batch functions can use
+ * aligned loads and stores:
+ *
+ *     GL_MATRIX_MAT4(view);          // numeric_t view[16], cache line aligned
+ *     GL_MATRIX_QUAT(rotations[64]); // 64 quaternions, 16 byte aligned
+ *
+ * Heap storage with the same guarantees comes from mat4_create_aligned,
+ * quat_create_aligned, vec4_create_aligned and glm_alloc_aligned.
+ */
+#if defined(_MSC_VER)
+#define GL_MATRIX_ALIGN(n) __declspec(align(n))
+#elif defined(__GNUC__) || defined(__clang__)
+#define GL_MATRIX_ALIGN(n) __attribute__((aligned(n)))
+#else
+#define GL_MATRIX_ALIGN(n)
+#endif
+
+#define GL_MATRIX_MAT4(name) GL_MATRIX_ALIGN(64) numeric_t name[16]
+#define GL_MATRIX_QUAT(name) GL_MATRIX_ALIGN(16) numeric_t name[4]
+#define GL_MATRIX_VEC4(name) GL_MATRIX_ALIGN(16) numeric_t name[4]
+
+typedef numeric_t *vec2_t;
+typedef numeric_t *vec3_t;
+typedef numeric_t *vec4_t;
+typedef numeric_t *mat3_t;
+typedef numeric_t *mat4_t;
+typedef numeric_t *quat_t;
+typedef numeric_t *dquat_t;
+typedef numeric_t *frustum_t;
+
+/* Symbol renaming for the double build. Every function declared below that
+   uses numeric_t needs an entry here. */
+#ifdef GL_MATRIX_DOUBLE
+#define vec2_add vec2_add_d
+#define vec2_create vec2_create_d
+#define vec2_create_in vec2_create_in_d
+#define vec2_direction vec2_direction_d
+#define vec2_dist vec2_dist_d
+#define vec2_dot vec2_dot_d
+#define vec2_length vec2_length_d
+#define vec2_lerp vec2_lerp_d
+#define vec2_negate vec2_negate_d
+#define vec2_normalize vec2_normalize_d
+#define vec2_ones vec2_ones_d
+#define vec2_scale vec2_scale_d
+#define vec2_set vec2_set_d
+#define vec2_subtract vec2_subtract_d
+#define vec2_zeroes vec2_zeroes_d
+#define vec3_add vec3_add_d
+#define vec3_create vec3_create_d
+#define vec3_create_in vec3_create_in_d
+#define vec3_cross vec3_cross_d
+#define vec3_cross_noalias vec3_cross_noalias_d
+#define vec3_direction vec3_direction_d
+#define vec3_dist vec3_dist_d
+#define vec3_dot vec3_dot_d
+#define vec3_length vec3_length_d
+#define vec3_lerp vec3_lerp_d
+#define vec3_multiply vec3_multiply_d
+#define vec3_negate vec3_negate_d
+#define vec3_normalize vec3_normalize_d
+#define vec3_ones vec3_ones_d
+#define vec3_scale vec3_scale_d
+#define vec3_set vec3_set_d
+#define vec3_subtract vec3_subtract_d
+#define vec3_unproject vec3_unproject_d
+#define vec3_unproject_array vec3_unproject_array_d
+#define vec3_zeroes vec3_zeroes_d
+#define vec4_add vec4_add_d
+#define vec4_create vec4_create_d
+#define vec4_create_in vec4_create_in_d
+#define vec4_create_aligned vec4_create_aligned_d
+#define vec4_direction vec4_direction_d
+#define vec4_dist vec4_dist_d
+#define vec4_dot vec4_dot_d
+#define vec4_length vec4_length_d
+#define vec4_lerp vec4_lerp_d
+#define vec4_negate vec4_negate_d
+#define vec4_normalize vec4_normalize_d
+#define vec4_ones vec4_ones_d
+#define vec4_scale vec4_scale_d
+#define vec4_set vec4_set_d
+#define vec4_subtract vec4_subtract_d
+#define vec4_zeroes vec4_zeroes_d
+#define mat3_create mat3_create_d
+#define mat3_create_in mat3_create_in_d
+#define mat3_identity mat3_identity_d
+#define mat3_multiplyVec3 mat3_multiplyVec3_d
+#define mat3_set mat3_set_d
+#define mat3_toMat4 mat3_toMat4_d
+#define mat3_transpose mat3_transpose_d
+#define mat4_alignVectors mat4_alignVectors_d
+#define mat4_create mat4_create_d
+#define mat4_create_in mat4_create_in_d
+#define mat4_create_aligned mat4_create_aligned_d
+#define mat4_determinant mat4_determinant_d
+#define mat4_fromRotationTranslation mat4_fromRotationTranslation_d
+#define mat4_frustum mat4_frustum_d
+#define mat4_identity mat4_identity_d
+#define mat4_inverse mat4_inverse_d
+#define mat4_inverse_noalias mat4_inverse_noalias_d
+#define mat4_inverseAffine mat4_inverseAffine_d
+#define mat4_inverseRigid mat4_inverseRigid_d
+#define mat4_lookAt mat4_lookAt_d
+#define mat4_multiply mat4_multiply_d
+#define mat4_multiply_noalias mat4_multiply_noalias_d
+#define mat4_multiplyAffine mat4_multiplyAffine_d
+#define mat4_multiplyVec3 mat4_multiplyVec3_d
+#define mat4_multiplyVec3_array mat4_multiplyVec3_array_d
+#define mat4_multiplyVec4 mat4_multiplyVec4_d
+#define mat4_multiplyVec4_array mat4_multiplyVec4_array_d
+#define mat4_ortho mat4_ortho_d
+#define mat4_perspective mat4_perspective_d
+#define mat4_rotate mat4_rotate_d
+#define mat4_rotateX mat4_rotateX_d
+#define mat4_rotateY mat4_rotateY_d
+#define mat4_rotateZ mat4_rotateZ_d
+#define mat4_scale mat4_scale_d
+#define mat4_scale_scalar mat4_scale_scalar_d
+#define mat4_set mat4_set_d
+#define mat4_toInverseMat3 mat4_toInverseMat3_d
+#define mat4_toMat3 mat4_toMat3_d
+#define mat4_toRotationMat mat4_toRotationMat_d
+#define mat4_translate mat4_translate_d
+#define mat4_transpose mat4_transpose_d
+#define quat_axisFromAngle quat_axisFromAngle_d
+#define quat_calculateW quat_calculateW_d
+#define quat_conjugate quat_conjugate_d
+#define quat_create quat_create_d
+#define quat_create_in quat_create_in_d
+#define quat_create_aligned quat_create_aligned_d
+#define quat_dot quat_dot_d
+#define quat_inverse quat_inverse_d
+#define quat_length quat_length_d
+#define quat_multiply quat_multiply_d
+#define quat_multiply_noalias quat_multiply_noalias_d
+#define quat_multiply_array quat_multiply_array_d
+#define quat_multiplyVec3 quat_multiplyVec3_d
+#define quat_multiplyVec3_array quat_multiplyVec3_array_d
+#define quat_normalize quat_normalize_d
+#define quat_rotate quat_rotate_d
+#define quat_set quat_set_d
+#define quat_slerp quat_slerp_d
+#define quat_slerpFast quat_slerpFast_d
+#define quat_slerp_array quat_slerp_array_d
+#define quat_toMat3 quat_toMat3_d
+#define quat_toMat4 quat_toMat4_d
+#define mat3_str mat3_str_d
+#define mat3_str_n mat3_str_n_d
+#define mat4_str mat4_str_d
+#define mat4_str_n mat4_str_n_d
+#define mat4_str_array mat4_str_array_d
+#define quat_str quat_str_d
+#define quat_str_n quat_str_n_d
+#define vec2_str vec2_str_d
+#define vec2_str_n vec2_str_n_d
+#define vec3_str vec3_str_d
+#define vec3_str_n vec3_str_n_d
+#define vec4_str vec4_str_d
+#define vec4_str_n vec4_str_n_d
+#define vec2_parse vec2_parse_d
+#define vec3_parse vec3_parse_d
+#define vec4_parse vec4_parse_d
+#define mat3_parse mat3_parse_d
+#define mat4_parse mat4_parse_d
+#define mat4_parse_array mat4_parse_array_d
+#define quat_parse quat_parse_d
+#define numbers_parse numbers_parse_d
+#define vec3_soa_add vec3_soa_add_d
+#define vec3_soa_create vec3_soa_create_d
+#define vec3_soa_cross vec3_soa_cross_d
+#define vec3_soa_dot vec3_soa_dot_d
+#define vec3_soa_free vec3_soa_free_d
+#define vec3_soa_fromAoS vec3_soa_fromAoS_d
+#define vec3_soa_length vec3_soa_length_d
+#define vec3_soa_lerp vec3_soa_lerp_d
+#define vec3_soa_normalize vec3_soa_normalize_d
+#define vec3_soa_scale vec3_soa_scale_d
+#define vec3_soa_subtract vec3_soa_subtract_d
+#define vec3_soa_toAoS vec3_soa_toAoS_d
+#define vec4_soa_add vec4_soa_add_d
+#define vec4_soa_create vec4_soa_create_d
+#define vec4_soa_dot vec4_soa_dot_d
+#define vec4_soa_free vec4_soa_free_d
+#define vec4_soa_fromAoS vec4_soa_fromAoS_d
+#define vec4_soa_length vec4_soa_length_d
+#define vec4_soa_lerp vec4_soa_lerp_d
+#define vec4_soa_normalize vec4_soa_normalize_d
+#define vec4_soa_scale vec4_soa_scale_d
+#define vec4_soa_subtract vec4_soa_subtract_d
+#define vec4_soa_toAoS vec4_soa_toAoS_d
+#define dquat_create dquat_create_d
+#define dquat_create_in dquat_create_in_d
+#define dquat_set dquat_set_d
+#define dquat_identity dquat_identity_d
+#define dquat_fromRotationTranslation dquat_fromRotationTranslation_d
+#define dquat_getTranslation dquat_getTranslation_d
+#define dquat_multiply dquat_multiply_d
+#define dquat_normalize dquat_normalize_d
+#define dquat_toMat4 dquat_toMat4_d
+#define dquat_transformPoint dquat_transformPoint_d
+#define dquat_str dquat_str_d
+#define dquat_str_n dquat_str_n_d
+#define dquat_parse dquat_parse_d
+#define frustum_fromMat4 frustum_fromMat4_d
+#define frustum_cullSpheres frustum_cullSpheres_d
+#define frustum_cullBoxes frustum_cullBoxes_d
+#define hierarchy_create hierarchy_create_d
+#define hierarchy_free hierarchy_free_d
+#define hierarchy_add hierarchy_add_d
+#define hierarchy_setLocal hierarchy_setLocal_d
+#define hierarchy_markDirty hierarchy_markDirty_d
+#define hierarchy_update hierarchy_update_d
+#define hierarchy_updateParallel hierarchy_updateParallel_d
+#define stream_write stream_write_d
+#define stream_writeEncoded stream_writeEncoded_d
+#define stream_open stream_open_d
+#define stream_data stream_data_d
+#define stream_close stream_close_d
+#define quat_pack32 quat_pack32_d
+#define quat_unpack32 quat_unpack32_d
+#define quat_pack48 quat_pack48_d
+#define quat_unpack48 quat_unpack48_d
+#define quat_pack32_array quat_pack32_array_d
+#define quat_unpack32_array quat_unpack32_array_d
+#define quat_pack48_array quat_pack48_array_d
+#define quat_unpack48_array quat_unpack48_array_d
+#define half_pack half_pack_d
+#define half_unpack half_unpack_d
+#define mat4_packTRS mat4_packTRS_d
+#define mat4_unpackTRS mat4_unpackTRS_d
+#define mat4_packTRS_array mat4_packTRS_array_d
+#define mat4_unpackTRS_array mat4_unpackTRS_array_d
+#define skin_linearBlend skin_linearBlend_d
+#define skin_linearBlendParallel skin_linearBlendParallel_d
+#define skin_dualQuaternion skin_dualQuaternion_d
+#define skin_dualQuaternionParallel skin_dualQuaternionParallel_d
+#endif /* GL_MATRIX_DOUBLE */
+
+/*
+ * Memory allocation
+ *
+ * Everything the library allocates - the *_create functions, and functions
+ * such as mat4_identity, mat4_lookAt or quat_toMat4 when they are given a NULL
+ * dest - is allocated through glm_alloc. By default that is calloc(), so the
+ * results can be released with either free() or glm_free().
+ *
+ * glm_set_allocator routes those allocations through a user supplied
+ * allocator instead, such as an arena or a per-thread pool (the hook itself
+ * is global, so a per-thread pool should look up its thread's pool inside the
+ * alloc function). Install it during startup, before any other thread uses
+ * the library, and release memory with glm_free while it is installed.
+ *
+ * If the library is built with GL_MATRIX_NO_MALLOC defined, glm_alloc never
+ * falls back to calloc(): without an installed allocator it prints a message
+ * and calls abort(). This makes any hidden allocation on a hot path fail
+ * loudly instead of silently hitting malloc.
+ */
+
+/*
+ * glm_alloc_fn
+ * Allocator hook. Returns `size` bytes aligned at least as well as malloc()
+ * would, or NULL on failure. The memory does not need to be zeroed.
+ */
+typedef void *(*glm_alloc_fn)(size_t size, void *user);
+
+/*
+ * glm_free_fn
+ * Deallocator hook. Releases memory returned by the matching glm_alloc_fn.
+ * May be NULL if the allocator never frees individual blocks (e.g. an arena).
+ */
+typedef void (*glm_free_fn)(void *ptr, void *user);
+
+/*
+ * glm_set_allocator
+ * Installs the allocator used by glm_alloc and glm_free
+ *
+ * Params:
+ * alloc - Allocator hook. If NULL, the default allocator is restored
+ * release - Optional, deallocator hook
+ * user - Pointer passed unchanged to both hooks
+ */
+void glm_set_allocator(glm_alloc_fn alloc, glm_free_fn release, void *user);
+
+/*
+ * glm_alloc
+ * Allocates zero-initialized memory through the installed allocator
+ *
+ * Params:
+ * size - number of bytes to allocate
+ *
+ * Returns:
+ * Pointer to the memory, NULL if it could not be allocated
+ */
+void *glm_alloc(size_t size);
+
+/*
+ * glm_free
+ * Releases memory obtained from glm_alloc (or any *_create function)
+ *
+ * Params:
+ * ptr - memory to release. May be NULL
+ */
+void glm_free(void *ptr);
+
+/*
+ * glm_alloc_aligned
+ * Allocates zeroed memory through glm_alloc, aligned to align bytes
+ *
+ * Params:
+ * size - number of bytes to allocate
+ * align - alignment in bytes, a power of two
+ *
+ * Returns:
+ * Pointer to the memory, NULL if it could not be allocated. Release it with
+ * glm_free_aligned, not glm_free.
+ */
+void *glm_alloc_aligned(size_t size, size_t align);
+
+/*
+ * glm_free_aligned
+ * Releases memory obtained from glm_alloc_aligned (or any *_create_aligned
+ * function)
+ *
+ * Params:
+ * ptr - memory to release. May be NULL
+ */
+void glm_free_aligned(void *ptr);
+
+/*
+ * glm_arena - Bump allocator
+ *
+ * An arena hands out memory from one contiguous buffer by advancing an
+ * offset, and releases everything at once with glm_arena_reset. Creating a
+ * frame's temporaries with the *_create_in functions lays them out next to
+ * each other and frees them in O(1) at the end of the frame.
+ *
+ * An arena can also serve every library allocation by installing it with
+ * glm_set_allocator(glm_arena_allocHook, NULL, &arena).
+ *
+ * Arenas are not thread safe; use one per thread.
+ */
+#define GL_MATRIX_ARENA_ALIGNMENT 64
+
+typedef struct {
+    unsigned char *base;
+    size_t size, used;
+    void *block;
+} glm_arena;
+
+/*
+ * glm_arena_init
+ * Initializes an arena with a newly allocated buffer
+ * The buffer is allocated with malloc() (not glm_alloc), and is aligned to
+ * GL_MATRIX_ARENA_ALIGNMENT bytes
+ *
+ * Params:
+ * arena - glm_arena to initialize
+ * size - capacity of the arena in bytes
+ *
+ * Returns:
+ * arena, NULL if the buffer could not be allocated
+ */
+glm_arena *glm_arena_init(glm_arena *arena, size_t size);
+
+/*
+ * glm_arena_initBuffer
+ * Initializes an arena that allocates from memory owned by the caller
+ *
+ * Params:
+ * arena - glm_arena to initialize
+ * buffer - memory to allocate from. It must outlive the arena
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * arena
+ */
+glm_arena *glm_arena_initBuffer(glm_arena *arena, void *buffer, size_t size);
+
+/*
+ * glm_arena_destroy
+ * Releases the buffer of an arena created with glm_arena_init
+ * Everything allocated from the arena becomes invalid
+ *
+ * Params:
+ * arena - glm_arena to destroy
+ */
+void glm_arena_destroy(glm_arena *arena);
+
+/*
+ * glm_arena_alloc
+ * Allocates memory from an arena. The memory is not initialized
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * size - number of bytes to allocate
+ * align - alignment of the result in bytes, a power of two. If 0, the
+ * result is aligned to 16 bytes
+ *
+ * Returns:
+ * Pointer to the memory, NULL if the arena does not have enough space left
+ */
+void *glm_arena_alloc(glm_arena *arena, size_t size, size_t align);
+
+/*
+ * glm_arena_reset
+ * Releases everything allocated from an arena at once
+ *
+ * Params:
+ * arena - glm_arena to reset
+ */
+void glm_arena_reset(glm_arena *arena);
+
+/*
+ * glm_arena_allocHook
+ * glm_alloc_fn that allocates from the glm_arena passed as `user`
+ */
+void *glm_arena_allocHook(size_t size, void *user);
+
+/*
+ * vec2_t - 2 Dimensional Vector
+ */
+
+/*
+ * vec2_create
+ * Creates a new instance of a vec2_t
+ *
+ * Params:
+ * vec - Optional, vec2_t containing values to initialize with. If NULL, the
+ * vector will be initialized with zeroes.
+ *
+ * Returns:
+ * New vec2, NULL if it could not be allocated
+ */
+GL_MATRIX_API vec2_t vec2_create(vec2_t vec);
+
+/*
+ * vec2_create_in
+ * Creates a new instance of a vec2_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * vec - Optional, vec2_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New vec2, NULL if the arena is full
+ */
+GL_MATRIX_API vec2_t vec2_create_in(glm_arena *arena, vec2_t vec);
+
+/*
+ * vec2_set
+ * Copies the values of one vec2_t to another
+ *
+ * Params:
+ * vec - vec2_t containing values to copy
+ * dest - vec2_t receiving copied values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec2_t vec2_set(vec2_t vec, vec2_t dest);
+
+/*
+ * vec2_zeroes
+ * Sets the value of a vec2_t to {0,0}
+ *
+ * Params:
+ * vec - vec2_t to set
+ *
+ * Returns:
+ * vec
+ */
+GL_MATRIX_API vec2_t vec2_zeroes(vec2_t vec);
+
+/*
+ * vec2_ones
+ * Sets the value of a vec2_t to {1,1}
+ *
+ * Params:
+ * vec - vec2_t to set
+ *
+ * Returns:
+ * vec
+ */
+GL_MATRIX_API vec2_t vec2_ones(vec2_t vec);
+
+/*
+ * vec2_add
+ * Performs a vector addition
+ *
+ * Params:
+ * vec - vec2, first operand
+ * vec2 - vec2, second operand
+ * dest - Optional, vec2_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec2_t vec2_add(vec2_t vec, vec2_t vec2, vec2_t dest);
+
+/*
+ * vec2_subtract
+ * Performs a vector subtraction
+ *
+ * Params:
+ * vec - vec2, first operand
+ * vec2 - vec2, second operand
+ * dest - Optional, vec2_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec2_t vec2_subtract(vec2_t vec, vec2_t vec2, vec2_t dest);
+
+/*
+ * vec2_negate
+ * Negates the components of a vec2
+ *
+ * Params:
+ * vec - vec2_t to negate
+ * dest - Optional, vec2_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec2_t vec2_negate(vec2_t vec, vec2_t dest);
+
+/*
+ * vec2_scale
+ * Multiplies the components of a vec2_t by a scalar value
+ *
+ * Params:
+ * vec - vec2_t to scale
+ * val - Numeric value to scale by
+ * dest - Optional, vec2_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec2_t vec2_scale(vec2_t vec, numeric_t val, vec2_t dest);
+
+/*
+ * vec2_normalize
+ * Generates a unit vector of the same direction as the provided vec2
+ * If vector length is 0, returns [0, 0]
+ *
+ * Params:
+ * vec - vec2_t to normalize
+ * dest - Optional, vec2_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec2_t vec2_normalize(vec2_t vec, vec2_t dest);
+
+/*
+ * vec2_length
+ * Caclulates the length of a vec2
+ *
+ * Params:
+ * vec - vec2_t to calculate length of
+ *
+ * Returns:
+ * Length of vec
+ */
+GL_MATRIX_API numeric_t vec2_length(vec2_t vec);
+
+/*
+ * vec2_dot
+ * Caclulates the dot product of two vec2s
+ *
+ * Params:
+ * vec - vec2, first operand
+ * vec2 - vec2, second operand
+ *
+ * Returns:
+ * Dot product of vec and vec2
+ */
+GL_MATRIX_API numeric_t vec2_dot(vec2_t vec, vec2_t vec2);
+
+/*
+ * vec2_direction
+ * Generates a unit vector pointing from one vector to another
+ *
+ * Params:
+ * vec - origin vec2
+ * vec2 - vec2_t to point to
+ * dest - Optional, vec2_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec2_t vec2_direction (vec2_t vec, vec2_t vec2, vec2_t dest);
+
+/*
+ * vec2_lerp
+ * Performs a linear interpolation between two vec2
+ *
+ * Params:
+ * vec - vec2, first vector
+ * vec2 - vec2, second vector
+ * lerp - interpolation amount between the two inputs
+ * dest - Optional, vec2_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec2_t vec2_lerp(vec2_t vec, vec2_t vec2, numeric_t lerp, vec2_t dest);
+
+/*
+ * vec2_dist
+ * Calculates the euclidian distance between two vec2
+ *
+ * Params:
+ * vec - vec2, first vector
+ * vec2 - vec2, second vector
+ *
+ * Returns:
+ * distance between vec and vec2
+ */
+GL_MATRIX_API numeric_t vec2_dist(vec2_t vec, vec2_t vec2);
+
+/*
+ * vec2_str
+ * Writes a string representation of a vector, formatted as for vec2_str_n
+ *
+ * Params:
+ * vec - vec2_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(2) bytes
+ */
+GL_MATRIX_API void vec2_str(vec2_t vec, char *buffer);
+
+/*
+ * vec2_str_n
+ * Writes a string representation of a vector into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * vec - vec2_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t vec2_str_n(vec2_t vec, char *buffer, size_t size);
+
+/*
+ * vec2_parse
+ * Reads a vector written by vec2_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the vector
+ * dest - vec2_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a vector
+ */
+GL_MATRIX_API const char *vec2_parse(const char *str, vec2_t dest);
+
+/*
+ * vec3_t - 3 Dimensional Vector
+ */
+
+/*
+ * vec3_create
+ * Creates a new instance of a vec3_t
+ *
+ * Params:
+ * vec - Optional, vec3_t containing values to initialize with. If NULL, the
+ * vector will be initialized with zeroes.
+ *
+ * Returns:
+ * New vec3, NULL if it could not be allocated
+ */
+GL_MATRIX_API vec3_t vec3_create(vec3_t vec);
+
+/*
+ * vec3_create_in
+ * Creates a new instance of a vec3_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * vec - Optional, vec3_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New vec3, NULL if the arena is full
+ */
+GL_MATRIX_API vec3_t vec3_create_in(glm_arena *arena, vec3_t vec);
+
+/*
+ * vec3_set
+ * Copies the values of one vec3_t to another
+ *
+ * Params:
+ * vec - vec3_t containing values to copy
+ * dest - vec3_t receiving copied values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec3_t vec3_set(vec3_t vec, vec3_t dest);
+
+/*
+ * vec3_zeroes
+ * Sets the value of a vec3_t to {0,0,0}
+ *
+ * Params:
+ * vec - vec3_t to set
+ *
+ * Returns:
+ * vec
+ */
+GL_MATRIX_API vec3_t vec3_zeroes(vec3_t vec);
+
+/*
+ * vec3_ones
+ * Sets the value of a vec3_t to {1,1,1}
+ *
+ * Params:
+ * vec - vec3_t to set
+ *
+ * Returns:
+ * vec
+ */
+GL_MATRIX_API vec3_t vec3_ones(vec3_t vec);
+
+/*
+ * vec3_add
+ * Performs a vector addition
+ *
+ * Params:
+ * vec - vec3, first operand
+ * vec2 - vec3, second operand
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t vec3_add(vec3_t vec, vec3_t vec2, vec3_t dest);
+
+/*
+ * vec3_subtract
+ * Performs a vector subtraction
+ *
+ * Params:
+ * vec - vec3, first operand
+ * vec2 - vec3, second operand
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t vec3_subtract(vec3_t vec, vec3_t vec2, vec3_t dest);
+
+/*
+ * vec3_multiply
+ * Performs a vector multiplication
+ *
+ * Params:
+ * vec - vec3, first operand
+ * vec2 - vec3, second operand
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t vec3_multiply(vec3_t vec, vec3_t vec2, vec3_t dest);
+
+/*
+ * vec3_negate
+ * Negates the components of a vec3
+ *
+ * Params:
+ * vec - vec3_t to negate
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t vec3_negate(vec3_t vec, vec3_t dest);
+
+/*
+ * vec3_scale
+ * Multiplies the components of a vec3_t by a scalar value
+ *
+ * Params:
+ * vec - vec3_t to scale
+ * val - Numeric value to scale by
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t vec3_scale(vec3_t vec, numeric_t val, vec3_t dest);
+
+/*
+ * vec3_normalize
+ * Generates a unit vector of the same direction as the provided vec3
+ * If vector length is 0, returns [0, 0, 0]
+ *
+ * Params:
+ * vec - vec3_t to normalize
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t vec3_normalize(vec3_t vec, vec3_t dest);
+
+/*
+ * vec3_cross
+ * Generates the cross product of two vec3s
+ *
+ * Params:
+ * vec - vec3, first operand
+ * vec2 - vec3, second operand
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t vec3_cross (vec3_t vec, vec3_t vec2, vec3_t dest);
+
+/*
+ * vec3_cross_noalias
+ * Generates the cross product of two vec3s into a separate vec3
+ *
+ * Params:
+ * vec, vec2 - as for vec3_cross
+ * dest - vec3_t receiving the result. Must not overlap vec or vec2
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec3_t vec3_cross_noalias(vec3_t GL_MATRIX_RESTRICT vec, vec3_t GL_MATRIX_RESTRICT vec2, vec3_t GL_MATRIX_RESTRICT dest);
+
+/*
+ * vec3_length
+ * Caclulates the length of a vec3
+ *
+ * Params:
+ * vec - vec3_t to calculate length of
+ *
+ * Returns:
+ * Length of vec
+ */
+GL_MATRIX_API numeric_t vec3_length(vec3_t vec);
+
+/*
+ * vec3_dot
+ * Caclulates the dot product of two vec3s
+ *
+ * Params:
+ * vec - vec3, first operand
+ * vec2 - vec3, second operand
+ *
+ * Returns:
+ * Dot product of vec and vec2
+ */
+GL_MATRIX_API numeric_t vec3_dot(vec3_t vec, vec3_t vec2);
+
+/*
+ * vec3_direction
+ * Generates a unit vector pointing from one vector to another
+ *
+ * Params:
+ * vec - origin vec3
+ * vec2 - vec3_t to point to
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t vec3_direction (vec3_t vec, vec3_t vec2, vec3_t dest);
+
+/*
+ * vec3_lerp
+ * Performs a linear interpolation between two vec3
+ *
+ * Params:
+ * vec - vec3, first vector
+ * vec2 - vec3, second vector
+ * lerp - interpolation amount between the two inputs
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+
+GL_MATRIX_API vec3_t vec3_lerp(vec3_t vec, vec3_t vec2, numeric_t lerp, vec3_t dest);
+
+/*
+ * vec3_dist
+ * Calculates the euclidian distance between two vec3
+ *
+ * Params:
+ * vec - vec3, first vector
+ * vec2 - vec3, second vector
+ *
+ * Returns:
+ * distance between vec and vec2
+ */
+GL_MATRIX_API numeric_t vec3_dist(vec3_t vec, vec3_t vec2);
+
+/*
+ * vec3_unproject
+ * Projects the specified vec3_t from screen space into object space
+ * Based on Mesa gluUnProject implementation at:
+ * http://webcvs.freedesktop.org/mesa/Mesa/src/glu/mesa/project.c?revision=1.4&view=markup
+ *
+ * Params:
+ * vec - vec3, screen-space vector to project
+ * view - mat4, View matrix
+ * proj - mat4, Projection matrix
+ * viewport - vec4, Viewport as given to gl.viewport [x, y, width, height]
+ * dest - Optional, vec3_t receiving unprojected result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t vec3_unproject(vec3_t vec, mat4_t view, mat4_t proj, vec4_t viewport, vec3_t dest);
+
+/*
+ * vec3_unproject_array
+ * Projects an array of vec3_t from screen space into object space
+ * The inverse view-projection matrix is calculated once for the whole array
+ * (or passed in precomputed), which makes this much faster than calling
+ * vec3_unproject for every point.
+ *
+ * Params:
+ * vec - first vec3_t of a packed array of screen-space vectors to project
+ * count - number of vectors to project
+ * view - mat4, View matrix. Ignored if invViewProj is given
+ * proj - mat4, Projection matrix. Ignored if invViewProj is given
+ * viewport - vec4, Viewport as given to gl.viewport [x, y, width, height]
+ * invViewProj - Optional, mat4 containing the inverse of (proj * view). If NULL,
+ * it is calculated from view and proj
+ * dest - Optional, first vec3_t of the array receiving unprojected results.
+ * If NULL, results are written to vec. Points that unproject to infinity are
+ * left unchanged
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise, NULL if proj * view cannot be inverted
+ */
+GL_MATRIX_API vec3_t vec3_unproject_array(vec3_t vec, size_t count, mat4_t view, mat4_t proj, vec4_t viewport, mat4_t invViewProj, vec3_t dest);
+
+/*
+ * vec3_str
+ * Writes a string representation of a vector, formatted as for vec3_str_n
+ *
+ * Params:
+ * vec - vec3_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(3) bytes
+ */
+GL_MATRIX_API void vec3_str(vec3_t vec, char *buffer);
+
+/*
+ * vec3_str_n
+ * Writes a string representation of a vector into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * vec - vec3_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t vec3_str_n(vec3_t vec, char *buffer, size_t size);
+
+/*
+ * vec3_parse
+ * Reads a vector written by vec3_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the vector
+ * dest - vec3_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a vector
+ */
+GL_MATRIX_API const char *vec3_parse(const char *str, vec3_t dest);
+
+/*
+ * vec4_t - 4 Dimensional Vector
+ */
+
+/*
+ * vec4_create
+ * Creates a new instance of a vec4_t
+ *
+ * Params:
+ * vec - Optional, vec4_t containing values to initialize with. If NULL, the
+ * vector will be initialized with zeroes.
+ *
+ * Returns:
+ * New vec4, NULL if it could not be allocated
+ */
+GL_MATRIX_API vec4_t vec4_create(vec4_t vec);
+
+/*
+ * vec4_create_in
+ * Creates a new instance of a vec4_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * vec - Optional, vec4_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New vec4, NULL if the arena is full
+ */
+GL_MATRIX_API vec4_t vec4_create_in(glm_arena *arena, vec4_t vec);
+
+/*
+ * vec4_create_aligned
+ * Creates a new instance of a vec4_t aligned to align bytes
+ *
+ * Params:
+ * vec - Optional, vec4_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ * align - alignment in bytes, a power of two: 16 for SSE and NEON, 32 for
+ * AVX, 64 for a cache line
+ *
+ * Returns:
+ * New vec4, NULL if it could not be allocated. Release it with
+ * glm_free_aligned.
+ */
+GL_MATRIX_API vec4_t vec4_create_aligned(vec4_t vec, size_t align);
+
+/*
+ * vec4_set
+ * Copies the values of one vec4_t to another
+ *
+ * Params:
+ * vec - vec4_t containing values to copy
+ * dest - vec4_t receiving copied values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec4_t vec4_set(vec4_t vec, vec4_t dest);
+
+/*
+ * vec4_zeroes
+ * Sets the value of a vec4_t to {0,0,0,0}
+ *
+ * Params:
+ * vec - vec4_t to set
+ *
+ * Returns:
+ * vec
+ */
+GL_MATRIX_API vec4_t vec4_zeroes(vec4_t vec);
+
+/*
+ * vec4_ones
+ * Sets the value of a vec4_t to {1,1,1,1}
+ *
+ * Params:
+ * vec - vec4_t to set
+ *
+ * Returns:
+ * vec
+ */
+GL_MATRIX_API vec4_t vec4_ones(vec4_t vec);
+
+/*
+ * vec4_add
+ * Performs a vector addition
+ *
+ * Params:
+ * vec - vec4, first operand
+ * vec2 - vec4, second operand
+ * dest - Optional, vec4_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t vec4_add(vec4_t vec, vec4_t vec2, vec4_t dest);
+
+/*
+ * vec4_subtract
+ * Performs a vector subtraction
+ *
+ * Params:
+ * vec - vec4, first operand
+ * vec2 - vec4, second operand
+ * dest - Optional, vec4_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t vec4_subtract(vec4_t vec, vec4_t vec2, vec4_t dest);
+
+/*
+ * vec4_negate
+ * Negates the components of a vec4
+ *
+ * Params:
+ * vec - vec4_t to negate
+ * dest - Optional, vec4_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t vec4_negate(vec4_t vec, vec4_t dest);
+
+/*
+ * vec4_scale
+ * Multiplies the components of a vec4_t by a scalar value
+ *
+ * Params:
+ * vec - vec4_t to scale
+ * val - Numeric value to scale by
+ * dest - Optional, vec4_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t vec4_scale(vec4_t vec, numeric_t val, vec4_t dest);
+
+/*
+ * vec4_normalize
+ * Generates a unit vector of the same direction as the provided vec4
+ * If vector length is 0, returns [0, 0, 0, 0]
+ *
+ * Params:
+ * vec - vec4_t to normalize
+ * dest - Optional, vec4_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t vec4_normalize(vec4_t vec, vec4_t dest);
+
+/*
+ * vec4_length
+ * Caclulates the length of a vec4
+ *
+ * Params:
+ * vec - vec4_t to calculate length of
+ *
+ * Returns:
+ * Length of vec
+ */
+GL_MATRIX_API numeric_t vec4_length(vec4_t vec);
+
+/*
+ * vec4_dot
+ * Caclulates the dot product of two vec4s
+ *
+ * Params:
+ * vec - vec4, first operand
+ * vec2 - vec4, second operand
+ *
+ * Returns:
+ * Dot product of vec and vec2
+ */
+GL_MATRIX_API numeric_t vec4_dot(vec4_t vec, vec4_t vec2);
+
+/*
+ * vec4_direction
+ * Generates a unit vector pointing from one vector to another
+ *
+ * Params:
+ * vec - origin vec4
+ * vec2 - vec4_t to point to
+ * dest - Optional, vec4_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t vec4_direction (vec4_t vec, vec4_t vec2, vec4_t dest);
+
+/*
+ * vec4_lerp
+ * Performs a linear interpolation between two vec4
+ *
+ * Params:
+ * vec - vec4, first vector
+ * vec2 - vec4, second vector
+ * lerp - interpolation amount between the two inputs
+ * dest - Optional, vec4_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t vec4_lerp(vec4_t vec, vec4_t vec2, numeric_t lerp, vec4_t dest);
+
+/*
+ * vec4_dist
+ * Calculates the euclidian distance between two vec4
+ *
+ * Params:
+ * vec - vec4, first vector
+ * vec2 - vec4, second vector
+ *
+ * Returns:
+ * distance between vec and vec2
+ */
+GL_MATRIX_API numeric_t vec4_dist(vec4_t vec, vec4_t vec2);
+
+/*
+ * vec4_str
+ * Writes a string representation of a vector, formatted as for vec4_str_n
+ *
+ * Params:
+ * vec - vec4_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(4) bytes
+ */
+GL_MATRIX_API void vec4_str(vec4_t vec, char *buffer);
+
+/*
+ * vec4_str_n
+ * Writes a string representation of a vector into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * vec - vec4_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t vec4_str_n(vec4_t vec, char *buffer, size_t size);
+
+/*
+ * vec4_parse
+ * Reads a vector written by vec4_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the vector
+ * dest - vec4_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a vector
+ */
+GL_MATRIX_API const char *vec4_parse(const char *str, vec4_t dest);
+
+/*
+ * mat3_t - 3x3 Matrix
+ */
+
+/*
+ * mat3_create
+ * Creates a new instance of a mat3_t
+ *
+ * Params:
+ * mat - Optional, mat3_t containing values to initialize with. If NULL the result
+ * will be initialized with zeroes.
+ *
+ * Returns:
+ * New mat3, NULL if it could not be allocated
+ */
+GL_MATRIX_API mat3_t mat3_create(mat3_t mat);
+
+/*
+ * mat3_create_in
+ * Creates a new instance of a mat3_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * mat - Optional, mat3_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New mat3, NULL if the arena is full
+ */
+GL_MATRIX_API mat3_t mat3_create_in(glm_arena *arena, mat3_t mat);
+
+/*
+ * mat3_set
+ * Copies the values of one mat3_t to another
+ *
+ * Params:
+ * mat - mat3_t containing values to copy
+ * dest - mat3_t receiving copied values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat3_t mat3_set(mat3_t mat, mat3_t dest);
+
+/*
+ * mat3_identity
+ * Sets a mat3_t to an identity matrix
+ *
+ * Params:
+ * dest - mat3_t to set
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat3_t mat3_identity(mat3_t dest);
+
+/*
+ * mat4.transpose
+ * Transposes a mat3_t (flips the values over the diagonal)
+ *
+ * Params:
+ * mat - mat3_t to transpose
+ * dest - Optional, mat3_t receiving transposed values. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest is specified, mat otherwise
+ */
+GL_MATRIX_API mat3_t mat3_transpose(mat3_t mat, mat3_t dest);
+
+/*
+ * mat3_toMat4
+ * Copies the elements of a mat3_t into the upper 3x3 elements of a mat4
+ *
+ * Params:
+ * mat - mat3_t containing values to copy
+ * dest - Optional, mat4_t receiving copied values
+ *
+ * Returns:
+ * dest if not NULL, a new mat4_t otherwise
+ */
+GL_MATRIX_API mat4_t mat3_toMat4(mat3_t mat, mat4_t dest);
+
+/*
+ * mat3_multiplyVec3
+ * Transforms a vec3_t with the given matrix
+ *
+ * Params:
+ * mat - mat3_t to transform the vector with
+ * vec - vec3_t to transform
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t mat3_multiplyVec3(mat3_t mat, vec3_t vec, vec3_t dest);
+
+/*
+ * mat3_str
+ * Writes a string representation of a mat3, formatted as for mat3_str_n
+ *
+ * Params:
+ * mat - mat3_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(9) bytes
+ */
+GL_MATRIX_API void mat3_str(mat3_t mat, char *buffer);
+
+/*
+ * mat3_str_n
+ * Writes a string representation of a mat3 into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * mat - mat3_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t mat3_str_n(mat3_t mat, char *buffer, size_t size);
+
+/*
+ * mat3_parse
+ * Reads a mat3 written by mat3_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the mat3
+ * dest - mat3_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a mat3
+ */
+GL_MATRIX_API const char *mat3_parse(const char *str, mat3_t dest);
+
+/*
+ * mat4_t - 4x4 Matrix
+ */
+
+/*
+ * mat4_create
+ * Creates a new instance of a mat4_t
+ *
+ * Params:
+ * mat - Optional, mat4_t containing values to initialize with
+ *
+ * Returns:
+ * New mat4, NULL if it could not be allocated
+ */
+GL_MATRIX_API mat4_t mat4_create(mat4_t mat);
+
+/*
+ * mat4_create_in
+ * Creates a new instance of a mat4_t in an arena
+ * The matrix is aligned to GL_MATRIX_ARENA_ALIGNMENT bytes, so it occupies
+ * exactly one cache line
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * mat - Optional, mat4_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New mat4, NULL if the arena is full
+ */
+GL_MATRIX_API mat4_t mat4_create_in(glm_arena *arena, mat4_t mat);
+
+/*
+ * mat4_create_aligned
+ * Creates a new instance of a mat4_t aligned to align bytes
+ *
+ * Params:
+ * mat - Optional, mat4_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ * align - alignment in bytes, a power of two: 16 for SSE and NEON, 32 for
+ * AVX, 64 for a cache line
+ *
+ * Returns:
+ * New mat4, NULL if it could not be allocated. Release it with
+ * glm_free_aligned.
+ */
+GL_MATRIX_API mat4_t mat4_create_aligned(mat4_t mat, size_t align);
+
+/*
+ * mat4_set
+ * Copies the values of one mat4_t to another
+ *
+ * Params:
+ * mat - mat4_t containing values to copy
+ * dest - mat4_t receiving copied values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_t mat4_set(mat4_t mat, mat4_t dest);
+
+/*
+ * mat4_identity
+ * Sets a mat4_t to an identity matrix
+ *
+ * Params:
+ * dest - mat4_t to set
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_t mat4_identity(mat4_t dest);
+
+/*
+ * mat4_transpose
+ * Transposes a mat4_t (flips the values over the diagonal)
+ *
+ * Params:
+ * mat - mat4_t to transpose
+ * dest - Optional, mat4_t receiving transposed values. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest is specified, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_transpose(mat4_t mat, mat4_t dest);
+
+/*
+ * mat4_determinant
+ * Calculates the determinant of a mat4
+ *
+ * Params:
+ * mat - mat4_t to calculate determinant of
+ *
+ * Returns:
+ * determinant of mat
+ */
+GL_MATRIX_API numeric_t mat4_determinant(mat4_t mat);
+
+/*
+ * mat4_inverse
+ * Calculates the inverse matrix of a mat4
+ *
+ * Params:
+ * mat - mat4_t to calculate inverse of
+ * dest - Optional, mat4_t receiving inverse matrix. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest is specified, mat otherwise, NULL if matrix cannot be inverted
+ */
+GL_MATRIX_API mat4_t mat4_inverse(mat4_t mat, mat4_t dest);
+
+/*
+ * mat4_inverse_noalias
+ * Calculates the inverse matrix of a mat4 into a separate mat4
+ *
+ * Params:
+ * mat - mat4_t to calculate inverse of
+ * dest - mat4_t receiving inverse matrix. Must not overlap mat
+ *
+ * Returns:
+ * dest, NULL if matrix cannot be inverted
+ */
+GL_MATRIX_API mat4_t mat4_inverse_noalias(mat4_t GL_MATRIX_RESTRICT mat, mat4_t GL_MATRIX_RESTRICT dest);
+
+/*
+ * mat4_inverseAffine
+ * Calculates the inverse of an affine mat4
+ * The bottom row of mat is assumed to be (0, 0, 0, 1) and is not read. Only
+ * the upper 3x3 is inverted, and the translation is back-substituted, which
+ * is much cheaper than mat4_inverse.
+ *
+ * Params:
+ * mat - mat4_t to calculate inverse of
+ * dest - Optional, mat4_t receiving inverse matrix. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest is specified, mat otherwise, NULL if matrix cannot be inverted
+ */
+GL_MATRIX_API mat4_t mat4_inverseAffine(mat4_t mat, mat4_t dest);
+
+/*
+ * mat4_inverseRigid
+ * Calculates the inverse of a rigid body transform
+ * mat must contain only a rotation and a translation (no scale or shear) with
+ * a bottom row of (0, 0, 0, 1). The inverse is then the transposed rotation
+ * with the rotated, negated translation.
+ *
+ * Params:
+ * mat - mat4_t to calculate inverse of
+ * dest - Optional, mat4_t receiving inverse matrix. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_inverseRigid(mat4_t mat, mat4_t dest);
+
+/*
+ * mat4_toRotationMat
+ * Copies the upper 3x3 elements of a mat4_t into another mat4
+ *
+ * Params:
+ * mat - mat4_t containing values to copy
+ * dest - Optional, mat4_t receiving copied values
+ *
+ * Returns:
+ * dest is specified, a new mat4_t otherwise
+ */
+GL_MATRIX_API mat4_t mat4_toRotationMat(mat4_t mat, mat4_t dest);
+
+/*
+ * mat4_toMat3
+ * Copies the upper 3x3 elements of a mat4_t into a mat3
+ *
+ * Params:
+ * mat - mat4_t containing values to copy
+ * dest - Optional, mat3_t receiving copied values
+ *
+ * Returns:
+ * dest is specified, a new mat3_t otherwise
+ */
+GL_MATRIX_API mat3_t mat4_toMat3(mat4_t mat, mat3_t dest);
+
+/*
+ * mat4_toInverseMat3
+ * Calculates the inverse of the upper 3x3 elements of a mat4_t and copies the result into a mat3
+ * The resulting matrix is useful for calculating transformed normals
+ *
+ * Params:
+ * mat - mat4_t containing values to invert and copy
+ * dest - Optional, mat3_t receiving values
+ *
+ * Returns:
+ * dest is specified, a new mat3_t otherwise, NULL if the matrix cannot be inverted
+ */
+GL_MATRIX_API mat3_t mat4_toInverseMat3(mat4_t mat, mat3_t dest);
+
+/*
+ * mat4_multiply
+ * Performs a matrix multiplication
+ *
+ * Params:
+ * mat - mat4, first operand
+ * mat2 - mat4, second operand
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_multiply(mat4_t mat, mat4_t mat2, mat4_t dest);
+
+/*
+ * mat4_multiply_noalias
+ * Performs a matrix multiplication into a separate mat4
+ * Gives the same result as mat4_multiply's scalar code.
+ *
+ * Params:
+ * mat, mat2 - as for mat4_multiply
+ * dest - mat4_t receiving operation result. Must not overlap mat or mat2
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_t mat4_multiply_noalias(mat4_t GL_MATRIX_RESTRICT mat, mat4_t GL_MATRIX_RESTRICT mat2, mat4_t GL_MATRIX_RESTRICT dest);
+
+/*
+ * mat4_multiplyAffine
+ * Performs a matrix multiplication of two affine matrices
+ * The bottom rows of mat and mat2 are assumed to be (0, 0, 0, 1); the result
+ * is the same as mat4_multiply for such matrices, with fewer operations.
+ * The bottom rows aren't read, and the result's is always exactly
+ * (0, 0, 0, 1), with every SIMD backend.
+ *
+ * Params:
+ * mat - mat4, first operand
+ * mat2 - mat4, second operand
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_multiplyAffine(mat4_t mat, mat4_t mat2, mat4_t dest);
+
+/*
+ * mat4_multiplyVec3
+ * Transforms a vec3_t with the given matrix
+ * 4th vector component is implicitly '1'
+ *
+ * Params:
+ * mat - mat4_t to transform the vector with
+ * vec - vec3_t to transform
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t mat4_multiplyVec3(mat4_t mat, vec3_t vec, vec3_t dest);
+
+/*
+ * mat4_multiplyVec4
+ * Transforms a vec4 with the given matrix
+ *
+ * Params:
+ * mat - mat4_t to transform the vector with
+ * vec - vec4 to transform
+ * dest - Optional, vec4 receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t mat4_multiplyVec4(mat4_t mat, vec4_t vec, vec4_t dest);
+
+/*
+ * mat4_multiplyVec3_array
+ * Transforms an array of vec3_t with the given matrix
+ * 4th vector component is implicitly '1'
+ *
+ * The matrix is loaded once for the whole batch, so this is much faster than
+ * calling mat4_multiplyVec3 in a loop. Vectors are read from and written to
+ * `stride` bytes apart, which allows transforming positions in place inside
+ * an interleaved vertex buffer.
+ *
+ * Params:
+ * mat - mat4_t to transform the vectors with
+ * vec - first vec3_t to transform
+ * count - number of vectors to transform
+ * stride - distance in bytes between consecutive vectors. If 0, the vectors
+ * are tightly packed (3 * sizeof(numeric_t))
+ * dest - Optional, first vec3_t receiving operation results, using the same
+ * stride as vec. If NULL, results are written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t mat4_multiplyVec3_array(mat4_t mat, vec3_t vec, size_t count, size_t stride, vec3_t dest);
+
+/*
+ * mat4_multiplyVec4_array
+ * Transforms an array of vec4_t with the given matrix
+ *
+ * See mat4_multiplyVec3_array for how the batch is laid out.
+ *
+ * Params:
+ * mat - mat4_t to transform the vectors with
+ * vec - first vec4_t to transform
+ * count - number of vectors to transform
+ * stride - distance in bytes between consecutive vectors. If 0, the vectors
+ * are tightly packed (4 * sizeof(numeric_t))
+ * dest - Optional, first vec4_t receiving operation results, using the same
+ * stride as vec. If NULL, results are written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec4_t mat4_multiplyVec4_array(mat4_t mat, vec4_t vec, size_t count, size_t stride, vec4_t dest);
+
+/*
+ * mat4_translate
+ * Translates a matrix by the given vector
+ *
+ * Params:
+ * mat - mat4_t to translate
+ * vec - vec3_t specifying the translation
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_translate(mat4_t mat, vec3_t vec, mat4_t dest);
+
+/*
+ * mat4_scale
+ * Scales a matrix by the given vector
+ *
+ * Params:
+ * mat - mat4_t to scale
+ * vec - vec3_t specifying the scale for each axis
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_scale(mat4_t mat, vec3_t vec, mat4_t dest);
+
+/*
+ * mat4_scale_scalar
+ * Scales a matrix by the given scalar
+ *
+ * Params:
+ * mat - mat4_t to scale
+ * scalar - scalar specifying the scale for each axis
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_scale_scalar(mat4_t mat, numeric_t scalar, mat4_t dest);
+
+/*
+ * mat4_rotate
+ * Rotates a matrix by the given angle around the specified axis
+ * If rotating around a primary axis (X,Y,Z) one of the specialized rotation functions should be used instead for performance
+ *
+ * Params:
+ * mat - mat4_t to rotate
+ * angle - angle (in radians) to rotate
+ * axis - vec3_t representing the axis to rotate around
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_rotate(mat4_t mat, numeric_t angle, vec3_t axis, mat4_t dest);
+
+/*
+ * mat4_rotateX
+ * Rotates a matrix by the given angle around the X axis
+ *
+ * Params:
+ * mat - mat4_t to rotate
+ * angle - angle (in radians) to rotate
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_rotateX(mat4_t mat, numeric_t angle, mat4_t dest);
+
+/*
+ * mat4_rotateY
+ * Rotates a matrix by the given angle around the Y axis
+ *
+ * Params:
+ * mat - mat4_t to rotate
+ * angle - angle (in radians) to rotate
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_rotateY(mat4_t mat, numeric_t angle, mat4_t dest);
+
+/*
+ * mat4_rotateZ
+ * Rotates a matrix by the given angle around the Z axis
+ *
+ * Params:
+ * mat - mat4_t to rotate
+ * angle - angle (in radians) to rotate
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to mat
+ *
+ * Returns:
+ * dest if not NULL, mat otherwise
+ */
+GL_MATRIX_API mat4_t mat4_rotateZ(mat4_t mat, numeric_t angle, mat4_t dest);
+
+/*
+ * mat4_frustum
+ * Generates a frustum matrix with the given bounds
+ *
+ * Params:
+ * left, right - scalar, left and right bounds of the frustum
+ * bottom, top - scalar, bottom and top bounds of the frustum
+ * near, far - scalar, near and far bounds of the frustum
+ * dest - Optional, mat4_t frustum matrix will be written into
+ *
+ * Returns:
+ * dest if not NULL, a new mat4_t otherwise
+ */
+GL_MATRIX_API mat4_t mat4_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest);
+
+/*
+ * mat4_perspective
+ * Generates a perspective projection matrix with the given bounds
+ *
+ * Params:
+ * fovy - scalar, vertical field of view (in degrees)
+ * aspect - scalar, aspect ratio. typically viewport width/height
+ * near, far - scalar, near and far bounds of the frustum
+ * dest - Optional, mat4_t frustum matrix will be written into
+ *
+ * Returns:
+ * dest if not NULL, a new mat4_t otherwise
+ */
+GL_MATRIX_API mat4_t mat4_perspective(numeric_t fovy, numeric_t aspect, numeric_t near, numeric_t far, mat4_t dest);
+
+/*
+ * mat4_ortho
+ * Generates a orthogonal projection matrix with the given bounds
+ *
+ * Params:
+ * left, right - scalar, left and right bounds of the frustum
+ * bottom, top - scalar, bottom and top bounds of the frustum
+ * near, far - scalar, near and far bounds of the frustum
+ * dest - Optional, mat4_t frustum matrix will be written into
+ *
+ * Returns:
+ * dest if not NULL, a new mat4_t otherwise
+ */
+GL_MATRIX_API mat4_t mat4_ortho(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest);
+
+/*
+ * mat4_lookAt
+ * Generates a look-at matrix with the given eye position, focal point, and up axis
+ *
+ * Params:
+ * eye - vec3, position of the viewer
+ * center - vec3, point the viewer is looking at
+ * up - vec3_t pointing "up"
+ * dest - Optional, mat4_t frustum matrix will be written into
+ *
+ * Returns:
+ * dest if not NULL, a new mat4_t otherwise
+ */
+GL_MATRIX_API mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest);
+
+/*
+ * mat4_fromRotationTranslation
+ * Creates a matrix from a quaternion rotation and vector translation
+ * This is equivalent to (but much faster than):
+ *
+ *     mat4_identity(dest);
+ *     mat4_translate(dest, vec);
+ *     mat4_t quatMat = mat4_create();
+ *     quat_toMat4(quat, quatMat);
+ *     mat4_multiply(dest, quatMat);
+ *
+ * Params:
+ * quat - quat specifying the rotation by
+ * vec - vec3_t specifying the translation
+ * dest - Optional, mat4_t receiving operation result. If NULL, result is written to a new mat4
+ *
+ * Returns:
+ * dest if not NULL, a new mat4_t otherwise
+ */
+GL_MATRIX_API mat4_t mat4_fromRotationTranslation(quat_t quat, vec3_t vec, mat4_t dest);
+
+/*
+ * mat4_alignVectors
+ * Creates a matrix that will rotate one vector to point into the direction of another.
+ *
+ * If the resulting matrix is applied to the source vector it will point in the
+ * direction of the target vector.
+ *
+ * Params:
+ * source - Source orientation
+ * target - Target orientation
+ * dest - mat4_t receiving operation result.
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_t mat4_alignVectors(vec3_t source, vec3_t target, mat4_t dest);
+
+/*
+ * mat4_str
+ * Writes a string representation of a mat4, formatted as for mat4_str_n
+ *
+ * Params:
+ * mat - mat4_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(16) bytes
+ */
+GL_MATRIX_API void mat4_str(mat4_t mat, char *buffer);
+
+/*
+ * mat4_str_n
+ * Writes a string representation of a mat4 into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * mat - mat4_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t mat4_str_n(mat4_t mat, char *buffer, size_t size);
+
+/*
+ * mat4_str_array
+ * Writes a string representation of an array of mat4 into one buffer, as a
+ * list of the matrices formatted by mat4_str_n: "[[...], [...]]"
+ *
+ * Params:
+ * mat - first of count consecutive mat4_t
+ * count - number of matrices
+ * buffer - char * to store the results. May be NULL if size is 0. At most
+ * GL_MATRIX_STR_SIZE(16) * count + 2 bytes are needed.
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t mat4_str_array(mat4_t mat, size_t count, char *buffer, size_t size);
+
+/*
+ * mat4_parse
+ * Reads a mat4 written by mat4_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the mat4
+ * dest - mat4_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a mat4
+ */
+GL_MATRIX_API const char *mat4_parse(const char *str, mat4_t dest);
+
+/*
+ * mat4_parse_array
+ * Reads an array of mat4 written by mat4_str_array, "[[...], [...]]"
+ *
+ * Params:
+ * str - NUL terminated text starting with the array
+ * count - number of matrices in the array
+ * dest - count consecutive mat4_t receiving the values. May be partly
+ * written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with an array of count matrices
+ */
+GL_MATRIX_API const char *mat4_parse_array(const char *str, size_t count, mat4_t dest);
+
+/*
+ * quat - Quaternions
+ */
+
+/*
+ * quat_create
+ * Creates a new instance of a quat_t
+ *
+ * Params:
+ * quat - Optional, quat_t containing values to initialize with
+ *
+ * Returns:
+ * New quat_t, NULL if it could not be allocated
+ */
+GL_MATRIX_API quat_t quat_create(quat_t quat);
+
+/*
+ * quat_create_in
+ * Creates a new instance of a quat_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * quat - Optional, quat_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New quat, NULL if the arena is full
+ */
+GL_MATRIX_API quat_t quat_create_in(glm_arena *arena, quat_t quat);
+
+/*
+ * quat_create_aligned
+ * Creates a new instance of a quat_t aligned to align bytes
+ *
+ * Params:
+ * quat - Optional, quat_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ * align - alignment in bytes, a power of two: 16 for SSE and NEON, 32 for
+ * AVX, 64 for a cache line
+ *
+ * Returns:
+ * New quat, NULL if it could not be allocated. Release it with
+ * glm_free_aligned.
+ */
+GL_MATRIX_API quat_t quat_create_aligned(quat_t quat, size_t align);
+
+/*
+ * quat_set
+ * Copies the values of one quat_t to another
+ *
+ * Params:
+ * quat - quat_t containing values to copy
+ * dest - quat_t receiving copied values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_set(quat_t quat, quat_t dest);
+
+/*
+ * quat_calculateW
+ * Calculates the W component of a quat_t from the X, Y, and Z components.
+ * Assumes that quaternion is 1 unit in length.
+ * Any existing W component will be ignored.
+ *
+ * Params:
+ * quat - quat_t to calculate W component of
+ * dest - Optional, quat_t receiving calculated values. If NULL, result is written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_calculateW(quat_t quat, quat_t dest);
+
+/**
+ * quat_dot
+ * Calculates the dot product of two quaternions
+ *
+ * @param {quat4} quat First operand
+ * @param {quat4} quat2 Second operand
+ *
+ * @return {number} Dot product of quat and quat2
+ */
+GL_MATRIX_API numeric_t quat_dot(quat_t quat, quat_t quat2);
+
+/*
+ * quat_inverse
+ * Calculates the inverse of a quat_t
+ *
+ * Params:
+ * quat - quat_t to calculate inverse of
+ * dest - Optional, quat_t receiving inverse values. If NULL, result is written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_inverse(quat_t quat, quat_t dest);
+
+/*
+ * quat_conjugate
+ * Calculates the conjugate of a quat_t
+ *
+ * Params:
+ * quat - quat_t to calculate conjugate of
+ * dest - Optional, quat_t receiving conjugate values. If NULL, result is written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_conjugate(quat_t quat, quat_t dest);
+
+/*
+ * quat_length
+ * Calculates the length of a quat_t
+ *
+ * Params:
+ * quat - quat_t to calculate length of
+ *
+ * Returns:
+ * Length of quat
+ */
+GL_MATRIX_API numeric_t quat_length(quat_t quat);
+
+/*
+ * quat_normalize
+ * Generates a unit quaternion of the same direction as the provided quat_t
+ * If quaternion length is 0, returns [0, 0, 0, 0]
+ *
+ * Params:
+ * quat - quat_t to normalize
+ * dest - Optional, quat_ receiving operation result. If NULL, result is written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_normalize(quat_t quat, quat_t dest);
+
+/*
+ * quat_multiply
+ * Performs a quaternion multiplication
+ *
+ * Params:
+ * quat - quat_t, first operand
+ * quat2 - quat_t, second operand
+ * dest - Optional, quat_t receiving operation result. If NULL, result is written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_multiply(quat_t quat, quat_t quat2, quat_t dest);
+
+/*
+ * quat_multiply_noalias
+ * Performs a quaternion multiplication into a separate quat
+ *
+ * Params:
+ * quat, quat2 - as for quat_multiply
+ * dest - quat_t receiving operation result. Must not overlap quat or quat2
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_multiply_noalias(quat_t GL_MATRIX_RESTRICT quat, quat_t GL_MATRIX_RESTRICT quat2, quat_t GL_MATRIX_RESTRICT dest);
+
+/*
+ * quat_multiplyVec3
+ * Transforms a vec3_t with the given quaternion
+ *
+ * Params:
+ * quat - quat_t to transform the vector with
+ * vec - vec3_t to transform
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API quat_t quat_multiplyVec3(quat_t quat, vec3_t vec, vec3_t dest);
+
+/*
+ * quat_multiplyVec3_array
+ * Transforms each vec3_t of an array with the corresponding quat_t
+ * The quaternions must be normalized. This uses a cheaper formula than
+ * quat_multiplyVec3, so results can differ from it in the last bits.
+ *
+ * Params:
+ * quat - first of count tightly packed quat_t
+ * vec - first of count tightly packed vec3_t to transform
+ * count - number of vectors
+ * dest - Optional, array of count vec3_t receiving operation results. If NULL, results are written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t quat_multiplyVec3_array(quat_t quat, vec3_t vec, size_t count, vec3_t dest);
+
+/*
+ * quat_toMat3
+ * Calculates a 3x3 matrix from the given quat_t
+ *
+ * Params:
+ * quat - quat_t to create matrix from
+ * dest - Optional, mat3_t receiving operation result
+ *
+ * Returns:
+ * dest if not NULL, a new mat3_t otherwise
+ */
+GL_MATRIX_API mat3_t quat_toMat3(quat_t quat, mat3_t dest);
+
+/*
+ * quat_toMat4
+ * Calculates a 4x4 matrix from the given quat_t
+ *
+ * Params:
+ * quat - quat_t to create matrix from
+ * dest - Optional, mat4_t receiving operation result
+ *
+ * Returns:
+ * dest if not NULL, a new mat4_t otherwise
+ */
+GL_MATRIX_API quat_t quat_toMat4(quat_t quat, mat4_t dest);
+
+/*
+ * quat_slerp
+ * Performs a spherical linear interpolation between two quat_t
+ *
+ * Params:
+ * quat - quat_t, first quaternion
+ * quat2 - quat_t, second quaternion
+ * slerp - interpolation amount between the two inputs
+ * dest - Optional, quat_t receiving operation result. If NULL, result is written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest);
+
+/*
+ * quat_slerpFast
+ * Approximates a spherical linear interpolation between two quat_t
+ * This is a normalized linear interpolation with a polynomial correction of
+ * the interpolation amount, so it has no trigonometric calls and no branches.
+ * Unlike quat_slerp it always takes the shortest path, flipping quat2 when
+ * the quaternions are more than 180 degrees apart. Compared with the exact
+ * shortest-path slerp of unit quaternions, the rotation is off by at most
+ * 0.0008 radians (0.045 degrees), which happens between rotations 180 degrees
+ * apart. For rotations up to 90 degrees apart it is off by at most 0.00008
+ * radians.
+ *
+ * Params:
+ * quat - quat_t, first quaternion, normalized
+ * quat2 - quat_t, second quaternion, normalized
+ * slerp - interpolation amount between the two inputs, 0 to 1
+ * dest - Optional, quat_t receiving operation result. If NULL, result is written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_slerpFast(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest);
+
+/*
+ * quat_multiply_array
+ * Multiplies two arrays of quat_t element by element
+ * Gives the same results as calling quat_multiply for each element
+ *
+ * Params:
+ * quat - first of count tightly packed quat_t, first operands
+ * quat2 - first of count tightly packed quat_t, second operands
+ * count - number of quaternions
+ * dest - Optional, array of count quat_t receiving operation results. If NULL, results are written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_multiply_array(quat_t quat, quat_t quat2, size_t count, quat_t dest);
+
+/*
+ * quat_slerp_array
+ * Performs a spherical linear interpolation between two arrays of quat_t
+ * Interpolates like calling quat_slerp for each element; use it to blend
+ * whole poses. With the SSE and AVX2 backends, four elements are done at a
+ * time, with acos and sin evaluated by polynomials and the special cases
+ * selected without branches, so the results can differ from quat_slerp's in
+ * the last bits while staying within the same error bound (see Math
+ * functions above). The other backends give exactly quat_slerp's results.
+ *
+ * Params:
+ * quat - first of count tightly packed quat_t, first quaternions
+ * quat2 - first of count tightly packed quat_t, second quaternions
+ * slerp - interpolation amount between the two inputs, used for every element
+ * count - number of quaternions
+ * dest - Optional, array of count quat_t receiving operation results. If NULL, results are written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_slerp_array(quat_t quat, quat_t quat2, numeric_t slerp, size_t count, quat_t dest);
+
+/*
+ * quat_axisFromAngle
+ * Creates a quaternion to rotate objects around a specific axis by a specific angle
+ *
+ * Params:
+ * axis - The axis to rotate around
+ * angle - The angle to rotate
+ * dest - quat_t receiving operation result
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_axisFromAngle(vec3_t axis, numeric_t angle, quat_t dest);
+
+/*
+ * quat_rotate
+ * Rotates a point around a quaternion by applying the formula
+ *
+ *    r = q.p.q*
+ *
+ * where q is the quaternion, q* is its conjugate, and p is the
+ * point to be rotated.
+ *
+ * Params:
+ * quat - quat_t, first quaternion
+ * p - vec3_t, the point to rotate
+ * dest - Optional, quat_t receiving operation result. If NULL, result is written to quat
+ *
+ * Returns:
+ * dest if not NULL, quat otherwise
+ */
+GL_MATRIX_API quat_t quat_rotate(quat_t quat, vec3_t p, quat_t dest);
+
+/*
+ * quat_str
+ * Writes a string representation of a quaternion, formatted as for quat_str_n
+ *
+ * Params:
+ * quat - quat_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(4) bytes
+ */
+GL_MATRIX_API void quat_str(quat_t quat, char *buffer);
+
+/*
+ * quat_str_n
+ * Writes a string representation of a quaternion into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * quat - quat_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t quat_str_n(quat_t quat, char *buffer, size_t size);
+
+/*
+ * quat_parse
+ * Reads a quaternion written by quat_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the quaternion
+ * dest - quat_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a quaternion
+ */
+GL_MATRIX_API const char *quat_parse(const char *str, quat_t dest);
+
+/*
+ * dquat_t - Dual quaternions
+ *
+ * A dual quaternion stores a rigid transform (rotation and translation) in 8
+ * numbers: the rotation quaternion in elements 0-3 (the real part, in the
+ * same x, y, z, w order as quat_t) followed by the dual part in elements 4-7.
+ * The real part of a dquat_t can be passed to the quat_* functions directly.
+ *
+ * Like mat4_multiply, dquat_multiply(a, b) gives the transform that applies b
+ * first and then a.
+ */
+
+/*
+ * dquat_create
+ * Creates a new instance of a dquat_t
+ *
+ * Params:
+ * dquat - Optional, dquat_t containing values to initialize with
+ *
+ * Returns:
+ * New dquat_t, NULL if it could not be allocated
+ */
+GL_MATRIX_API dquat_t dquat_create(dquat_t dquat);
+
+/*
+ * dquat_create_in
+ * Creates a new instance of a dquat_t in an arena
+ *
+ * Params:
+ * arena - glm_arena to allocate from
+ * dquat - Optional, dquat_t containing values to initialize with. If NULL, the
+ * result will be initialized with zeroes.
+ *
+ * Returns:
+ * New dquat, NULL if the arena is full
+ */
+GL_MATRIX_API dquat_t dquat_create_in(glm_arena *arena, dquat_t dquat);
+
+/*
+ * dquat_set
+ * Copies the values of one dquat_t to another
+ *
+ * Params:
+ * dquat - dquat_t containing values to copy
+ * dest - dquat_t receiving copied values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API dquat_t dquat_set(dquat_t dquat, dquat_t dest);
+
+/*
+ * dquat_identity
+ * Sets a dquat_t to the identity transform
+ *
+ * Params:
+ * dest - Optional, dquat_t to set. If NULL, a new dquat_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new dquat otherwise
+ */
+GL_MATRIX_API dquat_t dquat_identity(dquat_t dest);
+
+/*
+ * dquat_fromRotationTranslation
+ * Creates a dual quaternion from a rotation and a translation
+ * The result is the same transform as mat4_fromRotationTranslation gives
+ *
+ * Params:
+ * quat - quat_t, normalized rotation
+ * vec - vec3_t, translation
+ * dest - Optional, dquat_t receiving operation result. If NULL, a new dquat_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new dquat otherwise
+ */
+GL_MATRIX_API dquat_t dquat_fromRotationTranslation(quat_t quat, vec3_t vec, dquat_t dest);
+
+/*
+ * dquat_getTranslation
+ * Extracts the translation of a normalized dual quaternion
+ *
+ * Params:
+ * dquat - dquat_t to read the translation of
+ * dest - Optional, vec3_t receiving the translation. If NULL, a new vec3_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new vec3 otherwise
+ */
+GL_MATRIX_API vec3_t dquat_getTranslation(dquat_t dquat, vec3_t dest);
+
+/*
+ * dquat_multiply
+ * Performs a dual quaternion multiplication
+ *
+ * Params:
+ * dquat - dquat_t, first operand
+ * dquat2 - dquat_t, second operand
+ * dest - Optional, dquat_t receiving operation result. If NULL, result is written to dquat
+ *
+ * Returns:
+ * dest if not NULL, dquat otherwise
+ */
+GL_MATRIX_API dquat_t dquat_multiply(dquat_t dquat, dquat_t dquat2, dquat_t dest);
+
+/*
+ * dquat_normalize
+ * Divides both parts of a dual quaternion by the length of its real part
+ * If the real part has length 0, the result is all zeroes
+ *
+ * Params:
+ * dquat - dquat_t to normalize
+ * dest - Optional, dquat_t receiving operation result. If NULL, result is written to dquat
+ *
+ * Returns:
+ * dest if not NULL, dquat otherwise
+ */
+GL_MATRIX_API dquat_t dquat_normalize(dquat_t dquat, dquat_t dest);
+
+/*
+ * dquat_toMat4
+ * Calculates a 4x4 matrix from the given normalized dual quaternion
+ *
+ * Params:
+ * dquat - dquat_t to create matrix from
+ * dest - Optional, mat4_t receiving operation result. If NULL, a new mat4_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new mat4 otherwise
+ */
+GL_MATRIX_API mat4_t dquat_toMat4(dquat_t dquat, mat4_t dest);
+
+/*
+ * dquat_transformPoint
+ * Transforms a point with the given normalized dual quaternion
+ *
+ * Params:
+ * dquat - dquat_t to transform the point with
+ * vec - vec3_t, the point to transform
+ * dest - Optional, vec3_t receiving operation result. If NULL, result is written to vec
+ *
+ * Returns:
+ * dest if not NULL, vec otherwise
+ */
+GL_MATRIX_API vec3_t dquat_transformPoint(dquat_t dquat, vec3_t vec, vec3_t dest);
+
+/*
+ * dquat_str
+ * Writes a string representation of a dual quaternion, formatted as for dquat_str_n
+ *
+ * Params:
+ * dquat - dquat_t to represent as a string
+ * buffer - char * to store the results, at least GL_MATRIX_STR_SIZE(8) bytes
+ */
+GL_MATRIX_API void dquat_str(dquat_t dquat, char *buffer);
+
+/*
+ * dquat_str_n
+ * Writes a string representation of a dual quaternion into a buffer of limited size
+ *
+ * The numbers are written as by glm_formatFloat/glm_formatDouble, e.g.
+ * "[1, 0.5, -2e-7]". Like snprintf, at most size - 1 characters are written,
+ * followed by a terminating NUL.
+ *
+ * Params:
+ * dquat - dquat_t to represent as a string
+ * buffer - char * to store the results. May be NULL if size is 0
+ * size - size of buffer in bytes
+ *
+ * Returns:
+ * Length of the full string, which was truncated if it is size or more
+ */
+GL_MATRIX_API size_t dquat_str_n(dquat_t dquat, char *buffer, size_t size);
+
+/*
+ * dquat_parse
+ * Reads a dual quaternion written by dquat_str, "[a, b, ...]"
+ *
+ * The numbers are read as by glm_parseFloat/glm_parseDouble, so the text
+ * round-trips exactly. Whitespace is allowed around the brackets, commas
+ * and numbers.
+ *
+ * Params:
+ * str - NUL terminated text starting with the dual quaternion
+ * dest - dquat_t receiving the values. May be partly written on failure
+ *
+ * Returns:
+ * Pointer to the first character after the closing bracket, NULL if str
+ * doesn't start with a dual quaternion
+ */
+GL_MATRIX_API const char *dquat_parse(const char *str, dquat_t dest);
+
+/*
+ * vec3_soa_t, vec4_soa_t - Structure-of-arrays vector streams
+ *
+ * Each component is stored in its own array (x[], y[], z[], w[]) so that the
+ * stream kernels below operate on GL_MATRIX_SOA_LANES vectors at a time with
+ * plain vector loads and stores. Streams created with vec3_soa_create and
+ * vec4_soa_create have every component array aligned to
+ * GL_MATRIX_SOA_ALIGNMENT bytes and padded with zeroes to a multiple of
+ * GL_MATRIX_SOA_LANES, so the kernels never need a scalar tail loop. The
+ * kernels rely on that padding, so only pass them streams created that way.
+ *
+ * The kernels follow the same conventions as their vec3_t/vec4_t
+ * counterparts: if dest is NULL, the result is written to the first operand.
+ * All operands must have the same count.
+ */
+#define GL_MATRIX_SOA_LANES 16
+#define GL_MATRIX_SOA_ALIGNMENT 64
+
+typedef struct {
+    numeric_t *x, *y, *z;
+    size_t count;
+    void *block;
+} vec3_soa_t;
+
+typedef struct {
+    numeric_t *x, *y, *z, *w;
+    size_t count;
+    void *block;
+} vec4_soa_t;
+
+/*
+ * vec3_soa_create
+ * Allocates the component arrays of a vec3_soa_t, initialized with zeroes
+ *
+ * Params:
+ * soa - vec3_soa_t to initialize
+ * count - number of vectors in the stream
+ *
+ * Returns:
+ * soa, NULL if the memory could not be allocated
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_create(vec3_soa_t *soa, size_t count);
+
+/*
+ * vec3_soa_free
+ * Releases the component arrays of a vec3_soa_t created with vec3_soa_create
+ *
+ * Params:
+ * soa - vec3_soa_t to release
+ */
+GL_MATRIX_API void vec3_soa_free(vec3_soa_t *soa);
+
+/*
+ * vec3_soa_fromAoS
+ * Copies an array of vec3_t (x, y, z, x, y, z, ...) into a stream
+ *
+ * Params:
+ * vec - first element of the packed vec3_t array
+ * dest - vec3_soa_t receiving the values. Its count is the number of
+ * vectors copied
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_fromAoS(vec3_t vec, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_toAoS
+ * Copies a stream into an array of vec3_t (x, y, z, x, y, z, ...)
+ *
+ * Params:
+ * soa - vec3_soa_t containing the values to copy
+ * dest - first element of the packed vec3_t array receiving the values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec3_t vec3_soa_toAoS(vec3_soa_t *soa, vec3_t dest);
+
+/*
+ * vec3_soa_add
+ * Performs a vector addition on every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first operand
+ * soa2 - vec3_soa_t, second operand
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_add(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_subtract
+ * Performs a vector subtraction on every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first operand
+ * soa2 - vec3_soa_t, second operand
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_subtract(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_scale
+ * Multiplies every element of a stream by a scalar value
+ *
+ * Params:
+ * soa - vec3_soa_t to scale
+ * val - Numeric value to scale by
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_scale(vec3_soa_t *soa, numeric_t val, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_normalize
+ * Normalizes every element of a stream
+ * Elements of length 0 become [0, 0, 0]
+ *
+ * Params:
+ * soa - vec3_soa_t to normalize
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_normalize(vec3_soa_t *soa, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_cross
+ * Generates the cross product of every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first operand
+ * soa2 - vec3_soa_t, second operand
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_cross(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_lerp
+ * Performs a linear interpolation between every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first stream
+ * soa2 - vec3_soa_t, second stream
+ * lerp - interpolation amount between the two inputs
+ * dest - Optional, vec3_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec3_soa_t *vec3_soa_lerp(vec3_soa_t *soa, vec3_soa_t *soa2, numeric_t lerp, vec3_soa_t *dest);
+
+/*
+ * vec3_soa_dot
+ * Calculates the dot product of every element of two streams
+ *
+ * Params:
+ * soa - vec3_soa_t, first operand
+ * soa2 - vec3_soa_t, second operand
+ * dest - array of soa->count numeric_t receiving the dot products
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *vec3_soa_dot(vec3_soa_t *soa, vec3_soa_t *soa2, numeric_t *dest);
+
+/*
+ * vec3_soa_length
+ * Calculates the length of every element of a stream
+ *
+ * Params:
+ * soa - vec3_soa_t to calculate the lengths of
+ * dest - array of soa->count numeric_t receiving the lengths
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *vec3_soa_length(vec3_soa_t *soa, numeric_t *dest);
+
+/*
+ * vec4_soa_create
+ * Allocates the component arrays of a vec4_soa_t, initialized with zeroes
+ *
+ * Params:
+ * soa - vec4_soa_t to initialize
+ * count - number of vectors in the stream
+ *
+ * Returns:
+ * soa, NULL if the memory could not be allocated
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_create(vec4_soa_t *soa, size_t count);
+
+/*
+ * vec4_soa_free
+ * Releases the component arrays of a vec4_soa_t created with vec4_soa_create
+ *
+ * Params:
+ * soa - vec4_soa_t to release
+ */
+GL_MATRIX_API void vec4_soa_free(vec4_soa_t *soa);
+
+/*
+ * vec4_soa_fromAoS
+ * Copies an array of vec4_t (x, y, z, w, x, y, z, w, ...) into a stream
+ *
+ * Params:
+ * vec - first element of the packed vec4_t array
+ * dest - vec4_soa_t receiving the values. Its count is the number of
+ * vectors copied
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_fromAoS(vec4_t vec, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_toAoS
+ * Copies a stream into an array of vec4_t (x, y, z, w, x, y, z, w, ...)
+ *
+ * Params:
+ * soa - vec4_soa_t containing the values to copy
+ * dest - first element of the packed vec4_t array receiving the values
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API vec4_t vec4_soa_toAoS(vec4_soa_t *soa, vec4_t dest);
+
+/*
+ * vec4_soa_add
+ * Performs a vector addition on every element of two streams
+ *
+ * Params:
+ * soa - vec4_soa_t, first operand
+ * soa2 - vec4_soa_t, second operand
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_add(vec4_soa_t *soa, vec4_soa_t *soa2, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_subtract
+ * Performs a vector subtraction on every element of two streams
+ *
+ * Params:
+ * soa - vec4_soa_t, first operand
+ * soa2 - vec4_soa_t, second operand
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_subtract(vec4_soa_t *soa, vec4_soa_t *soa2, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_scale
+ * Multiplies every element of a stream by a scalar value
+ *
+ * Params:
+ * soa - vec4_soa_t to scale
+ * val - Numeric value to scale by
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_scale(vec4_soa_t *soa, numeric_t val, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_normalize
+ * Normalizes every element of a stream
+ * Elements of length 0 become [0, 0, 0, 0]
+ *
+ * Params:
+ * soa - vec4_soa_t to normalize
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_normalize(vec4_soa_t *soa, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_lerp
+ * Performs a linear interpolation between every element of two streams
+ *
+ * Params:
+ * soa - vec4_soa_t, first stream
+ * soa2 - vec4_soa_t, second stream
+ * lerp - interpolation amount between the two inputs
+ * dest - Optional, vec4_soa_t receiving operation result. If NULL, result is written to soa
+ *
+ * Returns:
+ * dest if not NULL, soa otherwise
+ */
+GL_MATRIX_API vec4_soa_t *vec4_soa_lerp(vec4_soa_t *soa, vec4_soa_t *soa2, numeric_t lerp, vec4_soa_t *dest);
+
+/*
+ * vec4_soa_dot
+ * Calculates the dot product of every element of two streams
+ *
+ * Params:
+ * soa - vec4_soa_t, first operand
+ * soa2 - vec4_soa_t, second operand
+ * dest - array of soa->count numeric_t receiving the dot products
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *vec4_soa_dot(vec4_soa_t *soa, vec4_soa_t *soa2, numeric_t *dest);
+
+/*
+ * vec4_soa_length
+ * Calculates the length of every element of a stream
+ *
+ * Params:
+ * soa - vec4_soa_t to calculate the lengths of
+ * dest - array of soa->count numeric_t receiving the lengths
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *vec4_soa_length(vec4_soa_t *soa, numeric_t *dest);
+
+/*
+ * frustum_t - View frustum culling
+ *
+ * A frustum_t is 24 numbers: six planes (a, b, c, d) in the order left,
+ * right, bottom, top, near, far. The plane normals (a, b, c) are normalized
+ * and point into the frustum, so a point p is inside a plane when
+ * a * p[0] + b * p[1] + c * p[2] + d >= 0.
+ *
+ * The culling functions test whole SoA streams (see vec3_soa_t) and write a
+ * visibility bitmask: bit i % 8 of mask[i / 8] is set if object i may be
+ * visible. mask must hold (count + 7) / 8 bytes. The tests are conservative;
+ * objects near the frustum's corners can be reported visible when they are
+ * not.
+ */
+
+/*
+ * frustum_fromMat4
+ * Extracts the planes of a view frustum from a projection or
+ * view-projection matrix
+ * The planes of a projection matrix are in view space; those of a
+ * view-projection matrix (e.g. mat4_multiply(proj, view)) are in world space.
+ *
+ * Params:
+ * mat - mat4_t to extract the frustum planes of
+ * dest - Optional, frustum_t receiving the planes. If NULL, a new frustum_t is created
+ *
+ * Returns:
+ * dest if not NULL, a new frustum otherwise
+ */
+GL_MATRIX_API frustum_t frustum_fromMat4(mat4_t mat, frustum_t dest);
+
+/*
+ * frustum_cullSpheres
+ * Tests a stream of bounding spheres against a frustum
+ *
+ * Params:
+ * frustum - frustum_t to test against
+ * spheres - vec4_soa_t of spheres: x, y and z hold the centers and w the radii
+ * mask - receives one bit per sphere, set if the sphere is visible
+ *
+ * Returns:
+ * The number of visible spheres
+ */
+GL_MATRIX_API size_t frustum_cullSpheres(frustum_t frustum, vec4_soa_t *spheres, unsigned char *mask);
+
+/*
+ * frustum_cullBoxes
+ * Tests a stream of axis aligned bounding boxes against a frustum
+ *
+ * Params:
+ * frustum - frustum_t to test against
+ * centers - vec3_soa_t of box centers
+ * extents - vec3_soa_t of box half sizes, with the same count as centers
+ * mask - receives one bit per box, set if the box is visible
+ *
+ * Returns:
+ * The number of visible boxes
+ */
+GL_MATRIX_API size_t frustum_cullBoxes(frustum_t frustum, vec3_soa_t *centers, vec3_soa_t *extents, unsigned char *mask);
+
+/*
+ * hierarchy_t - Transform hierarchy
+ *
+ * A scene graph of nodes, each with a local translation, rotation and scale
+ * relative to its parent, flattened into arrays. Nodes are numbered in the
+ * order they are added and a node's parent must be added before it, so the
+ * arrays are always topologically sorted and the world matrices can be
+ * computed in one forward pass.
+ *
+ * Changing a node marks it dirty. hierarchy_update recomputes the world
+ * matrices of the dirty nodes and their descendants only, and leaves the
+ * rest untouched.
+ *
+ * The arrays can be read directly: node i's world matrix is
+ * worlds + i * 16, its local translation translations + i * 3, its rotation
+ * (a quat_t) rotations + i * 4 and its scale scales + i * 3. Call
+ * hierarchy_markDirty after writing to the local arrays directly.
+ *
+ * hierarchy_updateParallel uses pthreads unless the library is built with
+ * GL_MATRIX_NO_THREADS, as the skinning functions do.
+ */
+
+/* Parent of root nodes, and the result of a failed hierarchy_add */
+#define GL_MATRIX_HIERARCHY_NONE ((size_t)-1)
+
+/* Upper limit on the threads used by one hierarchy_updateParallel call */
+#ifndef GL_MATRIX_HIERARCHY_MAX_THREADS
+#define GL_MATRIX_HIERARCHY_MAX_THREADS 64
+#endif
+
+typedef struct {
+    numeric_t *worlds;
+    numeric_t *translations, *rotations, *scales;
+    size_t *parents;
+    unsigned char *dirty;
+    size_t count, capacity;
+    size_t firstDirty;
+    void *block;
+    /* Nodes sorted by depth for hierarchy_updateParallel */
+    size_t *order, *levelStarts;
+    size_t levels, ordered;
+    void *levelBlock;
+} hierarchy_t;
+
+/*
+ * hierarchy_create
+ * Allocates an empty hierarchy with room for capacity nodes
+ *
+ * Params:
+ * h - hierarchy_t to initialize
+ * capacity - maximum number of nodes
+ *
+ * Returns:
+ * h, NULL if the memory could not be allocated
+ */
+GL_MATRIX_API hierarchy_t *hierarchy_create(hierarchy_t *h, size_t capacity);
+
+/*
+ * hierarchy_free
+ * Releases the arrays of a hierarchy_t created with hierarchy_create
+ *
+ * Params:
+ * h - hierarchy_t to release
+ */
+GL_MATRIX_API void hierarchy_free(hierarchy_t *h);
+
+/*
+ * hierarchy_add
+ * Adds a node to a hierarchy
+ * Its world matrix is computed by the next hierarchy_update.
+ *
+ * Params:
+ * h - hierarchy_t to add to
+ * parent - index of the parent node, or GL_MATRIX_HIERARCHY_NONE for a root
+ * translation - Optional, vec3_t local translation. If NULL, (0, 0, 0)
+ * rotation - Optional, quat_t local rotation. If NULL, the identity
+ * scale - Optional, vec3_t local scale. If NULL, (1, 1, 1)
+ *
+ * Returns:
+ * the index of the new node, GL_MATRIX_HIERARCHY_NONE if the hierarchy is
+ * full or parent is not a node of it
+ */
+GL_MATRIX_API size_t hierarchy_add(hierarchy_t *h, size_t parent, vec3_t translation, quat_t rotation, vec3_t scale);
+
+/*
+ * hierarchy_setLocal
+ * Changes the local transform of a node and marks it dirty
+ *
+ * Params:
+ * h - hierarchy_t containing the node
+ * node - index of the node
+ * translation - Optional, vec3_t local translation. If NULL, it is unchanged
+ * rotation - Optional, quat_t local rotation. If NULL, it is unchanged
+ * scale - Optional, vec3_t local scale. If NULL, it is unchanged
+ */
+GL_MATRIX_API void hierarchy_setLocal(hierarchy_t *h, size_t node, vec3_t translation, quat_t rotation, vec3_t scale);
+
+/*
+ * hierarchy_markDirty
+ * Marks a node so that hierarchy_update recomputes the world matrices of it
+ * and its descendants
+ *
+ * Params:
+ * h - hierarchy_t containing the node
+ * node - index of the node
+ */
+GL_MATRIX_API void hierarchy_markDirty(hierarchy_t *h, size_t node);
+
+/*
+ * hierarchy_update
+ * Recomputes the world matrices of the dirty nodes and their descendants
+ * and clears the dirty marks
+ * A node's world matrix is its parent's world matrix multiplied by
+ * translation * rotation * scale. The pass starts at the lowest numbered
+ * dirty node, so returns at once if nothing has changed.
+ *
+ * Params:
+ * h - hierarchy_t to update
+ *
+ * Returns:
+ * The number of world matrices recomputed
+ */
+GL_MATRIX_API size_t hierarchy_update(hierarchy_t *h);
+
+/*
+ * hierarchy_updateParallel
+ * Recomputes the world matrices of the dirty nodes and their descendants
+ * using several threads
+ * The nodes are processed one depth level at a time. Threads claim chunks of
+ * 128 nodes of the current level until it is done, then wait for each other
+ * before starting the next. The first call after nodes were added sorts the
+ * nodes by depth, allocating an index array the size of the hierarchy's
+ * capacity. Every node is computed exactly as by hierarchy_update, so the
+ * results are identical. Small updates run on the calling thread only.
+ *
+ * Params:
+ * h - hierarchy_t to update
+ * threads - number of threads to use, including the calling thread. At most
+ * GL_MATRIX_HIERARCHY_MAX_THREADS.
+ *
+ * Returns:
+ * The number of world matrices recomputed
+ */
+GL_MATRIX_API size_t hierarchy_updateParallel(hierarchy_t *h, unsigned int threads);
+
+/*
+ * Skinning
+ *
+ * Linear blend skinning on the CPU. Each vertex has four bone influences:
+ * four indices into a palette of bone matrices and four weights, which
+ * should add up to 1. Unused influences can point at any bone with a weight
+ * of 0. The bone matrices are blended with the weights and the position (and
+ * optionally the normal) is transformed by the blended matrix.
+ *
+ * Normals are transformed by the upper 3x3 of the blended matrix and are not
+ * renormalized, so normalize them afterwards if the bones scale or the
+ * weights make the result shorter.
+ *
+ * Define GL_MATRIX_NO_THREADS when building the library to leave out the
+ * pthreads dependency; skin_linearBlendParallel then runs on the calling
+ * thread. Otherwise link with -pthread.
+ */
+
+/* Upper limit on the threads used by one skin_linearBlendParallel call */
+#ifndef GL_MATRIX_SKIN_MAX_THREADS
+#define GL_MATRIX_SKIN_MAX_THREADS 64
+#endif
+
+/*
+ * skin_linearBlend
+ * Skins the positions and normals of a mesh
+ *
+ * Params:
+ * bones - bone palette, an array of tightly packed mat4_t
+ * indices - 4 bone indices per vertex
+ * weights - 4 weights per vertex
+ * positions - first of count tightly packed vec3_t, bind pose positions
+ * normals - Optional, first of count tightly packed vec3_t, bind pose
+ * normals. If NULL, only positions are skinned.
+ * count - number of vertices
+ * destPositions - Optional, array of count vec3_t receiving skinned positions. If NULL, results are written to positions
+ * destNormals - Optional, array of count vec3_t receiving skinned normals. If NULL, results are written to normals
+ */
+GL_MATRIX_API void skin_linearBlend(mat4_t bones, unsigned short *indices, numeric_t *weights,
+                      vec3_t positions, vec3_t normals, size_t count,
+                      vec3_t destPositions, vec3_t destNormals);
+
+/*
+ * skin_linearBlendParallel
+ * Skins the positions and normals of a mesh using several threads
+ * The vertices are split into one contiguous range per thread, each a
+ * multiple of 64 vertices, and the calling thread works on the first range.
+ * Every thread gets at least 4096 vertices, since starting a thread costs
+ * about as much as skinning that many, so meshes under 8192 vertices run on
+ * the calling thread only. The results are identical to skin_linearBlend.
+ *
+ * Params:
+ * bones, indices, weights, positions, normals, count, destPositions,
+ * destNormals - as for skin_linearBlend
+ * threads - number of threads to use, including the calling thread. At most
+ * GL_MATRIX_SKIN_MAX_THREADS.
+ */
+GL_MATRIX_API void skin_linearBlendParallel(mat4_t bones, unsigned short *indices, numeric_t *weights,
+                              vec3_t positions, vec3_t normals, size_t count,
+                              vec3_t destPositions, vec3_t destNormals, unsigned int threads);
+
+/*
+ * skin_dualQuaternion
+ * Skins the positions and normals of a mesh with dual quaternion blending
+ * The four bone dual quaternions are blended (after flipping them into the
+ * same hemisphere as the first) and normalized, so the result is always a
+ * rigid transform. Joints keep their volume when twisted, unlike with
+ * skin_linearBlend, and each bone takes 8 numbers instead of 16.
+ *
+ * Normals are only rotated, so unit normals stay unit length.
+ *
+ * Params:
+ * bones - bone palette, an array of tightly packed, normalized dquat_t
+ * indices, weights, positions, normals, count, destPositions,
+ * destNormals - as for skin_linearBlend
+ */
+GL_MATRIX_API void skin_dualQuaternion(dquat_t bones, unsigned short *indices, numeric_t *weights,
+                         vec3_t positions, vec3_t normals, size_t count,
+                         vec3_t destPositions, vec3_t destNormals);
+
+/*
+ * skin_dualQuaternionParallel
+ * Skins the positions and normals of a mesh with dual quaternion blending
+ * using several threads, splitting the work like skin_linearBlendParallel.
+ * Meshes under 8192 vertices run on the calling thread only.
+ *
+ * Params:
+ * bones, indices, weights, positions, normals, count, destPositions,
+ * destNormals - as for skin_dualQuaternion
+ * threads - number of threads to use, including the calling thread. At most
+ * GL_MATRIX_SKIN_MAX_THREADS.
+ */
+GL_MATRIX_API void skin_dualQuaternionParallel(dquat_t bones, unsigned short *indices, numeric_t *weights,
+                                 vec3_t positions, vec3_t normals, size_t count,
+                                 vec3_t destPositions, vec3_t destNormals, unsigned int threads);
+
+/*
+ * Binary streams
+ *
+ * A stream file holds an array of one type of element (vectors, matrices or
+ * quaternions) behind a 64 byte header recording the type, count, precision
+ * and byte order. stream_write saves an array, and stream_open maps a file
+ * into memory. When the file was written with the same precision and byte
+ * order, stream_open doesn't copy or parse anything: stream.data points at
+ * the elements inside the mapping, so a file of mat4 can be used as an
+ * array of mat4_t right away. Files of the other precision or byte order are
+ * converted into a copy allocated with glm_alloc.
+ *
+ * The mapping is copy-on-write: the elements can be modified in place, but
+ * the changes never reach the file. Building with GL_MATRIX_NO_MMAP reads
+ * the file into memory instead of mapping it.
+ *
+ * stream_writeEncoded can store the elements quantized with the functions
+ * of pack.c instead (see Quantization below), with the same error bounds:
+ *
+ * GL_MATRIX_STREAM_HALF    every number as a half float, 2 bytes, any type
+ * GL_MATRIX_STREAM_QUAT32  quat_pack32, 4 bytes per GL_MATRIX_STREAM_QUAT
+ * GL_MATRIX_STREAM_QUAT48  quat_pack48, 6 bytes per GL_MATRIX_STREAM_QUAT
+ * GL_MATRIX_STREAM_TRS     mat4_packTRS, 24 bytes per affine
+ *                          GL_MATRIX_STREAM_MAT4
+ *
+ * The bounds of QUAT32 and QUAT48 hold up to sign: a quaternion can be read
+ * back as -q, the same rotation. stream_open decodes such files into a copy
+ * allocated with glm_alloc.
+ */
+#define GL_MATRIX_STREAM_VEC2 1
+#define GL_MATRIX_STREAM_VEC3 2
+#define GL_MATRIX_STREAM_VEC4 3
+#define GL_MATRIX_STREAM_MAT3 4
+#define GL_MATRIX_STREAM_MAT4 5
+#define GL_MATRIX_STREAM_QUAT 6
+#define GL_MATRIX_STREAM_DQUAT 7
+
+#define GL_MATRIX_STREAM_RAW 0
+#define GL_MATRIX_STREAM_HALF 1
+#define GL_MATRIX_STREAM_QUAT32 2
+#define GL_MATRIX_STREAM_QUAT48 3
+#define GL_MATRIX_STREAM_TRS 4
+
+typedef struct {
+    /* First element, consecutive elements follow without gaps */
+    numeric_t *data;
+    size_t count;
+    /* GL_MATRIX_STREAM_* type and encoding of the file */
+    int type;
+    int encoding;
+    /* The file mapping, or the converted copy */
+    void *mapping;
+    size_t size;
+    numeric_t *copy;
+} stream_t;
+
+/*
+ * stream_write
+ * Writes an array of elements to a stream file, replacing it if it exists
+ *
+ * Params:
+ * path - file to write
+ * type - GL_MATRIX_STREAM_* type of the elements
+ * data - first of count consecutive elements
+ * count - number of elements
+ *
+ * Returns:
+ * 1 on success, 0 if the type is unknown or the file could not be written
+ */
+GL_MATRIX_API int stream_write(const char *path, int type, const numeric_t *data, size_t count);
+
+/*
+ * stream_writeEncoded
+ * Writes an array of elements to a stream file in the given encoding
+ *
+ * Params:
+ * path - file to write
+ * type - GL_MATRIX_STREAM_* type of the elements
+ * encoding - GL_MATRIX_STREAM_RAW, as stream_write, or one of the quantized
+ * encodings that can hold the type
+ * data - first of count consecutive elements. Quaternions must be
+ * normalized and matrices affine.
+ * count - number of elements
+ *
+ * Returns:
+ * 1 on success, 0 if the type or encoding is unknown, the encoding can't
+ * hold the type, or the file could not be written
+ */
+GL_MATRIX_API int stream_writeEncoded(const char *path, int type, int encoding, const numeric_t *data, size_t count);
+
+/*
+ * stream_open
+ * Opens a stream file for reading, mapping it into memory
+ *
+ * Params:
+ * stream - stream_t to initialize
+ * path - file to open
+ *
+ * Returns:
+ * stream, NULL if the file could not be opened or is not a valid stream
+ */
+GL_MATRIX_API stream_t *stream_open(stream_t *stream, const char *path);
+
+/*
+ * stream_data
+ * Returns the elements of a stream if they have the expected type
+ *
+ * Params:
+ * stream - open stream_t
+ * type - GL_MATRIX_STREAM_* type the caller expects, e.g.
+ * GL_MATRIX_STREAM_MAT4 to use the result as mat4_t
+ *
+ * Returns:
+ * First of stream->count elements, NULL if the stream holds another type
+ */
+GL_MATRIX_API numeric_t *stream_data(stream_t *stream, int type);
+
+/*
+ * stream_close
+ * Unmaps a stream, invalidating pointers into its elements
+ *
+ * Params:
+ * stream - stream_t opened with stream_open
+ */
+GL_MATRIX_API void stream_close(stream_t *stream);
+
+/*
+ * Quantization
+ *
+ * Compact encodings of quaternions, vectors and transforms for network
+ * replication and animation caches. The packed forms are the same in the
+ * float and double libraries, in the machine's byte order.
+ *
+ * Quaternions use the smallest three encoding: the index of the largest
+ * component and the other three, which lie in [-1/sqrt(2), 1/sqrt(2)],
+ * quantized to 10 bits each (quat_pack32, 4 bytes) or 15 bits each
+ * (quat_pack48, 6 bytes). The largest component is recomputed from the unit
+ * length on unpacking. Input quaternions must be normalized. Packing makes
+ * the largest component positive, so about half of all quaternions unpack as
+ * -q, which is the same rotation. Up to that sign, measured over 10^7 random
+ * unit quaternions, the largest error of a component is 2.0e-3 with 32 bits
+ * and 5.8e-5 with 48 bits, and the rotations they represent differ by at
+ * most 0.26 and 0.008 degrees. To compare components with the original,
+ * first negate the unpacked quaternion when its dot product with the
+ * original is negative.
+ *
+ * half_pack and half_unpack convert numbers to and from IEEE 754 half
+ * precision, rounding to nearest. The relative error of a normal half is at
+ * most 2^-11 (4.9e-4), and the range ends at 65504.
+ *
+ * mat4_trs_t holds an affine matrix as a float translation, a 48 bit
+ * rotation and a half precision scale, in 24 bytes instead of 64. Matrices
+ * with shear are not representable. With scales in [0.1, 0.9], the upper 3x3
+ * elements of the unpacked matrices were off by at most 2.5e-4.
+ */
+typedef struct {
+    float translation[3];
+    uint16_t rotation[3];
+    uint16_t scale[3];
+} mat4_trs_t;
+
+/*
+ * quat_pack32
+ * Packs a unit quaternion into 32 bits
+ *
+ * Params:
+ * quat - quat_t to pack, normalized
+ *
+ * Returns:
+ * The packed quaternion
+ */
+GL_MATRIX_API uint32_t quat_pack32(quat_t quat);
+
+/*
+ * quat_unpack32
+ * Unpacks a quaternion packed by quat_pack32
+ *
+ * Params:
+ * packed - packed quaternion
+ * dest - quat_t receiving the unit quaternion
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_unpack32(uint32_t packed, quat_t dest);
+
+/*
+ * quat_pack48
+ * Packs a unit quaternion into 48 bits
+ *
+ * Params:
+ * quat - quat_t to pack, normalized
+ * dest - 3 uint16_t receiving the packed quaternion
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API uint16_t *quat_pack48(quat_t quat, uint16_t *dest);
+
+/*
+ * quat_unpack48
+ * Unpacks a quaternion packed by quat_pack48
+ *
+ * Params:
+ * packed - 3 uint16_t, the packed quaternion
+ * dest - quat_t receiving the unit quaternion
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_unpack48(const uint16_t *packed, quat_t dest);
+
+/*
+ * quat_pack32_array
+ * Packs an array of unit quaternions into 32 bits each
+ *
+ * Params:
+ * quat - first of count consecutive quat_t
+ * count - number of quaternions
+ * dest - count uint32_t receiving the packed quaternions
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API uint32_t *quat_pack32_array(quat_t quat, size_t count, uint32_t *dest);
+
+/*
+ * quat_unpack32_array
+ * Unpacks an array of quaternions packed by quat_pack32
+ *
+ * Params:
+ * packed - count packed quaternions
+ * count - number of quaternions
+ * dest - count consecutive quat_t receiving the quaternions
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_unpack32_array(const uint32_t *packed, size_t count, quat_t dest);
+
+/*
+ * quat_pack48_array
+ * Packs an array of unit quaternions into 48 bits each
+ *
+ * Params:
+ * quat - first of count consecutive quat_t
+ * count - number of quaternions
+ * dest - 3 * count uint16_t receiving the packed quaternions
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API uint16_t *quat_pack48_array(quat_t quat, size_t count, uint16_t *dest);
+
+/*
+ * quat_unpack48_array
+ * Unpacks an array of quaternions packed by quat_pack48
+ *
+ * Params:
+ * packed - 3 * count uint16_t, the packed quaternions
+ * count - number of quaternions
+ * dest - count consecutive quat_t receiving the quaternions
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API quat_t quat_unpack48_array(const uint16_t *packed, size_t count, quat_t dest);
+
+/*
+ * half_pack
+ * Converts numbers to half precision
+ *
+ * Params:
+ * values - count numbers, e.g. 3 * n for an array of n vec3_t
+ * count - number of numbers
+ * dest - count uint16_t receiving the half precision numbers
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API uint16_t *half_pack(const numeric_t *values, size_t count, uint16_t *dest);
+
+/*
+ * half_unpack
+ * Converts half precision numbers back to numeric_t
+ *
+ * Params:
+ * packed - count half precision numbers
+ * count - number of numbers
+ * dest - count numbers receiving the result
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API numeric_t *half_unpack(const uint16_t *packed, size_t count, numeric_t *dest);
+
+/*
+ * mat4_packTRS
+ * Packs an affine matrix as translation, rotation and scale
+ *
+ * A matrix that mirrors is packed with a negative x scale.
+ *
+ * Params:
+ * mat - mat4_t to pack, an affine matrix without shear
+ * dest - mat4_trs_t receiving the packed matrix
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_trs_t *mat4_packTRS(mat4_t mat, mat4_trs_t *dest);
+
+/*
+ * mat4_unpackTRS
+ * Unpacks a matrix packed by mat4_packTRS
+ *
+ * Params:
+ * trs - packed matrix
+ * dest - mat4_t receiving the matrix
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_t mat4_unpackTRS(const mat4_trs_t *trs, mat4_t dest);
+
+/*
+ * mat4_packTRS_array
+ * Packs an array of affine matrices as translation, rotation and scale
+ *
+ * Params:
+ * mat - first of count consecutive mat4_t
+ * count - number of matrices
+ * dest - count mat4_trs_t receiving the packed matrices
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_trs_t *mat4_packTRS_array(mat4_t mat, size_t count, mat4_trs_t *dest);
+
+/*
+ * mat4_unpackTRS_array
+ * Unpacks an array of matrices packed by mat4_packTRS
+ *
+ * Params:
+ * trs - count packed matrices
+ * count - number of matrices
+ * dest - count consecutive mat4_t receiving the matrices
+ *
+ * Returns:
+ * dest
+ */
+GL_MATRIX_API mat4_t mat4_unpackTRS_array(const mat4_trs_t *trs, size_t count, mat4_t dest);
+
+/*
+ * Precision conversion
+ *
+ * These convert between float and double data regardless of which precision
+ * numeric_t is, so world-space transforms computed with the double library
+ * can be handed to a float renderer. They are built into libgl-matrix.a only.
+ */
+
+/*
+ * glm_doubleToFloat
+ * Converts an array of doubles to floats
+ *
+ * Params:
+ * src - array of count doubles
+ * dest - array of count floats receiving the result
+ * count - number of values to convert
+ *
+ * Returns:
+ * dest
+ */
+float *glm_doubleToFloat(const double *src, float *dest, size_t count);
+
+/*
+ * glm_floatToDouble
+ * Converts an array of floats to doubles
+ *
+ * Params:
+ * src - array of count floats
+ * dest - array of count doubles receiving the result
+ * count - number of values to convert
+ *
+ * Returns:
+ * dest
+ */
+double *glm_floatToDouble(const float *src, double *dest, size_t count);
+
+/*
+ * glm_mat4ToFloat
+ * Converts a double precision 4x4 matrix to float
+ *
+ * Params:
+ * mat - 16 doubles, the matrix to convert
+ * dest - 16 floats receiving the result
+ *
+ * Returns:
+ * dest
+ */
+float *glm_mat4ToFloat(const double *mat, float *dest);
+
+/*
+ * glm_mat4ToDouble
+ * Converts a float 4x4 matrix to double precision
+ *
+ * Params:
+ * mat - 16 floats, the matrix to convert
+ * dest - 16 doubles receiving the result
+ *
+ * Returns:
+ * dest
+ */
+double *glm_mat4ToDouble(const float *mat, double *dest);
+
+/*
+ * Number formatting
+ *
+ * glm_formatFloat and glm_formatDouble write the shortest string that reads
+ * back as the same number, e.g. "0.1" rather than "0.100000001". They don't
+ * depend on the locale, and are about three times faster than printf's
+ * "%.9g". The layout follows JavaScript's Number.prototype.toString: plain
+ * notation from 1e-6 up to 1e21 ("1", "-0.25", "123456"), exponent notation
+ * outside it ("1e-7", "1.5e+30"), and "inf", "-inf" and "nan", all of which
+ * strtod accepts. They are built into libgl-matrix.a only.
+ *
+ * GL_MATRIX_FORMAT_MAX is the most a number can take, including the NUL.
+ * GL_MATRIX_STR_SIZE(n) is the most a *_str string of n numbers can take.
+ */
+#define GL_MATRIX_FORMAT_MAX 26
+#define GL_MATRIX_STR_SIZE(n) ((n) * (GL_MATRIX_FORMAT_MAX + 1) + 2)
+
+/*
+ * glm_formatFloat
+ * Writes the shortest round-trip representation of a float
+ *
+ * Params:
+ * x - number to format
+ * buffer - char * to store the results, at least GL_MATRIX_FORMAT_MAX bytes
+ *
+ * Returns:
+ * Length of the string written, not counting the terminating NUL
+ */
+size_t glm_formatFloat(float x, char *buffer);
+
+/*
+ * glm_formatDouble
+ * Writes the shortest round-trip representation of a double
+ *
+ * Params:
+ * x - number to format
+ * buffer - char * to store the results, at least GL_MATRIX_FORMAT_MAX bytes
+ *
+ * Returns:
+ * Length of the string written, not counting the terminating NUL
+ */
+size_t glm_formatDouble(double x, char *buffer);
+
+/*
+ * Number parsing
+ *
+ * glm_parseFloat and glm_parseDouble read numbers as written by
+ * glm_formatFloat/glm_formatDouble, and anything else strtod accepts in
+ * decimal: an optional sign, digits with an optional decimal point, an
+ * optional exponent, and inf, infinity or nan in any case. The decimal point
+ * is always '.', whatever the locale, and the result is correctly rounded.
+ * They don't call strtod, allocate or skip leading whitespace, and are
+ * thread-safe. They are built into libgl-matrix.a only.
+ */
+
+/*
+ * glm_parseFloat
+ * Parses a number into a float
+ *
+ * Params:
+ * str - text starting with the number
+ * dest - float receiving the number
+ *
+ * Returns:
+ * Pointer to the first character after the number, NULL if str doesn't
+ * start with a number
+ */
+const char *glm_parseFloat(const char *str, float *dest);
+
+/*
+ * glm_parseDouble
+ * Parses a number into a double
+ *
+ * Params:
+ * str - text starting with the number
+ * dest - double receiving the number
+ *
+ * Returns:
+ * Pointer to the first character after the number, NULL if str doesn't
+ * start with a number
+ */
+const char *glm_parseDouble(const char *str, double *dest);
+
+/*
+ * numbers_parse
+ * Reads the numbers from a chunk of a large text file, e.g. of *_str output
+ *
+ * Numbers are separated by any of '[', ']', ',' and whitespace, so the
+ * brackets are skipped rather than checked. The chunk needn't be NUL
+ * terminated. A number that runs up to the end of the chunk may continue in
+ * the next one, so it is left unread: the caller moves the rest of the chunk
+ * to the start of the next. The text should therefore end with a separator,
+ * as *_str output does.
+ *
+ * Params:
+ * str - chunk of text
+ * length - length of the chunk in bytes
+ * dest - numeric_t array receiving the numbers
+ * max - size of dest; reading stops after max numbers
+ * count - receives the number of numbers read
+ *
+ * Returns:
+ * Pointer to where reading stopped, at most str + length. NULL if the text
+ * holds something other than numbers and separators, in which case count
+ * isn't set.
+ */
+GL_MATRIX_API const char *numbers_parse(const char *str, size_t length, numeric_t *dest, size_t max, size_t *count);
+
+/*
+ * Value types
+ *
+ * vec2s, vec3s, vec4s, quats and mat4s wrap the same numbers as vec2_t,
+ * vec3_t, vec4_t, quat_t and mat4_t in a struct, so they can be passed and
+ * returned by value. The functions below are static inline and never
+ * allocate. Because their operands are copies, they cannot alias, so the
+ * compiler can keep whole chains of them (e.g. mat4s_lookAt, mat4s_multiply,
+ * mat4s_multiplyVec4) in registers.
+ *
+ * Each function computes the same result as the pointer function of the same
+ * name without the "s" built with GL_MATRIX_SIMD_NONE, and takes its
+ * operands in the same order. They are plain C, so with the AVX2 or NEON
+ * backend, whose mat4_multiply and mat4_multiplyVec4 fuse multiply-adds,
+ * mat4s_multiply and mat4s_multiplyVec4 can differ from the pointer
+ * functions in the last bits. The v
+ * member can be passed wherever the pointer API expects a vec3_t, mat4_t
+ * etc., and the *_load functions go the other way.
+ */
+typedef struct { numeric_t v[2]; } vec2s;
+typedef struct { numeric_t v[3]; } vec3s;
+typedef struct { numeric_t v[4]; } vec4s;
+typedef struct { numeric_t v[4]; } quats;
+typedef struct { numeric_t v[16]; } mat4s;
+
+static inline vec2s vec2s_make(numeric_t x, numeric_t y) {
+    vec2s r;
+    r.v[0] = x; r.v[1] = y;
+    return r;
+}
+
+static inline vec2s vec2s_load(vec2_t vec) {
+    return vec2s_make(vec[0], vec[1]);
+}
+
+static inline vec2s vec2s_add(vec2s a, vec2s b) {
+    return vec2s_make(a.v[0] + b.v[0], a.v[1] + b.v[1]);
+}
+
+static inline vec2s vec2s_subtract(vec2s a, vec2s b) {
+    return vec2s_make(a.v[0] - b.v[0], a.v[1] - b.v[1]);
+}
+
+static inline vec2s vec2s_scale(vec2s a, numeric_t val) {
+    return vec2s_make(a.v[0] * val, a.v[1] * val);
+}
+
+static inline numeric_t vec2s_dot(vec2s a, vec2s b) {
+    return a.v[0] * b.v[0] + a.v[1] * b.v[1];
+}
+
+static inline numeric_t vec2s_length(vec2s a) {
+    return glm_sqrt(vec2s_dot(a, a));
+}
+
+static inline vec2s vec2s_normalize(vec2s a) {
+    numeric_t len = vec2s_length(a);
+    if (!len) { return vec2s_make(0, 0); }
+    return len == 1 ? a : vec2s_scale(a, 1 / len);
+}
+
+static inline vec2s vec2s_lerp(vec2s a, vec2s b, numeric_t lerp) {
+    return vec2s_make(a.v[0] + lerp * (b.v[0] - a.v[0]), a.v[1] + lerp * (b.v[1] - a.v[1]));
+}
+
+static inline vec3s vec3s_make(numeric_t x, numeric_t y, numeric_t z) {
+    vec3s r;
+    r.v[0] = x; r.v[1] = y; r.v[2] = z;
+    return r;
+}
+
+static inline vec3s vec3s_load(vec3_t vec) {
+    return vec3s_make(vec[0], vec[1], vec[2]);
+}
+
+static inline vec3s vec3s_add(vec3s a, vec3s b) {
+    return vec3s_make(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2]);
+}
+
+static inline vec3s vec3s_subtract(vec3s a, vec3s b) {
+    return vec3s_make(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2]);
+}
+
+static inline vec3s vec3s_multiply(vec3s a, vec3s b) {
+    return vec3s_make(a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2]);
+}
+
+static inline vec3s vec3s_negate(vec3s a) {
+    return vec3s_make(-a.v[0], -a.v[1], -a.v[2]);
+}
+
+static inline vec3s vec3s_scale(vec3s a, numeric_t val) {
+    return vec3s_make(a.v[0] * val, a.v[1] * val, a.v[2] * val);
+}
+
+static inline numeric_t vec3s_dot(vec3s a, vec3s b) {
+    return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2];
+}
+
+static inline vec3s vec3s_cross(vec3s a, vec3s b) {
+    return vec3s_make(a.v[1] * b.v[2] - a.v[2] * b.v[1],
+                      a.v[2] * b.v[0] - a.v[0] * b.v[2],
+                      a.v[0] * b.v[1] - a.v[1] * b.v[0]);
+}
+
+static inline numeric_t vec3s_length(vec3s a) {
+    return glm_sqrt(vec3s_dot(a, a));
+}
+
+static inline vec3s vec3s_normalize(vec3s a) {
+    numeric_t len = vec3s_length(a);
+    if (!len) { return vec3s_make(0, 0, 0); }
+    return len == 1 ? a : vec3s_scale(a, 1 / len);
+}
+
+static inline vec3s vec3s_lerp(vec3s a, vec3s b, numeric_t lerp) {
+    return vec3s_make(a.v[0] + lerp * (b.v[0] - a.v[0]),
+                      a.v[1] + lerp * (b.v[1] - a.v[1]),
+                      a.v[2] + lerp * (b.v[2] - a.v[2]));
+}
+
+static inline numeric_t vec3s_dist(vec3s a, vec3s b) {
+    return vec3s_length(vec3s_subtract(b, a));
+}
+
+static inline vec4s vec4s_make(numeric_t x, numeric_t y, numeric_t z, numeric_t w) {
+    vec4s r;
+    r.v[0] = x; r.v[1] = y; r.v[2] = z; r.v[3] = w;
+    return r;
+}
+
+static inline vec4s vec4s_load(vec4_t vec) {
+    return vec4s_make(vec[0], vec[1], vec[2], vec[3]);
+}
+
+static inline vec4s vec4s_add(vec4s a, vec4s b) {
+    return vec4s_make(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]);
+}
+
+static inline vec4s vec4s_subtract(vec4s a, vec4s b) {
+    return vec4s_make(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]);
+}
+
+static inline vec4s vec4s_scale(vec4s a, numeric_t val) {
+    return vec4s_make(a.v[0] * val, a.v[1] * val, a.v[2] * val, a.v[3] * val);
+}
+
+static inline numeric_t vec4s_dot(vec4s a, vec4s b) {
+    return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3];
+}
+
+static inline numeric_t vec4s_length(vec4s a) {
+    return glm_sqrt(vec4s_dot(a, a));
+}
+
+static inline vec4s vec4s_normalize(vec4s a) {
+    numeric_t len = vec4s_length(a);
+    if (!len) { return vec4s_make(0, 0, 0, 0); }
+    return len == 1 ? a : vec4s_scale(a, 1 / len);
+}
+
+static inline vec4s vec4s_lerp(vec4s a, vec4s b, numeric_t lerp) {
+    return vec4s_make(a.v[0] + lerp * (b.v[0] - a.v[0]),
+                      a.v[1] + lerp * (b.v[1] - a.v[1]),
+                      a.v[2] + lerp * (b.v[2] - a.v[2]),
+                      a.v[3] + lerp * (b.v[3] - a.v[3]));
+}
+
+static inline quats quats_make(numeric_t x, numeric_t y, numeric_t z, numeric_t w) {
+    quats r;
+    r.v[0] = x; r.v[1] = y; r.v[2] = z; r.v[3] = w;
+    return r;
+}
+
+static inline quats quats_load(quat_t quat) {
+    return quats_make(quat[0], quat[1], quat[2], quat[3]);
+}
+
+static inline quats quats_identity(void) {
+    return quats_make(0, 0, 0, 1);
+}
+
+static inline quats quats_conjugate(quats q) {
+    return quats_make(-q.v[0], -q.v[1], -q.v[2], q.v[3]);
+}
+
+static inline quats quats_normalize(quats q) {
+    numeric_t x = q.v[0], y = q.v[1], z = q.v[2], w = q.v[3],
+        len = glm_sqrt(x * x + y * y + z * z + w * w);
+    if (len == 0) { return quats_make(0, 0, 0, 0); }
+    len = 1 / len;
+    return quats_make(x * len, y * len, z * len, w * len);
+}
+
+static inline quats quats_multiply(quats a, quats b) {
+    numeric_t qax = a.v[0], qay = a.v[1], qaz = a.v[2], qaw = a.v[3],
+        qbx = b.v[0], qby = b.v[1], qbz = b.v[2], qbw = b.v[3];
+
+    return quats_make(qax * qbw + qaw * qbx + qay * qbz - qaz * qby,
+                      qay * qbw + qaw * qby + qaz * qbx - qax * qbz,
+                      qaz * qbw + qaw * qbz + qax * qby - qay * qbx,
+                      qaw * qbw - qax * qbx - qay * qby - qaz * qbz);
+}
+
+static inline vec3s quats_multiplyVec3(quats q, vec3s vec) {
+    numeric_t x = vec.v[0], y = vec.v[1], z = vec.v[2],
+        qx = q.v[0], qy = q.v[1], qz = q.v[2], qw = q.v[3],
+
+        ix = qw * x + qy * z - qz * y,
+        iy = qw * y + qz * x - qx * z,
+        iz = qw * z + qx * y - qy * x,
+        iw = -qx * x - qy * y - qz * z;
+
+    return vec3s_make(ix * qw + iw * -qx + iy * -qz - iz * -qy,
+                      iy * qw + iw * -qy + iz * -qx - ix * -qz,
+                      iz * qw + iw * -qz + ix * -qy - iy * -qx);
+}
+
+static inline quats quats_axisFromAngle(vec3s axis, numeric_t angle) {
+    numeric_t s = glm_sin(angle / 2);
+    axis = vec3s_normalize(axis);
+    return quats_make(axis.v[0] * s, axis.v[1] * s, axis.v[2] * s, glm_cos(angle / 2));
+}
+
+static inline mat4s mat4s_load(mat4_t mat) {
+    mat4s r;
+    int i;
+    for (i = 0; i < 16; i++) { r.v[i] = mat[i]; }
+    return r;
+}
+
+static inline mat4s mat4s_identity(void) {
+    mat4s r;
+    int i;
+    for (i = 0; i < 16; i++) { r.v[i] = i % 5 == 0; }
+    return r;
+}
+
+static inline mat4s mat4s_transpose(mat4s m) {
+    mat4s r;
+    int i, j;
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < 4; j++) { r.v[i * 4 + j] = m.v[j * 4 + i]; }
+    }
+    return r;
+}
+
+static inline mat4s mat4s_multiply(mat4s a, mat4s b) {
+    mat4s r;
+    int i, j;
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 4; i++) {
+            r.v[j * 4 + i] = a.v[i] * b.v[j * 4] + a.v[4 + i] * b.v[j * 4 + 1] +
+                a.v[8 + i] * b.v[j * 4 + 2] + a.v[12 + i] * b.v[j * 4 + 3];
+        }
+    }
+    return r;
+}
+
+static inline vec3s mat4s_multiplyVec3(mat4s m, vec3s vec) {
+    numeric_t x = vec.v[0], y = vec.v[1], z = vec.v[2];
+    return vec3s_make(m.v[0] * x + m.v[4] * y + m.v[8] * z + m.v[12],
+                      m.v[1] * x + m.v[5] * y + m.v[9] * z + m.v[13],
+                      m.v[2] * x + m.v[6] * y + m.v[10] * z + m.v[14]);
+}
+
+static inline vec4s mat4s_multiplyVec4(mat4s m, vec4s vec) {
+    vec4s r;
+    int i;
+    for (i = 0; i < 4; i++) {
+        r.v[i] = m.v[i] * vec.v[0] + m.v[4 + i] * vec.v[1] + m.v[8 + i] * vec.v[2] + m.v[12 + i] * vec.v[3];
+    }
+    return r;
+}
+
+static inline mat4s mat4s_translate(mat4s m, vec3s vec) {
+    int i;
+    for (i = 0; i < 4; i++) {
+        m.v[12 + i] += m.v[i] * vec.v[0] + m.v[4 + i] * vec.v[1] + m.v[8 + i] * vec.v[2];
+    }
+    return m;
+}
+
+static inline mat4s mat4s_scale(mat4s m, vec3s vec) {
+    int i;
+    for (i = 0; i < 12; i++) { m.v[i] *= vec.v[i / 4]; }
+    return m;
+}
+
+/* Calls mat4_inverse. Like it, returns m unchanged if it is singular */
+static inline mat4s mat4s_inverse(mat4s m) {
+    mat4_inverse(m.v, NULL);
+    return m;
+}
+
+static inline mat4s mat4s_fromRotationTranslation(quats q, vec3s vec) {
+    mat4s r;
+    numeric_t x = q.v[0], y = q.v[1], z = q.v[2], w = q.v[3],
+        x2 = x + x, y2 = y + y, z2 = z + z,
+        xx = x * x2, xy = x * y2, xz = x * z2,
+        yy = y * y2, yz = y * z2, zz = z * z2,
+        wx = w * x2, wy = w * y2, wz = w * z2;
+
+    r.v[0] = 1 - (yy + zz); r.v[1] = xy + wz; r.v[2] = xz - wy; r.v[3] = 0;
+    r.v[4] = xy - wz; r.v[5] = 1 - (xx + zz); r.v[6] = yz + wx; r.v[7] = 0;
+    r.v[8] = xz + wy; r.v[9] = yz - wx; r.v[10] = 1 - (xx + yy); r.v[11] = 0;
+    r.v[12] = vec.v[0]; r.v[13] = vec.v[1]; r.v[14] = vec.v[2]; r.v[15] = 1;
+    return r;
+}
+
+static inline mat4s quats_toMat4(quats q) {
+    return mat4s_fromRotationTranslation(q, vec3s_make(0, 0, 0));
+}
+
+static inline mat4s mat4s_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far) {
+    mat4s r;
+    numeric_t rl = right - left, tb = top - bottom, fn = far - near;
+    int i;
+
+    for (i = 0; i < 16; i++) { r.v[i] = 0; }
+    r.v[0] = (near * 2) / rl;
+    r.v[5] = (near * 2) / tb;
+    r.v[8] = (right + left) / rl;
+    r.v[9] = (top + bottom) / tb;
+    r.v[10] = -(far + near) / fn;
+    r.v[11] = -1;
+    r.v[14] = -(far * near * 2) / fn;
+    return r;
+}
+
+static inline mat4s mat4s_perspective(numeric_t fovy, numeric_t aspect, numeric_t near, numeric_t far) {
+    numeric_t top = near * glm_tan(fovy * (numeric_t)(3.14159265358979323846 / 360.0)),
+        right = top * aspect;
+    return mat4s_frustum(-right, right, -top, top, near, far);
+}
+
+static inline mat4s mat4s_lookAt(vec3s eye, vec3s center, vec3s up) {
+    mat4s r;
+    vec3s x, y, z;
+
+    if (eye.v[0] == center.v[0] && eye.v[1] == center.v[1] && eye.v[2] == center.v[2]) {
+        return mat4s_identity();
+    }
+
+    z = vec3s_subtract(eye, center);
+    z = vec3s_scale(z, 1 / vec3s_length(z));
+    x = vec3s_normalize(vec3s_cross(up, z));
+    y = vec3s_normalize(vec3s_cross(z, x));
+
+    r.v[0] = x.v[0]; r.v[1] = y.v[0]; r.v[2] = z.v[0]; r.v[3] = 0;
+    r.v[4] = x.v[1]; r.v[5] = y.v[1]; r.v[6] = z.v[1]; r.v[7] = 0;
+    r.v[8] = x.v[2]; r.v[9] = y.v[2]; r.v[10] = z.v[2]; r.v[11] = 0;
+    r.v[12] = -vec3s_dot(x, eye);
+    r.v[13] = -vec3s_dot(y, eye);
+    r.v[14] = -vec3s_dot(z, eye);
+    r.v[15] = 1;
+    return r;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+#if (defined(GL_MATRIX_IMPLEMENTATION) || defined(GL_MATRIX_STATIC_INLINE)) && !defined(GL_MATRIX_SOURCES_INCLUDED)
+#define GL_MATRIX_SOURCES_INCLUDED
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#if defined(GL_MATRIX_STATIC_INLINE) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+GL_MATRIX_API vec2_t vec2_create(vec2_t vec) {
+    vec2_t dest = glm_alloc(2 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (vec) {
+        dest[0] = vec[0];
+        dest[1] = vec[1];
+    } else {
+        dest[0] = dest[1] = 0;
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API vec2_t vec2_create_in(glm_arena *arena, vec2_t vec) {
+    vec2_t dest = glm_arena_alloc(arena, 2 * sizeof(numeric_t), sizeof(numeric_t) * 2);
+    if (!dest) { return NULL; }
+
+    if (vec) {
+        dest[0] = vec[0];
+        dest[1] = vec[1];
+    } else {
+        memset(dest, 0, 2 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API vec2_t vec2_set(vec2_t vec, vec2_t dest) {
+    dest[0] = vec[0];
+    dest[1] = vec[1];
+    return dest;
+}
+
+GL_MATRIX_API vec2_t vec2_zeroes(vec2_t vec) {
+    vec[0] = 0;
+    vec[1] = 0;
+    return vec;
+}
+
+GL_MATRIX_API vec2_t vec2_ones(vec2_t vec) {
+    vec[0] = 1;
+    vec[1] = 1;
+    return vec;
+}
+
+GL_MATRIX_API vec2_t vec2_add(vec2_t vec, vec2_t vec2, vec2_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] += vec2[0];
+        vec[1] += vec2[1];
+        return vec;
+    }
+
+    dest[0] = vec[0] + vec2[0];
+    dest[1] = vec[1] + vec2[1];
+
+    return dest;
+}
+
+GL_MATRIX_API vec2_t vec2_subtract(vec2_t vec, vec2_t vec2, vec2_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] -= vec2[0];
+        vec[1] -= vec2[1];
+        return vec;
+    }
+
+    dest[0] = vec[0] - vec2[0];
+    dest[1] = vec[1] - vec2[1];
+    return dest;
+}
+
+GL_MATRIX_API vec2_t vec2_negate(vec2_t vec, vec2_t dest) {
+    if (!dest) { dest = vec; }
+
+    dest[0] = -vec[0];
+    dest[1] = -vec[1];
+    return dest;
+}
+
+GL_MATRIX_API vec2_t vec2_scale(vec2_t vec, numeric_t val, vec2_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] *= val;
+        vec[1] *= val;
+        return vec;
+    }
+
+    dest[0] = vec[0] * val;
+    dest[1] = vec[1] * val;
+    return dest;
+}
+
+GL_MATRIX_API vec2_t vec2_normalize(vec2_t vec, vec2_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0], y = vec[1],
+        len = glm_sqrt(x * x + y * y);
+
+    if (!len) {
+        dest[0] = 0;
+        dest[1] = 0;
+        return dest;
+    } else if (len == 1) {
+        dest[0] = x;
+        dest[1] = y;
+        return dest;
+    }
+
+    len = 1 / len;
+    dest[0] = x * len;
+    dest[1] = y * len;
+    return dest;
+}
+
+GL_MATRIX_API numeric_t vec2_length(vec2_t vec) {
+    numeric_t x = vec[0], y = vec[1];
+    return glm_sqrt(x * x + y * y);
+}
+
+GL_MATRIX_API numeric_t vec2_dot(vec2_t vec, vec2_t vec2) {
+    return vec[0] * vec2[0] + vec[1] * vec2[1];
+}
+
+GL_MATRIX_API vec2_t vec2_direction (vec2_t vec, vec2_t vec2, vec2_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0] - vec2[0],
+        y = vec[1] - vec2[1],
+        len = glm_sqrt(x * x + y * y);
+
+    if (!len) {
+        dest[0] = 0;
+        dest[1] = 0;
+        return dest;
+    }
+
+    len = 1 / len;
+    dest[0] = x * len;
+    dest[1] = y * len;
+    return dest;
+}
+
+GL_MATRIX_API vec2_t vec2_lerp(vec2_t vec, vec2_t vec2, numeric_t lerp, vec2_t dest) {
+    if (!dest) { dest = vec; }
+    dest[0] = vec[0] + lerp * (vec2[0] - vec[0]);
+    dest[1] = vec[1] + lerp * (vec2[1] - vec[1]);
+    return dest;
+}
+
+GL_MATRIX_API numeric_t vec2_dist(vec2_t vec, vec2_t vec2) {
+    numeric_t x = vec2[0] - vec[0],
+        y = vec2[1] - vec[1];
+
+    return glm_sqrt(x*x + y*y);
+}
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+
+GL_MATRIX_API vec3_t vec3_create(vec3_t vec) {
+    vec3_t dest = glm_alloc(3 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (vec) {
+        dest[0] = vec[0];
+        dest[1] = vec[1];
+        dest[2] = vec[2];
+    } else {
+        dest[0] = dest[1] = dest[2] = 0;
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_create_in(glm_arena *arena, vec3_t vec) {
+    vec3_t dest = glm_arena_alloc(arena, 3 * sizeof(numeric_t), sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (vec) {
+        dest[0] = vec[0];
+        dest[1] = vec[1];
+        dest[2] = vec[2];
+    } else {
+        memset(dest, 0, 3 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_set(vec3_t vec, vec3_t dest) {
+    dest[0] = vec[0];
+    dest[1] = vec[1];
+    dest[2] = vec[2];
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_zeroes(vec3_t vec) {
+    vec[0] = 0;
+    vec[1] = 0;
+    vec[2] = 0;
+    return vec;
+}
+
+GL_MATRIX_API vec3_t vec3_ones(vec3_t vec) {
+    vec[0] = 1;
+    vec[1] = 1;
+    vec[2] = 1;
+    return vec;
+}
+
+GL_MATRIX_API vec3_t vec3_add(vec3_t vec, vec3_t vec2, vec3_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] += vec2[0];
+        vec[1] += vec2[1];
+        vec[2] += vec2[2];
+        return vec;
+    }
+
+    dest[0] = vec[0] + vec2[0];
+    dest[1] = vec[1] + vec2[1];
+    dest[2] = vec[2] + vec2[2];
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_subtract(vec3_t vec, vec3_t vec2, vec3_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] -= vec2[0];
+        vec[1] -= vec2[1];
+        vec[2] -= vec2[2];
+        return vec;
+    }
+
+    dest[0] = vec[0] - vec2[0];
+    dest[1] = vec[1] - vec2[1];
+    dest[2] = vec[2] - vec2[2];
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_multiply(vec3_t vec, vec3_t vec2, vec3_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] *= vec2[0];
+        vec[1] *= vec2[1];
+        vec[2] *= vec2[2];
+        return vec;
+    }
+
+    dest[0] = vec[0] * vec2[0];
+    dest[1] = vec[1] * vec2[1];
+    dest[2] = vec[2] * vec2[2];
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_negate(vec3_t vec, vec3_t dest) {
+    if (!dest) { dest = vec; }
+
+    dest[0] = -vec[0];
+    dest[1] = -vec[1];
+    dest[2] = -vec[2];
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_scale(vec3_t vec, numeric_t val, vec3_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] *= val;
+        vec[1] *= val;
+        vec[2] *= val;
+        return vec;
+    }
+
+    dest[0] = vec[0] * val;
+    dest[1] = vec[1] * val;
+    dest[2] = vec[2] * val;
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_normalize(vec3_t vec, vec3_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0], y = vec[1], z = vec[2],
+        len = glm_sqrt(x * x + y * y + z * z);
+
+    if (!len) {
+        dest[0] = 0;
+        dest[1] = 0;
+        dest[2] = 0;
+        return dest;
+    } else if (len == 1) {
+        dest[0] = x;
+        dest[1] = y;
+        dest[2] = z;
+        return dest;
+    }
+
+    len = 1 / len;
+    dest[0] = x * len;
+    dest[1] = y * len;
+    dest[2] = z * len;
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_cross (vec3_t vec, vec3_t vec2, vec3_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0], y = vec[1], z = vec[2],
+        x2 = vec2[0], y2 = vec2[1], z2 = vec2[2];
+
+    dest[0] = y * z2 - z * y2;
+    dest[1] = z * x2 - x * z2;
+    dest[2] = x * y2 - y * x2;
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_cross_noalias(vec3_t GL_MATRIX_RESTRICT vec, vec3_t GL_MATRIX_RESTRICT vec2, vec3_t GL_MATRIX_RESTRICT dest) {
+    assert(GL_MATRIX_DISJOINT(vec, 3, dest, 3) && GL_MATRIX_DISJOINT(vec2, 3, dest, 3));
+
+    dest[0] = vec[1] * vec2[2] - vec[2] * vec2[1];
+    dest[1] = vec[2] * vec2[0] - vec[0] * vec2[2];
+    dest[2] = vec[0] * vec2[1] - vec[1] * vec2[0];
+    return dest;
+}
+
+GL_MATRIX_API numeric_t vec3_length(vec3_t vec) {
+    numeric_t x = vec[0], y = vec[1], z = vec[2];
+    return glm_sqrt(x * x + y * y + z * z);
+}
+
+GL_MATRIX_API numeric_t vec3_dot(vec3_t vec, vec3_t vec2) {
+    return vec[0] * vec2[0] + vec[1] * vec2[1] + vec[2] * vec2[2];
+}
+
+GL_MATRIX_API vec3_t vec3_direction (vec3_t vec, vec3_t vec2, vec3_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0] - vec2[0],
+        y = vec[1] - vec2[1],
+        z = vec[2] - vec2[2],
+        len = glm_sqrt(x * x + y * y + z * z);
+
+    if (!len) {
+        dest[0] = 0;
+        dest[1] = 0;
+        dest[2] = 0;
+        return dest;
+    }
+
+    len = 1 / len;
+    dest[0] = x * len;
+    dest[1] = y * len;
+    dest[2] = z * len;
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_lerp(vec3_t vec, vec3_t vec2, numeric_t lerp, vec3_t dest) {
+    if (!dest) { dest = vec; }
+
+    dest[0] = vec[0] + lerp * (vec2[0] - vec[0]);
+    dest[1] = vec[1] + lerp * (vec2[1] - vec[1]);
+    dest[2] = vec[2] + lerp * (vec2[2] - vec[2]);
+
+    return dest;
+}
+
+GL_MATRIX_API numeric_t vec3_dist(vec3_t vec, vec3_t vec2) {
+    numeric_t x = vec2[0] - vec[0],
+        y = vec2[1] - vec[1],
+        z = vec2[2] - vec[2];
+
+    return glm_sqrt(x*x + y*y + z*z);
+}
+
+GL_MATRIX_API vec3_t vec3_unproject(vec3_t vec, mat4_t view, mat4_t proj, vec4_t viewport, vec3_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t m[16], v[4];
+
+    v[0] = (vec[0] - viewport[0]) * 2 / viewport[2] - 1;
+    v[1] = (vec[1] - viewport[1]) * 2 / viewport[3] - 1;
+    v[2] = 2 * vec[2] - 1;
+    v[3] = 1;
+
+    mat4_multiply(proj, view, m);
+    if(!mat4_inverse(m, NULL)) { return NULL; }
+
+    mat4_multiplyVec4(m, v, NULL);
+    if(v[3] == 0) { return NULL; }
+
+    dest[0] = v[0] / v[3];
+    dest[1] = v[1] / v[3];
+    dest[2] = v[2] / v[3];
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_unproject_array(vec3_t vec, size_t count, mat4_t view, mat4_t proj, vec4_t viewport, mat4_t invViewProj, vec3_t dest) {
+    numeric_t m[16], sx, sy, ox, oy, x, y, z, w;
+    size_t i;
+
+    if (!dest) { dest = vec; }
+
+    if (invViewProj) {
+        mat4_set(invViewProj, m);
+    } else {
+        mat4_multiply(proj, view, m);
+        if(!mat4_inverse(m, NULL)) { return NULL; }
+    }
+
+    // Fold the viewport transform into a scale and offset per axis
+    sx = 2 / viewport[2];
+    sy = 2 / viewport[3];
+    ox = -viewport[0] * sx - 1;
+    oy = -viewport[1] * sy - 1;
+
+    for (i = 0; i < count; i++) {
+        x = vec[3 * i] * sx + ox;
+        y = vec[3 * i + 1] * sy + oy;
+        z = 2 * vec[3 * i + 2] - 1;
+
+        w = m[3] * x + m[7] * y + m[11] * z + m[15];
+        if (w == 0) { continue; }
+        w = 1 / w;
+
+        dest[3 * i] = (m[0] * x + m[4] * y + m[8] * z + m[12]) * w;
+        dest[3 * i + 1] = (m[1] * x + m[5] * y + m[9] * z + m[13]) * w;
+        dest[3 * i + 2] = (m[2] * x + m[6] * y + m[10] * z + m[14]) * w;
+    }
+
+    return dest;
+}
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+GL_MATRIX_API vec4_t vec4_create(vec4_t vec) {
+    vec4_t dest = glm_alloc(4 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (vec) {
+        dest[0] = vec[0];
+        dest[1] = vec[1];
+        dest[2] = vec[2];
+        dest[3] = vec[3];
+    } else {
+        dest[0] = dest[1] = dest[2] = dest[3] = 0;
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_create_in(glm_arena *arena, vec4_t vec) {
+    vec4_t dest = glm_arena_alloc(arena, 4 * sizeof(numeric_t), 16);
+    if (!dest) { return NULL; }
+
+    if (vec) {
+        dest[0] = vec[0];
+        dest[1] = vec[1];
+        dest[2] = vec[2];
+        dest[3] = vec[3];
+    } else {
+        memset(dest, 0, 4 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_create_aligned(vec4_t vec, size_t align) {
+    vec4_t dest = glm_alloc_aligned(4 * sizeof(numeric_t), align);
+    if (!dest) { return NULL; }
+
+    if (vec) { memcpy(dest, vec, 4 * sizeof(numeric_t)); }
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_set(vec4_t vec, vec4_t dest) {
+    dest[0] = vec[0];
+    dest[1] = vec[1];
+    dest[2] = vec[2];
+    dest[3] = vec[3];
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_zeroes(vec4_t vec) {
+    vec[0] = 0;
+    vec[1] = 0;
+    vec[2] = 0;
+    vec[3] = 0;
+    return vec;
+}
+
+GL_MATRIX_API vec4_t vec4_ones(vec4_t vec) {
+    vec[0] = 1;
+    vec[1] = 1;
+    vec[2] = 1;
+    vec[3] = 1;
+    return vec;
+}
+
+GL_MATRIX_API vec4_t vec4_add(vec4_t vec, vec4_t vec2, vec4_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] += vec2[0];
+        vec[1] += vec2[1];
+        vec[2] += vec2[2];
+        vec[3] += vec2[3];
+        return vec;
+    }
+
+    dest[0] = vec[0] + vec2[0];
+    dest[1] = vec[1] + vec2[1];
+    dest[2] = vec[2] + vec2[2];
+    dest[3] = vec[3] + vec2[3];
+
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_subtract(vec4_t vec, vec4_t vec2, vec4_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] -= vec2[0];
+        vec[1] -= vec2[1];
+        vec[2] -= vec2[2];
+        vec[3] -= vec2[3];
+        return vec;
+    }
+
+    dest[0] = vec[0] - vec2[0];
+    dest[1] = vec[1] - vec2[1];
+    dest[2] = vec[2] - vec2[2];
+    dest[3] = vec[3] - vec2[3];
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_negate(vec4_t vec, vec4_t dest) {
+    if (!dest) { dest = vec; }
+
+    dest[0] = -vec[0];
+    dest[1] = -vec[1];
+    dest[2] = -vec[2];
+    dest[3] = -vec[3];
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_scale(vec4_t vec, numeric_t val, vec4_t dest) {
+    if (!dest || vec == dest) {
+        vec[0] *= val;
+        vec[1] *= val;
+        vec[2] *= val;
+        vec[3] *= val;
+        return vec;
+    }
+
+    dest[0] = vec[0] * val;
+    dest[1] = vec[1] * val;
+    dest[2] = vec[2] * val;
+    dest[3] = vec[3] * val;
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_normalize(vec4_t vec, vec4_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0], y = vec[1], z = vec[2], w = vec[3],
+        len = glm_sqrt(x * x + y * y + z * z + w * w);
+
+    if (!len) {
+        dest[0] = 0;
+        dest[1] = 0;
+        dest[2] = 0;
+        dest[3] = 0;
+        return dest;
+    } else if (len == 1) {
+        dest[0] = x;
+        dest[1] = y;
+        dest[2] = z;
+        dest[3] = z;
+        return dest;
+    }
+
+    len = 1 / len;
+    dest[0] = x * len;
+    dest[1] = y * len;
+    dest[2] = z * len;
+    dest[3] = w * len;
+    return dest;
+}
+
+GL_MATRIX_API numeric_t vec4_length(vec4_t vec) {
+    numeric_t x = vec[0], y = vec[1], z = vec[2], w = vec[3];
+    return glm_sqrt(x * x + y * y + z * z + w * w);
+}
+
+GL_MATRIX_API numeric_t vec4_dot(vec4_t vec, vec4_t vec2) {
+    return vec[0] * vec2[0] + vec[1] * vec2[1] + vec[2] * vec2[2] + vec[3] * vec2[3];
+}
+
+GL_MATRIX_API vec4_t vec4_direction (vec4_t vec, vec4_t vec2, vec4_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0] - vec2[0],
+        y = vec[1] - vec2[1],
+        z = vec[2] - vec2[2],
+        w = vec[3] - vec2[3],
+        len = glm_sqrt(x * x + y * y + z * z + w * w);
+
+    if (!len) {
+        dest[0] = 0;
+        dest[1] = 0;
+        dest[2] = 0;
+        dest[3] = 0;
+        return dest;
+    }
+
+    len = 1 / len;
+    dest[0] = x * len;
+    dest[1] = y * len;
+    dest[2] = z * len;
+    dest[3] = w * len;
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_lerp(vec4_t vec, vec4_t vec2, numeric_t lerp, vec4_t dest) {
+    if (!dest) { dest = vec; }
+
+    dest[0] = vec[0] + lerp * (vec2[0] - vec[0]);
+    dest[1] = vec[1] + lerp * (vec2[1] - vec[1]);
+    dest[2] = vec[2] + lerp * (vec2[2] - vec[2]);
+    dest[3] = vec[3] + lerp * (vec2[3] - vec[3]);
+
+    return dest;
+}
+
+GL_MATRIX_API numeric_t vec4_dist(vec4_t vec, vec4_t vec2) {
+    numeric_t x = vec2[0] - vec[0],
+        y = vec2[1] - vec[1],
+        z = vec2[2] - vec[2],
+        w = vec2[3] - vec[3];
+
+    return glm_sqrt(x*x + y*y + z*z + w*w);
+}
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+GL_MATRIX_API mat3_t mat3_create(mat3_t mat) {
+    mat3_t dest = glm_alloc(9 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (mat) {
+        dest[0] = mat[0];
+        dest[1] = mat[1];
+        dest[2] = mat[2];
+        dest[3] = mat[3];
+        dest[4] = mat[4];
+        dest[5] = mat[5];
+        dest[6] = mat[6];
+        dest[7] = mat[7];
+        dest[8] = mat[8];
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API mat3_t mat3_create_in(glm_arena *arena, mat3_t mat) {
+    mat3_t dest = glm_arena_alloc(arena, 9 * sizeof(numeric_t), sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (mat) {
+        dest[0] = mat[0];
+        dest[1] = mat[1];
+        dest[2] = mat[2];
+        dest[3] = mat[3];
+        dest[4] = mat[4];
+        dest[5] = mat[5];
+        dest[6] = mat[6];
+        dest[7] = mat[7];
+        dest[8] = mat[8];
+    } else {
+        memset(dest, 0, 9 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API mat3_t mat3_set(mat3_t mat, mat3_t dest) {
+    dest[0] = mat[0];
+    dest[1] = mat[1];
+    dest[2] = mat[2];
+    dest[3] = mat[3];
+    dest[4] = mat[4];
+    dest[5] = mat[5];
+    dest[6] = mat[6];
+    dest[7] = mat[7];
+    dest[8] = mat[8];
+    return dest;
+}
+
+GL_MATRIX_API mat3_t mat3_identity(mat3_t dest) {
+    if (!dest) { dest = mat3_create(NULL); }
+    dest[0] = 1;
+    dest[1] = 0;
+    dest[2] = 0;
+    dest[3] = 0;
+    dest[4] = 1;
+    dest[5] = 0;
+    dest[6] = 0;
+    dest[7] = 0;
+    dest[8] = 1;
+    return dest;
+}
+
+GL_MATRIX_API mat3_t mat3_transpose(mat3_t mat, mat3_t dest) {
+    // If we are transposing ourselves we can skip a few steps but have to cache some values
+    if (!dest || mat == dest) {
+        numeric_t a01 = mat[1], a02 = mat[2],
+            a12 = mat[5];
+
+        mat[1] = mat[3];
+        mat[2] = mat[6];
+        mat[3] = a01;
+        mat[5] = mat[7];
+        mat[6] = a02;
+        mat[7] = a12;
+        return mat;
+    }
+
+    dest[0] = mat[0];
+    dest[1] = mat[3];
+    dest[2] = mat[6];
+    dest[3] = mat[1];
+    dest[4] = mat[4];
+    dest[5] = mat[7];
+    dest[6] = mat[2];
+    dest[7] = mat[5];
+    dest[8] = mat[8];
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat3_toMat4(mat3_t mat, mat4_t dest) {
+    if (!dest) { dest = mat4_create(NULL); }
+
+    dest[15] = 1;
+    dest[14] = 0;
+    dest[13] = 0;
+    dest[12] = 0;
+
+    dest[11] = 0;
+    dest[10] = mat[8];
+    dest[9] = mat[7];
+    dest[8] = mat[6];
+
+    dest[7] = 0;
+    dest[6] = mat[5];
+    dest[5] = mat[4];
+    dest[4] = mat[3];
+
+    dest[3] = 0;
+    dest[2] = mat[2];
+    dest[1] = mat[1];
+    dest[0] = mat[0];
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t mat3_multiplyVec3(mat3_t mat, vec3_t vec, vec3_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0], y = vec[1], z = vec[2];
+
+    dest[0] = mat[0] * x + mat[3] * y + mat[6] * z;
+    dest[1] = mat[1] * x + mat[4] * y + mat[7] * z;
+    dest[2] = mat[2] * x + mat[5] * y + mat[8] * z;
+
+    return dest;
+}
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+#include <immintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#include <emmintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+GL_MATRIX_API mat4_t mat4_create(mat4_t mat) {
+    mat4_t dest = glm_alloc(16 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (mat) {
+        dest[0] = mat[0];
+        dest[1] = mat[1];
+        dest[2] = mat[2];
+        dest[3] = mat[3];
+        dest[4] = mat[4];
+        dest[5] = mat[5];
+        dest[6] = mat[6];
+        dest[7] = mat[7];
+        dest[8] = mat[8];
+        dest[9] = mat[9];
+        dest[10] = mat[10];
+        dest[11] = mat[11];
+        dest[12] = mat[12];
+        dest[13] = mat[13];
+        dest[14] = mat[14];
+        dest[15] = mat[15];
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_create_in(glm_arena *arena, mat4_t mat) {
+    mat4_t dest = glm_arena_alloc(arena, 16 * sizeof(numeric_t), GL_MATRIX_ARENA_ALIGNMENT);
+    if (!dest) { return NULL; }
+
+    if (mat) {
+        dest[0] = mat[0];
+        dest[1] = mat[1];
+        dest[2] = mat[2];
+        dest[3] = mat[3];
+        dest[4] = mat[4];
+        dest[5] = mat[5];
+        dest[6] = mat[6];
+        dest[7] = mat[7];
+        dest[8] = mat[8];
+        dest[9] = mat[9];
+        dest[10] = mat[10];
+        dest[11] = mat[11];
+        dest[12] = mat[12];
+        dest[13] = mat[13];
+        dest[14] = mat[14];
+        dest[15] = mat[15];
+    } else {
+        memset(dest, 0, 16 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_create_aligned(mat4_t mat, size_t align) {
+    mat4_t dest = glm_alloc_aligned(16 * sizeof(numeric_t), align);
+    if (!dest) { return NULL; }
+
+    if (mat) { memcpy(dest, mat, 16 * sizeof(numeric_t)); }
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_set(mat4_t mat, mat4_t dest) {
+    dest[0] = mat[0];
+    dest[1] = mat[1];
+    dest[2] = mat[2];
+    dest[3] = mat[3];
+    dest[4] = mat[4];
+    dest[5] = mat[5];
+    dest[6] = mat[6];
+    dest[7] = mat[7];
+    dest[8] = mat[8];
+    dest[9] = mat[9];
+    dest[10] = mat[10];
+    dest[11] = mat[11];
+    dest[12] = mat[12];
+    dest[13] = mat[13];
+    dest[14] = mat[14];
+    dest[15] = mat[15];
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_identity(mat4_t dest) {
+    if (!dest) { dest = mat4_create(NULL); }
+    dest[0] = 1;
+    dest[1] = 0;
+    dest[2] = 0;
+    dest[3] = 0;
+    dest[4] = 0;
+    dest[5] = 1;
+    dest[6] = 0;
+    dest[7] = 0;
+    dest[8] = 0;
+    dest[9] = 0;
+    dest[10] = 1;
+    dest[11] = 0;
+    dest[12] = 0;
+    dest[13] = 0;
+    dest[14] = 0;
+    dest[15] = 1;
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_transpose(mat4_t mat, mat4_t dest) {
+    // If we are transposing ourselves we can skip a few steps but have to cache some values
+    if (!dest || mat == dest) {
+        numeric_t a01 = mat[1], a02 = mat[2], a03 = mat[3],
+            a12 = mat[6], a13 = mat[7],
+            a23 = mat[11];
+
+        mat[1] = mat[4];
+        mat[2] = mat[8];
+        mat[3] = mat[12];
+        mat[4] = a01;
+        mat[6] = mat[9];
+        mat[7] = mat[13];
+        mat[8] = a02;
+        mat[9] = a12;
+        mat[11] = mat[14];
+        mat[12] = a03;
+        mat[13] = a13;
+        mat[14] = a23;
+        return mat;
+    }
+
+    dest[0] = mat[0];
+    dest[1] = mat[4];
+    dest[2] = mat[8];
+    dest[3] = mat[12];
+    dest[4] = mat[1];
+    dest[5] = mat[5];
+    dest[6] = mat[9];
+    dest[7] = mat[13];
+    dest[8] = mat[2];
+    dest[9] = mat[6];
+    dest[10] = mat[10];
+    dest[11] = mat[14];
+    dest[12] = mat[3];
+    dest[13] = mat[7];
+    dest[14] = mat[11];
+    dest[15] = mat[15];
+    return dest;
+}
+
+GL_MATRIX_API numeric_t mat4_determinant(mat4_t mat) {
+    // Cache the matrix values (makes for huge speed increases!)
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2], a03 = mat[3],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6], a13 = mat[7],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10], a23 = mat[11],
+        a30 = mat[12], a31 = mat[13], a32 = mat[14], a33 = mat[15];
+
+    return (a30 * a21 * a12 * a03 - a20 * a31 * a12 * a03 - a30 * a11 * a22 * a03 + a10 * a31 * a22 * a03 +
+            a20 * a11 * a32 * a03 - a10 * a21 * a32 * a03 - a30 * a21 * a02 * a13 + a20 * a31 * a02 * a13 +
+            a30 * a01 * a22 * a13 - a00 * a31 * a22 * a13 - a20 * a01 * a32 * a13 + a00 * a21 * a32 * a13 +
+            a30 * a11 * a02 * a23 - a10 * a31 * a02 * a23 - a30 * a01 * a12 * a23 + a00 * a31 * a12 * a23 +
+            a10 * a01 * a32 * a23 - a00 * a11 * a32 * a23 - a20 * a11 * a02 * a33 + a10 * a21 * a02 * a33 +
+            a20 * a01 * a12 * a33 - a00 * a21 * a12 * a33 - a10 * a01 * a22 * a33 + a00 * a11 * a22 * a33);
+}
+
+GL_MATRIX_API mat4_t mat4_inverse(mat4_t mat, mat4_t dest) {
+    if (!dest) { dest = mat; }
+
+    // Cache the matrix values (makes for huge speed increases!)
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2], a03 = mat[3],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6], a13 = mat[7],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10], a23 = mat[11],
+        a30 = mat[12], a31 = mat[13], a32 = mat[14], a33 = mat[15],
+
+        b00 = a00 * a11 - a01 * a10,
+        b01 = a00 * a12 - a02 * a10,
+        b02 = a00 * a13 - a03 * a10,
+        b03 = a01 * a12 - a02 * a11,
+        b04 = a01 * a13 - a03 * a11,
+        b05 = a02 * a13 - a03 * a12,
+        b06 = a20 * a31 - a21 * a30,
+        b07 = a20 * a32 - a22 * a30,
+        b08 = a20 * a33 - a23 * a30,
+        b09 = a21 * a32 - a22 * a31,
+        b10 = a21 * a33 - a23 * a31,
+        b11 = a22 * a33 - a23 * a32,
+
+        d = (b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06),
+        invDet;
+
+        // Calculate the determinant
+        if (!d) { return NULL; }
+        invDet = 1 / d;
+
+    dest[0] = (a11 * b11 - a12 * b10 + a13 * b09) * invDet;
+    dest[1] = (-a01 * b11 + a02 * b10 - a03 * b09) * invDet;
+    dest[2] = (a31 * b05 - a32 * b04 + a33 * b03) * invDet;
+    dest[3] = (-a21 * b05 + a22 * b04 - a23 * b03) * invDet;
+    dest[4] = (-a10 * b11 + a12 * b08 - a13 * b07) * invDet;
+    dest[5] = (a00 * b11 - a02 * b08 + a03 * b07) * invDet;
+    dest[6] = (-a30 * b05 + a32 * b02 - a33 * b01) * invDet;
+    dest[7] = (a20 * b05 - a22 * b02 + a23 * b01) * invDet;
+    dest[8] = (a10 * b10 - a11 * b08 + a13 * b06) * invDet;
+    dest[9] = (-a00 * b10 + a01 * b08 - a03 * b06) * invDet;
+    dest[10] = (a30 * b04 - a31 * b02 + a33 * b00) * invDet;
+    dest[11] = (-a20 * b04 + a21 * b02 - a23 * b00) * invDet;
+    dest[12] = (-a10 * b09 + a11 * b07 - a12 * b06) * invDet;
+    dest[13] = (a00 * b09 - a01 * b07 + a02 * b06) * invDet;
+    dest[14] = (-a30 * b03 + a31 * b01 - a32 * b00) * invDet;
+    dest[15] = (a20 * b03 - a21 * b01 + a22 * b00) * invDet;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_inverse_noalias(mat4_t GL_MATRIX_RESTRICT mat, mat4_t GL_MATRIX_RESTRICT dest) {
+    numeric_t b00, b01, b02, b03, b04, b05, b06, b07, b08, b09, b10, b11, d;
+
+    assert(GL_MATRIX_DISJOINT(mat, 16, dest, 16));
+
+    b00 = mat[0] * mat[5] - mat[1] * mat[4];
+    b01 = mat[0] * mat[6] - mat[2] * mat[4];
+    b02 = mat[0] * mat[7] - mat[3] * mat[4];
+    b03 = mat[1] * mat[6] - mat[2] * mat[5];
+    b04 = mat[1] * mat[7] - mat[3] * mat[5];
+    b05 = mat[2] * mat[7] - mat[3] * mat[6];
+    b06 = mat[8] * mat[13] - mat[9] * mat[12];
+    b07 = mat[8] * mat[14] - mat[10] * mat[12];
+    b08 = mat[8] * mat[15] - mat[11] * mat[12];
+    b09 = mat[9] * mat[14] - mat[10] * mat[13];
+    b10 = mat[9] * mat[15] - mat[11] * mat[13];
+    b11 = mat[10] * mat[15] - mat[11] * mat[14];
+
+    d = b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
+    if (!d) { return NULL; }
+    d = 1 / d;
+
+    // dest can't overlap mat, so the stores don't force mat to be reloaded
+    dest[0] = (mat[5] * b11 - mat[6] * b10 + mat[7] * b09) * d;
+    dest[1] = (-mat[1] * b11 + mat[2] * b10 - mat[3] * b09) * d;
+    dest[2] = (mat[13] * b05 - mat[14] * b04 + mat[15] * b03) * d;
+    dest[3] = (-mat[9] * b05 + mat[10] * b04 - mat[11] * b03) * d;
+    dest[4] = (-mat[4] * b11 + mat[6] * b08 - mat[7] * b07) * d;
+    dest[5] = (mat[0] * b11 - mat[2] * b08 + mat[3] * b07) * d;
+    dest[6] = (-mat[12] * b05 + mat[14] * b02 - mat[15] * b01) * d;
+    dest[7] = (mat[8] * b05 - mat[10] * b02 + mat[11] * b01) * d;
+    dest[8] = (mat[4] * b10 - mat[5] * b08 + mat[7] * b06) * d;
+    dest[9] = (-mat[0] * b10 + mat[1] * b08 - mat[3] * b06) * d;
+    dest[10] = (mat[12] * b04 - mat[13] * b02 + mat[15] * b00) * d;
+    dest[11] = (-mat[8] * b04 + mat[9] * b02 - mat[11] * b00) * d;
+    dest[12] = (-mat[4] * b09 + mat[5] * b07 - mat[6] * b06) * d;
+    dest[13] = (mat[0] * b09 - mat[1] * b07 + mat[2] * b06) * d;
+    dest[14] = (-mat[12] * b03 + mat[13] * b01 - mat[14] * b00) * d;
+    dest[15] = (mat[8] * b03 - mat[9] * b01 + mat[10] * b00) * d;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_toRotationMat(mat4_t mat, mat4_t dest) {
+    if (!dest) { dest = mat4_create(NULL); }
+
+    dest[0] = mat[0];
+    dest[1] = mat[1];
+    dest[2] = mat[2];
+    dest[3] = mat[3];
+    dest[4] = mat[4];
+    dest[5] = mat[5];
+    dest[6] = mat[6];
+    dest[7] = mat[7];
+    dest[8] = mat[8];
+    dest[9] = mat[9];
+    dest[10] = mat[10];
+    dest[11] = mat[11];
+    dest[12] = 0;
+    dest[13] = 0;
+    dest[14] = 0;
+    dest[15] = 1;
+
+    return dest;
+}
+
+GL_MATRIX_API mat3_t mat4_toMat3(mat4_t mat, mat3_t dest) {
+    if (!dest) { dest = mat3_create(NULL); }
+
+    dest[0] = mat[0];
+    dest[1] = mat[1];
+    dest[2] = mat[2];
+    dest[3] = mat[4];
+    dest[4] = mat[5];
+    dest[5] = mat[6];
+    dest[6] = mat[8];
+    dest[7] = mat[9];
+    dest[8] = mat[10];
+
+    return dest;
+}
+
+GL_MATRIX_API mat3_t mat4_toInverseMat3(mat4_t mat, mat3_t dest) {
+    // Cache the matrix values (makes for huge speed increases!)
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10],
+
+        b01 = a22 * a11 - a12 * a21,
+        b11 = -a22 * a10 + a12 * a20,
+        b21 = a21 * a10 - a11 * a20,
+
+        d = a00 * b01 + a01 * b11 + a02 * b21,
+        id;
+
+    if (!d) { return NULL; }
+    id = 1 / d;
+
+    if (!dest) { dest = mat3_create(NULL); }
+
+    dest[0] = b01 * id;
+    dest[1] = (-a22 * a01 + a02 * a21) * id;
+    dest[2] = (a12 * a01 - a02 * a11) * id;
+    dest[3] = b11 * id;
+    dest[4] = (a22 * a00 - a02 * a20) * id;
+    dest[5] = (-a12 * a00 + a02 * a10) * id;
+    dest[6] = b21 * id;
+    dest[7] = (-a21 * a00 + a01 * a20) * id;
+    dest[8] = (a11 * a00 - a01 * a10) * id;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_multiply(mat4_t mat, mat4_t mat2, mat4_t dest) {
+    if (!dest) { dest = mat; }
+
+    // All of mat and mat2 is loaded before the first store, so dest may alias either operand
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+    // Two result columns per 256-bit register: each lane holds one column of mat2
+    __m256 a0 = _mm256_broadcast_ps((const __m128 *)(mat)),
+        a1 = _mm256_broadcast_ps((const __m128 *)(mat + 4)),
+        a2 = _mm256_broadcast_ps((const __m128 *)(mat + 8)),
+        a3 = _mm256_broadcast_ps((const __m128 *)(mat + 12)),
+        b01 = _mm256_loadu_ps(mat2),
+        b23 = _mm256_loadu_ps(mat2 + 8),
+        r01, r23;
+
+    r01 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, 0x00));
+    r23 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, 0x00));
+    r01 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b01, b01, 0x55), r01);
+    r23 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b23, b23, 0x55), r23);
+    r01 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b01, b01, 0xAA), r01);
+    r23 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b23, b23, 0xAA), r23);
+    r01 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b01, b01, 0xFF), r01);
+    r23 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b23, b23, 0xFF), r23);
+
+    _mm256_storeu_ps(dest, r01);
+    _mm256_storeu_ps(dest + 8, r23);
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    __m128 a0 = _mm_loadu_ps(mat), a1 = _mm_loadu_ps(mat + 4),
+        a2 = _mm_loadu_ps(mat + 8), a3 = _mm_loadu_ps(mat + 12),
+        b0 = _mm_loadu_ps(mat2), b1 = _mm_loadu_ps(mat2 + 4),
+        b2 = _mm_loadu_ps(mat2 + 8), b3 = _mm_loadu_ps(mat2 + 12);
+
+    // Summed in the same order as the scalar code so both give identical results
+#define MAT4_SSE_COLUMN(b) \
+    _mm_add_ps(_mm_add_ps(_mm_add_ps( \
+        _mm_mul_ps(a0, _mm_shuffle_ps(b, b, 0x00)), \
+        _mm_mul_ps(a1, _mm_shuffle_ps(b, b, 0x55))), \
+        _mm_mul_ps(a2, _mm_shuffle_ps(b, b, 0xAA))), \
+        _mm_mul_ps(a3, _mm_shuffle_ps(b, b, 0xFF)))
+
+    _mm_storeu_ps(dest, MAT4_SSE_COLUMN(b0));
+    _mm_storeu_ps(dest + 4, MAT4_SSE_COLUMN(b1));
+    _mm_storeu_ps(dest + 8, MAT4_SSE_COLUMN(b2));
+    _mm_storeu_ps(dest + 12, MAT4_SSE_COLUMN(b3));
+#undef MAT4_SSE_COLUMN
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t a0 = vld1q_f32(mat), a1 = vld1q_f32(mat + 4),
+        a2 = vld1q_f32(mat + 8), a3 = vld1q_f32(mat + 12),
+        b0 = vld1q_f32(mat2), b1 = vld1q_f32(mat2 + 4),
+        b2 = vld1q_f32(mat2 + 8), b3 = vld1q_f32(mat2 + 12);
+
+#define MAT4_NEON_COLUMN(b) \
+    vmlaq_lane_f32(vmlaq_lane_f32(vmlaq_lane_f32( \
+        vmulq_lane_f32(a0, vget_low_f32(b), 0), \
+        a1, vget_low_f32(b), 1), \
+        a2, vget_high_f32(b), 0), \
+        a3, vget_high_f32(b), 1)
+
+    vst1q_f32(dest, MAT4_NEON_COLUMN(b0));
+    vst1q_f32(dest + 4, MAT4_NEON_COLUMN(b1));
+    vst1q_f32(dest + 8, MAT4_NEON_COLUMN(b2));
+    vst1q_f32(dest + 12, MAT4_NEON_COLUMN(b3));
+#undef MAT4_NEON_COLUMN
+#else
+    // Cache the matrix values (makes for huge speed increases!)
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2], a03 = mat[3],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6], a13 = mat[7],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10], a23 = mat[11],
+        a30 = mat[12], a31 = mat[13], a32 = mat[14], a33 = mat[15],
+
+        b00 = mat2[0], b01 = mat2[1], b02 = mat2[2], b03 = mat2[3],
+        b10 = mat2[4], b11 = mat2[5], b12 = mat2[6], b13 = mat2[7],
+        b20 = mat2[8], b21 = mat2[9], b22 = mat2[10], b23 = mat2[11],
+        b30 = mat2[12], b31 = mat2[13], b32 = mat2[14], b33 = mat2[15];
+
+    dest[0] = b00 * a00 + b01 * a10 + b02 * a20 + b03 * a30;
+    dest[1] = b00 * a01 + b01 * a11 + b02 * a21 + b03 * a31;
+    dest[2] = b00 * a02 + b01 * a12 + b02 * a22 + b03 * a32;
+    dest[3] = b00 * a03 + b01 * a13 + b02 * a23 + b03 * a33;
+    dest[4] = b10 * a00 + b11 * a10 + b12 * a20 + b13 * a30;
+    dest[5] = b10 * a01 + b11 * a11 + b12 * a21 + b13 * a31;
+    dest[6] = b10 * a02 + b11 * a12 + b12 * a22 + b13 * a32;
+    dest[7] = b10 * a03 + b11 * a13 + b12 * a23 + b13 * a33;
+    dest[8] = b20 * a00 + b21 * a10 + b22 * a20 + b23 * a30;
+    dest[9] = b20 * a01 + b21 * a11 + b22 * a21 + b23 * a31;
+    dest[10] = b20 * a02 + b21 * a12 + b22 * a22 + b23 * a32;
+    dest[11] = b20 * a03 + b21 * a13 + b22 * a23 + b23 * a33;
+    dest[12] = b30 * a00 + b31 * a10 + b32 * a20 + b33 * a30;
+    dest[13] = b30 * a01 + b31 * a11 + b32 * a21 + b33 * a31;
+    dest[14] = b30 * a02 + b31 * a12 + b32 * a22 + b33 * a32;
+    dest[15] = b30 * a03 + b31 * a13 + b32 * a23 + b33 * a33;
+#endif
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_multiply_noalias(mat4_t GL_MATRIX_RESTRICT mat, mat4_t GL_MATRIX_RESTRICT mat2, mat4_t GL_MATRIX_RESTRICT dest) {
+    int i, j;
+
+    assert(GL_MATRIX_DISJOINT(mat, 16, dest, 16) && GL_MATRIX_DISJOINT(mat2, 16, dest, 16));
+
+    // Summed in the same order as mat4_multiply. With no aliasing to guard
+    // against, the compiler is free to vectorize this as it sees fit.
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 4; i++) {
+            dest[j * 4 + i] = mat2[j * 4] * mat[i] + mat2[j * 4 + 1] * mat[4 + i] +
+                mat2[j * 4 + 2] * mat[8 + i] + mat2[j * 4 + 3] * mat[12 + i];
+        }
+    }
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_multiplyAffine(mat4_t mat, mat4_t mat2, mat4_t dest) {
+    if (!dest) { dest = mat; }
+
+    // As in mat4_multiply, everything is loaded before the first store
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    // Only the translation column needs a3. The bottom row is set to exactly
+    // (0, 0, 0, 1) afterwards, as the scalar code writes it, whatever the w
+    // lanes of the inputs hold.
+    __m128 a0 = _mm_loadu_ps(mat), a1 = _mm_loadu_ps(mat + 4),
+        a2 = _mm_loadu_ps(mat + 8), a3 = _mm_loadu_ps(mat + 12),
+        xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)),
+        r0, r1, r2, r3;
+
+#define MAT4_AFFINE_COLUMN(j) \
+    _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(mat2[(j) * 4]), a0), \
+                          _mm_mul_ps(_mm_set1_ps(mat2[(j) * 4 + 1]), a1)), \
+               _mm_mul_ps(_mm_set1_ps(mat2[(j) * 4 + 2]), a2))
+    r0 = _mm_and_ps(MAT4_AFFINE_COLUMN(0), xyz);
+    r1 = _mm_and_ps(MAT4_AFFINE_COLUMN(1), xyz);
+    r2 = _mm_and_ps(MAT4_AFFINE_COLUMN(2), xyz);
+    r3 = _mm_or_ps(_mm_and_ps(_mm_add_ps(MAT4_AFFINE_COLUMN(3), a3), xyz), _mm_set_ps(1, 0, 0, 0));
+#undef MAT4_AFFINE_COLUMN
+
+    _mm_storeu_ps(dest, r0);
+    _mm_storeu_ps(dest + 4, r1);
+    _mm_storeu_ps(dest + 8, r2);
+    _mm_storeu_ps(dest + 12, r3);
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t a0 = vld1q_f32(mat), a1 = vld1q_f32(mat + 4),
+        a2 = vld1q_f32(mat + 8), a3 = vld1q_f32(mat + 12),
+        b0 = vld1q_f32(mat2), b1 = vld1q_f32(mat2 + 4),
+        b2 = vld1q_f32(mat2 + 8), b3 = vld1q_f32(mat2 + 12);
+
+    // The lane forms on 64-bit halves, as the laneq forms are AArch64 only
+#define MAT4_NEON_AFFINE_COLUMN(b) \
+    vmlaq_lane_f32(vmlaq_lane_f32( \
+        vmulq_lane_f32(a0, vget_low_f32(b), 0), \
+        a1, vget_low_f32(b), 1), \
+        a2, vget_high_f32(b), 0)
+
+    // With an exact (0, 0, 0, 1) bottom row, as in the SSE and scalar code
+    vst1q_f32(dest, vsetq_lane_f32(0, MAT4_NEON_AFFINE_COLUMN(b0), 3));
+    vst1q_f32(dest + 4, vsetq_lane_f32(0, MAT4_NEON_AFFINE_COLUMN(b1), 3));
+    vst1q_f32(dest + 8, vsetq_lane_f32(0, MAT4_NEON_AFFINE_COLUMN(b2), 3));
+    vst1q_f32(dest + 12, vsetq_lane_f32(1, vaddq_f32(MAT4_NEON_AFFINE_COLUMN(b3), a3), 3));
+#undef MAT4_NEON_AFFINE_COLUMN
+#else
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10],
+        a30 = mat[12], a31 = mat[13], a32 = mat[14],
+
+        b00 = mat2[0], b01 = mat2[1], b02 = mat2[2],
+        b10 = mat2[4], b11 = mat2[5], b12 = mat2[6],
+        b20 = mat2[8], b21 = mat2[9], b22 = mat2[10],
+        b30 = mat2[12], b31 = mat2[13], b32 = mat2[14];
+
+    dest[0] = b00 * a00 + b01 * a10 + b02 * a20;
+    dest[1] = b00 * a01 + b01 * a11 + b02 * a21;
+    dest[2] = b00 * a02 + b01 * a12 + b02 * a22;
+    dest[3] = 0;
+    dest[4] = b10 * a00 + b11 * a10 + b12 * a20;
+    dest[5] = b10 * a01 + b11 * a11 + b12 * a21;
+    dest[6] = b10 * a02 + b11 * a12 + b12 * a22;
+    dest[7] = 0;
+    dest[8] = b20 * a00 + b21 * a10 + b22 * a20;
+    dest[9] = b20 * a01 + b21 * a11 + b22 * a21;
+    dest[10] = b20 * a02 + b21 * a12 + b22 * a22;
+    dest[11] = 0;
+    dest[12] = b30 * a00 + b31 * a10 + b32 * a20 + a30;
+    dest[13] = b30 * a01 + b31 * a11 + b32 * a21 + a31;
+    dest[14] = b30 * a02 + b31 * a12 + b32 * a22 + a32;
+    dest[15] = 1;
+#endif
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_inverseAffine(mat4_t mat, mat4_t dest) {
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10],
+        tx = mat[12], ty = mat[13], tz = mat[14],
+
+        b01 = a22 * a11 - a12 * a21,
+        b11 = -a22 * a10 + a12 * a20,
+        b21 = a21 * a10 - a11 * a20,
+
+        d = a00 * b01 + a01 * b11 + a02 * b21,
+        id, r00, r01, r02, r10, r11, r12, r20, r21, r22;
+
+    if (!d) { return NULL; }
+    if (!dest) { dest = mat; }
+    id = 1 / d;
+
+    // Inverse of the upper 3x3, as in mat4_toInverseMat3
+    r00 = b01 * id;
+    r01 = (-a22 * a01 + a02 * a21) * id;
+    r02 = (a12 * a01 - a02 * a11) * id;
+    r10 = b11 * id;
+    r11 = (a22 * a00 - a02 * a20) * id;
+    r12 = (-a12 * a00 + a02 * a10) * id;
+    r20 = b21 * id;
+    r21 = (-a21 * a00 + a01 * a20) * id;
+    r22 = (a11 * a00 - a01 * a10) * id;
+
+    dest[0] = r00; dest[1] = r01; dest[2] = r02; dest[3] = 0;
+    dest[4] = r10; dest[5] = r11; dest[6] = r12; dest[7] = 0;
+    dest[8] = r20; dest[9] = r21; dest[10] = r22; dest[11] = 0;
+    dest[12] = -(r00 * tx + r10 * ty + r20 * tz);
+    dest[13] = -(r01 * tx + r11 * ty + r21 * tz);
+    dest[14] = -(r02 * tx + r12 * ty + r22 * tz);
+    dest[15] = 1;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_inverseRigid(mat4_t mat, mat4_t dest) {
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10],
+        tx = mat[12], ty = mat[13], tz = mat[14];
+
+    if (!dest) { dest = mat; }
+
+    dest[0] = a00; dest[1] = a10; dest[2] = a20; dest[3] = 0;
+    dest[4] = a01; dest[5] = a11; dest[6] = a21; dest[7] = 0;
+    dest[8] = a02; dest[9] = a12; dest[10] = a22; dest[11] = 0;
+    dest[12] = -(a00 * tx + a01 * ty + a02 * tz);
+    dest[13] = -(a10 * tx + a11 * ty + a12 * tz);
+    dest[14] = -(a20 * tx + a21 * ty + a22 * tz);
+    dest[15] = 1;
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t mat4_multiplyVec3(mat4_t mat, vec3_t vec, vec3_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0], y = vec[1], z = vec[2];
+
+    dest[0] = mat[0] * x + mat[4] * y + mat[8] * z + mat[12];
+    dest[1] = mat[1] * x + mat[5] * y + mat[9] * z + mat[13];
+    dest[2] = mat[2] * x + mat[6] * y + mat[10] * z + mat[14];
+
+    return dest;
+}
+
+GL_MATRIX_API vec4_t mat4_multiplyVec4(mat4_t mat, vec4_t vec, vec4_t dest) {
+    if (!dest) { dest = vec; }
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(mat), _mm_set1_ps(vec[0]));
+    r = _mm_fmadd_ps(_mm_loadu_ps(mat + 4), _mm_set1_ps(vec[1]), r);
+    r = _mm_fmadd_ps(_mm_loadu_ps(mat + 8), _mm_set1_ps(vec[2]), r);
+    r = _mm_fmadd_ps(_mm_loadu_ps(mat + 12), _mm_set1_ps(vec[3]), r);
+    _mm_storeu_ps(dest, r);
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    __m128 v = _mm_loadu_ps(vec),
+        r = _mm_mul_ps(_mm_loadu_ps(mat), _mm_shuffle_ps(v, v, 0x00));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(mat + 4), _mm_shuffle_ps(v, v, 0x55)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(mat + 8), _mm_shuffle_ps(v, v, 0xAA)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(mat + 12), _mm_shuffle_ps(v, v, 0xFF)));
+    _mm_storeu_ps(dest, r);
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t v = vld1q_f32(vec),
+        r = vmulq_lane_f32(vld1q_f32(mat), vget_low_f32(v), 0);
+    r = vmlaq_lane_f32(r, vld1q_f32(mat + 4), vget_low_f32(v), 1);
+    r = vmlaq_lane_f32(r, vld1q_f32(mat + 8), vget_high_f32(v), 0);
+    r = vmlaq_lane_f32(r, vld1q_f32(mat + 12), vget_high_f32(v), 1);
+    vst1q_f32(dest, r);
+#else
+    numeric_t x = vec[0], y = vec[1], z = vec[2], w = vec[3];
+
+    dest[0] = mat[0] * x + mat[4] * y + mat[8] * z + mat[12] * w;
+    dest[1] = mat[1] * x + mat[5] * y + mat[9] * z + mat[13] * w;
+    dest[2] = mat[2] * x + mat[6] * y + mat[10] * z + mat[14] * w;
+    dest[3] = mat[3] * x + mat[7] * y + mat[11] * z + mat[15] * w;
+#endif
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t mat4_multiplyVec3_array(mat4_t mat, vec3_t vec, size_t count, size_t stride, vec3_t dest) {
+    const char *src = (const char *)vec;
+    char *dst;
+    size_t i;
+
+    if (!dest) { dest = vec; }
+    if (!stride) { stride = 3 * sizeof(numeric_t); }
+    dst = (char *)dest;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    __m128 m0 = _mm_loadu_ps(mat), m1 = _mm_loadu_ps(mat + 4),
+        m2 = _mm_loadu_ps(mat + 8), m3 = _mm_loadu_ps(mat + 12);
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        const numeric_t *v = (const numeric_t *)src;
+        numeric_t *d = (numeric_t *)dst;
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+        __m128 r = _mm_fmadd_ps(m0, _mm_set1_ps(v[0]), m3);
+        r = _mm_fmadd_ps(m1, _mm_set1_ps(v[1]), r);
+        r = _mm_fmadd_ps(m2, _mm_set1_ps(v[2]), r);
+#else
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(m0, _mm_set1_ps(v[0])),
+            _mm_mul_ps(m1, _mm_set1_ps(v[1]))),
+            _mm_mul_ps(m2, _mm_set1_ps(v[2]))), m3);
+#endif
+        // Store only x, y and z so we never write past the end of the vector
+        _mm_storel_pi((__m64 *)d, r);
+        _mm_store_ss(d + 2, _mm_movehl_ps(r, r));
+    }
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t m0 = vld1q_f32(mat), m1 = vld1q_f32(mat + 4),
+        m2 = vld1q_f32(mat + 8), m3 = vld1q_f32(mat + 12);
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        const numeric_t *v = (const numeric_t *)src;
+        numeric_t *d = (numeric_t *)dst;
+        float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(m3, m0, v[0]), m1, v[1]), m2, v[2]);
+        vst1_f32(d, vget_low_f32(r));
+        vst1q_lane_f32(d + 2, r, 2);
+    }
+#else
+    // Keep the matrix in locals for the whole batch
+    numeric_t m00 = mat[0], m01 = mat[1], m02 = mat[2],
+        m10 = mat[4], m11 = mat[5], m12 = mat[6],
+        m20 = mat[8], m21 = mat[9], m22 = mat[10],
+        m30 = mat[12], m31 = mat[13], m32 = mat[14];
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        const numeric_t *v = (const numeric_t *)src;
+        numeric_t *d = (numeric_t *)dst;
+        numeric_t x = v[0], y = v[1], z = v[2];
+
+        d[0] = m00 * x + m10 * y + m20 * z + m30;
+        d[1] = m01 * x + m11 * y + m21 * z + m31;
+        d[2] = m02 * x + m12 * y + m22 * z + m32;
+    }
+#endif
+
+    return dest;
+}
+
+GL_MATRIX_API vec4_t mat4_multiplyVec4_array(mat4_t mat, vec4_t vec, size_t count, size_t stride, vec4_t dest) {
+    const char *src = (const char *)vec;
+    char *dst;
+    size_t i;
+
+    if (!dest) { dest = vec; }
+    if (!stride) { stride = 4 * sizeof(numeric_t); }
+    dst = (char *)dest;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    __m128 m0 = _mm_loadu_ps(mat), m1 = _mm_loadu_ps(mat + 4),
+        m2 = _mm_loadu_ps(mat + 8), m3 = _mm_loadu_ps(mat + 12);
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+#define MAT4_VEC4_PRODUCT(v) \
+    _mm_fmadd_ps(m3, _mm_shuffle_ps(v, v, 0xFF), \
+    _mm_fmadd_ps(m2, _mm_shuffle_ps(v, v, 0xAA), \
+    _mm_fmadd_ps(m1, _mm_shuffle_ps(v, v, 0x55), \
+    _mm_mul_ps(m0, _mm_shuffle_ps(v, v, 0x00)))))
+#else
+#define MAT4_VEC4_PRODUCT(v) \
+    _mm_add_ps(_mm_add_ps(_mm_add_ps( \
+        _mm_mul_ps(m0, _mm_shuffle_ps(v, v, 0x00)), \
+        _mm_mul_ps(m1, _mm_shuffle_ps(v, v, 0x55))), \
+        _mm_mul_ps(m2, _mm_shuffle_ps(v, v, 0xAA))), \
+        _mm_mul_ps(m3, _mm_shuffle_ps(v, v, 0xFF)))
+#endif
+#define MAT4_VEC4_LOOP(load, store) \
+    for (i = 0; i < count; i++, src += stride, dst += stride) { \
+        __m128 v = load((const numeric_t *)src); \
+        store((numeric_t *)dst, MAT4_VEC4_PRODUCT(v)); \
+    }
+
+    // Checked once for the whole batch: if every vector is 16 byte aligned,
+    // aligned loads and stores are used throughout
+    if (((size_t)src | (size_t)dst | stride) % 16 == 0) {
+        MAT4_VEC4_LOOP(_mm_load_ps, _mm_store_ps)
+    } else {
+        MAT4_VEC4_LOOP(_mm_loadu_ps, _mm_storeu_ps)
+    }
+#undef MAT4_VEC4_LOOP
+#undef MAT4_VEC4_PRODUCT
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t m0 = vld1q_f32(mat), m1 = vld1q_f32(mat + 4),
+        m2 = vld1q_f32(mat + 8), m3 = vld1q_f32(mat + 12);
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        float32x4_t v = vld1q_f32((const numeric_t *)src),
+            r = vmulq_lane_f32(m0, vget_low_f32(v), 0);
+        r = vmlaq_lane_f32(r, m1, vget_low_f32(v), 1);
+        r = vmlaq_lane_f32(r, m2, vget_high_f32(v), 0);
+        r = vmlaq_lane_f32(r, m3, vget_high_f32(v), 1);
+        vst1q_f32((numeric_t *)dst, r);
+    }
+#else
+    numeric_t m00 = mat[0], m01 = mat[1], m02 = mat[2], m03 = mat[3],
+        m10 = mat[4], m11 = mat[5], m12 = mat[6], m13 = mat[7],
+        m20 = mat[8], m21 = mat[9], m22 = mat[10], m23 = mat[11],
+        m30 = mat[12], m31 = mat[13], m32 = mat[14], m33 = mat[15];
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        const numeric_t *v = (const numeric_t *)src;
+        numeric_t *d = (numeric_t *)dst;
+        numeric_t x = v[0], y = v[1], z = v[2], w = v[3];
+
+        d[0] = m00 * x + m10 * y + m20 * z + m30 * w;
+        d[1] = m01 * x + m11 * y + m21 * z + m31 * w;
+        d[2] = m02 * x + m12 * y + m22 * z + m32 * w;
+        d[3] = m03 * x + m13 * y + m23 * z + m33 * w;
+    }
+#endif
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_translate(mat4_t mat, vec3_t vec, mat4_t dest) {
+    numeric_t x = vec[0], y = vec[1], z = vec[2],
+        a00, a01, a02, a03,
+        a10, a11, a12, a13,
+        a20, a21, a22, a23;
+
+    if (!dest || mat == dest) {
+        mat[12] = mat[0] * x + mat[4] * y + mat[8] * z + mat[12];
+        mat[13] = mat[1] * x + mat[5] * y + mat[9] * z + mat[13];
+        mat[14] = mat[2] * x + mat[6] * y + mat[10] * z + mat[14];
+        mat[15] = mat[3] * x + mat[7] * y + mat[11] * z + mat[15];
+        return mat;
+    }
+
+    a00 = mat[0]; a01 = mat[1]; a02 = mat[2]; a03 = mat[3];
+    a10 = mat[4]; a11 = mat[5]; a12 = mat[6]; a13 = mat[7];
+    a20 = mat[8]; a21 = mat[9]; a22 = mat[10]; a23 = mat[11];
+
+    dest[0] = a00; dest[1] = a01; dest[2] = a02; dest[3] = a03;
+    dest[4] = a10; dest[5] = a11; dest[6] = a12; dest[7] = a13;
+    dest[8] = a20; dest[9] = a21; dest[10] = a22; dest[11] = a23;
+
+    dest[12] = a00 * x + a10 * y + a20 * z + mat[12];
+    dest[13] = a01 * x + a11 * y + a21 * z + mat[13];
+    dest[14] = a02 * x + a12 * y + a22 * z + mat[14];
+    dest[15] = a03 * x + a13 * y + a23 * z + mat[15];
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_scale(mat4_t mat, vec3_t vec, mat4_t dest) {
+    numeric_t x = vec[0], y = vec[1], z = vec[2];
+
+    if (!dest || mat == dest) {
+        mat[0] *= x;
+        mat[1] *= x;
+        mat[2] *= x;
+        mat[3] *= x;
+        mat[4] *= y;
+        mat[5] *= y;
+        mat[6] *= y;
+        mat[7] *= y;
+        mat[8] *= z;
+        mat[9] *= z;
+        mat[10] *= z;
+        mat[11] *= z;
+        return mat;
+    }
+
+    dest[0] = mat[0] * x;
+    dest[1] = mat[1] * x;
+    dest[2] = mat[2] * x;
+    dest[3] = mat[3] * x;
+    dest[4] = mat[4] * y;
+    dest[5] = mat[5] * y;
+    dest[6] = mat[6] * y;
+    dest[7] = mat[7] * y;
+    dest[8] = mat[8] * z;
+    dest[9] = mat[9] * z;
+    dest[10] = mat[10] * z;
+    dest[11] = mat[11] * z;
+    dest[12] = mat[12];
+    dest[13] = mat[13];
+    dest[14] = mat[14];
+    dest[15] = mat[15];
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_scale_scalar(mat4_t mat, numeric_t scalar, mat4_t dest) {
+    if (!dest || mat == dest) {
+        mat[0] *= scalar;
+        mat[1] *= scalar;
+        mat[2] *= scalar;
+        mat[3] *= scalar;
+        mat[4] *= scalar;
+        mat[5] *= scalar;
+        mat[6] *= scalar;
+        mat[7] *= scalar;
+        mat[8] *= scalar;
+        mat[9] *= scalar;
+        mat[10] *= scalar;
+        mat[11] *= scalar;
+        return mat;
+    }
+
+    dest[0] = mat[0] * scalar;
+    dest[1] = mat[1] * scalar;
+    dest[2] = mat[2] * scalar;
+    dest[3] = mat[3] * scalar;
+    dest[4] = mat[4] * scalar;
+    dest[5] = mat[5] * scalar;
+    dest[6] = mat[6] * scalar;
+    dest[7] = mat[7] * scalar;
+    dest[8] = mat[8] * scalar;
+    dest[9] = mat[9] * scalar;
+    dest[10] = mat[10] * scalar;
+    dest[11] = mat[11] * scalar;
+    dest[12] = mat[12];
+    dest[13] = mat[13];
+    dest[14] = mat[14];
+    dest[15] = mat[15];
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_rotate(mat4_t mat, numeric_t angle, vec3_t axis, mat4_t dest) {
+    numeric_t x = axis[0], y = axis[1], z = axis[2],
+        len = glm_sqrt(x * x + y * y + z * z),
+        s, c, t,
+        a00, a01, a02, a03,
+        a10, a11, a12, a13,
+        a20, a21, a22, a23,
+        b00, b01, b02,
+        b10, b11, b12,
+        b20, b21, b22;
+
+    if (!len) { return NULL; }
+    if (len != 1) {
+        len = 1 / len;
+        x *= len;
+        y *= len;
+        z *= len;
+    }
+
+    s = glm_sin(angle);
+    c = glm_cos(angle);
+    t = 1 - c;
+
+    a00 = mat[0]; a01 = mat[1]; a02 = mat[2]; a03 = mat[3];
+    a10 = mat[4]; a11 = mat[5]; a12 = mat[6]; a13 = mat[7];
+    a20 = mat[8]; a21 = mat[9]; a22 = mat[10]; a23 = mat[11];
+
+    // Construct the elements of the rotation matrix
+    b00 = x * x * t + c; b01 = y * x * t + z * s; b02 = z * x * t - y * s;
+    b10 = x * y * t - z * s; b11 = y * y * t + c; b12 = z * y * t + x * s;
+    b20 = x * z * t + y * s; b21 = y * z * t - x * s; b22 = z * z * t + c;
+
+    if (!dest) {
+        dest = mat;
+    } else if (mat != dest) { // If the source and destination differ, copy the unchanged last row
+        dest[12] = mat[12];
+        dest[13] = mat[13];
+        dest[14] = mat[14];
+        dest[15] = mat[15];
+    }
+
+    // Perform rotation-specific matrix multiplication
+    dest[0] = a00 * b00 + a10 * b01 + a20 * b02;
+    dest[1] = a01 * b00 + a11 * b01 + a21 * b02;
+    dest[2] = a02 * b00 + a12 * b01 + a22 * b02;
+    dest[3] = a03 * b00 + a13 * b01 + a23 * b02;
+
+    dest[4] = a00 * b10 + a10 * b11 + a20 * b12;
+    dest[5] = a01 * b10 + a11 * b11 + a21 * b12;
+    dest[6] = a02 * b10 + a12 * b11 + a22 * b12;
+    dest[7] = a03 * b10 + a13 * b11 + a23 * b12;
+
+    dest[8] = a00 * b20 + a10 * b21 + a20 * b22;
+    dest[9] = a01 * b20 + a11 * b21 + a21 * b22;
+    dest[10] = a02 * b20 + a12 * b21 + a22 * b22;
+    dest[11] = a03 * b20 + a13 * b21 + a23 * b22;
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_rotateX(mat4_t mat, numeric_t angle, mat4_t dest) {
+    numeric_t s = glm_sin(angle),
+        c = glm_cos(angle),
+        a10 = mat[4],
+        a11 = mat[5],
+        a12 = mat[6],
+        a13 = mat[7],
+        a20 = mat[8],
+        a21 = mat[9],
+        a22 = mat[10],
+        a23 = mat[11];
+
+    if (!dest) {
+        dest = mat;
+    } else if (mat != dest) { // If the source and destination differ, copy the unchanged rows
+        dest[0] = mat[0];
+        dest[1] = mat[1];
+        dest[2] = mat[2];
+        dest[3] = mat[3];
+
+        dest[12] = mat[12];
+        dest[13] = mat[13];
+        dest[14] = mat[14];
+        dest[15] = mat[15];
+    }
+
+    // Perform axis-specific matrix multiplication
+    dest[4] = a10 * c + a20 * s;
+    dest[5] = a11 * c + a21 * s;
+    dest[6] = a12 * c + a22 * s;
+    dest[7] = a13 * c + a23 * s;
+
+    dest[8] = a10 * -s + a20 * c;
+    dest[9] = a11 * -s + a21 * c;
+    dest[10] = a12 * -s + a22 * c;
+    dest[11] = a13 * -s + a23 * c;
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_rotateY(mat4_t mat, numeric_t angle, mat4_t dest) {
+    numeric_t s = glm_sin(angle),
+        c = glm_cos(angle),
+        a00 = mat[0],
+        a01 = mat[1],
+        a02 = mat[2],
+        a03 = mat[3],
+        a20 = mat[8],
+        a21 = mat[9],
+        a22 = mat[10],
+        a23 = mat[11];
+
+    if (!dest) {
+        dest = mat;
+    } else if (mat != dest) { // If the source and destination differ, copy the unchanged rows
+        dest[4] = mat[4];
+        dest[5] = mat[5];
+        dest[6] = mat[6];
+        dest[7] = mat[7];
+
+        dest[12] = mat[12];
+        dest[13] = mat[13];
+        dest[14] = mat[14];
+        dest[15] = mat[15];
+    }
+
+    // Perform axis-specific matrix multiplication
+    dest[0] = a00 * c + a20 * -s;
+    dest[1] = a01 * c + a21 * -s;
+    dest[2] = a02 * c + a22 * -s;
+    dest[3] = a03 * c + a23 * -s;
+
+    dest[8] = a00 * s + a20 * c;
+    dest[9] = a01 * s + a21 * c;
+    dest[10] = a02 * s + a22 * c;
+    dest[11] = a03 * s + a23 * c;
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_rotateZ(mat4_t mat, numeric_t angle, mat4_t dest) {
+    numeric_t s = glm_sin(angle),
+        c = glm_cos(angle),
+        a00 = mat[0],
+        a01 = mat[1],
+        a02 = mat[2],
+        a03 = mat[3],
+        a10 = mat[4],
+        a11 = mat[5],
+        a12 = mat[6],
+        a13 = mat[7];
+
+    if (!dest) {
+        dest = mat;
+    } else if (mat != dest) { // If the source and destination differ, copy the unchanged last row
+        dest[8] = mat[8];
+        dest[9] = mat[9];
+        dest[10] = mat[10];
+        dest[11] = mat[11];
+
+        dest[12] = mat[12];
+        dest[13] = mat[13];
+        dest[14] = mat[14];
+        dest[15] = mat[15];
+    }
+
+    // Perform axis-specific matrix multiplication
+    dest[0] = a00 * c + a10 * s;
+    dest[1] = a01 * c + a11 * s;
+    dest[2] = a02 * c + a12 * s;
+    dest[3] = a03 * c + a13 * s;
+
+    dest[4] = a00 * -s + a10 * c;
+    dest[5] = a01 * -s + a11 * c;
+    dest[6] = a02 * -s + a12 * c;
+    dest[7] = a03 * -s + a13 * c;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest) {
+    if (!dest) { dest = mat4_create(NULL); }
+    numeric_t rl = (right - left),
+        tb = (top - bottom),
+        fn = (far - near);
+    dest[0] = (near * 2) / rl;
+    dest[1] = 0;
+    dest[2] = 0;
+    dest[3] = 0;
+    dest[4] = 0;
+    dest[5] = (near * 2) / tb;
+    dest[6] = 0;
+    dest[7] = 0;
+    dest[8] = (right + left) / rl;
+    dest[9] = (top + bottom) / tb;
+    dest[10] = -(far + near) / fn;
+    dest[11] = -1;
+    dest[12] = 0;
+    dest[13] = 0;
+    dest[14] = -(far * near * 2) / fn;
+    dest[15] = 0;
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_perspective(numeric_t fovy, numeric_t aspect, numeric_t near, numeric_t far, mat4_t dest) {
+    numeric_t top = near * glm_tan(fovy * (numeric_t)(3.14159265358979323846 / 360.0)),
+        right = top * aspect;
+    return mat4_frustum(-right, right, -top, top, near, far, dest);
+}
+
+GL_MATRIX_API mat4_t mat4_ortho(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest) {
+    if (!dest) { dest = mat4_create(NULL); }
+    numeric_t rl = (right - left),
+        tb = (top - bottom),
+        fn = (far - near);
+    dest[0] = 2 / rl;
+    dest[1] = 0;
+    dest[2] = 0;
+    dest[3] = 0;
+    dest[4] = 0;
+    dest[5] = 2 / tb;
+    dest[6] = 0;
+    dest[7] = 0;
+    dest[8] = 0;
+    dest[9] = 0;
+    dest[10] = -2 / fn;
+    dest[11] = 0;
+    dest[12] = -(left + right) / rl;
+    dest[13] = -(top + bottom) / tb;
+    dest[14] = -(far + near) / fn;
+    dest[15] = 1;
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest) {
+    if (!dest) { dest = mat4_create(NULL); }
+
+    numeric_t x0, x1, x2, y0, y1, y2, z0, z1, z2, len,
+        eyex = eye[0],
+        eyey = eye[1],
+        eyez = eye[2],
+        upx = up[0],
+        upy = up[1],
+        upz = up[2],
+        centerx = center[0],
+        centery = center[1],
+        centerz = center[2];
+
+    if (eyex == centerx && eyey == centery && eyez == centerz) {
+        return mat4_identity(dest);
+    }
+
+    //vec3.direction(eye, center, z);
+    z0 = eyex - centerx;
+    z1 = eyey - centery;
+    z2 = eyez - centerz;
+
+    // normalize (no check needed for 0 because of early return)
+    len = 1 / glm_sqrt(z0 * z0 + z1 * z1 + z2 * z2);
+    z0 *= len;
+    z1 *= len;
+    z2 *= len;
+
+    //vec3.normalize(vec3.cross(up, z, x));
+    x0 = upy * z2 - upz * z1;
+    x1 = upz * z0 - upx * z2;
+    x2 = upx * z1 - upy * z0;
+    len = glm_sqrt(x0 * x0 + x1 * x1 + x2 * x2);
+    if (!len) {
+        x0 = 0;
+        x1 = 0;
+        x2 = 0;
+    } else {
+        len = 1 / len;
+        x0 *= len;
+        x1 *= len;
+        x2 *= len;
+    }
+
+    //vec3.normalize(vec3.cross(z, x, y));
+    y0 = z1 * x2 - z2 * x1;
+    y1 = z2 * x0 - z0 * x2;
+    y2 = z0 * x1 - z1 * x0;
+
+    len = glm_sqrt(y0 * y0 + y1 * y1 + y2 * y2);
+    if (!len) {
+        y0 = 0;
+        y1 = 0;
+        y2 = 0;
+    } else {
+        len = 1 / len;
+        y0 *= len;
+        y1 *= len;
+        y2 *= len;
+    }
+
+    dest[0] = x0;
+    dest[1] = y0;
+    dest[2] = z0;
+    dest[3] = 0;
+    dest[4] = x1;
+    dest[5] = y1;
+    dest[6] = z1;
+    dest[7] = 0;
+    dest[8] = x2;
+    dest[9] = y2;
+    dest[10] = z2;
+    dest[11] = 0;
+    dest[12] = -(x0 * eyex + x1 * eyey + x2 * eyez);
+    dest[13] = -(y0 * eyex + y1 * eyey + y2 * eyez);
+    dest[14] = -(z0 * eyex + z1 * eyey + z2 * eyez);
+    dest[15] = 1;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_fromRotationTranslation(quat_t quat, vec3_t vec, mat4_t dest) {
+    if (!dest) { dest = mat4_create(NULL); }
+
+    // Quaternion math
+    numeric_t x = quat[0], y = quat[1], z = quat[2], w = quat[3],
+        x2 = x + x,
+        y2 = y + y,
+        z2 = z + z,
+
+        xx = x * x2,
+        xy = x * y2,
+        xz = x * z2,
+        yy = y * y2,
+        yz = y * z2,
+        zz = z * z2,
+        wx = w * x2,
+        wy = w * y2,
+        wz = w * z2;
+
+    dest[0] = 1 - (yy + zz);
+    dest[1] = xy + wz;
+    dest[2] = xz - wy;
+    dest[3] = 0;
+    dest[4] = xy - wz;
+    dest[5] = 1 - (xx + zz);
+    dest[6] = yz + wx;
+    dest[7] = 0;
+    dest[8] = xz + wy;
+    dest[9] = yz - wx;
+    dest[10] = 1 - (xx + yy);
+    dest[11] = 0;
+    dest[12] = vec[0];
+    dest[13] = vec[1];
+    dest[14] = vec[2];
+    dest[15] = 1;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_alignVectors(vec3_t from, vec3_t to, mat4_t dest) {
+	// Adapted from https://gist.github.com/kevinmoran/b45980723e53edeb8a5a43c49f134724
+
+	numeric_t axis[3];
+	numeric_t cosA = vec3_dot(from, to);
+
+	// See https://www.j3d.org/matrix_faq/matrfaq_latest.html#Q39
+	// If the angles are nearly opposite (dot product == -1) then the cross product will be zero
+	// and won't be usable as an axis, so we rotate `from` with an arbitrary 90 degrees
+	if(glm_fabs(cosA + 1.f) < 0.001f) {
+		// http://www.gamedev.net/forums/topic/357797-rotate-a-vector-by-90-degrees/3348469/
+		numeric_t alt[3] = {from[0], -from[2], from[1]}; //x, -z, y
+		if(glm_fabs(vec3_dot(alt, to) + 1.f) < 0.001f) {
+			// Still to close, use a different axis
+			alt[0] = -from[2], alt[1] = from[1], alt[2] = from[0];
+		}
+		vec3_cross(alt, to, axis);
+	} else {
+		vec3_cross(from, to, axis);
+	}
+
+	const numeric_t k = 1.0f / (1.0f + cosA);
+
+	dest[ 0] = (axis[0] * axis[0] * k) + cosA;
+	dest[ 4] = (axis[1] * axis[0] * k) - axis[2];
+	dest[ 8] = (axis[2] * axis[0] * k) + axis[1];
+	dest[12] = 0;
+
+	dest[ 1] = (axis[0] * axis[1] * k) + axis[2];
+	dest[ 5] = (axis[1] * axis[1] * k) + cosA;
+	dest[ 9] = (axis[2] * axis[1] * k) - axis[0];
+	dest[13] = 0;
+
+	dest[ 2] = (axis[0] * axis[2] * k) - axis[1];
+	dest[ 6] = (axis[1] * axis[2] * k) + axis[0];
+	dest[10] = (axis[2] * axis[2] * k) + cosA;
+	dest[14] = 0;
+
+	dest[ 3] = 0;
+	dest[ 7] = 0;
+	dest[11] = 0;
+	dest[15] = 1;
+
+	return dest;
+}
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+GL_MATRIX_API quat_t quat_create(quat_t quat) {
+    quat_t dest = glm_alloc(4 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (quat) {
+        dest[0] = quat[0];
+        dest[1] = quat[1];
+        dest[2] = quat[2];
+        dest[3] = quat[3];
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_create_in(glm_arena *arena, quat_t quat) {
+    quat_t dest = glm_arena_alloc(arena, 4 * sizeof(numeric_t), 16);
+    if (!dest) { return NULL; }
+
+    if (quat) {
+        dest[0] = quat[0];
+        dest[1] = quat[1];
+        dest[2] = quat[2];
+        dest[3] = quat[3];
+    } else {
+        memset(dest, 0, 4 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_create_aligned(quat_t quat, size_t align) {
+    quat_t dest = glm_alloc_aligned(4 * sizeof(numeric_t), align);
+    if (!dest) { return NULL; }
+
+    if (quat) { memcpy(dest, quat, 4 * sizeof(numeric_t)); }
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_set(quat_t quat, quat_t dest) {
+    dest[0] = quat[0];
+    dest[1] = quat[1];
+    dest[2] = quat[2];
+    dest[3] = quat[3];
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_calculateW(quat_t quat, quat_t dest) {
+    numeric_t x = quat[0], y = quat[1], z = quat[2];
+
+    if (!dest || quat == dest) {
+        quat[3] = -glm_sqrt(glm_fabs(1 - x * x - y * y - z * z));
+        return quat;
+    }
+    dest[0] = x;
+    dest[1] = y;
+    dest[2] = z;
+    dest[3] = -glm_sqrt(glm_fabs(1 - x * x - y * y - z * z));
+    return dest;
+}
+
+GL_MATRIX_API numeric_t quat_dot(quat_t quat, quat_t quat2) {
+    return quat[0]*quat2[0] + quat[1]*quat2[1] + quat[2]*quat2[2] + quat[3]*quat2[3];
+}
+
+GL_MATRIX_API quat_t quat_inverse(quat_t quat, quat_t dest) {
+    numeric_t dot = quat_dot(quat,quat),
+        invDot = 1 / dot;
+    if(!dest || quat == dest) {
+        quat[0] *= -invDot;
+        quat[1] *= -invDot;
+        quat[2] *= -invDot;
+        quat[3] *= invDot;
+        return quat;
+    }
+    dest[0] = -quat[0]*invDot;
+    dest[1] = -quat[1]*invDot;
+    dest[2] = -quat[2]*invDot;
+    dest[3] = quat[3]*invDot;
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_conjugate(quat_t quat, quat_t dest) {
+    if (!dest || quat == dest) {
+        quat[0] *= -1;
+        quat[1] *= -1;
+        quat[2] *= -1;
+        return quat;
+    }
+    dest[0] = -quat[0];
+    dest[1] = -quat[1];
+    dest[2] = -quat[2];
+    dest[3] = quat[3];
+    return dest;
+}
+
+GL_MATRIX_API numeric_t quat_length(quat_t quat) {
+    numeric_t x = quat[0], y = quat[1], z = quat[2], w = quat[3];
+    return glm_sqrt(x * x + y * y + z * z + w * w);
+}
+
+GL_MATRIX_API quat_t quat_normalize(quat_t quat, quat_t dest) {
+    if (!dest) { dest = quat; }
+
+    numeric_t x = quat[0], y = quat[1], z = quat[2], w = quat[3],
+        len = glm_sqrt(x * x + y * y + z * z + w * w);
+    if (len == 0) {
+        dest[0] = 0;
+        dest[1] = 0;
+        dest[2] = 0;
+        dest[3] = 0;
+        return dest;
+    }
+    len = 1 / len;
+    dest[0] = x * len;
+    dest[1] = y * len;
+    dest[2] = z * len;
+    dest[3] = w * len;
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_multiply(quat_t quat, quat_t quat2, quat_t dest) {
+    if (!dest) { dest = quat; }
+
+    numeric_t qax = quat[0], qay = quat[1], qaz = quat[2], qaw = quat[3],
+        qbx = quat2[0], qby = quat2[1], qbz = quat2[2], qbw = quat2[3];
+
+    dest[0] = qax * qbw + qaw * qbx + qay * qbz - qaz * qby;
+    dest[1] = qay * qbw + qaw * qby + qaz * qbx - qax * qbz;
+    dest[2] = qaz * qbw + qaw * qbz + qax * qby - qay * qbx;
+    dest[3] = qaw * qbw - qax * qbx - qay * qby - qaz * qbz;
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_multiply_noalias(quat_t GL_MATRIX_RESTRICT quat, quat_t GL_MATRIX_RESTRICT quat2, quat_t GL_MATRIX_RESTRICT dest) {
+    assert(GL_MATRIX_DISJOINT(quat, 4, dest, 4) && GL_MATRIX_DISJOINT(quat2, 4, dest, 4));
+
+    dest[0] = quat[0] * quat2[3] + quat[3] * quat2[0] + quat[1] * quat2[2] - quat[2] * quat2[1];
+    dest[1] = quat[1] * quat2[3] + quat[3] * quat2[1] + quat[2] * quat2[0] - quat[0] * quat2[2];
+    dest[2] = quat[2] * quat2[3] + quat[3] * quat2[2] + quat[0] * quat2[1] - quat[1] * quat2[0];
+    dest[3] = quat[3] * quat2[3] - quat[0] * quat2[0] - quat[1] * quat2[1] - quat[2] * quat2[2];
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_multiplyVec3(quat_t quat, vec3_t vec, vec3_t dest) {
+    if (!dest) { dest = vec; }
+
+    numeric_t x = vec[0], y = vec[1], z = vec[2],
+        qx = quat[0], qy = quat[1], qz = quat[2], qw = quat[3],
+
+        // calculate quat * vec
+        ix = qw * x + qy * z - qz * y,
+        iy = qw * y + qz * x - qx * z,
+        iz = qw * z + qx * y - qy * x,
+        iw = -qx * x - qy * y - qz * z;
+
+    // calculate result * inverse quat
+    dest[0] = ix * qw + iw * -qx + iy * -qz - iz * -qy;
+    dest[1] = iy * qw + iw * -qy + iz * -qx - ix * -qz;
+    dest[2] = iz * qw + iw * -qz + ix * -qy - iy * -qx;
+
+    return dest;
+}
+
+GL_MATRIX_API mat3_t quat_toMat3(quat_t quat, mat3_t dest) {
+    if (!dest) { dest = mat3_create(NULL); }
+
+    numeric_t x = quat[0], y = quat[1], z = quat[2], w = quat[3],
+        x2 = x + x,
+        y2 = y + y,
+        z2 = z + z,
+
+        xx = x * x2,
+        xy = x * y2,
+        xz = x * z2,
+        yy = y * y2,
+        yz = y * z2,
+        zz = z * z2,
+        wx = w * x2,
+        wy = w * y2,
+        wz = w * z2;
+
+    dest[0] = 1 - (yy + zz);
+    dest[1] = xy + wz;
+    dest[2] = xz - wy;
+
+    dest[3] = xy - wz;
+    dest[4] = 1 - (xx + zz);
+    dest[5] = yz + wx;
+
+    dest[6] = xz + wy;
+    dest[7] = yz - wx;
+    dest[8] = 1 - (xx + yy);
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_toMat4(quat_t quat, mat4_t dest) {
+    if (!dest) { dest = mat4_create(NULL); }
+
+    numeric_t x = quat[0], y = quat[1], z = quat[2], w = quat[3],
+        x2 = x + x,
+        y2 = y + y,
+        z2 = z + z,
+
+        xx = x * x2,
+        xy = x * y2,
+        xz = x * z2,
+        yy = y * y2,
+        yz = y * z2,
+        zz = z * z2,
+        wx = w * x2,
+        wy = w * y2,
+        wz = w * z2;
+
+    dest[0] = 1 - (yy + zz);
+    dest[1] = xy + wz;
+    dest[2] = xz - wy;
+    dest[3] = 0;
+
+    dest[4] = xy - wz;
+    dest[5] = 1 - (xx + zz);
+    dest[6] = yz + wx;
+    dest[7] = 0;
+
+    dest[8] = xz + wy;
+    dest[9] = yz - wx;
+    dest[10] = 1 - (xx + yy);
+    dest[11] = 0;
+
+    dest[12] = 0;
+    dest[13] = 0;
+    dest[14] = 0;
+    dest[15] = 1;
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest) {
+    if (!dest) { dest = quat; }
+
+    numeric_t cosHalfTheta = quat[0] * quat2[0] + quat[1] * quat2[1] + quat[2] * quat2[2] + quat[3] * quat2[3],
+        halfTheta,
+        sinHalfTheta,
+        ratioA,
+        ratioB;
+
+    if (glm_fabs(cosHalfTheta) >= 1) {
+        if (dest != quat) {
+            dest[0] = quat[0];
+            dest[1] = quat[1];
+            dest[2] = quat[2];
+            dest[3] = quat[3];
+        }
+        return dest;
+    }
+
+    halfTheta = glm_acos(cosHalfTheta);
+    sinHalfTheta = glm_sqrt(1 - cosHalfTheta * cosHalfTheta);
+
+    if (glm_fabs(sinHalfTheta) < 0.001f) {
+        dest[0] = (quat[0] * 0.5f + quat2[0] * 0.5f);
+        dest[1] = (quat[1] * 0.5f + quat2[1] * 0.5f);
+        dest[2] = (quat[2] * 0.5f + quat2[2] * 0.5f);
+        dest[3] = (quat[3] * 0.5f + quat2[3] * 0.5f);
+        return dest;
+    }
+
+    ratioA = glm_sin((1 - slerp) * halfTheta) / sinHalfTheta;
+    ratioB = glm_sin(slerp * halfTheta) / sinHalfTheta;
+
+    dest[0] = (quat[0] * ratioA + quat2[0] * ratioB);
+    dest[1] = (quat[1] * ratioA + quat2[1] * ratioB);
+    dest[2] = (quat[2] * ratioA + quat2[2] * ratioB);
+    dest[3] = (quat[3] * ratioA + quat2[3] * ratioB);
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_slerpFast(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest) {
+    numeric_t ax = quat[0], ay = quat[1], az = quat[2], aw = quat[3],
+        bx = quat2[0], by = quat2[1], bz = quat2[2], bw = quat2[3],
+        d = ax * bx + ay * by + az * bz + aw * bw,
+        ad = glm_fabs(d),
+
+        // Polynomial fit that corrects nlerp's uneven angular speed; see
+        // "Approximating slerp" by Arseny Kapoulkine
+        A = 1.0904f + ad * (-3.2452f + ad * (3.55645f - ad * 1.43519f)),
+        B = 0.848013f + ad * (-1.06021f + ad * 0.215638f),
+        h = slerp - 0.5f,
+        k = A * h * h + B,
+        t = slerp + slerp * h * (slerp - 1) * k,
+
+        // Interpolate towards -quat2 when that is the shorter way round
+        ratioA = 1 - t,
+        ratioB = d < 0 ? -t : t,
+        x = ax * ratioA + bx * ratioB,
+        y = ay * ratioA + by * ratioB,
+        z = az * ratioA + bz * ratioB,
+        w = aw * ratioA + bw * ratioB,
+        il = 1 / glm_sqrt(x * x + y * y + z * z + w * w);
+
+    if (!dest) { dest = quat; }
+
+    dest[0] = x * il;
+    dest[1] = y * il;
+    dest[2] = z * il;
+    dest[3] = w * il;
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_multiply_array(quat_t quat, quat_t quat2, size_t count, quat_t dest) {
+    size_t i;
+
+    if (!dest) { dest = quat; }
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    // Same products and summation order as quat_multiply, one quaternion per
+    // register: the w lane's minus signs are folded into the shuffled operands
+    const __m128 wsign = _mm_castsi128_ps(_mm_set_epi32((int)0x80000000, 0, 0, 0));
+
+#define QUAT_MULTIPLY_LOOP(load, store) \
+    for (i = 0; i < count; i++) { \
+        __m128 a = load(quat + i * 4), b = load(quat2 + i * 4), \
+            r = _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3))); \
+        \
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_xor_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 3, 3, 3)), wsign), \
+                                     _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 2, 1, 0)))); \
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_xor_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 2, 1)), wsign), \
+                                     _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 0, 2)))); \
+        r = _mm_sub_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 0, 2)), \
+                                     _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 0, 2, 1)))); \
+        store(dest + i * 4, r); \
+    }
+
+    // The quaternions are packed, so the arrays' alignment decides for all of them
+    if (((size_t)quat | (size_t)quat2 | (size_t)dest) % 16 == 0) {
+        QUAT_MULTIPLY_LOOP(_mm_load_ps, _mm_store_ps)
+    } else {
+        QUAT_MULTIPLY_LOOP(_mm_loadu_ps, _mm_storeu_ps)
+    }
+#undef QUAT_MULTIPLY_LOOP
+#else
+    for (i = 0; i < count; i++) {
+        const numeric_t *qa = quat + i * 4, *qb = quat2 + i * 4;
+        numeric_t qax = qa[0], qay = qa[1], qaz = qa[2], qaw = qa[3],
+            qbx = qb[0], qby = qb[1], qbz = qb[2], qbw = qb[3];
+        numeric_t *d = dest + i * 4;
+
+        d[0] = qax * qbw + qaw * qbx + qay * qbz - qaz * qby;
+        d[1] = qay * qbw + qaw * qby + qaz * qbx - qax * qbz;
+        d[2] = qaz * qbw + qaw * qbz + qax * qby - qay * qbx;
+        d[3] = qaw * qbw - qax * qbx - qay * qby - qaz * qbz;
+    }
+#endif
+
+    return dest;
+}
+
+// Number of slerp weights computed per pass of quat_slerp_array
+#define QUAT_SLERP_BLOCK 64
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+// pi as a float and the rest of it, so that pi - x keeps its precision
+#define QUAT_PI_HIGH 3.14159274f
+#define QUAT_PI_LOW (-8.74227766e-8f)
+
+static __m128 quat_select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// acos of four numbers in [-1, 1], from the asin polynomial of Cephes'
+// asinf: acos(x) = pi/2 - asin(x) for |x| <= 0.5, and
+// 2 * asin(sqrt((1 - x) / 2)) above
+static __m128 quat_acos4(__m128 x) {
+    const __m128 half = _mm_set1_ps(0.5f), sign = _mm_set1_ps(-0.0f);
+    __m128 a = _mm_andnot_ps(sign, x), big = _mm_cmpgt_ps(a, half),
+        z = quat_select4(big, _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1), a), half), _mm_mul_ps(a, a)),
+        r = quat_select4(big, _mm_sqrt_ps(z), a),
+        p = _mm_set1_ps(4.2163199048e-2f), result;
+
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(2.4181311049e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(4.5470025998e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(7.4953002686e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.6666752422e-1f));
+    p = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), r), r);
+
+    // acos(|x|), then acos(x) = pi - acos(|x|) for negative x
+    result = quat_select4(big, _mm_add_ps(p, p),
+                          _mm_add_ps(_mm_sub_ps(_mm_set1_ps(QUAT_PI_HIGH * 0.5f), p), _mm_set1_ps(QUAT_PI_LOW * 0.5f)));
+    return quat_select4(_mm_cmplt_ps(x, _mm_setzero_ps()),
+                        _mm_add_ps(_mm_sub_ps(_mm_set1_ps(QUAT_PI_HIGH), result), _mm_set1_ps(QUAT_PI_LOW)), result);
+}
+
+// sin of four numbers in [0, pi], folded onto [0, pi/2] and evaluated with
+// the Taylor series up to x^11, which is within 6e-8 there
+static __m128 quat_sin4(__m128 x) {
+    __m128 y = quat_select4(_mm_cmpgt_ps(x, _mm_set1_ps(QUAT_PI_HIGH * 0.5f)),
+                            _mm_add_ps(_mm_sub_ps(_mm_set1_ps(QUAT_PI_HIGH), x), _mm_set1_ps(QUAT_PI_LOW)), x),
+        z = _mm_mul_ps(y, y),
+        p = _mm_set1_ps(-2.50521084e-8f);
+
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(2.75573192e-6f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-1.98412698e-4f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(8.33333333e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-1.66666667e-1f));
+    return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), y), y);
+}
+#endif
+
+GL_MATRIX_API quat_t quat_slerp_array(quat_t quat, quat_t quat2, numeric_t slerp, size_t count, quat_t dest) {
+    numeric_t ratioA[QUAT_SLERP_BLOCK], ratioB[QUAT_SLERP_BLOCK];
+    size_t base = 0, i, n;
+
+    if (!dest) { dest = quat; }
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    // Four elements at a time, with the weights computed by polynomials and
+    // quat_slerp's special cases selected by masks instead of branches
+    for (; base + 4 <= count; base += 4) {
+        const numeric_t *qa = quat + base * 4, *qb = quat2 + base * 4;
+        __m128 a0 = _mm_loadu_ps(qa), a1 = _mm_loadu_ps(qa + 4), a2 = _mm_loadu_ps(qa + 8), a3 = _mm_loadu_ps(qa + 12),
+            b0 = _mm_loadu_ps(qb), b1 = _mm_loadu_ps(qb + 4), b2 = _mm_loadu_ps(qb + 8), b3 = _mm_loadu_ps(qb + 12),
+            ax = a0, ay = a1, az = a2, aw = a3, bx = b0, by = b1, bz = b2, bw = b3,
+            one = _mm_set1_ps(1), half = _mm_set1_ps(0.5f),
+            cosHalfTheta, halfTheta, sinHalfTheta, ra, rb, same, close;
+        numeric_t *d = dest + base * 4;
+
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+        // Same summation order as quat_slerp
+        cosHalfTheta = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                             _mm_mul_ps(az, bz)), _mm_mul_ps(aw, bw));
+        same = _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), cosHalfTheta), one);
+        cosHalfTheta = _mm_max_ps(_mm_min_ps(cosHalfTheta, one), _mm_set1_ps(-1));
+
+        halfTheta = quat_acos4(cosHalfTheta);
+        sinHalfTheta = _mm_sqrt_ps(_mm_sub_ps(one, _mm_mul_ps(cosHalfTheta, cosHalfTheta)));
+        close = _mm_cmplt_ps(sinHalfTheta, _mm_set1_ps(0.001f));
+
+        ra = _mm_div_ps(quat_sin4(_mm_mul_ps(_mm_set1_ps(1 - slerp), halfTheta)), sinHalfTheta);
+        rb = _mm_div_ps(quat_sin4(_mm_mul_ps(_mm_set1_ps(slerp), halfTheta)), sinHalfTheta);
+        ra = quat_select4(same, one, quat_select4(close, half, ra));
+        rb = quat_select4(same, _mm_setzero_ps(), quat_select4(close, half, rb));
+
+        _mm_storeu_ps(d, _mm_add_ps(_mm_mul_ps(a0, _mm_shuffle_ps(ra, ra, 0x00)), _mm_mul_ps(b0, _mm_shuffle_ps(rb, rb, 0x00))));
+        _mm_storeu_ps(d + 4, _mm_add_ps(_mm_mul_ps(a1, _mm_shuffle_ps(ra, ra, 0x55)), _mm_mul_ps(b1, _mm_shuffle_ps(rb, rb, 0x55))));
+        _mm_storeu_ps(d + 8, _mm_add_ps(_mm_mul_ps(a2, _mm_shuffle_ps(ra, ra, 0xAA)), _mm_mul_ps(b2, _mm_shuffle_ps(rb, rb, 0xAA))));
+        _mm_storeu_ps(d + 12, _mm_add_ps(_mm_mul_ps(a3, _mm_shuffle_ps(ra, ra, 0xFF)), _mm_mul_ps(b3, _mm_shuffle_ps(rb, rb, 0xFF))));
+    }
+#endif
+
+    for (; base < count; base += n) {
+        const numeric_t *qa = quat + base * 4, *qb = quat2 + base * 4;
+        numeric_t *d = dest + base * 4;
+
+        n = count - base < QUAT_SLERP_BLOCK ? count - base : QUAT_SLERP_BLOCK;
+
+        // The transcendental part of quat_slerp, with its special cases
+        // turned into weights so that the blend below has no branches
+        for (i = 0; i < n; i++) {
+            const numeric_t *a = qa + i * 4, *b = qb + i * 4;
+            numeric_t cosHalfTheta = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3],
+                halfTheta, sinHalfTheta;
+
+            if (glm_fabs(cosHalfTheta) >= 1) {
+                ratioA[i] = 1;
+                ratioB[i] = 0;
+                continue;
+            }
+
+            halfTheta = glm_acos(cosHalfTheta);
+            sinHalfTheta = glm_sqrt(1 - cosHalfTheta * cosHalfTheta);
+
+            if (glm_fabs(sinHalfTheta) < 0.001f) {
+                ratioA[i] = 0.5f;
+                ratioB[i] = 0.5f;
+                continue;
+            }
+
+            ratioA[i] = glm_sin((1 - slerp) * halfTheta) / sinHalfTheta;
+            ratioB[i] = glm_sin(slerp * halfTheta) / sinHalfTheta;
+        }
+
+        for (i = 0; i < n; i++) {
+            const numeric_t *a = qa + i * 4, *b = qb + i * 4;
+            numeric_t ra = ratioA[i], rb = ratioB[i];
+
+            d[i * 4] = a[0] * ra + b[0] * rb;
+            d[i * 4 + 1] = a[1] * ra + b[1] * rb;
+            d[i * 4 + 2] = a[2] * ra + b[2] * rb;
+            d[i * 4 + 3] = a[3] * ra + b[3] * rb;
+        }
+    }
+
+    return dest;
+}
+
+#undef QUAT_SLERP_BLOCK
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#undef QUAT_PI_LOW
+#undef QUAT_PI_HIGH
+#endif
+
+GL_MATRIX_API vec3_t quat_multiplyVec3_array(quat_t quat, vec3_t vec, size_t count, vec3_t dest) {
+    size_t i;
+
+    if (!dest) { dest = vec; }
+
+    // v' = v + w * t + cross(q, t) with t = 2 * cross(q, v) needs about half
+    // the operations of the q * v * q^-1 product used by quat_multiplyVec3
+    i = 0;
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    // Four elements at a time, transposed so that each register holds one
+    // component of four quaternions or vectors
+    for (; i + 4 <= count; i += 4) {
+        const numeric_t *q = quat + i * 4, *v = vec + i * 3;
+        __m128 qx = _mm_loadu_ps(q), qy = _mm_loadu_ps(q + 4),
+            qz = _mm_loadu_ps(q + 8), qw = _mm_loadu_ps(q + 12),
+            x = _mm_set_ps(v[9], v[6], v[3], v[0]),
+            y = _mm_set_ps(v[10], v[7], v[4], v[1]),
+            z = _mm_set_ps(v[11], v[8], v[5], v[2]),
+            tx, ty, tz, rx, ry, rz;
+        numeric_t out[3][4];
+        int j;
+
+        _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+        tx = _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y));
+        ty = _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z));
+        tz = _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x));
+        tx = _mm_add_ps(tx, tx);
+        ty = _mm_add_ps(ty, ty);
+        tz = _mm_add_ps(tz, tz);
+
+        rx = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+        ry = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+        rz = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+
+        _mm_storeu_ps(out[0], rx);
+        _mm_storeu_ps(out[1], ry);
+        _mm_storeu_ps(out[2], rz);
+        for (j = 0; j < 4; j++) {
+            dest[(i + j) * 3] = out[0][j];
+            dest[(i + j) * 3 + 1] = out[1][j];
+            dest[(i + j) * 3 + 2] = out[2][j];
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        const numeric_t *q = quat + i * 4, *v = vec + i * 3;
+        numeric_t x = v[0], y = v[1], z = v[2],
+            qx = q[0], qy = q[1], qz = q[2], qw = q[3],
+
+            tx = 2 * (qy * z - qz * y),
+            ty = 2 * (qz * x - qx * z),
+            tz = 2 * (qx * y - qy * x);
+        numeric_t *d = dest + i * 3;
+
+        d[0] = x + qw * tx + (qy * tz - qz * ty);
+        d[1] = y + qw * ty + (qz * tx - qx * tz);
+        d[2] = z + qw * tz + (qx * ty - qy * tx);
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_rotate(quat_t q, vec3_t p, quat_t dest) {
+
+    if(!dest) {
+        dest = q;
+    }
+    numeric_t t[4] = {p[0], p[1], p[2], 0}, r[4];
+
+    quat_multiply(q, t, r);
+    quat_multiply(r, quat_conjugate(q, t), dest);
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_axisFromAngle(vec3_t axis, numeric_t angle, quat_t dest) {
+	/*
+	ref: http://www.euclideanspace.com/maths/geometry/rotations/conversions/angleToQuaternion/index.htm
+	 */
+	numeric_t a[3];
+	vec3_normalize(axis, a);
+	dest[3] = glm_cos(angle/2);
+	dest[0] = a[0] * glm_sin(angle/2);
+	dest[1] = a[1] * glm_sin(angle/2);
+	dest[2] = a[2] * glm_sin(angle/2);
+	return dest;
+}
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+GL_MATRIX_API dquat_t dquat_create(dquat_t dquat) {
+    dquat_t dest = glm_alloc(8 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (dquat) {
+        memcpy(dest, dquat, 8 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_create_in(glm_arena *arena, dquat_t dquat) {
+    dquat_t dest = glm_arena_alloc(arena, 8 * sizeof(numeric_t), 32);
+    if (!dest) { return NULL; }
+
+    if (dquat) {
+        memcpy(dest, dquat, 8 * sizeof(numeric_t));
+    } else {
+        memset(dest, 0, 8 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_set(dquat_t dquat, dquat_t dest) {
+    dest[0] = dquat[0];
+    dest[1] = dquat[1];
+    dest[2] = dquat[2];
+    dest[3] = dquat[3];
+    dest[4] = dquat[4];
+    dest[5] = dquat[5];
+    dest[6] = dquat[6];
+    dest[7] = dquat[7];
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_identity(dquat_t dest) {
+    if (!dest) { dest = dquat_create(NULL); }
+    dest[0] = 0;
+    dest[1] = 0;
+    dest[2] = 0;
+    dest[3] = 1;
+    dest[4] = 0;
+    dest[5] = 0;
+    dest[6] = 0;
+    dest[7] = 0;
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_fromRotationTranslation(quat_t quat, vec3_t vec, dquat_t dest) {
+    numeric_t qx = quat[0], qy = quat[1], qz = quat[2], qw = quat[3],
+        tx = vec[0] * 0.5f, ty = vec[1] * 0.5f, tz = vec[2] * 0.5f;
+
+    if (!dest) { dest = dquat_create(NULL); }
+
+    dest[0] = qx;
+    dest[1] = qy;
+    dest[2] = qz;
+    dest[3] = qw;
+
+    // dual = (t / 2) * real, with t as a quaternion with w = 0
+    dest[4] = tx * qw + ty * qz - tz * qy;
+    dest[5] = ty * qw + tz * qx - tx * qz;
+    dest[6] = tz * qw + tx * qy - ty * qx;
+    dest[7] = -tx * qx - ty * qy - tz * qz;
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t dquat_getTranslation(dquat_t dquat, vec3_t dest) {
+    numeric_t rx = dquat[0], ry = dquat[1], rz = dquat[2], rw = dquat[3],
+        dx = dquat[4], dy = dquat[5], dz = dquat[6], dw = dquat[7];
+
+    if (!dest) { dest = vec3_create(NULL); }
+
+    // t = 2 * dual * conjugate(real)
+    dest[0] = 2 * (rw * dx - dw * rx + ry * dz - rz * dy);
+    dest[1] = 2 * (rw * dy - dw * ry + rz * dx - rx * dz);
+    dest[2] = 2 * (rw * dz - dw * rz + rx * dy - ry * dx);
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_multiply(dquat_t dquat, dquat_t dquat2, dquat_t dest) {
+    if (!dest) { dest = dquat; }
+
+    numeric_t ax = dquat[0], ay = dquat[1], az = dquat[2], aw = dquat[3],
+        adx = dquat[4], ady = dquat[5], adz = dquat[6], adw = dquat[7],
+        bx = dquat2[0], by = dquat2[1], bz = dquat2[2], bw = dquat2[3],
+        bdx = dquat2[4], bdy = dquat2[5], bdz = dquat2[6], bdw = dquat2[7];
+
+    // real = a.real * b.real
+    dest[0] = ax * bw + aw * bx + ay * bz - az * by;
+    dest[1] = ay * bw + aw * by + az * bx - ax * bz;
+    dest[2] = az * bw + aw * bz + ax * by - ay * bx;
+    dest[3] = aw * bw - ax * bx - ay * by - az * bz;
+
+    // dual = a.real * b.dual + a.dual * b.real
+    dest[4] = ax * bdw + aw * bdx + ay * bdz - az * bdy + adx * bw + adw * bx + ady * bz - adz * by;
+    dest[5] = ay * bdw + aw * bdy + az * bdx - ax * bdz + ady * bw + adw * by + adz * bx - adx * bz;
+    dest[6] = az * bdw + aw * bdz + ax * bdy - ay * bdx + adz * bw + adw * bz + adx * by - ady * bx;
+    dest[7] = aw * bdw - ax * bdx - ay * bdy - az * bdz + adw * bw - adx * bx - ady * by - adz * bz;
+
+    return dest;
+}
+
+GL_MATRIX_API dquat_t dquat_normalize(dquat_t dquat, dquat_t dest) {
+    if (!dest) { dest = dquat; }
+
+    numeric_t len = glm_sqrt(dquat[0] * dquat[0] + dquat[1] * dquat[1] +
+                             dquat[2] * dquat[2] + dquat[3] * dquat[3]);
+
+    if (!len) {
+        dest[0] = 0;
+        dest[1] = 0;
+        dest[2] = 0;
+        dest[3] = 0;
+        dest[4] = 0;
+        dest[5] = 0;
+        dest[6] = 0;
+        dest[7] = 0;
+        return dest;
+    }
+
+    len = 1 / len;
+    dest[0] = dquat[0] * len;
+    dest[1] = dquat[1] * len;
+    dest[2] = dquat[2] * len;
+    dest[3] = dquat[3] * len;
+    dest[4] = dquat[4] * len;
+    dest[5] = dquat[5] * len;
+    dest[6] = dquat[6] * len;
+    dest[7] = dquat[7] * len;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t dquat_toMat4(dquat_t dquat, mat4_t dest) {
+    numeric_t t[3];
+
+    dquat_getTranslation(dquat, t);
+    dest = quat_toMat4(dquat, dest);
+    dest[12] = t[0];
+    dest[13] = t[1];
+    dest[14] = t[2];
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t dquat_transformPoint(dquat_t dquat, vec3_t vec, vec3_t dest) {
+    numeric_t t[3];
+
+    if (!dest) { dest = vec; }
+
+    dquat_getTranslation(dquat, t);
+    quat_multiplyVec3(dquat, vec, dest);
+    dest[0] += t[0];
+    dest[1] += t[1];
+    dest[2] += t[2];
+
+    return dest;
+}
+#include <stdlib.h>
+#include <string.h>
+
+
+#ifdef GL_MATRIX_DOUBLE
+#define str_number glm_formatDouble
+#define str_parseNumber glm_parseDouble
+#else
+#define str_number glm_formatFloat
+#define str_parseNumber glm_parseFloat
+#endif
+
+// Writes "[a, b, ...]" at buffer + len, where size is the size of the whole
+// buffer, and returns the new length. Output that doesn't fit is dropped, but
+// still counted; the caller terminates the string.
+static size_t str_values(const numeric_t *values, size_t count, char *buffer, size_t size, size_t len) {
+    char number[GL_MATRIX_FORMAT_MAX];
+    size_t i, n, room;
+
+    if (len < size) { buffer[len] = '['; }
+    len++;
+
+    for (i = 0; i < count; i++) {
+        if (i) {
+            if (len + 2 <= size) { memcpy(buffer + len, ", ", 2); }
+            else if (len < size) { buffer[len] = ','; }
+            len += 2;
+        }
+
+        // Format straight into the buffer while there is room for the
+        // longest number, and through a copy near the end
+        room = len < size ? size - len : 0;
+        if (room >= GL_MATRIX_FORMAT_MAX) {
+            len += str_number(values[i], buffer + len);
+        } else {
+            n = str_number(values[i], number);
+            if (room) { memcpy(buffer + len, number, n < room ? n : room); }
+            len += n;
+        }
+    }
+
+    if (len < size) { buffer[len] = ']'; }
+    return len + 1;
+}
+
+static size_t str_terminate(char *buffer, size_t size, size_t len) {
+    if (size) { buffer[len < size ? len : size - 1] = '\0'; }
+    return len;
+}
+
+GL_MATRIX_API size_t vec2_str_n(vec2_t vec, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(vec, 2, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t vec3_str_n(vec3_t vec, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(vec, 3, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t vec4_str_n(vec4_t vec, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(vec, 4, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t mat3_str_n(mat3_t mat, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(mat, 9, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t mat4_str_n(mat4_t mat, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(mat, 16, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t quat_str_n(quat_t quat, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(quat, 4, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t dquat_str_n(dquat_t dquat, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(dquat, 8, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t mat4_str_array(mat4_t mat, size_t count, char *buffer, size_t size) {
+    size_t i, len = 0;
+
+    if (len < size) { buffer[len] = '['; }
+    len++;
+
+    for (i = 0; i < count; i++) {
+        if (i) {
+            if (len + 2 <= size) { memcpy(buffer + len, ", ", 2); }
+            else if (len < size) { buffer[len] = ','; }
+            len += 2;
+        }
+        len = str_values(mat + i * 16, 16, buffer, size, len);
+    }
+
+    if (len < size) { buffer[len] = ']'; }
+    return str_terminate(buffer, size, len + 1);
+}
+
+GL_MATRIX_API void vec2_str(vec2_t vec, char *buffer) {
+    vec2_str_n(vec, buffer, GL_MATRIX_STR_SIZE(2));
+}
+
+GL_MATRIX_API void vec3_str(vec3_t vec, char *buffer) {
+    vec3_str_n(vec, buffer, GL_MATRIX_STR_SIZE(3));
+}
+
+GL_MATRIX_API void vec4_str(vec4_t vec, char *buffer) {
+    vec4_str_n(vec, buffer, GL_MATRIX_STR_SIZE(4));
+}
+
+GL_MATRIX_API void mat3_str(mat3_t mat, char *buffer) {
+    mat3_str_n(mat, buffer, GL_MATRIX_STR_SIZE(9));
+}
+
+GL_MATRIX_API void mat4_str(mat4_t mat, char *buffer) {
+    mat4_str_n(mat, buffer, GL_MATRIX_STR_SIZE(16));
+}
+
+GL_MATRIX_API void quat_str(quat_t quat, char *buffer) {
+    quat_str_n(quat, buffer, GL_MATRIX_STR_SIZE(4));
+}
+
+GL_MATRIX_API void dquat_str(dquat_t dquat, char *buffer) {
+    dquat_str_n(dquat, buffer, GL_MATRIX_STR_SIZE(8));
+}
+
+static int str_isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+static int str_isSeparator(char c) {
+    return c == ' ' || c == ',' || c == '\n' || c == '[' || c == ']' || c == '\t' || c == '\r';
+}
+
+static const char *str_skipSpace(const char *p) {
+    while (str_isSpace(*p)) { p++; }
+    return p;
+}
+
+// Reads "[a, b, ...]" with count numbers, as written by str_values, with any
+// whitespace around the brackets, commas and numbers. Returns the end of the
+// list, or NULL if str doesn't start with one.
+static const char *str_parseValues(const char *str, size_t count, numeric_t *dest) {
+    const char *p = str_skipSpace(str);
+    size_t i;
+
+    if (*p != '[') { return NULL; }
+    p++;
+
+    for (i = 0; i < count; i++) {
+        p = str_skipSpace(p);
+        if (i) {
+            if (*p != ',') { return NULL; }
+            p = str_skipSpace(p + 1);
+        }
+        p = str_parseNumber(p, dest + i);
+        if (!p) { return NULL; }
+    }
+
+    p = str_skipSpace(p);
+    return *p == ']' ? p + 1 : NULL;
+}
+
+GL_MATRIX_API const char *vec2_parse(const char *str, vec2_t dest) {
+    return str_parseValues(str, 2, dest);
+}
+
+GL_MATRIX_API const char *vec3_parse(const char *str, vec3_t dest) {
+    return str_parseValues(str, 3, dest);
+}
+
+GL_MATRIX_API const char *vec4_parse(const char *str, vec4_t dest) {
+    return str_parseValues(str, 4, dest);
+}
+
+GL_MATRIX_API const char *mat3_parse(const char *str, mat3_t dest) {
+    return str_parseValues(str, 9, dest);
+}
+
+GL_MATRIX_API const char *mat4_parse(const char *str, mat4_t dest) {
+    return str_parseValues(str, 16, dest);
+}
+
+GL_MATRIX_API const char *quat_parse(const char *str, quat_t dest) {
+    return str_parseValues(str, 4, dest);
+}
+
+GL_MATRIX_API const char *dquat_parse(const char *str, dquat_t dest) {
+    return str_parseValues(str, 8, dest);
+}
+
+GL_MATRIX_API const char *mat4_parse_array(const char *str, size_t count, mat4_t dest) {
+    const char *p = str_skipSpace(str);
+    size_t i;
+
+    if (*p != '[') { return NULL; }
+    p++;
+
+    for (i = 0; i < count; i++) {
+        if (i) {
+            p = str_skipSpace(p);
+            if (*p != ',') { return NULL; }
+            p++;
+        }
+        p = str_parseValues(p, 16, dest + i * 16);
+        if (!p) { return NULL; }
+    }
+
+    p = str_skipSpace(p);
+    return *p == ']' ? p + 1 : NULL;
+}
+
+GL_MATRIX_API const char *numbers_parse(const char *str, size_t length, numeric_t *dest, size_t max, size_t *count) {
+    const char *p = str, *last = str + length;
+    size_t n = 0;
+
+    // Only read up to the last separator in the chunk. A number that starts
+    // before it also ends there at the latest, so the parser never reads
+    // past the chunk, and a number the chunk cuts off is left for the next.
+    while (last > str && !str_isSeparator(last[-1])) { last--; }
+
+    for (;;) {
+        while (p < last && str_isSeparator(*p)) { p++; }
+        if (p == last || n == max) { break; }
+
+        p = str_parseNumber(p, dest + n);
+        if (!p || !str_isSeparator(*p)) { return NULL; }
+        n++;
+    }
+
+    *count = n;
+    return p;
+}
+
+#undef str_parseNumber
+#undef str_number
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+// Number of vectors processed by one iteration of the stream kernels, and the
+// number every stream's component arrays are padded to
+#define SOA_LANES GL_MATRIX_SOA_LANES
+
+static size_t soa_padded(size_t count) {
+    return (count + SOA_LANES - 1) / SOA_LANES * SOA_LANES;
+}
+
+// Allocates `n` zeroed component arrays of `count` padded elements from one
+// block, each starting on a GL_MATRIX_SOA_ALIGNMENT boundary
+static void *soa_alloc(numeric_t **arrays, int n, size_t count) {
+    size_t stride = soa_padded(count) * sizeof(numeric_t);
+    unsigned char *block, *base;
+    int i;
+
+    stride = (stride + GL_MATRIX_SOA_ALIGNMENT - 1) / GL_MATRIX_SOA_ALIGNMENT * GL_MATRIX_SOA_ALIGNMENT;
+    block = glm_alloc(n * stride + GL_MATRIX_SOA_ALIGNMENT);
+    if (!block) { return NULL; }
+
+    base = block + (GL_MATRIX_SOA_ALIGNMENT - (size_t)block % GL_MATRIX_SOA_ALIGNMENT) % GL_MATRIX_SOA_ALIGNMENT;
+    for (i = 0; i < n; i++) {
+        arrays[i] = (numeric_t *)(base + i * stride);
+    }
+    return block;
+}
+
+static void soa_add(const numeric_t *a, const numeric_t *b, numeric_t *dest, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) { dest[i] = a[i] + b[i]; }
+}
+
+static void soa_subtract(const numeric_t *a, const numeric_t *b, numeric_t *dest, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) { dest[i] = a[i] - b[i]; }
+}
+
+static void soa_scale(const numeric_t *a, numeric_t val, numeric_t *dest, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) { dest[i] = a[i] * val; }
+}
+
+static void soa_lerp(const numeric_t *a, const numeric_t *b, numeric_t lerp, numeric_t *dest, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) { dest[i] = a[i] + lerp * (b[i] - a[i]); }
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_create(vec3_soa_t *soa, size_t count) {
+    numeric_t *arrays[3];
+
+    soa->block = soa_alloc(arrays, 3, count);
+    if (!soa->block) { return NULL; }
+
+    soa->x = arrays[0];
+    soa->y = arrays[1];
+    soa->z = arrays[2];
+    soa->count = count;
+    return soa;
+}
+
+GL_MATRIX_API void vec3_soa_free(vec3_soa_t *soa) {
+    glm_free(soa->block);
+    soa->block = NULL;
+    soa->x = soa->y = soa->z = NULL;
+    soa->count = 0;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_fromAoS(vec3_t vec, vec3_soa_t *dest) {
+    size_t i, n = dest->count;
+
+    for (i = 0; i < n; i++, vec += 3) {
+        dest->x[i] = vec[0];
+        dest->y[i] = vec[1];
+        dest->z[i] = vec[2];
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_soa_toAoS(vec3_soa_t *soa, vec3_t dest) {
+    size_t i, n = soa->count;
+    vec3_t d = dest;
+
+    for (i = 0; i < n; i++, d += 3) {
+        d[0] = soa->x[i];
+        d[1] = soa->y[i];
+        d[2] = soa->z[i];
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_add(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_add(soa->x, soa2->x, dest->x, n);
+    soa_add(soa->y, soa2->y, dest->y, n);
+    soa_add(soa->z, soa2->z, dest->z, n);
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_subtract(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_subtract(soa->x, soa2->x, dest->x, n);
+    soa_subtract(soa->y, soa2->y, dest->y, n);
+    soa_subtract(soa->z, soa2->z, dest->z, n);
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_scale(vec3_soa_t *soa, numeric_t val, vec3_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_scale(soa->x, val, dest->x, n);
+    soa_scale(soa->y, val, dest->y, n);
+    soa_scale(soa->z, val, dest->z, n);
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_lerp(vec3_soa_t *soa, vec3_soa_t *soa2, numeric_t lerp, vec3_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_lerp(soa->x, soa2->x, lerp, dest->x, n);
+    soa_lerp(soa->y, soa2->y, lerp, dest->y, n);
+    soa_lerp(soa->z, soa2->z, lerp, dest->z, n);
+    return dest;
+}
+
+// The kernels below read a whole block of lanes into locals before writing
+// anything, so dest may alias an operand and the compiler does not need
+// runtime overlap checks to vectorize the inner loops.
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_normalize(vec3_soa_t *soa, vec3_soa_t *dest) {
+    size_t i, j, n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t x[SOA_LANES], y[SOA_LANES], z[SOA_LANES], len[SOA_LANES];
+
+        for (j = 0; j < SOA_LANES; j++) { x[j] = soa->x[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { y[j] = soa->y[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { z[j] = soa->z[i + j]; }
+
+        for (j = 0; j < SOA_LANES; j++) {
+            len[j] = glm_sqrt(x[j] * x[j] + y[j] * y[j] + z[j] * z[j]);
+            len[j] = len[j] ? 1 / len[j] : 0;
+        }
+
+        for (j = 0; j < SOA_LANES; j++) { dest->x[i + j] = x[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->y[i + j] = y[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->z[i + j] = z[j] * len[j]; }
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_cross(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest) {
+    size_t i, j, n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t x[SOA_LANES], y[SOA_LANES], z[SOA_LANES], x2[SOA_LANES], y2[SOA_LANES], z2[SOA_LANES];
+
+        for (j = 0; j < SOA_LANES; j++) { x[j] = soa->x[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { y[j] = soa->y[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { z[j] = soa->z[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { x2[j] = soa2->x[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { y2[j] = soa2->y[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { z2[j] = soa2->z[i + j]; }
+
+        for (j = 0; j < SOA_LANES; j++) { dest->x[i + j] = y[j] * z2[j] - z[j] * y2[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->y[i + j] = z[j] * x2[j] - x[j] * z2[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->z[i + j] = x[j] * y2[j] - y[j] * x2[j]; }
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *vec3_soa_dot(vec3_soa_t *soa, vec3_soa_t *soa2, numeric_t *dest) {
+    size_t i, j, n = soa->count;
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t r[SOA_LANES];
+        size_t m = n - i < SOA_LANES ? n - i : SOA_LANES;
+
+        for (j = 0; j < SOA_LANES; j++) {
+            r[j] = soa->x[i + j] * soa2->x[i + j] + soa->y[i + j] * soa2->y[i + j] + soa->z[i + j] * soa2->z[i + j];
+        }
+        memcpy(dest + i, r, m * sizeof(numeric_t));
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *vec3_soa_length(vec3_soa_t *soa, numeric_t *dest) {
+    size_t i, j, n = soa->count;
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t r[SOA_LANES];
+        size_t m = n - i < SOA_LANES ? n - i : SOA_LANES;
+
+        for (j = 0; j < SOA_LANES; j++) {
+            numeric_t x = soa->x[i + j], y = soa->y[i + j], z = soa->z[i + j];
+            r[j] = glm_sqrt(x * x + y * y + z * z);
+        }
+        memcpy(dest + i, r, m * sizeof(numeric_t));
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_create(vec4_soa_t *soa, size_t count) {
+    numeric_t *arrays[4];
+
+    soa->block = soa_alloc(arrays, 4, count);
+    if (!soa->block) { return NULL; }
+
+    soa->x = arrays[0];
+    soa->y = arrays[1];
+    soa->z = arrays[2];
+    soa->w = arrays[3];
+    soa->count = count;
+    return soa;
+}
+
+GL_MATRIX_API void vec4_soa_free(vec4_soa_t *soa) {
+    glm_free(soa->block);
+    soa->block = NULL;
+    soa->x = soa->y = soa->z = soa->w = NULL;
+    soa->count = 0;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_fromAoS(vec4_t vec, vec4_soa_t *dest) {
+    size_t i, n = dest->count;
+
+    for (i = 0; i < n; i++, vec += 4) {
+        dest->x[i] = vec[0];
+        dest->y[i] = vec[1];
+        dest->z[i] = vec[2];
+        dest->w[i] = vec[3];
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_soa_toAoS(vec4_soa_t *soa, vec4_t dest) {
+    size_t i, n = soa->count;
+    vec4_t d = dest;
+
+    for (i = 0; i < n; i++, d += 4) {
+        d[0] = soa->x[i];
+        d[1] = soa->y[i];
+        d[2] = soa->z[i];
+        d[3] = soa->w[i];
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_add(vec4_soa_t *soa, vec4_soa_t *soa2, vec4_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_add(soa->x, soa2->x, dest->x, n);
+    soa_add(soa->y, soa2->y, dest->y, n);
+    soa_add(soa->z, soa2->z, dest->z, n);
+    soa_add(soa->w, soa2->w, dest->w, n);
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_subtract(vec4_soa_t *soa, vec4_soa_t *soa2, vec4_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_subtract(soa->x, soa2->x, dest->x, n);
+    soa_subtract(soa->y, soa2->y, dest->y, n);
+    soa_subtract(soa->z, soa2->z, dest->z, n);
+    soa_subtract(soa->w, soa2->w, dest->w, n);
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_scale(vec4_soa_t *soa, numeric_t val, vec4_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_scale(soa->x, val, dest->x, n);
+    soa_scale(soa->y, val, dest->y, n);
+    soa_scale(soa->z, val, dest->z, n);
+    soa_scale(soa->w, val, dest->w, n);
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_lerp(vec4_soa_t *soa, vec4_soa_t *soa2, numeric_t lerp, vec4_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_lerp(soa->x, soa2->x, lerp, dest->x, n);
+    soa_lerp(soa->y, soa2->y, lerp, dest->y, n);
+    soa_lerp(soa->z, soa2->z, lerp, dest->z, n);
+    soa_lerp(soa->w, soa2->w, lerp, dest->w, n);
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_normalize(vec4_soa_t *soa, vec4_soa_t *dest) {
+    size_t i, j, n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t x[SOA_LANES], y[SOA_LANES], z[SOA_LANES], w[SOA_LANES], len[SOA_LANES];
+
+        for (j = 0; j < SOA_LANES; j++) { x[j] = soa->x[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { y[j] = soa->y[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { z[j] = soa->z[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { w[j] = soa->w[i + j]; }
+
+        for (j = 0; j < SOA_LANES; j++) {
+            len[j] = glm_sqrt(x[j] * x[j] + y[j] * y[j] + z[j] * z[j] + w[j] * w[j]);
+            len[j] = len[j] ? 1 / len[j] : 0;
+        }
+
+        for (j = 0; j < SOA_LANES; j++) { dest->x[i + j] = x[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->y[i + j] = y[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->z[i + j] = z[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->w[i + j] = w[j] * len[j]; }
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *vec4_soa_dot(vec4_soa_t *soa, vec4_soa_t *soa2, numeric_t *dest) {
+    size_t i, j, n = soa->count;
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t r[SOA_LANES];
+        size_t m = n - i < SOA_LANES ? n - i : SOA_LANES;
+
+        for (j = 0; j < SOA_LANES; j++) {
+            r[j] = soa->x[i + j] * soa2->x[i + j] + soa->y[i + j] * soa2->y[i + j] +
+                soa->z[i + j] * soa2->z[i + j] + soa->w[i + j] * soa2->w[i + j];
+        }
+        memcpy(dest + i, r, m * sizeof(numeric_t));
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *vec4_soa_length(vec4_soa_t *soa, numeric_t *dest) {
+    size_t i, j, n = soa->count;
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t r[SOA_LANES];
+        size_t m = n - i < SOA_LANES ? n - i : SOA_LANES;
+
+        for (j = 0; j < SOA_LANES; j++) {
+            numeric_t x = soa->x[i + j], y = soa->y[i + j], z = soa->z[i + j], w = soa->w[i + j];
+            r[j] = glm_sqrt(x * x + y * y + z * z + w * w);
+        }
+        memcpy(dest + i, r, m * sizeof(numeric_t));
+    }
+    return dest;
+}
+
+#undef SOA_LANES
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+#include <immintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+// Objects tested per iteration; the SoA streams are padded to a multiple of
+// this, so there is no scalar tail
+#define FRUSTUM_LANES GL_MATRIX_SOA_LANES
+
+GL_MATRIX_API frustum_t frustum_fromMat4(mat4_t mat, frustum_t dest) {
+    int i;
+
+    if (!dest) { dest = glm_alloc(24 * sizeof(numeric_t)); }
+
+    // Gribb/Hartmann: each plane is the fourth row of the matrix plus or
+    // minus one of the others. mat is column-major, so row r is
+    // mat[r], mat[4 + r], mat[8 + r], mat[12 + r].
+    for (i = 0; i < 3; i++) {
+        numeric_t *lo = dest + i * 8, *hi = dest + i * 8 + 4;
+        lo[0] = mat[3] + mat[i];
+        lo[1] = mat[7] + mat[4 + i];
+        lo[2] = mat[11] + mat[8 + i];
+        lo[3] = mat[15] + mat[12 + i];
+        hi[0] = mat[3] - mat[i];
+        hi[1] = mat[7] - mat[4 + i];
+        hi[2] = mat[11] - mat[8 + i];
+        hi[3] = mat[15] - mat[12 + i];
+    }
+
+    for (i = 0; i < 6; i++) {
+        numeric_t *p = dest + i * 4,
+            len = glm_sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (len) {
+            len = 1 / len;
+            p[0] *= len;
+            p[1] *= len;
+            p[2] *= len;
+            p[3] *= len;
+        }
+    }
+
+    return dest;
+}
+
+// Number of set bits in each 4 bit value
+static const unsigned char frustum_bitCount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+// Writes the visibility bits of one block of FRUSTUM_LANES objects to the
+// mask, dropping the padding lanes past `valid`, and returns how many of the
+// objects are visible
+static size_t frustum_store(unsigned int bits, unsigned char *mask, size_t valid) {
+    size_t j, n = 0;
+
+    if (valid < FRUSTUM_LANES) { bits &= (1u << valid) - 1; }
+    for (j = 0; j < FRUSTUM_LANES && j < valid; j += 8) {
+        mask[j / 8] = (unsigned char)(bits >> j);
+    }
+    for (j = 0; j < FRUSTUM_LANES; j += 4) {
+        n += frustum_bitCount[(bits >> j) & 15];
+    }
+    return n;
+}
+
+GL_MATRIX_API size_t frustum_cullSpheres(frustum_t frustum, vec4_soa_t *spheres, unsigned char *mask) {
+    size_t i, j, count = spheres->count, visible = 0;
+    int p;
+
+    for (i = 0; i < count; i += FRUSTUM_LANES) {
+        unsigned int bits = 0;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+        // The streams are GL_MATRIX_SOA_ALIGNMENT aligned, so aligned loads are safe
+        for (j = 0; j < FRUSTUM_LANES; j += 4) {
+            __m128 x = _mm_load_ps(spheres->x + i + j), y = _mm_load_ps(spheres->y + i + j),
+                z = _mm_load_ps(spheres->z + i + j),
+                r = _mm_sub_ps(_mm_setzero_ps(), _mm_load_ps(spheres->w + i + j)),
+                in = _mm_cmpeq_ps(x, x);
+
+            // A sphere is culled if it lies entirely behind any plane
+            for (p = 0; p < 6; p++) {
+                const numeric_t *pl = frustum + p * 4;
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(pl[0]), x),
+                    _mm_mul_ps(_mm_set1_ps(pl[1]), y)),
+                    _mm_mul_ps(_mm_set1_ps(pl[2]), z)),
+                    _mm_set1_ps(pl[3]));
+                in = _mm_and_ps(in, _mm_cmpge_ps(d, r));
+            }
+            bits |= (unsigned int)_mm_movemask_ps(in) << j;
+        }
+#else
+        for (j = 0; j < FRUSTUM_LANES; j++) {
+            numeric_t x = spheres->x[i + j], y = spheres->y[i + j],
+                z = spheres->z[i + j], r = -spheres->w[i + j];
+            unsigned int in = 1;
+
+            // A sphere is culled if it lies entirely behind any plane
+            for (p = 0; p < 6; p++) {
+                const numeric_t *pl = frustum + p * 4;
+                in &= pl[0] * x + pl[1] * y + pl[2] * z + pl[3] >= r;
+            }
+            bits |= in << j;
+        }
+#endif
+
+        visible += frustum_store(bits, mask + i / 8, count - i);
+    }
+
+    return visible;
+}
+
+GL_MATRIX_API size_t frustum_cullBoxes(frustum_t frustum, vec3_soa_t *centers, vec3_soa_t *extents, unsigned char *mask) {
+    size_t i, j, count = centers->count, visible = 0;
+    numeric_t absPlanes[18];
+    int p;
+
+    // The box's extent along a plane normal acts as the radius
+    for (p = 0; p < 18; p++) {
+        absPlanes[p] = glm_fabs(frustum[p / 3 * 4 + p % 3]);
+    }
+
+    for (i = 0; i < count; i += FRUSTUM_LANES) {
+        unsigned int bits = 0;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+        for (j = 0; j < FRUSTUM_LANES; j += 4) {
+            __m128 x = _mm_load_ps(centers->x + i + j), y = _mm_load_ps(centers->y + i + j),
+                z = _mm_load_ps(centers->z + i + j),
+                ex = _mm_load_ps(extents->x + i + j), ey = _mm_load_ps(extents->y + i + j),
+                ez = _mm_load_ps(extents->z + i + j),
+                in = _mm_cmpeq_ps(x, x);
+
+            for (p = 0; p < 6; p++) {
+                const numeric_t *pl = frustum + p * 4, *ap = absPlanes + p * 3;
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(pl[0]), x),
+                    _mm_mul_ps(_mm_set1_ps(pl[1]), y)),
+                    _mm_mul_ps(_mm_set1_ps(pl[2]), z)),
+                    _mm_set1_ps(pl[3])),
+                    r = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(ap[0]), ex),
+                    _mm_mul_ps(_mm_set1_ps(ap[1]), ey)),
+                    _mm_mul_ps(_mm_set1_ps(ap[2]), ez));
+                in = _mm_and_ps(in, _mm_cmpge_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+            }
+            bits |= (unsigned int)_mm_movemask_ps(in) << j;
+        }
+#else
+        for (j = 0; j < FRUSTUM_LANES; j++) {
+            numeric_t x = centers->x[i + j], y = centers->y[i + j], z = centers->z[i + j],
+                ex = extents->x[i + j], ey = extents->y[i + j], ez = extents->z[i + j];
+            unsigned int in = 1;
+
+            for (p = 0; p < 6; p++) {
+                const numeric_t *pl = frustum + p * 4, *ap = absPlanes + p * 3;
+                in &= pl[0] * x + pl[1] * y + pl[2] * z + pl[3] + (ap[0] * ex + ap[1] * ey + ap[2] * ez) >= 0;
+            }
+            bits |= in << j;
+        }
+#endif
+
+        visible += frustum_store(bits, mask + i / 8, count - i);
+    }
+
+    return visible;
+}
+
+#undef FRUSTUM_LANES
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+#ifndef GL_MATRIX_NO_THREADS
+#include <pthread.h>
+#endif
+
+#define HIERARCHY_NONE GL_MATRIX_HIERARCHY_NONE
+
+// Nodes claimed at a time by a thread of hierarchy_updateParallel
+#define HIERARCHY_CHUNK 128
+
+GL_MATRIX_API hierarchy_t *hierarchy_create(hierarchy_t *h, size_t capacity) {
+    unsigned char *block;
+
+    // One block: the numeric_t arrays first, so every array stays aligned
+    // for its type, then the parents and the dirty flags
+    block = glm_alloc(capacity * (26 * sizeof(numeric_t) + sizeof(size_t) + 1));
+    if (!block) { return NULL; }
+
+    h->block = block;
+    h->worlds = (numeric_t *)block;
+    h->translations = h->worlds + capacity * 16;
+    h->rotations = h->translations + capacity * 3;
+    h->scales = h->rotations + capacity * 4;
+    h->parents = (size_t *)(h->scales + capacity * 3);
+    h->dirty = (unsigned char *)(h->parents + capacity);
+    h->count = 0;
+    h->capacity = capacity;
+    h->firstDirty = HIERARCHY_NONE;
+    h->order = h->levelStarts = NULL;
+    h->levels = h->ordered = 0;
+    h->levelBlock = NULL;
+    return h;
+}
+
+GL_MATRIX_API void hierarchy_free(hierarchy_t *h) {
+    glm_free(h->block);
+    h->block = NULL;
+    h->worlds = h->translations = h->rotations = h->scales = NULL;
+    h->parents = NULL;
+    h->dirty = NULL;
+    h->count = h->capacity = 0;
+    h->firstDirty = HIERARCHY_NONE;
+    glm_free(h->levelBlock);
+    h->order = h->levelStarts = NULL;
+    h->levels = h->ordered = 0;
+    h->levelBlock = NULL;
+}
+
+GL_MATRIX_API size_t hierarchy_add(hierarchy_t *h, size_t parent, vec3_t translation, quat_t rotation, vec3_t scale) {
+    size_t node = h->count;
+    numeric_t *t, *r, *s;
+
+    if (node == h->capacity || (parent != HIERARCHY_NONE && parent >= node)) { return HIERARCHY_NONE; }
+
+    t = h->translations + node * 3;
+    r = h->rotations + node * 4;
+    s = h->scales + node * 3;
+    if (translation) { vec3_set(translation, t); } else { vec3_zeroes(t); }
+    if (rotation) { quat_set(rotation, r); } else { r[0] = r[1] = r[2] = 0; r[3] = 1; }
+    if (scale) { vec3_set(scale, s); } else { vec3_ones(s); }
+
+    h->parents[node] = parent;
+    h->count++;
+    hierarchy_markDirty(h, node);
+    return node;
+}
+
+GL_MATRIX_API void hierarchy_setLocal(hierarchy_t *h, size_t node, vec3_t translation, quat_t rotation, vec3_t scale) {
+    if (translation) { vec3_set(translation, h->translations + node * 3); }
+    if (rotation) { quat_set(rotation, h->rotations + node * 4); }
+    if (scale) { vec3_set(scale, h->scales + node * 3); }
+    hierarchy_markDirty(h, node);
+}
+
+GL_MATRIX_API void hierarchy_markDirty(hierarchy_t *h, size_t node) {
+    h->dirty[node] = 1;
+    if (node < h->firstDirty) { h->firstDirty = node; }
+}
+
+// Recomputes node i's world matrix if it or its parent is dirty, and flags
+// it dirty in turn so the change propagates to its children. `local` is
+// scratch space for the local matrix. Returns 1 if the node was updated.
+static int hierarchy_updateNode(hierarchy_t *h, size_t i, numeric_t *local) {
+    size_t parent = h->parents[i];
+    numeric_t *world = h->worlds + i * 16;
+
+    if (!h->dirty[i]) {
+        if (parent == HIERARCHY_NONE || !h->dirty[parent]) { return 0; }
+        h->dirty[i] = 1;
+    }
+
+    if (parent == HIERARCHY_NONE) {
+        mat4_fromRotationTranslation(h->rotations + i * 4, h->translations + i * 3, world);
+        mat4_scale(world, h->scales + i * 3, NULL);
+    } else {
+        mat4_fromRotationTranslation(h->rotations + i * 4, h->translations + i * 3, local);
+        mat4_scale(local, h->scales + i * 3, NULL);
+        mat4_multiplyAffine(h->worlds + parent * 16, local, world);
+    }
+    return 1;
+}
+
+GL_MATRIX_API size_t hierarchy_update(hierarchy_t *h) {
+    size_t i, first = h->firstDirty, count = h->count, updated = 0;
+    numeric_t local[16];
+
+    if (first >= count) { return 0; }
+
+    // Parents come before their children, so by the time a node is reached
+    // its parent's flag says whether the parent's world matrix changed. The
+    // flags are left set during the pass so they propagate down the subtree.
+    for (i = first; i < count; i++) {
+        updated += hierarchy_updateNode(h, i, local);
+    }
+
+    memset(h->dirty + first, 0, count - first);
+    h->firstDirty = HIERARCHY_NONE;
+    return updated;
+}
+
+#ifndef GL_MATRIX_NO_THREADS
+// Sorts the nodes by depth into h->order, so that each level can be updated
+// in parallel once the level above it is done. Kept until nodes are added.
+static int hierarchy_sortLevels(hierarchy_t *h) {
+    size_t i, *depths, count = h->count, levels = 0;
+
+    if (h->ordered == count && h->levelBlock) { return 1; }
+
+    if (!h->levelBlock) {
+        // order, depths and levelStarts; there are at most capacity levels
+        h->levelBlock = glm_alloc((3 * h->capacity + 1) * sizeof(size_t));
+        if (!h->levelBlock) { return 0; }
+    }
+    h->order = h->levelBlock;
+    depths = h->order + h->capacity;
+    h->levelStarts = depths + h->capacity;
+
+    for (i = 0; i < count; i++) {
+        size_t parent = h->parents[i];
+        depths[i] = parent == HIERARCHY_NONE ? 0 : depths[parent] + 1;
+        if (depths[i] >= levels) { levels = depths[i] + 1; }
+    }
+
+    // Counting sort. Nodes keep their relative order within a level.
+    memset(h->levelStarts, 0, (levels + 1) * sizeof(size_t));
+    for (i = 0; i < count; i++) { h->levelStarts[depths[i] + 1]++; }
+    for (i = 0; i < levels; i++) { h->levelStarts[i + 1] += h->levelStarts[i]; }
+    for (i = 0; i < count; i++) { h->order[h->levelStarts[depths[i]]++] = i; }
+    for (i = levels; i > 0; i--) { h->levelStarts[i] = h->levelStarts[i - 1]; }
+    h->levelStarts[0] = 0;
+
+    h->levels = levels;
+    h->ordered = count;
+    return 1;
+}
+
+typedef struct {
+    hierarchy_t *h;
+    pthread_mutex_t lock;
+    pthread_cond_t levelDone;
+    unsigned int threads, waiting;
+    size_t level, next, updated;
+} hierarchy_pool;
+
+// Run by every thread: claims chunks of the current level until it is used
+// up, then waits for the other threads to finish it before the next level
+static void *hierarchy_work(void *arg) {
+    hierarchy_pool *pool = arg;
+    hierarchy_t *h = pool->h;
+    size_t level, begin, end, updated = 0;
+    numeric_t local[16];
+
+    for (level = 0; level < h->levels; level++) {
+        end = h->levelStarts[level + 1];
+        // The levels are contiguous in h->order and a claim never goes past
+        // the end of its level, so pool->next reaches exactly the start of
+        // the next level once this one is used up
+        for (;;) {
+            size_t stop;
+
+            pthread_mutex_lock(&pool->lock);
+            begin = pool->next;
+            stop = end - begin < HIERARCHY_CHUNK ? end : begin + HIERARCHY_CHUNK;
+            if (begin < end) { pool->next = stop; }
+            pthread_mutex_unlock(&pool->lock);
+            if (begin >= end) { break; }
+
+            for (; begin < stop; begin++) {
+                updated += hierarchy_updateNode(h, h->order[begin], local);
+            }
+        }
+
+        // Wait until every thread is done with this level, as the next one
+        // reads its world matrices and dirty flags
+
+        pthread_mutex_lock(&pool->lock);
+        if (++pool->waiting == pool->threads) {
+            pool->waiting = 0;
+            pool->level++;
+            pthread_cond_broadcast(&pool->levelDone);
+        } else {
+            while (pool->level == level) { pthread_cond_wait(&pool->levelDone, &pool->lock); }
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->updated += updated;
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+#endif
+
+GL_MATRIX_API size_t hierarchy_updateParallel(hierarchy_t *h, unsigned int threads) {
+#ifndef GL_MATRIX_NO_THREADS
+    hierarchy_pool pool;
+    pthread_t tids[GL_MATRIX_HIERARCHY_MAX_THREADS];
+    unsigned int t, started = 1;
+    size_t first = h->firstDirty, count = h->count;
+
+    if (threads > GL_MATRIX_HIERARCHY_MAX_THREADS) { threads = GL_MATRIX_HIERARCHY_MAX_THREADS; }
+    if (threads < 2 || first >= count || count - first < 2 * HIERARCHY_CHUNK || !hierarchy_sortLevels(h)) {
+        return hierarchy_update(h);
+    }
+
+    pool.h = h;
+    pool.waiting = 0;
+    pool.level = 0;
+    pool.next = 0;
+    pool.updated = 0;
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.levelDone, NULL);
+
+    // Hold the lock until every thread has been started, so the threads
+    // wait for the right number of others at the end of each level
+    pthread_mutex_lock(&pool.lock);
+    for (t = 1; t < threads; t++) {
+        if (pthread_create(&tids[started], NULL, hierarchy_work, &pool) == 0) { started++; }
+    }
+    pool.threads = started;
+    pthread_mutex_unlock(&pool.lock);
+
+    hierarchy_work(&pool);
+    for (t = 1; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+
+    pthread_cond_destroy(&pool.levelDone);
+    pthread_mutex_destroy(&pool.lock);
+
+    memset(h->dirty + first, 0, count - first);
+    h->firstDirty = HIERARCHY_NONE;
+    return pool.updated;
+#else
+    (void)threads;
+    return hierarchy_update(h);
+#endif
+}
+
+#undef HIERARCHY_CHUNK
+#undef HIERARCHY_NONE
+#include <stdlib.h>
+#include <math.h>
+
+
+#ifndef GL_MATRIX_NO_THREADS
+#include <pthread.h>
+#endif
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+#include <immintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#include <emmintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// Chunks handed to threads are multiples of this many vertices, so threads
+// never write to the same cache line of the outputs
+#define SKIN_CHUNK 64
+
+// Fewest vertices worth starting a thread for: a few thousand vertices take
+// about as long as creating and joining the thread
+#define SKIN_MIN_SHARE 4096
+
+typedef struct skin_job skin_job;
+
+struct skin_job {
+    void (*blend)(const skin_job *job);
+    numeric_t *bones;
+    unsigned short *indices;
+    numeric_t *weights;
+    vec3_t positions, normals;
+    vec3_t destPositions, destNormals;
+    size_t begin, end;
+};
+
+static void skin_blendRange(const skin_job *job) {
+    size_t i;
+
+    for (i = job->begin; i < job->end; i++) {
+        const unsigned short *bi = job->indices + i * 4;
+        const numeric_t *w = job->weights + i * 4, *p = job->positions + i * 3;
+        const numeric_t *b0 = job->bones + bi[0] * 16, *b1 = job->bones + bi[1] * 16,
+            *b2 = job->bones + bi[2] * 16, *b3 = job->bones + bi[3] * 16;
+        numeric_t *dp = job->destPositions + i * 3;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+        // Blend the four bone matrices column by column, then transform with
+        // the blended matrix as mat4_multiplyVec3 does
+        __m128 w0 = _mm_set1_ps(w[0]), w1 = _mm_set1_ps(w[1]),
+            w2 = _mm_set1_ps(w[2]), w3 = _mm_set1_ps(w[3]), c[4], r;
+        int j;
+
+        for (j = 0; j < 4; j++) {
+            c[j] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(w0, _mm_loadu_ps(b0 + j * 4)),
+                _mm_mul_ps(w1, _mm_loadu_ps(b1 + j * 4))),
+                _mm_mul_ps(w2, _mm_loadu_ps(b2 + j * 4))),
+                _mm_mul_ps(w3, _mm_loadu_ps(b3 + j * 4)));
+        }
+
+        r = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(c[0], _mm_set1_ps(p[0])),
+            _mm_mul_ps(c[1], _mm_set1_ps(p[1]))),
+            _mm_mul_ps(c[2], _mm_set1_ps(p[2]))), c[3]);
+        _mm_storel_pi((__m64 *)dp, r);
+        _mm_store_ss(dp + 2, _mm_movehl_ps(r, r));
+
+        if (job->normals) {
+            const numeric_t *n = job->normals + i * 3;
+            numeric_t *dn = job->destNormals + i * 3;
+
+            r = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(c[0], _mm_set1_ps(n[0])),
+                _mm_mul_ps(c[1], _mm_set1_ps(n[1]))),
+                _mm_mul_ps(c[2], _mm_set1_ps(n[2])));
+            _mm_storel_pi((__m64 *)dn, r);
+            _mm_store_ss(dn + 2, _mm_movehl_ps(r, r));
+        }
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+        float32x4_t c[4], r;
+        int j;
+
+        for (j = 0; j < 4; j++) {
+            c[j] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(
+                vld1q_f32(b0 + j * 4), w[0]),
+                vld1q_f32(b1 + j * 4), w[1]),
+                vld1q_f32(b2 + j * 4), w[2]),
+                vld1q_f32(b3 + j * 4), w[3]);
+        }
+
+        r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c[3], c[0], p[0]), c[1], p[1]), c[2], p[2]);
+        vst1_f32(dp, vget_low_f32(r));
+        vst1q_lane_f32(dp + 2, r, 2);
+
+        if (job->normals) {
+            const numeric_t *n = job->normals + i * 3;
+            numeric_t *dn = job->destNormals + i * 3;
+
+            r = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(c[0], n[0]), c[1], n[1]), c[2], n[2]);
+            vst1_f32(dn, vget_low_f32(r));
+            vst1q_lane_f32(dn + 2, r, 2);
+        }
+#else
+        numeric_t w0 = w[0], w1 = w[1], w2 = w[2], w3 = w[3], m[12],
+            x = p[0], y = p[1], z = p[2];
+        int j;
+
+        // Only the upper 3x4 of the bones is needed
+        for (j = 0; j < 4; j++) {
+            m[j * 3] = w0 * b0[j * 4] + w1 * b1[j * 4] + w2 * b2[j * 4] + w3 * b3[j * 4];
+            m[j * 3 + 1] = w0 * b0[j * 4 + 1] + w1 * b1[j * 4 + 1] + w2 * b2[j * 4 + 1] + w3 * b3[j * 4 + 1];
+            m[j * 3 + 2] = w0 * b0[j * 4 + 2] + w1 * b1[j * 4 + 2] + w2 * b2[j * 4 + 2] + w3 * b3[j * 4 + 2];
+        }
+
+        dp[0] = m[0] * x + m[3] * y + m[6] * z + m[9];
+        dp[1] = m[1] * x + m[4] * y + m[7] * z + m[10];
+        dp[2] = m[2] * x + m[5] * y + m[8] * z + m[11];
+
+        if (job->normals) {
+            const numeric_t *n = job->normals + i * 3;
+            numeric_t *dn = job->destNormals + i * 3;
+
+            x = n[0]; y = n[1]; z = n[2];
+            dn[0] = m[0] * x + m[3] * y + m[6] * z;
+            dn[1] = m[1] * x + m[4] * y + m[7] * z;
+            dn[2] = m[2] * x + m[5] * y + m[8] * z;
+        }
+#endif
+    }
+}
+
+static void skin_dualQuaternionRange(const skin_job *job) {
+    size_t i;
+
+    for (i = job->begin; i < job->end; i++) {
+        const unsigned short *bi = job->indices + i * 4;
+        const numeric_t *w = job->weights + i * 4, *p = job->positions + i * 3;
+        const numeric_t *q0 = job->bones + bi[0] * 8, *q1 = job->bones + bi[1] * 8,
+            *q2 = job->bones + bi[2] * 8, *q3 = job->bones + bi[3] * 8;
+        numeric_t *dp = job->destPositions + i * 3;
+
+        numeric_t b[8], il, rx, ry, rz, rw, tx, ty, tz, x, y, z, cx, cy, cz;
+
+        // q and -q are the same transform; flip each bone into the same
+        // hemisphere as the first before blending. The flips vary
+        // unpredictably from vertex to vertex, so avoid branching on them.
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+        {
+            __m128 r0 = _mm_loadu_ps(q0), r1 = _mm_loadu_ps(q1),
+                r2 = _mm_loadu_ps(q2), r3 = _mm_loadu_ps(q3),
+                signBit = _mm_set1_ps(-0.0f), d1, d2, d3, t, w1, w2, w3;
+
+            // Horizontal dot products; every lane ends up holding the sum
+#define SKIN_DOT4(a, b, out) \
+            t = _mm_mul_ps(a, b); \
+            t = _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 3, 0, 1))); \
+            out = _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 3, 2)))
+            SKIN_DOT4(r0, r1, d1);
+            SKIN_DOT4(r0, r2, d2);
+            SKIN_DOT4(r0, r3, d3);
+#undef SKIN_DOT4
+
+            // Copy the sign of each dot product onto its weight
+            w1 = _mm_xor_ps(_mm_set1_ps(w[1]), _mm_and_ps(d1, signBit));
+            w2 = _mm_xor_ps(_mm_set1_ps(w[2]), _mm_and_ps(d2, signBit));
+            w3 = _mm_xor_ps(_mm_set1_ps(w[3]), _mm_and_ps(d3, signBit));
+            t = _mm_set1_ps(w[0]);
+
+            _mm_storeu_ps(b, _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(t, r0), _mm_mul_ps(w1, r1)), _mm_mul_ps(w2, r2)), _mm_mul_ps(w3, r3)));
+            _mm_storeu_ps(b + 4, _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(t, _mm_loadu_ps(q0 + 4)), _mm_mul_ps(w1, _mm_loadu_ps(q1 + 4))),
+                _mm_mul_ps(w2, _mm_loadu_ps(q2 + 4))), _mm_mul_ps(w3, _mm_loadu_ps(q3 + 4))));
+        }
+#else
+        {
+            numeric_t w0 = w[0],
+                w1 = w[1] * (1 - 2 * (q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3] < 0)),
+                w2 = w[2] * (1 - 2 * (q0[0] * q2[0] + q0[1] * q2[1] + q0[2] * q2[2] + q0[3] * q2[3] < 0)),
+                w3 = w[3] * (1 - 2 * (q0[0] * q3[0] + q0[1] * q3[1] + q0[2] * q3[2] + q0[3] * q3[3] < 0));
+            int j;
+
+            for (j = 0; j < 8; j++) {
+                b[j] = w0 * q0[j] + w1 * q1[j] + w2 * q2[j] + w3 * q3[j];
+            }
+        }
+#endif
+
+        il = 1 / glm_sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3]);
+        rx = b[0] * il; ry = b[1] * il; rz = b[2] * il; rw = b[3] * il;
+
+        // Translation as in dquat_getTranslation, scaled by il once more for
+        // the dual part
+        il *= 2;
+        tx = (rw * b[4] - b[7] * rx + ry * b[6] - rz * b[5]) * il;
+        ty = (rw * b[5] - b[7] * ry + rz * b[4] - rx * b[6]) * il;
+        tz = (rw * b[6] - b[7] * rz + rx * b[5] - ry * b[4]) * il;
+
+        // Rotate with v + w * c + cross(r, c), c = 2 * cross(r, v)
+        x = p[0]; y = p[1]; z = p[2];
+        cx = 2 * (ry * z - rz * y);
+        cy = 2 * (rz * x - rx * z);
+        cz = 2 * (rx * y - ry * x);
+        dp[0] = x + rw * cx + (ry * cz - rz * cy) + tx;
+        dp[1] = y + rw * cy + (rz * cx - rx * cz) + ty;
+        dp[2] = z + rw * cz + (rx * cy - ry * cx) + tz;
+
+        if (job->normals) {
+            const numeric_t *n = job->normals + i * 3;
+            numeric_t *dn = job->destNormals + i * 3;
+
+            x = n[0]; y = n[1]; z = n[2];
+            cx = 2 * (ry * z - rz * y);
+            cy = 2 * (rz * x - rx * z);
+            cz = 2 * (rx * y - ry * x);
+            dn[0] = x + rw * cx + (ry * cz - rz * cy);
+            dn[1] = y + rw * cy + (rz * cx - rx * cz);
+            dn[2] = z + rw * cz + (rx * cy - ry * cx);
+        }
+    }
+}
+
+static void skin_initJob(skin_job *job, void (*blend)(const skin_job *job), numeric_t *bones,
+                         unsigned short *indices, numeric_t *weights, vec3_t positions, vec3_t normals,
+                         vec3_t destPositions, vec3_t destNormals) {
+    job->blend = blend;
+    job->bones = bones;
+    job->indices = indices;
+    job->weights = weights;
+    job->positions = positions;
+    job->normals = normals;
+    job->destPositions = destPositions ? destPositions : positions;
+    job->destNormals = destNormals ? destNormals : normals;
+}
+
+#ifndef GL_MATRIX_NO_THREADS
+static void *skin_thread(void *job) {
+    ((skin_job *)job)->blend(job);
+    return NULL;
+}
+#endif
+
+// Runs `job` over count vertices, split across up to `threads` threads
+static void skin_run(const skin_job *job, size_t count, unsigned int threads) {
+#ifndef GL_MATRIX_NO_THREADS
+    skin_job jobs[GL_MATRIX_SKIN_MAX_THREADS];
+    pthread_t tids[GL_MATRIX_SKIN_MAX_THREADS];
+    int started[GL_MATRIX_SKIN_MAX_THREADS];
+    size_t chunk, begin;
+    unsigned int t, n;
+
+    if (threads > GL_MATRIX_SKIN_MAX_THREADS) { threads = GL_MATRIX_SKIN_MAX_THREADS; }
+    // Give every thread at least SKIN_MIN_SHARE vertices; small meshes run on the calling thread
+    if (threads > count / SKIN_MIN_SHARE) { threads = (unsigned int)(count / SKIN_MIN_SHARE); }
+
+    // Round the per-thread share up to whole chunks; small meshes use fewer threads
+    chunk = threads > 1 ? (count + threads - 1) / threads : count;
+    chunk = (chunk + SKIN_CHUNK - 1) / SKIN_CHUNK * SKIN_CHUNK;
+    if (chunk < count) {
+        for (n = 0, begin = 0; begin < count; n++, begin += chunk) {
+            jobs[n] = *job;
+            jobs[n].begin = begin;
+            jobs[n].end = count - begin < chunk ? count : begin + chunk;
+        }
+
+        // The calling thread takes the first chunk. If a thread can't be
+        // started its chunk is done here too.
+        for (t = 1; t < n; t++) {
+            started[t] = pthread_create(&tids[t], NULL, skin_thread, &jobs[t]) == 0;
+        }
+        job->blend(&jobs[0]);
+        for (t = 1; t < n; t++) {
+            if (started[t]) {
+                pthread_join(tids[t], NULL);
+            } else {
+                job->blend(&jobs[t]);
+            }
+        }
+        return;
+    }
+#else
+    (void)threads;
+#endif
+    {
+        skin_job all = *job;
+        all.begin = 0;
+        all.end = count;
+        job->blend(&all);
+    }
+}
+
+GL_MATRIX_API void skin_linearBlend(mat4_t bones, unsigned short *indices, numeric_t *weights,
+                      vec3_t positions, vec3_t normals, size_t count,
+                      vec3_t destPositions, vec3_t destNormals) {
+    skin_job job;
+
+    skin_initJob(&job, skin_blendRange, bones, indices, weights, positions, normals, destPositions, destNormals);
+    skin_run(&job, count, 1);
+}
+
+GL_MATRIX_API void skin_linearBlendParallel(mat4_t bones, unsigned short *indices, numeric_t *weights,
+                              vec3_t positions, vec3_t normals, size_t count,
+                              vec3_t destPositions, vec3_t destNormals, unsigned int threads) {
+    skin_job job;
+
+    skin_initJob(&job, skin_blendRange, bones, indices, weights, positions, normals, destPositions, destNormals);
+    skin_run(&job, count, threads);
+}
+
+GL_MATRIX_API void skin_dualQuaternion(dquat_t bones, unsigned short *indices, numeric_t *weights,
+                         vec3_t positions, vec3_t normals, size_t count,
+                         vec3_t destPositions, vec3_t destNormals) {
+    skin_job job;
+
+    skin_initJob(&job, skin_dualQuaternionRange, bones, indices, weights, positions, normals, destPositions, destNormals);
+    skin_run(&job, count, 1);
+}
+
+GL_MATRIX_API void skin_dualQuaternionParallel(dquat_t bones, unsigned short *indices, numeric_t *weights,
+                                 vec3_t positions, vec3_t normals, size_t count,
+                                 vec3_t destPositions, vec3_t destNormals, unsigned int threads) {
+    skin_job job;
+
+    skin_initJob(&job, skin_dualQuaternionRange, bones, indices, weights, positions, normals, destPositions, destNormals);
+    skin_run(&job, count, threads);
+}
+
+#undef SKIN_CHUNK
+#undef SKIN_MIN_SHARE
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+
+#ifndef GL_MATRIX_NO_MMAP
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#endif
+
+/*
+ * File layout. The header is 64 bytes, so the data that follows it is cache
+ * line aligned in the mapping:
+ *
+ *  0  "GLMX"
+ *  4  version, 1
+ *  5  element type, GL_MATRIX_STREAM_*
+ *  6  bytes per number for GL_MATRIX_STREAM_RAW: 4 for float, 8 for double;
+ *     0 for the quantized encodings
+ *  7  encoding of the elements, GL_MATRIX_STREAM_RAW etc.
+ *  8  0x01020304 as a 32 bit integer in the writer's byte order
+ * 16  element count, 64 bit, in the writer's byte order
+ * 24  zeroes up to byte 64
+ */
+#define STREAM_HEADER 64
+#define STREAM_VERSION 1
+#define STREAM_ORDER 0x01020304UL
+#define STREAM_ORDER_SWAPPED 0x04030201UL
+
+// Elements encoded at a time by stream_writeEncoded
+#define STREAM_BATCH 256
+// Bytes of the largest encoded element, a GL_MATRIX_STREAM_MAT4 of halves
+#define STREAM_MAX_ENCODED 32
+
+static size_t stream_components(int type) {
+    static const unsigned char components[] = { 0, 2, 3, 4, 9, 16, 4, 8 };
+    return type > 0 && type <= GL_MATRIX_STREAM_DQUAT ? components[type] : 0;
+}
+
+// Bytes per element in a file, 0 if the encoding can't hold the type
+static size_t stream_elementSize(int type, int encoding, size_t precision) {
+    size_t components = stream_components(type);
+
+    if (!components) { return 0; }
+    switch (encoding) {
+    case GL_MATRIX_STREAM_RAW: return precision == 4 || precision == 8 ? components * precision : 0;
+    case GL_MATRIX_STREAM_HALF: return components * 2;
+    case GL_MATRIX_STREAM_QUAT32: return type == GL_MATRIX_STREAM_QUAT ? 4 : 0;
+    case GL_MATRIX_STREAM_QUAT48: return type == GL_MATRIX_STREAM_QUAT ? 6 : 0;
+    case GL_MATRIX_STREAM_TRS: return type == GL_MATRIX_STREAM_MAT4 ? 24 : 0;
+    default: return 0;
+    }
+}
+
+static uint16_t stream_swap16(uint16_t x) {
+    return (uint16_t)((x >> 8) | (x << 8));
+}
+
+static uint32_t stream_swap32(uint32_t x) {
+    return (x >> 24) | ((x >> 8) & 0xFF00) | ((x << 8) & 0xFF0000) | (x << 24);
+}
+
+static uint64_t stream_swap64(uint64_t x) {
+    return ((uint64_t)stream_swap32((uint32_t)x) << 32) | stream_swap32((uint32_t)(x >> 32));
+}
+
+// Maps the whole file copy-on-write, so the data can be modified in place
+// without touching the file
+static int stream_map(const char *path, unsigned char **base, size_t *size) {
+#if defined(GL_MATRIX_NO_MMAP)
+    FILE *file = fopen(path, "rb");
+    long length;
+
+    if (!file) { return 0; }
+    if (fseek(file, 0, SEEK_END) || (length = ftell(file)) <= 0 || fseek(file, 0, SEEK_SET)) {
+        fclose(file);
+        return 0;
+    }
+
+    // Aligned like a mapping, so the data after the header is cache line
+    // aligned here too
+    *size = (size_t)length;
+    *base = glm_alloc_aligned(*size, STREAM_HEADER);
+    if (*base && fread(*base, 1, *size, file) != *size) {
+        glm_free_aligned(*base);
+        *base = NULL;
+    }
+    fclose(file);
+    return *base != NULL;
+#elif defined(_WIN32)
+    HANDLE file, mapping;
+    LARGE_INTEGER length;
+
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) { return 0; }
+    if (!GetFileSizeEx(file, &length) || length.QuadPart <= 0 || (unsigned long long)length.QuadPart > (size_t)-1) {
+        CloseHandle(file);
+        return 0;
+    }
+
+    // The view keeps the mapping, and the mapping the file, open
+    mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) { return 0; }
+    *base = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+
+    *size = (size_t)length.QuadPart;
+    return *base != NULL;
+#else
+    struct stat st;
+    void *mapping;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) { return 0; }
+    if (fstat(fd, &st) || st.st_size <= 0 || (unsigned long long)st.st_size > (size_t)-1) {
+        close(fd);
+        return 0;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    mapping = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) { return 0; }
+
+    *base = mapping;
+    *size = (size_t)st.st_size;
+    return 1;
+#endif
+}
+
+static void stream_unmap(unsigned char *base, size_t size) {
+#if defined(GL_MATRIX_NO_MMAP)
+    (void)size;
+    glm_free_aligned(base);
+#elif defined(_WIN32)
+    (void)size;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, size);
+#endif
+}
+
+// Converts numbers written in another precision or byte order to numeric_t
+static void stream_convert(const unsigned char *src, size_t precision, int swap, size_t count, numeric_t *dest) {
+    size_t i;
+
+    for (i = 0; i < count; i++, src += precision) {
+        if (precision == 4) {
+            uint32_t bits;
+            float value;
+
+            memcpy(&bits, src, 4);
+            if (swap) { bits = stream_swap32(bits); }
+            memcpy(&value, &bits, 4);
+            dest[i] = (numeric_t)value;
+        } else {
+            uint64_t bits;
+            double value;
+
+            memcpy(&bits, src, 8);
+            if (swap) { bits = stream_swap64(bits); }
+            memcpy(&value, &bits, 8);
+            dest[i] = (numeric_t)value;
+        }
+    }
+}
+
+// Reads count half floats from src, swapping their bytes if swap is set
+static void stream_readHalves(const unsigned char *src, int swap, size_t count, numeric_t *dest) {
+    uint16_t halves[64];
+    size_t i, n;
+
+    for (; count; count -= n, src += n * 2, dest += n) {
+        n = count < 64 ? count : 64;
+        memcpy(halves, src, n * 2);
+        if (swap) {
+            for (i = 0; i < n; i++) { halves[i] = stream_swap16(halves[i]); }
+        }
+        half_unpack(halves, n, dest);
+    }
+}
+
+// Decodes the quantized elements of a file into numeric_t
+static void stream_decode(const unsigned char *src, int type, int encoding, int swap, size_t count, numeric_t *dest) {
+    size_t i, j, components = stream_components(type);
+
+    if (encoding == GL_MATRIX_STREAM_HALF) {
+        stream_readHalves(src, swap, count * components, dest);
+        return;
+    }
+
+    for (i = 0; i < count; i++, dest += components) {
+        if (encoding == GL_MATRIX_STREAM_QUAT32) {
+            uint32_t packed;
+
+            memcpy(&packed, src + i * 4, 4);
+            quat_unpack32(swap ? stream_swap32(packed) : packed, dest);
+        } else if (encoding == GL_MATRIX_STREAM_QUAT48) {
+            uint16_t packed[3];
+
+            memcpy(packed, src + i * 6, 6);
+            for (j = 0; swap && j < 3; j++) { packed[j] = stream_swap16(packed[j]); }
+            quat_unpack48(packed, dest);
+        } else {
+            const unsigned char *element = src + i * 24;
+            mat4_trs_t trs;
+            uint32_t bits;
+
+            for (j = 0; j < 3; j++) {
+                memcpy(&bits, element + j * 4, 4);
+                if (swap) { bits = stream_swap32(bits); }
+                memcpy(&trs.translation[j], &bits, 4);
+            }
+            memcpy(trs.rotation, element + 12, 6);
+            memcpy(trs.scale, element + 18, 6);
+            for (j = 0; swap && j < 3; j++) {
+                trs.rotation[j] = stream_swap16(trs.rotation[j]);
+                trs.scale[j] = stream_swap16(trs.scale[j]);
+            }
+            mat4_unpackTRS(&trs, dest);
+        }
+    }
+}
+
+// Encodes up to STREAM_BATCH elements into buffer and returns its length
+static size_t stream_encode(const numeric_t *data, int type, int encoding, size_t count, unsigned char *buffer) {
+    size_t i, components = stream_components(type);
+
+    for (i = 0; i < count; i++, data += components) {
+        if (encoding == GL_MATRIX_STREAM_HALF) {
+            uint16_t halves[16];
+
+            half_pack(data, components, halves);
+            memcpy(buffer + i * components * 2, halves, components * 2);
+        } else if (encoding == GL_MATRIX_STREAM_QUAT32) {
+            uint32_t packed = quat_pack32((numeric_t *)data);
+
+            memcpy(buffer + i * 4, &packed, 4);
+        } else if (encoding == GL_MATRIX_STREAM_QUAT48) {
+            uint16_t packed[3];
+
+            quat_pack48((numeric_t *)data, packed);
+            memcpy(buffer + i * 6, packed, 6);
+        } else {
+            mat4_trs_t trs;
+
+            mat4_packTRS((numeric_t *)data, &trs);
+            memcpy(buffer + i * 24, trs.translation, 12);
+            memcpy(buffer + i * 24 + 12, trs.rotation, 6);
+            memcpy(buffer + i * 24 + 18, trs.scale, 6);
+        }
+    }
+    return count * stream_elementSize(type, encoding, 0);
+}
+
+GL_MATRIX_API int stream_write(const char *path, int type, const numeric_t *data, size_t count) {
+    return stream_writeEncoded(path, type, GL_MATRIX_STREAM_RAW, data, count);
+}
+
+GL_MATRIX_API int stream_writeEncoded(const char *path, int type, int encoding, const numeric_t *data, size_t count) {
+    unsigned char header[STREAM_HEADER], buffer[STREAM_BATCH * STREAM_MAX_ENCODED];
+    uint32_t order = STREAM_ORDER;
+    uint64_t elements = count;
+    size_t i, n, numbers = stream_components(type) * count;
+    FILE *file;
+    int ok;
+
+    if (!stream_elementSize(type, encoding, sizeof(numeric_t))) { return 0; }
+
+    memset(header, 0, sizeof header);
+    memcpy(header, "GLMX", 4);
+    header[4] = STREAM_VERSION;
+    header[5] = (unsigned char)type;
+    header[6] = encoding == GL_MATRIX_STREAM_RAW ? sizeof(numeric_t) : 0;
+    header[7] = (unsigned char)encoding;
+    memcpy(header + 8, &order, 4);
+    memcpy(header + 16, &elements, 8);
+
+    file = fopen(path, "wb");
+    if (!file) { return 0; }
+    ok = fwrite(header, 1, sizeof header, file) == sizeof header;
+
+    if (encoding == GL_MATRIX_STREAM_RAW) {
+        ok = ok && fwrite(data, sizeof(numeric_t), numbers, file) == numbers;
+    } else {
+        // Encoded a batch at a time, so nothing is allocated
+        for (i = 0; ok && i < count; i += n) {
+            n = count - i < STREAM_BATCH ? count - i : STREAM_BATCH;
+            n = stream_encode(data + i * stream_components(type), type, encoding, n, buffer);
+            ok = fwrite(buffer, 1, n, file) == n;
+            n /= stream_elementSize(type, encoding, 0);
+        }
+    }
+
+    if (fclose(file)) { ok = 0; }
+    return ok;
+}
+
+GL_MATRIX_API stream_t *stream_open(stream_t *stream, const char *path) {
+    unsigned char *base;
+    size_t size, precision, components, element, numbers;
+    uint32_t order;
+    uint64_t count;
+    int swap, encoding;
+
+    if (!stream_map(path, &base, &size)) { return NULL; }
+
+    if (size < STREAM_HEADER || memcmp(base, "GLMX", 4) || base[4] != STREAM_VERSION) {
+        stream_unmap(base, size);
+        return NULL;
+    }
+
+    components = stream_components(base[5]);
+    precision = base[6];
+    encoding = base[7];
+    element = stream_elementSize(base[5], encoding, precision);
+    memcpy(&order, base + 8, 4);
+    memcpy(&count, base + 16, 8);
+    swap = order == STREAM_ORDER_SWAPPED;
+    if (swap) { count = stream_swap64(count); }
+
+    // Also rejects files cut short, and counts that overflow size_t
+    if (!element || (!swap && order != STREAM_ORDER) || count > (size - STREAM_HEADER) / element) {
+        stream_unmap(base, size);
+        return NULL;
+    }
+
+    numbers = (size_t)count * components;
+    stream->count = (size_t)count;
+    stream->type = base[5];
+    stream->encoding = encoding;
+
+    if (encoding == GL_MATRIX_STREAM_RAW && !swap && precision == sizeof(numeric_t)) {
+        // Zero copy: the elements are used where they lie in the mapping
+        stream->data = (numeric_t *)(base + STREAM_HEADER);
+        stream->mapping = base;
+        stream->size = size;
+        stream->copy = NULL;
+        return stream;
+    }
+
+    stream->copy = glm_alloc(numbers ? numbers * sizeof(numeric_t) : 1);
+    if (stream->copy && encoding == GL_MATRIX_STREAM_RAW) {
+        stream_convert(base + STREAM_HEADER, precision, swap, numbers, stream->copy);
+    } else if (stream->copy) {
+        stream_decode(base + STREAM_HEADER, stream->type, encoding, swap, stream->count, stream->copy);
+    }
+    stream_unmap(base, size);
+    if (!stream->copy) { return NULL; }
+
+    stream->data = stream->copy;
+    stream->mapping = NULL;
+    stream->size = 0;
+    return stream;
+}
+
+GL_MATRIX_API numeric_t *stream_data(stream_t *stream, int type) {
+    return stream->type == type ? stream->data : NULL;
+}
+
+GL_MATRIX_API void stream_close(stream_t *stream) {
+    if (stream->mapping) { stream_unmap(stream->mapping, stream->size); }
+    glm_free(stream->copy);
+    stream->data = stream->copy = NULL;
+    stream->mapping = NULL;
+    stream->count = stream->size = 0;
+    stream->type = stream->encoding = 0;
+}
+
+#undef STREAM_ORDER_SWAPPED
+#undef STREAM_ORDER
+#undef STREAM_MAX_ENCODED
+#undef STREAM_BATCH
+#undef STREAM_VERSION
+#undef STREAM_HEADER
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+
+
+// 1 / sqrt(2), the largest magnitude of any but the largest component of a
+// unit quaternion
+#define PACK_SQRT1_2 0.70710678118654752440
+
+// Splits a unit quaternion into the index of its largest component and the
+// other three, mapped from [-1/sqrt(2), 1/sqrt(2)] to integers in [0, max].
+// The largest component is made positive, as q and -q are the same rotation.
+static unsigned int pack_smallestThree(quat_t quat, uint32_t max, uint32_t *values) {
+    unsigned int i, j, largest = 0;
+    numeric_t scale = (numeric_t)(max / (2 * PACK_SQRT1_2)), half = (numeric_t)max / 2, v;
+
+    for (i = 1; i < 4; i++) {
+        if (glm_fabs(quat[i]) > glm_fabs(quat[largest])) { largest = i; }
+    }
+    if (quat[largest] < 0) { scale = -scale; }
+
+    for (i = 0, j = 0; i < 4; i++) {
+        if (i == largest) { continue; }
+        v = quat[i] * scale + half;
+        if (v < 0) { v = 0; }
+        if (v > max) { v = (numeric_t)max; }
+        values[j++] = (uint32_t)(v + (numeric_t)0.5);
+    }
+    return largest;
+}
+
+static quat_t pack_unsmallestThree(unsigned int largest, uint32_t max, const uint32_t *values, quat_t dest) {
+    numeric_t scale = (numeric_t)(2 * PACK_SQRT1_2 / max), sum = 0, v;
+    unsigned int i, j;
+
+    for (i = 0, j = 0; i < 4; i++) {
+        if (i == largest) { continue; }
+        v = values[j++] * scale - (numeric_t)PACK_SQRT1_2;
+        dest[i] = v;
+        sum += v * v;
+    }
+    dest[largest] = sum < 1 ? glm_sqrt(1 - sum) : 0;
+    return dest;
+}
+
+GL_MATRIX_API uint32_t quat_pack32(quat_t quat) {
+    uint32_t values[3];
+    unsigned int largest = pack_smallestThree(quat, 1023, values);
+
+    return (uint32_t)largest << 30 | values[0] << 20 | values[1] << 10 | values[2];
+}
+
+GL_MATRIX_API quat_t quat_unpack32(uint32_t packed, quat_t dest) {
+    uint32_t values[3];
+
+    values[0] = (packed >> 20) & 1023;
+    values[1] = (packed >> 10) & 1023;
+    values[2] = packed & 1023;
+    return pack_unsmallestThree(packed >> 30, 1023, values, dest);
+}
+
+GL_MATRIX_API uint16_t *quat_pack48(quat_t quat, uint16_t *dest) {
+    uint32_t values[3];
+    unsigned int largest = pack_smallestThree(quat, 32767, values);
+
+    // 2 bits of index and 3 * 15 bits of components, from the top bit down
+    dest[0] = (uint16_t)(largest << 14 | values[0] >> 1);
+    dest[1] = (uint16_t)((values[0] & 1) << 15 | values[1]);
+    dest[2] = (uint16_t)values[2];
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_unpack48(const uint16_t *packed, quat_t dest) {
+    uint32_t values[3];
+
+    values[0] = (uint32_t)(packed[0] & 0x3FFF) << 1 | packed[1] >> 15;
+    values[1] = packed[1] & 0x7FFF;
+    values[2] = packed[2] & 0x7FFF;
+    return pack_unsmallestThree(packed[0] >> 14, 32767, values, dest);
+}
+
+GL_MATRIX_API uint32_t *quat_pack32_array(quat_t quat, size_t count, uint32_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = quat_pack32(quat + i * 4);
+    }
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_unpack32_array(const uint32_t *packed, size_t count, quat_t dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        quat_unpack32(packed[i], dest + i * 4);
+    }
+    return dest;
+}
+
+GL_MATRIX_API uint16_t *quat_pack48_array(quat_t quat, size_t count, uint16_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        quat_pack48(quat + i * 4, dest + i * 3);
+    }
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_unpack48_array(const uint16_t *packed, size_t count, quat_t dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        quat_unpack48(packed + i * 3, dest + i * 4);
+    }
+    return dest;
+}
+
+// IEEE 754 binary16, rounding to nearest even
+static uint16_t pack_toHalf(float value) {
+    uint32_t bits, sign, result, rest, shift;
+
+    memcpy(&bits, &value, sizeof bits);
+    sign = (bits >> 16) & 0x8000;
+    bits &= 0x7FFFFFFF;
+
+    // NaN stays a (quiet) NaN; 65520 and up round to infinity
+    if (bits > 0x7F800000) { return (uint16_t)(sign | 0x7E00); }
+    if (bits >= 0x477FF000) { return (uint16_t)(sign | 0x7C00); }
+
+    if (bits >= 0x38800000) {
+        // Normal: rebias the exponent from 127 to 15 and round off 13 bits
+        result = (bits - 0x38000000) >> 13;
+        rest = bits & 0x1FFF;
+    } else {
+        // Subnormal, in units of 2^-24. Below 2^-25 everything rounds to 0.
+        if (bits < 0x33000000) { return (uint16_t)sign; }
+        shift = 126 - (bits >> 23);
+        bits = (bits & 0x7FFFFF) | 0x800000;
+        result = bits >> shift;
+        rest = bits & ((1u << shift) - 1);
+        if (rest > 1u << (shift - 1) || (rest == 1u << (shift - 1) && (result & 1))) { result++; }
+        return (uint16_t)(sign | result);
+    }
+
+    if (rest > 0x1000 || (rest == 0x1000 && (result & 1))) { result++; }
+    return (uint16_t)(sign | result);
+}
+
+static float pack_fromHalf(uint16_t half) {
+    uint32_t sign = (uint32_t)(half & 0x8000) << 16, exponent = (half >> 10) & 0x1F, mantissa = half & 0x3FF, bits;
+    float value;
+
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000 | mantissa << 13;
+    } else if (exponent) {
+        bits = sign | (exponent + 112) << 23 | mantissa << 13;
+    } else {
+        // Subnormal or zero: mantissa * 2^-24 is exact in a float
+        value = (float)mantissa * 5.9604644775390625e-8f;
+        return sign ? -value : value;
+    }
+
+    memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+GL_MATRIX_API uint16_t *half_pack(const numeric_t *values, size_t count, uint16_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = pack_toHalf((float)values[i]);
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *half_unpack(const uint16_t *packed, size_t count, numeric_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = pack_fromHalf(packed[i]);
+    }
+    return dest;
+}
+
+GL_MATRIX_API mat4_trs_t *mat4_packTRS(mat4_t mat, mat4_trs_t *dest) {
+    numeric_t scale[3], r[9], q[4], cross[3], trace, s;
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        numeric_t *column = mat + i * 4;
+        scale[i] = glm_sqrt(column[0] * column[0] + column[1] * column[1] + column[2] * column[2]);
+        s = scale[i] ? 1 / scale[i] : 0;
+        r[i * 3] = column[0] * s;
+        r[i * 3 + 1] = column[1] * s;
+        r[i * 3 + 2] = column[2] * s;
+        dest->translation[i] = (float)mat[12 + i];
+    }
+
+    // A mirroring matrix is a rotation with a negative scale
+    vec3_cross(r, r + 3, cross);
+    if (vec3_dot(cross, r + 6) < 0) {
+        scale[0] = -scale[0];
+        r[0] = -r[0];
+        r[1] = -r[1];
+        r[2] = -r[2];
+    }
+
+    // Rotation matrix to quaternion, dividing by the largest of 4w, 4x, 4y
+    // and 4z for accuracy. r is column major: r[c * 3 + row].
+    trace = r[0] + r[4] + r[8];
+    if (trace > 0) {
+        s = glm_sqrt(trace + 1) * 2;
+        q[3] = s / 4;
+        q[0] = (r[5] - r[7]) / s;
+        q[1] = (r[6] - r[2]) / s;
+        q[2] = (r[1] - r[3]) / s;
+    } else if (r[0] > r[4] && r[0] > r[8]) {
+        s = glm_sqrt(1 + r[0] - r[4] - r[8]) * 2;
+        q[3] = (r[5] - r[7]) / s;
+        q[0] = s / 4;
+        q[1] = (r[3] + r[1]) / s;
+        q[2] = (r[6] + r[2]) / s;
+    } else if (r[4] > r[8]) {
+        s = glm_sqrt(1 + r[4] - r[0] - r[8]) * 2;
+        q[3] = (r[6] - r[2]) / s;
+        q[0] = (r[3] + r[1]) / s;
+        q[1] = s / 4;
+        q[2] = (r[7] + r[5]) / s;
+    } else {
+        s = glm_sqrt(1 + r[8] - r[0] - r[4]) * 2;
+        q[3] = (r[1] - r[3]) / s;
+        q[0] = (r[6] + r[2]) / s;
+        q[1] = (r[7] + r[5]) / s;
+        q[2] = s / 4;
+    }
+
+    quat_normalize(q, NULL);
+    quat_pack48(q, dest->rotation);
+    half_pack(scale, 3, dest->scale);
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_unpackTRS(const mat4_trs_t *trs, mat4_t dest) {
+    numeric_t q[4], t[3], scale[3];
+
+    t[0] = trs->translation[0];
+    t[1] = trs->translation[1];
+    t[2] = trs->translation[2];
+    quat_unpack48(trs->rotation, q);
+    half_unpack(trs->scale, 3, scale);
+
+    mat4_fromRotationTranslation(q, t, dest);
+    return mat4_scale(dest, scale, NULL);
+}
+
+GL_MATRIX_API mat4_trs_t *mat4_packTRS_array(mat4_t mat, size_t count, mat4_trs_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        mat4_packTRS(mat + i * 16, dest + i);
+    }
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_unpackTRS_array(const mat4_trs_t *trs, size_t count, mat4_t dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        mat4_unpackTRS(trs + i, dest + i * 16);
+    }
+    return dest;
+}
+
+#undef PACK_SQRT1_2
+#if defined(GL_MATRIX_STATIC_INLINE) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+#if defined(GL_MATRIX_IMPLEMENTATION) && !defined(GL_MATRIX_IMPLEMENTATION_INCLUDED)
+#define GL_MATRIX_IMPLEMENTATION_INCLUDED
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+
+static glm_alloc_fn glm_alloc_hook = NULL;
+static glm_free_fn glm_free_hook = NULL;
+static void *glm_alloc_user = NULL;
+
+void glm_set_allocator(glm_alloc_fn alloc, glm_free_fn release, void *user) {
+    glm_alloc_hook = alloc;
+    glm_free_hook = alloc ? release : NULL;
+    glm_alloc_user = alloc ? user : NULL;
+}
+
+void *glm_alloc(size_t size) {
+    void *ptr;
+
+    if (!glm_alloc_hook) {
+#ifdef GL_MATRIX_NO_MALLOC
+        fprintf(stderr, "gl-matrix: allocation of %lu bytes with no allocator installed\n", (unsigned long)size);
+        abort();
+#else
+        return calloc(1, size);
+#endif
+    }
+
+    ptr = glm_alloc_hook(size, glm_alloc_user);
+    if (ptr) { memset(ptr, 0, size); }
+    return ptr;
+}
+
+void glm_free(void *ptr) {
+    if (!ptr) { return; }
+
+    if (!glm_alloc_hook) {
+        free(ptr);
+    } else if (glm_free_hook) {
+        glm_free_hook(ptr, glm_alloc_user);
+    }
+}
+
+void *glm_alloc_aligned(size_t size, size_t align) {
+    unsigned char *block, *ptr;
+
+    if (align < sizeof(void *)) { align = sizeof(void *); }
+    // Sizes so large that the padding would wrap around can't be allocated
+    if (size > SIZE_MAX - (align - 1) - sizeof(void *)) { return NULL; }
+
+    // Room to move the start up to the next multiple of align, with the
+    // pointer glm_free needs stored just below it
+    block = glm_alloc(size + align - 1 + sizeof(void *));
+    if (!block) { return NULL; }
+
+    ptr = (unsigned char *)(((size_t)block + sizeof(void *) + align - 1) & ~(size_t)(align - 1));
+    ((void **)ptr)[-1] = block;
+    return ptr;
+}
+
+void glm_free_aligned(void *ptr) {
+    if (!ptr) { return; }
+    glm_free(((void **)ptr)[-1]);
+}
+#include <stdlib.h>
+#include <stdint.h>
+
+
+glm_arena *glm_arena_init(glm_arena *arena, size_t size) {
+    unsigned char *block;
+
+    if (size > SIZE_MAX - GL_MATRIX_ARENA_ALIGNMENT) { return NULL; }
+    block = malloc(size + GL_MATRIX_ARENA_ALIGNMENT);
+    if (!block) { return NULL; }
+
+    glm_arena_initBuffer(arena, block + (GL_MATRIX_ARENA_ALIGNMENT - (size_t)block % GL_MATRIX_ARENA_ALIGNMENT) % GL_MATRIX_ARENA_ALIGNMENT, size);
+    arena->block = block;
+    return arena;
+}
+
+glm_arena *glm_arena_initBuffer(glm_arena *arena, void *buffer, size_t size) {
+    arena->base = buffer;
+    arena->size = size;
+    arena->used = 0;
+    arena->block = NULL;
+    return arena;
+}
+
+void glm_arena_destroy(glm_arena *arena) {
+    free(arena->block);
+    arena->base = NULL;
+    arena->block = NULL;
+    arena->size = arena->used = 0;
+}
+
+void *glm_arena_alloc(glm_arena *arena, size_t size, size_t align) {
+    unsigned char *ptr;
+    size_t pad;
+
+    if (!align) { align = 16; }
+    pad = (align - (size_t)(arena->base + arena->used) % align) % align;
+    if (pad > arena->size - arena->used || size > arena->size - arena->used - pad) { return NULL; }
+
+    ptr = arena->base + arena->used + pad;
+    arena->used += pad + size;
+    return ptr;
+}
+
+void glm_arena_reset(glm_arena *arena) {
+    arena->used = 0;
+}
+
+void *glm_arena_allocHook(size_t size, void *user) {
+    return glm_arena_alloc(user, size, 16);
+}
+#include <stdlib.h>
+
+
+float *glm_doubleToFloat(const double *src, float *dest, size_t count) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = (float)src[i];
+    }
+    return dest;
+}
+
+double *glm_floatToDouble(const float *src, double *dest, size_t count) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = src[i];
+    }
+    return dest;
+}
+
+float *glm_mat4ToFloat(const double *mat, float *dest) {
+    return glm_doubleToFloat(mat, dest, 16);
+}
+
+double *glm_mat4ToDouble(const float *mat, double *dest) {
+    return glm_floatToDouble(mat, dest, 16);
+}
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+/*
+ * Shortest round-trip number formatting, with the Grisu2 algorithm from
+ * Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+ * with Integers" (PLDI 2010).
+ *
+ * A number is scaled by a cached power of ten into a 64 bit fixed point
+ * window, and digits are generated until they identify the number among its
+ * neighbours. The result always parses back to the same float or double; it
+ * is the shortest such string for all but a tiny fraction of inputs.
+ */
+
+typedef struct {
+    uint64_t f;
+    int e;
+} glm_diyfp;
+
+// 10^(8i - 348), normalized to a 64 bit significand and binary exponent
+static const uint64_t glm_format_powF[] = {
+    0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL,
+    0xCF42894A5DCE35EAULL, 0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL,
+    0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL, 0xBE5691EF416BD60CULL,
+    0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+    0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL,
+    0xC21094364DFB5637ULL, 0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL,
+    0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL, 0xB23867FB2A35B28EULL,
+    0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+    0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL,
+    0xB5B5ADA8AAFF80B8ULL, 0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL,
+    0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL, 0xA6DFBD9FB8E5B88FULL,
+    0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+    0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL,
+    0xAA242499697392D3ULL, 0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL,
+    0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL, 0x9C40000000000000ULL,
+    0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+    0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL,
+    0x9F4F2726179A2245ULL, 0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL,
+    0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL, 0x924D692CA61BE758ULL,
+    0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+    0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL,
+    0x952AB45CFA97A0B3ULL, 0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL,
+    0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL, 0x88FCF317F22241E2ULL,
+    0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+    0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL,
+    0x8BAB8EEFB6409C1AULL, 0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL,
+    0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL, 0x80444B5E7AA7CF85ULL,
+    0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+    0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL, 0xAF87023B9BF0EE6BULL
+};
+
+static const short glm_format_powE[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066
+};
+
+static const uint64_t glm_format_pow10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static glm_diyfp glm_diyfp_make(uint64_t f, int e) {
+    glm_diyfp x;
+    x.f = f;
+    x.e = e;
+    return x;
+}
+
+// The upper 64 bits of the 128 bit product, rounded
+static glm_diyfp glm_diyfp_multiply(glm_diyfp x, glm_diyfp y) {
+    const uint64_t m32 = 0xFFFFFFFFULL;
+    uint64_t a = x.f >> 32, b = x.f & m32, c = y.f >> 32, d = y.f & m32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & m32) + (bc & m32) + (1ULL << 31);
+
+    return glm_diyfp_make(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64);
+}
+
+static glm_diyfp glm_diyfp_normalize(glm_diyfp x) {
+#if defined(__GNUC__) || defined(__clang__)
+    int shift = __builtin_clzll(x.f);
+    x.f <<= shift;
+    x.e -= shift;
+#else
+    while (!(x.f & (1ULL << 63))) {
+        x.f <<= 1;
+        x.e--;
+    }
+#endif
+    return x;
+}
+
+static int glm_format_countDigits(uint32_t n) {
+    int digits = 1;
+    while (digits < 10 && n >= glm_format_pow10[digits]) { digits++; }
+    return digits;
+}
+
+static void glm_format_round(char *buffer, int length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance) {
+    while (rest < distance && delta - rest >= tenKappa &&
+           (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance)) {
+        buffer[length - 1]--;
+        rest += tenKappa;
+    }
+}
+
+// Generates the digits of w, which lies in [upper - delta, upper]. Returns
+// the number of digits; the value is digits * 10^*k.
+static int glm_format_digits(glm_diyfp w, glm_diyfp upper, uint64_t delta, char *buffer, int *k) {
+    const glm_diyfp one = glm_diyfp_make(1ULL << -upper.e, upper.e);
+    const uint64_t distance = upper.f - w.f;
+    uint32_t p1 = (uint32_t)(upper.f >> -one.e);
+    uint64_t p2 = upper.f & (one.f - 1);
+    int kappa = glm_format_countDigits(p1), length = 0;
+
+    while (kappa > 0) {
+        uint32_t d;
+        uint64_t rest;
+
+        // Constant divisors, which compile to multiplications
+        switch (kappa) {
+        case 10: d = p1 / 1000000000; p1 %= 1000000000; break;
+        case 9: d = p1 / 100000000; p1 %= 100000000; break;
+        case 8: d = p1 / 10000000; p1 %= 10000000; break;
+        case 7: d = p1 / 1000000; p1 %= 1000000; break;
+        case 6: d = p1 / 100000; p1 %= 100000; break;
+        case 5: d = p1 / 10000; p1 %= 10000; break;
+        case 4: d = p1 / 1000; p1 %= 1000; break;
+        case 3: d = p1 / 100; p1 %= 100; break;
+        case 2: d = p1 / 10; p1 %= 10; break;
+        default: d = p1; p1 = 0; break;
+        }
+        if (d || length) { buffer[length++] = (char)('0' + d); }
+        kappa--;
+
+        rest = ((uint64_t)p1 << -one.e) + p2;
+        if (rest <= delta) {
+            *k += kappa;
+            glm_format_round(buffer, length, delta, rest, glm_format_pow10[kappa] << -one.e, distance);
+            return length;
+        }
+    }
+
+    for (;;) {
+        char d;
+
+        p2 *= 10;
+        delta *= 10;
+        d = (char)(p2 >> -one.e);
+        if (d || length) { buffer[length++] = (char)('0' + d); }
+        p2 &= one.f - 1;
+        kappa--;
+
+        if (p2 < delta) {
+            *k += kappa;
+            glm_format_round(buffer, length, delta, p2, one.f,
+                             -kappa < 20 ? distance * glm_format_pow10[-kappa] : 0);
+            return length;
+        }
+    }
+}
+
+// f * 2^e is a positive finite number whose significand has the hidden bit
+// `hidden` (0 for subnormals). Writes its digits and returns their count.
+static int glm_format_grisu2(uint64_t f, int e, uint64_t hidden, char *buffer, int *k) {
+    glm_diyfp v = glm_diyfp_make(f, e), upper, lower, w, c;
+    int index;
+    double dk;
+
+    // The neighbourhood that still rounds to v. The gap below is half as
+    // wide when v is an exact power of two.
+    upper = glm_diyfp_normalize(glm_diyfp_make((f << 1) + 1, e - 1));
+    lower = f == hidden ? glm_diyfp_make((f << 2) - 1, e - 2) : glm_diyfp_make((f << 1) - 1, e - 1);
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    // Pick the cached power that brings upper's exponent into [-60, -32]
+    dk = (-61 - upper.e) * 0.30102999566398114 + 347;
+    index = (int)dk;
+    if (dk - index > 0.0) { index++; }
+    index = (index >> 3) + 1;
+    *k = -(-348 + index * 8);
+    c = glm_diyfp_make(glm_format_powF[index], glm_format_powE[index]);
+
+    w = glm_diyfp_multiply(glm_diyfp_normalize(v), c);
+    upper = glm_diyfp_multiply(upper, c);
+    lower = glm_diyfp_multiply(lower, c);
+    // Shrink the interval by the multiplication error so that every digit
+    // string inside it is still safe
+    lower.f++;
+    upper.f--;
+    return glm_format_digits(w, upper, upper.f - lower.f, buffer, k);
+}
+
+// Lays out digits * 10^k the way JavaScript's Number.prototype.toString does:
+// plain notation from 1e-6 up to 1e21, exponent notation outside of it
+static size_t glm_format_layout(char *buffer, int length, int k) {
+    int point = length + k, i;
+
+    if (length <= point && point <= 21) {
+        for (i = length; i < point; i++) { buffer[i] = '0'; }
+        buffer[point] = '\0';
+        return (size_t)point;
+    }
+
+    if (0 < point && point <= 21) {
+        memmove(buffer + point + 1, buffer + point, (size_t)(length - point));
+        buffer[point] = '.';
+        buffer[length + 1] = '\0';
+        return (size_t)length + 1;
+    }
+
+    if (-6 < point && point <= 0) {
+        int offset = 2 - point;
+        memmove(buffer + offset, buffer, (size_t)length);
+        buffer[0] = '0';
+        buffer[1] = '.';
+        for (i = 2; i < offset; i++) { buffer[i] = '0'; }
+        buffer[length + offset] = '\0';
+        return (size_t)(length + offset);
+    }
+
+    {
+        int exponent = point - 1, end = length;
+        unsigned int digits;
+
+        if (length > 1) {
+            memmove(buffer + 2, buffer + 1, (size_t)(length - 1));
+            buffer[1] = '.';
+            end++;
+        }
+        buffer[end++] = 'e';
+        buffer[end++] = exponent < 0 ? '-' : '+';
+        digits = (unsigned int)(exponent < 0 ? -exponent : exponent);
+        if (digits >= 100) { buffer[end++] = (char)('0' + digits / 100); digits %= 100; buffer[end++] = (char)('0' + digits / 10); }
+        else if (digits >= 10) { buffer[end++] = (char)('0' + digits / 10); }
+        buffer[end++] = (char)('0' + digits % 10);
+        buffer[end] = '\0';
+        return (size_t)end;
+    }
+}
+
+// Handles the sign, zero, infinities and NaN, and formats the rest
+static size_t glm_format(int negative, int special, uint64_t f, int e, uint64_t hidden, char *buffer) {
+    char *start = buffer;
+    int length, k;
+
+    if (special) {
+        // f is the significand of an infinity or a NaN
+        if (f) { memcpy(buffer, "nan", 4); return 3; }
+        if (negative) { *buffer++ = '-'; }
+        memcpy(buffer, "inf", 4);
+        return (size_t)(buffer - start) + 3;
+    }
+
+    if (negative) { *buffer++ = '-'; }
+    if (!f) {
+        memcpy(buffer, "0", 2);
+        return (size_t)(buffer - start) + 1;
+    }
+
+    length = glm_format_grisu2(f, e, hidden, buffer, &k);
+    return (size_t)(buffer - start) + glm_format_layout(buffer, length, k);
+}
+
+size_t glm_formatFloat(float x, char *buffer) {
+    uint32_t bits, biased, significand;
+
+    memcpy(&bits, &x, sizeof bits);
+    biased = (bits >> 23) & 0xFF;
+    significand = bits & 0x7FFFFF;
+
+    if (biased == 0xFF) { return glm_format(bits >> 31, 1, significand, 0, 0, buffer); }
+    if (biased) {
+        return glm_format(bits >> 31, 0, significand | 0x800000, (int)biased - 150, 0x800000, buffer);
+    }
+    return glm_format(bits >> 31, 0, significand, -149, 0, buffer);
+}
+
+size_t glm_formatDouble(double x, char *buffer) {
+    const uint64_t hidden = 1ULL << 52;
+    uint64_t bits, significand;
+    int biased;
+
+    memcpy(&bits, &x, sizeof bits);
+    biased = (int)((bits >> 52) & 0x7FF);
+    significand = bits & (hidden - 1);
+
+    if (biased == 0x7FF) { return glm_format((int)(bits >> 63), 1, significand, 0, 0, buffer); }
+    if (biased) {
+        return glm_format((int)(bits >> 63), 0, significand | hidden, biased - 1075, hidden, buffer);
+    }
+    return glm_format((int)(bits >> 63), 0, significand, -1074, 0, buffer);
+}
+#include <string.h>
+#include <stdint.h>
+
+
+/*
+ * Number parsing, the counterpart of format.c.
+ *
+ * The digits are gathered into a 64 bit integer w and a decimal exponent q,
+ * and w * 10^q is rounded to a float or double with the Eisel-Lemire
+ * algorithm (Daniel Lemire, "Number Parsing at a Gigabyte per Second",
+ * 2021): w is multiplied by a 128 bit approximation of 5^q, and the result
+ * is correctly rounded unless it is too close to a tie to tell. Those rare
+ * cases, numbers of more than 19 digits, exponents outside the table and
+ * subnormal results go to the slow path instead: the simple decimal
+ * conversion used by Go's strconv and by fast_float (Nigel Tao, "The Simple
+ * Decimal Conversion Algorithm", 2020). It holds the digits in a fixed
+ * buffer and shifts them by powers of two until the binary exponent and
+ * mantissa fall out, so it doesn't depend on the locale or allocate.
+ */
+
+#define PARSE_MIN_POWER (-64)
+#define PARSE_MAX_POWER 64
+
+// Digits the slow path keeps. Enough to decide every tie, the rest only
+// count as nonzero or not.
+#define PARSE_DIGITS 800
+// Largest shift at once, so the slow path's arithmetic fits 64 bits
+#define PARSE_MAX_SHIFT 60
+
+// 5^q for q in [PARSE_MIN_POWER, PARSE_MAX_POWER], normalized to 128 bits:
+// the high and then the low 64 bits
+static const uint64_t glm_parse_pow5[] = {
+    0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL,
+    0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL,
+    0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL,
+    0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL,
+    0xCDB02555653131B6ULL, 0x3792F412CB06794DULL,
+    0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL,
+    0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL,
+    0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL,
+    0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL,
+    0x9CED737BB6C4183DULL, 0x55464DD69685606BULL,
+    0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL,
+    0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL,
+    0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL,
+    0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL,
+    0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL,
+    0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL,
+    0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL,
+    0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL,
+    0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL,
+    0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL,
+    0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL,
+    0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL,
+    0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL,
+    0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL,
+    0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL,
+    0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL,
+    0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL,
+    0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL,
+    0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL,
+    0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL,
+    0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL,
+    0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL,
+    0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL,
+    0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL,
+    0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL,
+    0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL,
+    0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL,
+    0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL,
+    0xC612062576589DDAULL, 0x95364AFE032A819EULL,
+    0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL,
+    0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL,
+    0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL,
+    0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL,
+    0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL,
+    0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL,
+    0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL,
+    0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL,
+    0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL,
+    0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL,
+    0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL,
+    0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL,
+    0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL,
+    0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL,
+    0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL,
+    0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL,
+    0x89705F4136B4A597ULL, 0x31680A88F8953031ULL,
+    0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL,
+    0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL,
+    0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL,
+    0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL,
+    0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL,
+    0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL,
+    0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL,
+    0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL,
+    0xA000000000000000ULL, 0x0000000000000000ULL,
+    0xC800000000000000ULL, 0x0000000000000000ULL,
+    0xFA00000000000000ULL, 0x0000000000000000ULL,
+    0x9C40000000000000ULL, 0x0000000000000000ULL,
+    0xC350000000000000ULL, 0x0000000000000000ULL,
+    0xF424000000000000ULL, 0x0000000000000000ULL,
+    0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xBEBC200000000000ULL, 0x0000000000000000ULL,
+    0xEE6B280000000000ULL, 0x0000000000000000ULL,
+    0x9502F90000000000ULL, 0x0000000000000000ULL,
+    0xBA43B74000000000ULL, 0x0000000000000000ULL,
+    0xE8D4A51000000000ULL, 0x0000000000000000ULL,
+    0x9184E72A00000000ULL, 0x0000000000000000ULL,
+    0xB5E620F480000000ULL, 0x0000000000000000ULL,
+    0xE35FA931A0000000ULL, 0x0000000000000000ULL,
+    0x8E1BC9BF04000000ULL, 0x0000000000000000ULL,
+    0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL,
+    0xDE0B6B3A76400000ULL, 0x0000000000000000ULL,
+    0x8AC7230489E80000ULL, 0x0000000000000000ULL,
+    0xAD78EBC5AC620000ULL, 0x0000000000000000ULL,
+    0xD8D726B7177A8000ULL, 0x0000000000000000ULL,
+    0x878678326EAC9000ULL, 0x0000000000000000ULL,
+    0xA968163F0A57B400ULL, 0x0000000000000000ULL,
+    0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL,
+    0x84595161401484A0ULL, 0x0000000000000000ULL,
+    0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL,
+    0xCECB8F27F4200F3AULL, 0x0000000000000000ULL,
+    0x813F3978F8940984ULL, 0x4000000000000000ULL,
+    0xA18F07D736B90BE5ULL, 0x5000000000000000ULL,
+    0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL,
+    0xFC6F7C4045812296ULL, 0x4D00000000000000ULL,
+    0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL,
+    0xC5371912364CE305ULL, 0x6C28000000000000ULL,
+    0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL,
+    0x9A130B963A6C115CULL, 0x3C7F400000000000ULL,
+    0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL,
+    0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL,
+    0x96769950B50D88F4ULL, 0x1314448000000000ULL,
+    0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL,
+    0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL,
+    0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL,
+    0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL,
+    0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL,
+    0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL,
+    0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL,
+    0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL,
+    0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL,
+    0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL,
+    0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL,
+    0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL,
+    0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL,
+    0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL,
+    0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL,
+    0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL,
+    0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL,
+    0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL,
+    0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL,
+    0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL,
+    0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL,
+    0x9F4F2726179A2245ULL, 0x01D762422C946590ULL,
+    0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL,
+    0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL,
+    0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL,
+    0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL
+};
+
+typedef struct {
+    uint64_t w;
+    int q;
+    int negative;
+    // More significant digits than fit in w, which the slow path handles
+    int truncated;
+    // 'i' for infinity, 'n' for NaN, 0 for a finite number
+    char special;
+} glm_parse_decimal;
+
+// Scans a number: an optional sign, digits with an optional decimal point,
+// an optional exponent, or inf/infinity/nan in any case. Returns the end of
+// the number, NULL if there isn't one.
+static const char *glm_parse_scan(const char *str, glm_parse_decimal *d) {
+    const char *p = str, *digits;
+    uint64_t w = 0;
+    int significant = 0, exponent = 0, q = 0, truncated = 0;
+
+    d->w = 0;
+    d->q = 0;
+    d->truncated = 0;
+    d->special = 0;
+    d->negative = *p == '-';
+    if (*p == '-' || *p == '+') { p++; }
+
+    if ((p[0] | 0x20) == 'i' && (p[1] | 0x20) == 'n' && (p[2] | 0x20) == 'f') {
+        d->special = 'i';
+        p += 3;
+        if ((p[0] | 0x20) == 'i' && (p[1] | 0x20) == 'n' && (p[2] | 0x20) == 'i' &&
+            (p[3] | 0x20) == 't' && (p[4] | 0x20) == 'y') {
+            p += 5;
+        }
+        return p;
+    }
+    if ((p[0] | 0x20) == 'n' && (p[1] | 0x20) == 'a' && (p[2] | 0x20) == 'n') {
+        d->special = 'n';
+        return p + 3;
+    }
+
+    // Gathered in locals: stores through d could alias the text
+    digits = p;
+    for (; *p >= '0' && *p <= '9'; p++) {
+        if (significant < 19) {
+            w = w * 10 + (uint64_t)(*p - '0');
+            significant += w != 0;
+        } else {
+            q++;
+            truncated |= *p != '0';
+        }
+    }
+    if (*p == '.') {
+        for (p++; *p >= '0' && *p <= '9'; p++) {
+            if (significant < 19) {
+                w = w * 10 + (uint64_t)(*p - '0');
+                significant += w != 0;
+                q--;
+            } else {
+                truncated |= *p != '0';
+            }
+        }
+    }
+    // "." and "" aren't numbers
+    if (p == digits || (p == digits + 1 && *digits == '.')) { return NULL; }
+
+    if ((*p | 0x20) == 'e') {
+        const char *e = p + 1;
+        int negative = *e == '-';
+
+        if (*e == '-' || *e == '+') { e++; }
+        if (*e >= '0' && *e <= '9') {
+            for (; *e >= '0' && *e <= '9'; e++) {
+                // Large enough to overflow or underflow any double
+                if (exponent < 100000) { exponent = exponent * 10 + (*e - '0'); }
+            }
+            q += negative ? -exponent : exponent;
+            p = e;
+        }
+    }
+
+    d->w = w;
+    d->q = q;
+    d->truncated = truncated;
+    return p;
+}
+
+// The high 64 bits of a * b, and the low 64 in *low
+static uint64_t glm_parse_multiply(uint64_t a, uint64_t b, uint64_t *low) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+
+    *low = (uint64_t)product;
+    return (uint64_t)(product >> 64);
+#else
+    const uint64_t m32 = 0xFFFFFFFFULL;
+    uint64_t a0 = a & m32, a1 = a >> 32, b0 = b & m32, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t middle = (p00 >> 32) + (p01 & m32) + (p10 & m32);
+
+    *low = (middle << 32) | (p00 & m32);
+    return p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+#endif
+}
+
+// Eisel-Lemire. Rounds w * 10^q (w != 0) to a binary float with `bits`
+// explicit mantissa bits and exponent bias `bias`, and returns its bit
+// pattern without the sign, or 0 if the fallback is needed.
+static uint64_t glm_parse_eiselLemire(uint64_t w, int q, int bits, int bias) {
+    const uint64_t *power;
+    uint64_t high, low, secondHigh, secondLow, mantissa, mask;
+    int leading = 0, upper, shift, exponent;
+
+    if (q < PARSE_MIN_POWER || q > PARSE_MAX_POWER) { return 0; }
+    power = glm_parse_pow5 + 2 * (q - PARSE_MIN_POWER);
+
+#if defined(__GNUC__) || defined(__clang__)
+    leading = __builtin_clzll(w);
+    w <<= leading;
+#else
+    while (!(w & (1ULL << 63))) {
+        w <<= 1;
+        leading++;
+    }
+#endif
+
+    // The low half of 5^q only matters when the bits below the mantissa
+    // and its rounding bits are all ones
+    high = glm_parse_multiply(w, power[0], &low);
+    mask = 0xFFFFFFFFFFFFFFFFULL >> (bits + 3);
+    if ((high & mask) == mask) {
+        secondHigh = glm_parse_multiply(w, power[1], &secondLow);
+        low += secondHigh;
+        if (secondHigh > low) { high++; }
+    }
+
+    upper = (int)(high >> 63);
+    shift = upper + 64 - bits - 3;
+    mantissa = high >> shift;
+    // floor(q * log2(10)) + 63, with the shift rounding toward -infinity
+    exponent = ((217706 * q) >> 16) + 63 + upper - leading + bias;
+
+    // Subnormals, and exact ties, which the product can't tell apart from
+    // numbers just above or below them
+    if (exponent <= 0 || (low <= 1 && (mantissa & 3) == 1 && (mantissa << shift) == high)) { return 0; }
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= 2ULL << bits) {
+        mantissa = 1ULL << bits;
+        exponent++;
+    }
+    mantissa &= ~(1ULL << bits);
+
+    // Infinity
+    if (exponent >= 2 * bias + 1) { return (uint64_t)(2 * bias + 1) << bits; }
+    return mantissa | (uint64_t)exponent << bits;
+}
+
+// A decimal number 0.digits * 10^point for the slow path, with the digits
+// as values 0-9 and no trailing zeros. The slack past PARSE_DIGITS takes
+// the digits a left shift adds before they are trimmed.
+typedef struct {
+    unsigned char digits[PARSE_DIGITS + 20];
+    int count;
+    int point;
+    // Nonzero digits were dropped past PARSE_DIGITS
+    int truncated;
+} glm_parse_big;
+
+static void glm_parse_trim(glm_parse_big *b) {
+    while (b->count > 0 && b->digits[b->count - 1] == 0) { b->count--; }
+    if (!b->count) { b->point = 0; }
+}
+
+// Multiplies b by 2^shift, shift <= PARSE_MAX_SHIFT
+static void glm_parse_shiftLeft(glm_parse_big *b, int shift) {
+    // 2^shift has at most this many digits, and the product at most this
+    // many more than b
+    int grow = ((shift * 1233) >> 12) + 1, r = b->count, w = b->count + grow, i;
+    uint64_t n = 0;
+
+    while (r > 0) {
+        n += (uint64_t)b->digits[--r] << shift;
+        b->digits[--w] = (unsigned char)(n % 10);
+        n /= 10;
+    }
+    while (n > 0) {
+        b->digits[--w] = (unsigned char)(n % 10);
+        n /= 10;
+    }
+
+    // w is the number of unused leading places
+    b->count += grow - w;
+    b->point += grow - w;
+    if (w) { memmove(b->digits, b->digits + w, (size_t)b->count); }
+    if (b->count > PARSE_DIGITS) {
+        for (i = PARSE_DIGITS; i < b->count; i++) { b->truncated |= b->digits[i] != 0; }
+        b->count = PARSE_DIGITS;
+    }
+    glm_parse_trim(b);
+}
+
+// Divides b by 2^shift, shift <= PARSE_MAX_SHIFT
+static void glm_parse_shiftRight(glm_parse_big *b, int shift) {
+    uint64_t n = 0, mask = (1ULL << shift) - 1;
+    int r = 0, w = 0;
+
+    // Enough leading digits for the first digit of the quotient
+    while (!(n >> shift)) {
+        if (r < b->count) {
+            n = n * 10 + b->digits[r];
+        } else if (n) {
+            n *= 10;
+        } else {
+            b->count = 0;
+            b->point = 0;
+            return;
+        }
+        r++;
+    }
+    b->point -= r - 1;
+
+    for (; r < b->count; r++) {
+        unsigned char digit = b->digits[r];
+
+        b->digits[w++] = (unsigned char)(n >> shift);
+        n = (n & mask) * 10 + digit;
+    }
+    while (n > 0) {
+        if (w < PARSE_DIGITS) {
+            b->digits[w++] = (unsigned char)(n >> shift);
+        } else if (n >> shift) {
+            b->truncated = 1;
+        }
+        n = (n & mask) * 10;
+    }
+    b->count = w;
+    glm_parse_trim(b);
+}
+
+static void glm_parse_shift(glm_parse_big *b, int shift) {
+    if (!b->count) { return; }
+    for (; shift > PARSE_MAX_SHIFT; shift -= PARSE_MAX_SHIFT) { glm_parse_shiftLeft(b, PARSE_MAX_SHIFT); }
+    for (; shift < -PARSE_MAX_SHIFT; shift += PARSE_MAX_SHIFT) { glm_parse_shiftRight(b, PARSE_MAX_SHIFT); }
+    if (shift > 0) { glm_parse_shiftLeft(b, shift); }
+    if (shift < 0) { glm_parse_shiftRight(b, -shift); }
+}
+
+// The integer part of b, rounded half to even on the fraction
+static uint64_t glm_parse_round(const glm_parse_big *b) {
+    uint64_t n = 0;
+    int i, up;
+
+    for (i = 0; i < b->point; i++) { n = n * 10 + (i < b->count ? b->digits[i] : 0); }
+    if (b->point < 0 || b->point >= b->count) { return n; }
+
+    if (b->digits[b->point] == 5 && b->point + 1 == b->count) {
+        up = b->truncated || (b->point > 0 && (b->digits[b->point - 1] & 1));
+    } else {
+        up = b->digits[b->point] >= 5;
+    }
+    return n + (uint64_t)up;
+}
+
+// The slow path. Rounds the number glm_parse_scan accepted at str, which is
+// finite, to a binary float as glm_parse_eiselLemire does, including
+// subnormals, zero and infinity.
+static uint64_t glm_parse_slow(const char *str, int bits, int bias) {
+    // floor(n * log2(10)), and 1 for n = 0: shifts that bring a number with
+    // n integer digits, or n leading zeros, toward [0.5, 1) without
+    // overshooting
+    static const int powers[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53, 56, 59 };
+    const int count = (int)(sizeof powers / sizeof powers[0]);
+    glm_parse_big b;
+    const char *p = str;
+    uint64_t mantissa;
+    int exponent = 0, dot = 0, digits = 0, shift;
+
+    b.count = 0;
+    b.point = 0;
+    b.truncated = 0;
+    if (*p == '-' || *p == '+') { p++; }
+    for (; (*p >= '0' && *p <= '9') || (*p == '.' && !dot); p++) {
+        if (*p == '.') {
+            dot = 1;
+            b.point = digits;
+        } else if (*p == '0' && !digits) {
+            // Leading zeros
+            b.point--;
+        } else {
+            if (b.count < PARSE_DIGITS) {
+                b.digits[b.count++] = (unsigned char)(*p - '0');
+            } else {
+                b.truncated |= *p != '0';
+            }
+            digits++;
+        }
+    }
+    if (!dot) { b.point = digits; }
+    if ((*p | 0x20) == 'e') {
+        const char *e = p + 1;
+        int negative = *e == '-', value = 0;
+
+        if (*e == '-' || *e == '+') { e++; }
+        for (; *e >= '0' && *e <= '9'; e++) {
+            if (value < 100000) { value = value * 10 + (*e - '0'); }
+        }
+        b.point += negative ? -value : value;
+    }
+    glm_parse_trim(&b);
+
+    // Zero, and numbers far outside any double
+    if (!b.count || b.point < -330) { return 0; }
+    if (b.point > 310) { return (uint64_t)(2 * bias + 1) << bits; }
+
+    // Scale into [0.5, 1) by powers of two, counting them in exponent
+    while (b.point > 0) {
+        shift = b.point < count ? powers[b.point] : PARSE_MAX_SHIFT;
+        glm_parse_shift(&b, -shift);
+        exponent += shift;
+    }
+    while (b.point < 0 || (b.point == 0 && b.digits[0] < 5)) {
+        shift = -b.point < count ? powers[-b.point] : PARSE_MAX_SHIFT;
+        glm_parse_shift(&b, shift);
+        exponent -= shift;
+    }
+
+    // From [0.5, 1) to [1, 2), and up to the smallest exponent, where the
+    // number becomes subnormal
+    exponent--;
+    if (exponent < 1 - bias) {
+        glm_parse_shift(&b, exponent - (1 - bias));
+        exponent = 1 - bias;
+    }
+    if (exponent + bias >= 2 * bias + 1) { return (uint64_t)(2 * bias + 1) << bits; }
+
+    glm_parse_shift(&b, bits + 1);
+    mantissa = glm_parse_round(&b);
+    // Rounded up to the next power of two
+    if (mantissa == 2ULL << bits) {
+        mantissa >>= 1;
+        exponent++;
+        if (exponent + bias >= 2 * bias + 1) { return (uint64_t)(2 * bias + 1) << bits; }
+    }
+    // Subnormal
+    if (!(mantissa & (1ULL << bits))) { return mantissa; }
+    return (mantissa & ~(1ULL << bits)) | (uint64_t)(exponent + bias) << bits;
+}
+
+const char *glm_parseFloat(const char *str, float *dest) {
+    glm_parse_decimal d;
+    const char *end = glm_parse_scan(str, &d);
+    uint32_t bits;
+
+    if (!end) { return NULL; }
+
+    if (d.special == 'i') {
+        bits = 0x7F800000;
+    } else if (d.special == 'n') {
+        bits = 0x7FC00000;
+    } else if (d.w == 0) {
+        bits = 0;
+    } else {
+        uint64_t result = d.truncated ? 0 : glm_parse_eiselLemire(d.w, d.q, 23, 127);
+        bits = (uint32_t)(result ? result : glm_parse_slow(str, 23, 127));
+    }
+
+    if (d.negative) { bits |= 0x80000000; }
+    memcpy(dest, &bits, sizeof bits);
+    return end;
+}
+
+const char *glm_parseDouble(const char *str, double *dest) {
+    glm_parse_decimal d;
+    const char *end = glm_parse_scan(str, &d);
+    uint64_t bits;
+
+    if (!end) { return NULL; }
+
+    if (d.special == 'i') {
+        bits = 0x7FF0000000000000ULL;
+    } else if (d.special == 'n') {
+        bits = 0x7FF8000000000000ULL;
+    } else if (d.w == 0) {
+        bits = 0;
+    } else {
+        bits = d.truncated ? 0 : glm_parse_eiselLemire(d.w, d.q, 52, 1023);
+        if (!bits) { bits = glm_parse_slow(str, 52, 1023); }
+    }
+
+    if (d.negative) { bits |= 0x8000000000000000ULL; }
+    memcpy(dest, &bits, sizeof bits);
+    return end;
+}
+
+#undef PARSE_MAX_SHIFT
+#undef PARSE_DIGITS
+#undef PARSE_MAX_POWER
+#undef PARSE_MIN_POWER
+#endif /* GL_MATRIX_IMPLEMENTATION */
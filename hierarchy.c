@@ -0,0 +1,266 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "gl-matrix.h"
+
+#ifndef GL_MATRIX_NO_THREADS
+#include <pthread.h>
+#endif
+
+#define HIERARCHY_NONE GL_MATRIX_HIERARCHY_NONE
+
+// Nodes claimed at a time by a thread of hierarchy_updateParallel
+#define HIERARCHY_CHUNK 128
+
+GL_MATRIX_API hierarchy_t *hierarchy_create(hierarchy_t *h, size_t capacity) {
+    unsigned char *block;
+
+    // One block: the numeric_t arrays first, so every array stays aligned
+    // for its type, then the parents and the dirty flags
+    block = glm_alloc(capacity * (26 * sizeof(numeric_t) + sizeof(size_t) + 1));
+    if (!block) { return NULL; }
+
+    h->block = block;
+    h->worlds = (numeric_t *)block;
+    h->translations = h->worlds + capacity * 16;
+    h->rotations = h->translations + capacity * 3;
+    h->scales = h->rotations + capacity * 4;
+    h->parents = (size_t *)(h->scales + capacity * 3);
+    h->dirty = (unsigned char *)(h->parents + capacity);
+    h->count = 0;
+    h->capacity = capacity;
+    h->firstDirty = HIERARCHY_NONE;
+    h->order = h->levelStarts = NULL;
+    h->levels = h->ordered = 0;
+    h->levelBlock = NULL;
+    return h;
+}
+
+GL_MATRIX_API void hierarchy_free(hierarchy_t *h) {
+    glm_free(h->block);
+    h->block = NULL;
+    h->worlds = h->translations = h->rotations = h->scales = NULL;
+    h->parents = NULL;
+    h->dirty = NULL;
+    h->count = h->capacity = 0;
+    h->firstDirty = HIERARCHY_NONE;
+    glm_free(h->levelBlock);
+    h->order = h->levelStarts = NULL;
+    h->levels = h->ordered = 0;
+    h->levelBlock = NULL;
+}
+
+GL_MATRIX_API size_t hierarchy_add(hierarchy_t *h, size_t parent, vec3_t translation, quat_t rotation, vec3_t scale) {
+    size_t node = h->count;
+    numeric_t *t, *r, *s;
+
+    if (node == h->capacity || (parent != HIERARCHY_NONE && parent >= node)) { return HIERARCHY_NONE; }
+
+    t = h->translations + node * 3;
+    r = h->rotations + node * 4;
+    s = h->scales + node * 3;
+    if (translation) { vec3_set(translation, t); } else { vec3_zeroes(t); }
+    if (rotation) { quat_set(rotation, r); } else { r[0] = r[1] = r[2] = 0; r[3] = 1; }
+    if (scale) { vec3_set(scale, s); } else { vec3_ones(s); }
+
+    h->parents[node] = parent;
+    h->count++;
+    hierarchy_markDirty(h, node);
+    return node;
+}
+
+GL_MATRIX_API void hierarchy_setLocal(hierarchy_t *h, size_t node, vec3_t translation, quat_t rotation, vec3_t scale) {
+    if (translation) { vec3_set(translation, h->translations + node * 3); }
+    if (rotation) { quat_set(rotation, h->rotations + node * 4); }
+    if (scale) { vec3_set(scale, h->scales + node * 3); }
+    hierarchy_markDirty(h, node);
+}
+
+GL_MATRIX_API void hierarchy_markDirty(hierarchy_t *h, size_t node) {
+    h->dirty[node] = 1;
+    if (node < h->firstDirty) { h->firstDirty = node; }
+}
+
+// Recomputes node i's world matrix if it or its parent is dirty, and flags
+// it dirty in turn so the change propagates to its children. `local` is
+// scratch space for the local matrix. Returns 1 if the node was updated.
+static int hierarchy_updateNode(hierarchy_t *h, size_t i, numeric_t *local) {
+    size_t parent = h->parents[i];
+    numeric_t *world = h->worlds + i * 16;
+
+    if (!h->dirty[i]) {
+        if (parent == HIERARCHY_NONE || !h->dirty[parent]) { return 0; }
+        h->dirty[i] = 1;
+    }
+
+    if (parent == HIERARCHY_NONE) {
+        mat4_fromRotationTranslation(h->rotations + i * 4, h->translations + i * 3, world);
+        mat4_scale(world, h->scales + i * 3, NULL);
+    } else {
+        mat4_fromRotationTranslation(h->rotations + i * 4, h->translations + i * 3, local);
+        mat4_scale(local, h->scales + i * 3, NULL);
+        mat4_multiplyAffine(h->worlds + parent * 16, local, world);
+    }
+    return 1;
+}
+
+GL_MATRIX_API size_t hierarchy_update(hierarchy_t *h) {
+    size_t i, first = h->firstDirty, count = h->count, updated = 0;
+    numeric_t local[16];
+
+    if (first >= count) { return 0; }
+
+    // Parents come before their children, so by the time a node is reached
+    // its parent's flag says whether the parent's world matrix changed. The
+    // flags are left set during the pass so they propagate down the subtree.
+    for (i = first; i < count; i++) {
+        updated += hierarchy_updateNode(h, i, local);
+    }
+
+    memset(h->dirty + first, 0, count - first);
+    h->firstDirty = HIERARCHY_NONE;
+    return updated;
+}
+
+#ifndef GL_MATRIX_NO_THREADS
+// Sorts the nodes by depth into h->order, so that each level can be updated
+// in parallel once the level above it is done. Kept until nodes are added.
+static int hierarchy_sortLevels(hierarchy_t *h) {
+    size_t i, *depths, count = h->count, levels = 0;
+
+    if (h->ordered == count && h->levelBlock) { return 1; }
+
+    if (!h->levelBlock) {
+        // order, depths and levelStarts; there are at most capacity levels
+        h->levelBlock = glm_alloc((3 * h->capacity + 1) * sizeof(size_t));
+        if (!h->levelBlock) { return 0; }
+    }
+    h->order = h->levelBlock;
+    depths = h->order + h->capacity;
+    h->levelStarts = depths + h->capacity;
+
+    for (i = 0; i < count; i++) {
+        size_t parent = h->parents[i];
+        depths[i] = parent == HIERARCHY_NONE ? 0 : depths[parent] + 1;
+        if (depths[i] >= levels) { levels = depths[i] + 1; }
+    }
+
+    // Counting sort. Nodes keep their relative order within a level.
+    memset(h->levelStarts, 0, (levels + 1) * sizeof(size_t));
+    for (i = 0; i < count; i++) { h->levelStarts[depths[i] + 1]++; }
+    for (i = 0; i < levels; i++) { h->levelStarts[i + 1] += h->levelStarts[i]; }
+    for (i = 0; i < count; i++) { h->order[h->levelStarts[depths[i]]++] = i; }
+    for (i = levels; i > 0; i--) { h->levelStarts[i] = h->levelStarts[i - 1]; }
+    h->levelStarts[0] = 0;
+
+    h->levels = levels;
+    h->ordered = count;
+    return 1;
+}
+
+typedef struct {
+    hierarchy_t *h;
+    pthread_mutex_t lock;
+    pthread_cond_t levelDone;
+    unsigned int threads, waiting;
+    size_t level, next, updated;
+} hierarchy_pool;
+
+// Run by every thread: claims chunks of the current level until it is used
+// up, then waits for the other threads to finish it before the next level
+static void *hierarchy_work(void *arg) {
+    hierarchy_pool *pool = arg;
+    hierarchy_t *h = pool->h;
+    size_t level, begin, end, updated = 0;
+    numeric_t local[16];
+
+    for (level = 0; level < h->levels; level++) {
+        end = h->levelStarts[level + 1];
+        // The levels are contiguous in h->order and a claim never goes past
+        // the end of its level, so pool->next reaches exactly the start of
+        // the next level once this one is used up
+        for (;;) {
+            size_t stop;
+
+            pthread_mutex_lock(&pool->lock);
+            begin = pool->next;
+            stop = end - begin < HIERARCHY_CHUNK ? end : begin + HIERARCHY_CHUNK;
+            if (begin < end) { pool->next = stop; }
+            pthread_mutex_unlock(&pool->lock);
+            if (begin >= end) { break; }
+
+            for (; begin < stop; begin++) {
+                updated += hierarchy_updateNode(h, h->order[begin], local);
+            }
+        }
+
+        // Wait until every thread is done with this level, as the next one
+        // reads its world matrices and dirty flags
+
+        pthread_mutex_lock(&pool->lock);
+        if (++pool->waiting == pool->threads) {
+            pool->waiting = 0;
+            pool->level++;
+            pthread_cond_broadcast(&pool->levelDone);
+        } else {
+            while (pool->level == level) { pthread_cond_wait(&pool->levelDone, &pool->lock); }
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->updated += updated;
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+#endif
+
+GL_MATRIX_API size_t hierarchy_updateParallel(hierarchy_t *h, unsigned int threads) {
+#ifndef GL_MATRIX_NO_THREADS
+    hierarchy_pool pool;
+    pthread_t tids[GL_MATRIX_HIERARCHY_MAX_THREADS];
+    unsigned int t, started = 1;
+    size_t first = h->firstDirty, count = h->count;
+
+    if (threads > GL_MATRIX_HIERARCHY_MAX_THREADS) { threads = GL_MATRIX_HIERARCHY_MAX_THREADS; }
+    if (threads < 2 || first >= count || count - first < 2 * HIERARCHY_CHUNK || !hierarchy_sortLevels(h)) {
+        return hierarchy_update(h);
+    }
+
+    pool.h = h;
+    pool.waiting = 0;
+    pool.level = 0;
+    pool.next = 0;
+    pool.updated = 0;
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.levelDone, NULL);
+
+    // Hold the lock until every thread has been started, so the threads
+    // wait for the right number of others at the end of each level
+    pthread_mutex_lock(&pool.lock);
+    for (t = 1; t < threads; t++) {
+        if (pthread_create(&tids[started], NULL, hierarchy_work, &pool) == 0) { started++; }
+    }
+    pool.threads = started;
+    pthread_mutex_unlock(&pool.lock);
+
+    hierarchy_work(&pool);
+    for (t = 1; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+
+    pthread_cond_destroy(&pool.levelDone);
+    pthread_mutex_destroy(&pool.lock);
+
+    memset(h->dirty + first, 0, count - first);
+    h->firstDirty = HIERARCHY_NONE;
+    return pool.updated;
+#else
+    (void)threads;
+    return hierarchy_update(h);
+#endif
+}
+
+#undef HIERARCHY_CHUNK
+#undef HIERARCHY_NONE
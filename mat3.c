@@ -1,10 +1,12 @@
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "gl-matrix.h"
 
-mat3_t mat3_create(mat3_t mat) {
-    mat3_t dest = calloc(9, sizeof(numeric_t));
+GL_MATRIX_API mat3_t mat3_create(mat3_t mat) {
+    mat3_t dest = glm_alloc(9 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
 
     if (mat) {
         dest[0] = mat[0];
@@ -21,7 +23,28 @@ mat3_t mat3_create(mat3_t mat) {
     return dest;
 }
 
-mat3_t mat3_set(mat3_t mat, mat3_t dest) {
+GL_MATRIX_API mat3_t mat3_create_in(glm_arena *arena, mat3_t mat) {
+    mat3_t dest = glm_arena_alloc(arena, 9 * sizeof(numeric_t), sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (mat) {
+        dest[0] = mat[0];
+        dest[1] = mat[1];
+        dest[2] = mat[2];
+        dest[3] = mat[3];
+        dest[4] = mat[4];
+        dest[5] = mat[5];
+        dest[6] = mat[6];
+        dest[7] = mat[7];
+        dest[8] = mat[8];
+    } else {
+        memset(dest, 0, 9 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API mat3_t mat3_set(mat3_t mat, mat3_t dest) {
     dest[0] = mat[0];
     dest[1] = mat[1];
     dest[2] = mat[2];
@@ -34,7 +57,7 @@ mat3_t mat3_set(mat3_t mat, mat3_t dest) {
     return dest;
 }
 
-mat3_t mat3_identity(mat3_t dest) {
+GL_MATRIX_API mat3_t mat3_identity(mat3_t dest) {
     if (!dest) { dest = mat3_create(NULL); }
     dest[0] = 1;
     dest[1] = 0;
@@ -48,7 +71,7 @@ mat3_t mat3_identity(mat3_t dest) {
     return dest;
 }
 
-mat3_t mat3_transpose(mat3_t mat, mat3_t dest) {
+GL_MATRIX_API mat3_t mat3_transpose(mat3_t mat, mat3_t dest) {
     // If we are transposing ourselves we can skip a few steps but have to cache some values
     if (!dest || mat == dest) {
         numeric_t a01 = mat[1], a02 = mat[2],
@@ -75,7 +98,7 @@ mat3_t mat3_transpose(mat3_t mat, mat3_t dest) {
     return dest;
 }
 
-mat4_t mat3_toMat4(mat3_t mat, mat4_t dest) {
+GL_MATRIX_API mat4_t mat3_toMat4(mat3_t mat, mat4_t dest) {
     if (!dest) { dest = mat4_create(NULL); }
 
     dest[15] = 1;
@@ -101,7 +124,7 @@ mat4_t mat3_toMat4(mat3_t mat, mat4_t dest) {
     return dest;
 }
 
-vec3_t mat3_multiplyVec3(mat3_t mat, vec3_t vec, vec3_t dest) {
+GL_MATRIX_API vec3_t mat3_multiplyVec3(mat3_t mat, vec3_t vec, vec3_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0], y = vec[1], z = vec[2];
@@ -1,10 +1,21 @@
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <assert.h>
 
 #include "gl-matrix.h"
 
-mat4_t mat4_create(mat4_t mat) {
-    mat4_t dest = calloc(16, sizeof(numeric_t));
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+#include <immintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#include <emmintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+GL_MATRIX_API mat4_t mat4_create(mat4_t mat) {
+    mat4_t dest = glm_alloc(16 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
 
     if (mat) {
         dest[0] = mat[0];
@@ -28,7 +39,43 @@ mat4_t mat4_create(mat4_t mat) {
     return dest;
 }
 
-mat4_t mat4_set(mat4_t mat, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_create_in(glm_arena *arena, mat4_t mat) {
+    mat4_t dest = glm_arena_alloc(arena, 16 * sizeof(numeric_t), GL_MATRIX_ARENA_ALIGNMENT);
+    if (!dest) { return NULL; }
+
+    if (mat) {
+        dest[0] = mat[0];
+        dest[1] = mat[1];
+        dest[2] = mat[2];
+        dest[3] = mat[3];
+        dest[4] = mat[4];
+        dest[5] = mat[5];
+        dest[6] = mat[6];
+        dest[7] = mat[7];
+        dest[8] = mat[8];
+        dest[9] = mat[9];
+        dest[10] = mat[10];
+        dest[11] = mat[11];
+        dest[12] = mat[12];
+        dest[13] = mat[13];
+        dest[14] = mat[14];
+        dest[15] = mat[15];
+    } else {
+        memset(dest, 0, 16 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_create_aligned(mat4_t mat, size_t align) {
+    mat4_t dest = glm_alloc_aligned(16 * sizeof(numeric_t), align);
+    if (!dest) { return NULL; }
+
+    if (mat) { memcpy(dest, mat, 16 * sizeof(numeric_t)); }
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_set(mat4_t mat, mat4_t dest) {
     dest[0] = mat[0];
     dest[1] = mat[1];
     dest[2] = mat[2];
@@ -48,7 +95,7 @@ mat4_t mat4_set(mat4_t mat, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_identity(mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_identity(mat4_t dest) {
     if (!dest) { dest = mat4_create(NULL); }
     dest[0] = 1;
     dest[1] = 0;
@@ -69,7 +116,7 @@ mat4_t mat4_identity(mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_transpose(mat4_t mat, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_transpose(mat4_t mat, mat4_t dest) {
     // If we are transposing ourselves we can skip a few steps but have to cache some values
     if (!dest || mat == dest) {
         numeric_t a01 = mat[1], a02 = mat[2], a03 = mat[3],
@@ -110,7 +157,7 @@ mat4_t mat4_transpose(mat4_t mat, mat4_t dest) {
     return dest;
 }
 
-numeric_t mat4_determinant(mat4_t mat) {
+GL_MATRIX_API numeric_t mat4_determinant(mat4_t mat) {
     // Cache the matrix values (makes for huge speed increases!)
     numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2], a03 = mat[3],
         a10 = mat[4], a11 = mat[5], a12 = mat[6], a13 = mat[7],
@@ -125,7 +172,7 @@ numeric_t mat4_determinant(mat4_t mat) {
             a20 * a01 * a12 * a33 - a00 * a21 * a12 * a33 - a10 * a01 * a22 * a33 + a00 * a11 * a22 * a33);
 }
 
-mat4_t mat4_inverse(mat4_t mat, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_inverse(mat4_t mat, mat4_t dest) {
     if (!dest) { dest = mat; }
 
     // Cache the matrix values (makes for huge speed increases!)
@@ -174,7 +221,50 @@ mat4_t mat4_inverse(mat4_t mat, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_toRotationMat(mat4_t mat, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_inverse_noalias(mat4_t GL_MATRIX_RESTRICT mat, mat4_t GL_MATRIX_RESTRICT dest) {
+    numeric_t b00, b01, b02, b03, b04, b05, b06, b07, b08, b09, b10, b11, d;
+
+    assert(GL_MATRIX_DISJOINT(mat, 16, dest, 16));
+
+    b00 = mat[0] * mat[5] - mat[1] * mat[4];
+    b01 = mat[0] * mat[6] - mat[2] * mat[4];
+    b02 = mat[0] * mat[7] - mat[3] * mat[4];
+    b03 = mat[1] * mat[6] - mat[2] * mat[5];
+    b04 = mat[1] * mat[7] - mat[3] * mat[5];
+    b05 = mat[2] * mat[7] - mat[3] * mat[6];
+    b06 = mat[8] * mat[13] - mat[9] * mat[12];
+    b07 = mat[8] * mat[14] - mat[10] * mat[12];
+    b08 = mat[8] * mat[15] - mat[11] * mat[12];
+    b09 = mat[9] * mat[14] - mat[10] * mat[13];
+    b10 = mat[9] * mat[15] - mat[11] * mat[13];
+    b11 = mat[10] * mat[15] - mat[11] * mat[14];
+
+    d = b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
+    if (!d) { return NULL; }
+    d = 1 / d;
+
+    // dest can't overlap mat, so the stores don't force mat to be reloaded
+    dest[0] = (mat[5] * b11 - mat[6] * b10 + mat[7] * b09) * d;
+    dest[1] = (-mat[1] * b11 + mat[2] * b10 - mat[3] * b09) * d;
+    dest[2] = (mat[13] * b05 - mat[14] * b04 + mat[15] * b03) * d;
+    dest[3] = (-mat[9] * b05 + mat[10] * b04 - mat[11] * b03) * d;
+    dest[4] = (-mat[4] * b11 + mat[6] * b08 - mat[7] * b07) * d;
+    dest[5] = (mat[0] * b11 - mat[2] * b08 + mat[3] * b07) * d;
+    dest[6] = (-mat[12] * b05 + mat[14] * b02 - mat[15] * b01) * d;
+    dest[7] = (mat[8] * b05 - mat[10] * b02 + mat[11] * b01) * d;
+    dest[8] = (mat[4] * b10 - mat[5] * b08 + mat[7] * b06) * d;
+    dest[9] = (-mat[0] * b10 + mat[1] * b08 - mat[3] * b06) * d;
+    dest[10] = (mat[12] * b04 - mat[13] * b02 + mat[15] * b00) * d;
+    dest[11] = (-mat[8] * b04 + mat[9] * b02 - mat[11] * b00) * d;
+    dest[12] = (-mat[4] * b09 + mat[5] * b07 - mat[6] * b06) * d;
+    dest[13] = (mat[0] * b09 - mat[1] * b07 + mat[2] * b06) * d;
+    dest[14] = (-mat[12] * b03 + mat[13] * b01 - mat[14] * b00) * d;
+    dest[15] = (mat[8] * b03 - mat[9] * b01 + mat[10] * b00) * d;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_toRotationMat(mat4_t mat, mat4_t dest) {
     if (!dest) { dest = mat4_create(NULL); }
 
     dest[0] = mat[0];
@@ -197,7 +287,7 @@ mat4_t mat4_toRotationMat(mat4_t mat, mat4_t dest) {
     return dest;
 }
 
-mat3_t mat4_toMat3(mat4_t mat, mat3_t dest) {
+GL_MATRIX_API mat3_t mat4_toMat3(mat4_t mat, mat3_t dest) {
     if (!dest) { dest = mat3_create(NULL); }
 
     dest[0] = mat[0];
@@ -213,7 +303,7 @@ mat3_t mat4_toMat3(mat4_t mat, mat3_t dest) {
     return dest;
 }
 
-mat3_t mat4_toInverseMat3(mat4_t mat, mat3_t dest) {
+GL_MATRIX_API mat3_t mat4_toInverseMat3(mat4_t mat, mat3_t dest) {
     // Cache the matrix values (makes for huge speed increases!)
     numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2],
         a10 = mat[4], a11 = mat[5], a12 = mat[6],
@@ -244,9 +334,69 @@ mat3_t mat4_toInverseMat3(mat4_t mat, mat3_t dest) {
     return dest;
 }
 
-mat4_t mat4_multiply(mat4_t mat, mat4_t mat2, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_multiply(mat4_t mat, mat4_t mat2, mat4_t dest) {
     if (!dest) { dest = mat; }
 
+    // All of mat and mat2 is loaded before the first store, so dest may alias either operand
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+    // Two result columns per 256-bit register: each lane holds one column of mat2
+    __m256 a0 = _mm256_broadcast_ps((const __m128 *)(mat)),
+        a1 = _mm256_broadcast_ps((const __m128 *)(mat + 4)),
+        a2 = _mm256_broadcast_ps((const __m128 *)(mat + 8)),
+        a3 = _mm256_broadcast_ps((const __m128 *)(mat + 12)),
+        b01 = _mm256_loadu_ps(mat2),
+        b23 = _mm256_loadu_ps(mat2 + 8),
+        r01, r23;
+
+    r01 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, 0x00));
+    r23 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, 0x00));
+    r01 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b01, b01, 0x55), r01);
+    r23 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b23, b23, 0x55), r23);
+    r01 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b01, b01, 0xAA), r01);
+    r23 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b23, b23, 0xAA), r23);
+    r01 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b01, b01, 0xFF), r01);
+    r23 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b23, b23, 0xFF), r23);
+
+    _mm256_storeu_ps(dest, r01);
+    _mm256_storeu_ps(dest + 8, r23);
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    __m128 a0 = _mm_loadu_ps(mat), a1 = _mm_loadu_ps(mat + 4),
+        a2 = _mm_loadu_ps(mat + 8), a3 = _mm_loadu_ps(mat + 12),
+        b0 = _mm_loadu_ps(mat2), b1 = _mm_loadu_ps(mat2 + 4),
+        b2 = _mm_loadu_ps(mat2 + 8), b3 = _mm_loadu_ps(mat2 + 12);
+
+    // Summed in the same order as the scalar code so both give identical results
+#define MAT4_SSE_COLUMN(b) \
+    _mm_add_ps(_mm_add_ps(_mm_add_ps( \
+        _mm_mul_ps(a0, _mm_shuffle_ps(b, b, 0x00)), \
+        _mm_mul_ps(a1, _mm_shuffle_ps(b, b, 0x55))), \
+        _mm_mul_ps(a2, _mm_shuffle_ps(b, b, 0xAA))), \
+        _mm_mul_ps(a3, _mm_shuffle_ps(b, b, 0xFF)))
+
+    _mm_storeu_ps(dest, MAT4_SSE_COLUMN(b0));
+    _mm_storeu_ps(dest + 4, MAT4_SSE_COLUMN(b1));
+    _mm_storeu_ps(dest + 8, MAT4_SSE_COLUMN(b2));
+    _mm_storeu_ps(dest + 12, MAT4_SSE_COLUMN(b3));
+#undef MAT4_SSE_COLUMN
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t a0 = vld1q_f32(mat), a1 = vld1q_f32(mat + 4),
+        a2 = vld1q_f32(mat + 8), a3 = vld1q_f32(mat + 12),
+        b0 = vld1q_f32(mat2), b1 = vld1q_f32(mat2 + 4),
+        b2 = vld1q_f32(mat2 + 8), b3 = vld1q_f32(mat2 + 12);
+
+#define MAT4_NEON_COLUMN(b) \
+    vmlaq_lane_f32(vmlaq_lane_f32(vmlaq_lane_f32( \
+        vmulq_lane_f32(a0, vget_low_f32(b), 0), \
+        a1, vget_low_f32(b), 1), \
+        a2, vget_high_f32(b), 0), \
+        a3, vget_high_f32(b), 1)
+
+    vst1q_f32(dest, MAT4_NEON_COLUMN(b0));
+    vst1q_f32(dest + 4, MAT4_NEON_COLUMN(b1));
+    vst1q_f32(dest + 8, MAT4_NEON_COLUMN(b2));
+    vst1q_f32(dest + 12, MAT4_NEON_COLUMN(b3));
+#undef MAT4_NEON_COLUMN
+#else
     // Cache the matrix values (makes for huge speed increases!)
     numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2], a03 = mat[3],
         a10 = mat[4], a11 = mat[5], a12 = mat[6], a13 = mat[7],
@@ -274,11 +424,164 @@ mat4_t mat4_multiply(mat4_t mat, mat4_t mat2, mat4_t dest) {
     dest[13] = b30 * a01 + b31 * a11 + b32 * a21 + b33 * a31;
     dest[14] = b30 * a02 + b31 * a12 + b32 * a22 + b33 * a32;
     dest[15] = b30 * a03 + b31 * a13 + b32 * a23 + b33 * a33;
+#endif
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_multiply_noalias(mat4_t GL_MATRIX_RESTRICT mat, mat4_t GL_MATRIX_RESTRICT mat2, mat4_t GL_MATRIX_RESTRICT dest) {
+    int i, j;
+
+    assert(GL_MATRIX_DISJOINT(mat, 16, dest, 16) && GL_MATRIX_DISJOINT(mat2, 16, dest, 16));
+
+    // Summed in the same order as mat4_multiply. With no aliasing to guard
+    // against, the compiler is free to vectorize this as it sees fit.
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 4; i++) {
+            dest[j * 4 + i] = mat2[j * 4] * mat[i] + mat2[j * 4 + 1] * mat[4 + i] +
+                mat2[j * 4 + 2] * mat[8 + i] + mat2[j * 4 + 3] * mat[12 + i];
+        }
+    }
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_multiplyAffine(mat4_t mat, mat4_t mat2, mat4_t dest) {
+    if (!dest) { dest = mat; }
+
+    // As in mat4_multiply, everything is loaded before the first store
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    // Only the translation column needs a3. The bottom row is set to exactly
+    // (0, 0, 0, 1) afterwards, as the scalar code writes it, whatever the w
+    // lanes of the inputs hold.
+    __m128 a0 = _mm_loadu_ps(mat), a1 = _mm_loadu_ps(mat + 4),
+        a2 = _mm_loadu_ps(mat + 8), a3 = _mm_loadu_ps(mat + 12),
+        xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)),
+        r0, r1, r2, r3;
+
+#define MAT4_AFFINE_COLUMN(j) \
+    _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(mat2[(j) * 4]), a0), \
+                          _mm_mul_ps(_mm_set1_ps(mat2[(j) * 4 + 1]), a1)), \
+               _mm_mul_ps(_mm_set1_ps(mat2[(j) * 4 + 2]), a2))
+    r0 = _mm_and_ps(MAT4_AFFINE_COLUMN(0), xyz);
+    r1 = _mm_and_ps(MAT4_AFFINE_COLUMN(1), xyz);
+    r2 = _mm_and_ps(MAT4_AFFINE_COLUMN(2), xyz);
+    r3 = _mm_or_ps(_mm_and_ps(_mm_add_ps(MAT4_AFFINE_COLUMN(3), a3), xyz), _mm_set_ps(1, 0, 0, 0));
+#undef MAT4_AFFINE_COLUMN
+
+    _mm_storeu_ps(dest, r0);
+    _mm_storeu_ps(dest + 4, r1);
+    _mm_storeu_ps(dest + 8, r2);
+    _mm_storeu_ps(dest + 12, r3);
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t a0 = vld1q_f32(mat), a1 = vld1q_f32(mat + 4),
+        a2 = vld1q_f32(mat + 8), a3 = vld1q_f32(mat + 12),
+        b0 = vld1q_f32(mat2), b1 = vld1q_f32(mat2 + 4),
+        b2 = vld1q_f32(mat2 + 8), b3 = vld1q_f32(mat2 + 12);
+
+    // The lane forms on 64-bit halves, as the laneq forms are AArch64 only
+#define MAT4_NEON_AFFINE_COLUMN(b) \
+    vmlaq_lane_f32(vmlaq_lane_f32( \
+        vmulq_lane_f32(a0, vget_low_f32(b), 0), \
+        a1, vget_low_f32(b), 1), \
+        a2, vget_high_f32(b), 0)
+
+    // With an exact (0, 0, 0, 1) bottom row, as in the SSE and scalar code
+    vst1q_f32(dest, vsetq_lane_f32(0, MAT4_NEON_AFFINE_COLUMN(b0), 3));
+    vst1q_f32(dest + 4, vsetq_lane_f32(0, MAT4_NEON_AFFINE_COLUMN(b1), 3));
+    vst1q_f32(dest + 8, vsetq_lane_f32(0, MAT4_NEON_AFFINE_COLUMN(b2), 3));
+    vst1q_f32(dest + 12, vsetq_lane_f32(1, vaddq_f32(MAT4_NEON_AFFINE_COLUMN(b3), a3), 3));
+#undef MAT4_NEON_AFFINE_COLUMN
+#else
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10],
+        a30 = mat[12], a31 = mat[13], a32 = mat[14],
+
+        b00 = mat2[0], b01 = mat2[1], b02 = mat2[2],
+        b10 = mat2[4], b11 = mat2[5], b12 = mat2[6],
+        b20 = mat2[8], b21 = mat2[9], b22 = mat2[10],
+        b30 = mat2[12], b31 = mat2[13], b32 = mat2[14];
+
+    dest[0] = b00 * a00 + b01 * a10 + b02 * a20;
+    dest[1] = b00 * a01 + b01 * a11 + b02 * a21;
+    dest[2] = b00 * a02 + b01 * a12 + b02 * a22;
+    dest[3] = 0;
+    dest[4] = b10 * a00 + b11 * a10 + b12 * a20;
+    dest[5] = b10 * a01 + b11 * a11 + b12 * a21;
+    dest[6] = b10 * a02 + b11 * a12 + b12 * a22;
+    dest[7] = 0;
+    dest[8] = b20 * a00 + b21 * a10 + b22 * a20;
+    dest[9] = b20 * a01 + b21 * a11 + b22 * a21;
+    dest[10] = b20 * a02 + b21 * a12 + b22 * a22;
+    dest[11] = 0;
+    dest[12] = b30 * a00 + b31 * a10 + b32 * a20 + a30;
+    dest[13] = b30 * a01 + b31 * a11 + b32 * a21 + a31;
+    dest[14] = b30 * a02 + b31 * a12 + b32 * a22 + a32;
+    dest[15] = 1;
+#endif
 
     return dest;
 }
 
-vec3_t mat4_multiplyVec3(mat4_t mat, vec3_t vec, vec3_t dest) {
+GL_MATRIX_API mat4_t mat4_inverseAffine(mat4_t mat, mat4_t dest) {
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10],
+        tx = mat[12], ty = mat[13], tz = mat[14],
+
+        b01 = a22 * a11 - a12 * a21,
+        b11 = -a22 * a10 + a12 * a20,
+        b21 = a21 * a10 - a11 * a20,
+
+        d = a00 * b01 + a01 * b11 + a02 * b21,
+        id, r00, r01, r02, r10, r11, r12, r20, r21, r22;
+
+    if (!d) { return NULL; }
+    if (!dest) { dest = mat; }
+    id = 1 / d;
+
+    // Inverse of the upper 3x3, as in mat4_toInverseMat3
+    r00 = b01 * id;
+    r01 = (-a22 * a01 + a02 * a21) * id;
+    r02 = (a12 * a01 - a02 * a11) * id;
+    r10 = b11 * id;
+    r11 = (a22 * a00 - a02 * a20) * id;
+    r12 = (-a12 * a00 + a02 * a10) * id;
+    r20 = b21 * id;
+    r21 = (-a21 * a00 + a01 * a20) * id;
+    r22 = (a11 * a00 - a01 * a10) * id;
+
+    dest[0] = r00; dest[1] = r01; dest[2] = r02; dest[3] = 0;
+    dest[4] = r10; dest[5] = r11; dest[6] = r12; dest[7] = 0;
+    dest[8] = r20; dest[9] = r21; dest[10] = r22; dest[11] = 0;
+    dest[12] = -(r00 * tx + r10 * ty + r20 * tz);
+    dest[13] = -(r01 * tx + r11 * ty + r21 * tz);
+    dest[14] = -(r02 * tx + r12 * ty + r22 * tz);
+    dest[15] = 1;
+
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_inverseRigid(mat4_t mat, mat4_t dest) {
+    numeric_t a00 = mat[0], a01 = mat[1], a02 = mat[2],
+        a10 = mat[4], a11 = mat[5], a12 = mat[6],
+        a20 = mat[8], a21 = mat[9], a22 = mat[10],
+        tx = mat[12], ty = mat[13], tz = mat[14];
+
+    if (!dest) { dest = mat; }
+
+    dest[0] = a00; dest[1] = a10; dest[2] = a20; dest[3] = 0;
+    dest[4] = a01; dest[5] = a11; dest[6] = a21; dest[7] = 0;
+    dest[8] = a02; dest[9] = a12; dest[10] = a22; dest[11] = 0;
+    dest[12] = -(a00 * tx + a01 * ty + a02 * tz);
+    dest[13] = -(a10 * tx + a11 * ty + a12 * tz);
+    dest[14] = -(a20 * tx + a21 * ty + a22 * tz);
+    dest[15] = 1;
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t mat4_multiplyVec3(mat4_t mat, vec3_t vec, vec3_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0], y = vec[1], z = vec[2];
@@ -290,20 +593,179 @@ vec3_t mat4_multiplyVec3(mat4_t mat, vec3_t vec, vec3_t dest) {
     return dest;
 }
 
-vec4_t mat4_multiplyVec4(mat4_t mat, vec4_t vec, vec4_t dest) {
+GL_MATRIX_API vec4_t mat4_multiplyVec4(mat4_t mat, vec4_t vec, vec4_t dest) {
     if (!dest) { dest = vec; }
 
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(mat), _mm_set1_ps(vec[0]));
+    r = _mm_fmadd_ps(_mm_loadu_ps(mat + 4), _mm_set1_ps(vec[1]), r);
+    r = _mm_fmadd_ps(_mm_loadu_ps(mat + 8), _mm_set1_ps(vec[2]), r);
+    r = _mm_fmadd_ps(_mm_loadu_ps(mat + 12), _mm_set1_ps(vec[3]), r);
+    _mm_storeu_ps(dest, r);
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    __m128 v = _mm_loadu_ps(vec),
+        r = _mm_mul_ps(_mm_loadu_ps(mat), _mm_shuffle_ps(v, v, 0x00));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(mat + 4), _mm_shuffle_ps(v, v, 0x55)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(mat + 8), _mm_shuffle_ps(v, v, 0xAA)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(mat + 12), _mm_shuffle_ps(v, v, 0xFF)));
+    _mm_storeu_ps(dest, r);
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t v = vld1q_f32(vec),
+        r = vmulq_lane_f32(vld1q_f32(mat), vget_low_f32(v), 0);
+    r = vmlaq_lane_f32(r, vld1q_f32(mat + 4), vget_low_f32(v), 1);
+    r = vmlaq_lane_f32(r, vld1q_f32(mat + 8), vget_high_f32(v), 0);
+    r = vmlaq_lane_f32(r, vld1q_f32(mat + 12), vget_high_f32(v), 1);
+    vst1q_f32(dest, r);
+#else
     numeric_t x = vec[0], y = vec[1], z = vec[2], w = vec[3];
 
     dest[0] = mat[0] * x + mat[4] * y + mat[8] * z + mat[12] * w;
     dest[1] = mat[1] * x + mat[5] * y + mat[9] * z + mat[13] * w;
     dest[2] = mat[2] * x + mat[6] * y + mat[10] * z + mat[14] * w;
     dest[3] = mat[3] * x + mat[7] * y + mat[11] * z + mat[15] * w;
+#endif
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t mat4_multiplyVec3_array(mat4_t mat, vec3_t vec, size_t count, size_t stride, vec3_t dest) {
+    const char *src = (const char *)vec;
+    char *dst;
+    size_t i;
+
+    if (!dest) { dest = vec; }
+    if (!stride) { stride = 3 * sizeof(numeric_t); }
+    dst = (char *)dest;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    __m128 m0 = _mm_loadu_ps(mat), m1 = _mm_loadu_ps(mat + 4),
+        m2 = _mm_loadu_ps(mat + 8), m3 = _mm_loadu_ps(mat + 12);
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        const numeric_t *v = (const numeric_t *)src;
+        numeric_t *d = (numeric_t *)dst;
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+        __m128 r = _mm_fmadd_ps(m0, _mm_set1_ps(v[0]), m3);
+        r = _mm_fmadd_ps(m1, _mm_set1_ps(v[1]), r);
+        r = _mm_fmadd_ps(m2, _mm_set1_ps(v[2]), r);
+#else
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(m0, _mm_set1_ps(v[0])),
+            _mm_mul_ps(m1, _mm_set1_ps(v[1]))),
+            _mm_mul_ps(m2, _mm_set1_ps(v[2]))), m3);
+#endif
+        // Store only x, y and z so we never write past the end of the vector
+        _mm_storel_pi((__m64 *)d, r);
+        _mm_store_ss(d + 2, _mm_movehl_ps(r, r));
+    }
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t m0 = vld1q_f32(mat), m1 = vld1q_f32(mat + 4),
+        m2 = vld1q_f32(mat + 8), m3 = vld1q_f32(mat + 12);
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        const numeric_t *v = (const numeric_t *)src;
+        numeric_t *d = (numeric_t *)dst;
+        float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(m3, m0, v[0]), m1, v[1]), m2, v[2]);
+        vst1_f32(d, vget_low_f32(r));
+        vst1q_lane_f32(d + 2, r, 2);
+    }
+#else
+    // Keep the matrix in locals for the whole batch
+    numeric_t m00 = mat[0], m01 = mat[1], m02 = mat[2],
+        m10 = mat[4], m11 = mat[5], m12 = mat[6],
+        m20 = mat[8], m21 = mat[9], m22 = mat[10],
+        m30 = mat[12], m31 = mat[13], m32 = mat[14];
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        const numeric_t *v = (const numeric_t *)src;
+        numeric_t *d = (numeric_t *)dst;
+        numeric_t x = v[0], y = v[1], z = v[2];
+
+        d[0] = m00 * x + m10 * y + m20 * z + m30;
+        d[1] = m01 * x + m11 * y + m21 * z + m31;
+        d[2] = m02 * x + m12 * y + m22 * z + m32;
+    }
+#endif
+
+    return dest;
+}
+
+GL_MATRIX_API vec4_t mat4_multiplyVec4_array(mat4_t mat, vec4_t vec, size_t count, size_t stride, vec4_t dest) {
+    const char *src = (const char *)vec;
+    char *dst;
+    size_t i;
+
+    if (!dest) { dest = vec; }
+    if (!stride) { stride = 4 * sizeof(numeric_t); }
+    dst = (char *)dest;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    __m128 m0 = _mm_loadu_ps(mat), m1 = _mm_loadu_ps(mat + 4),
+        m2 = _mm_loadu_ps(mat + 8), m3 = _mm_loadu_ps(mat + 12);
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+#define MAT4_VEC4_PRODUCT(v) \
+    _mm_fmadd_ps(m3, _mm_shuffle_ps(v, v, 0xFF), \
+    _mm_fmadd_ps(m2, _mm_shuffle_ps(v, v, 0xAA), \
+    _mm_fmadd_ps(m1, _mm_shuffle_ps(v, v, 0x55), \
+    _mm_mul_ps(m0, _mm_shuffle_ps(v, v, 0x00)))))
+#else
+#define MAT4_VEC4_PRODUCT(v) \
+    _mm_add_ps(_mm_add_ps(_mm_add_ps( \
+        _mm_mul_ps(m0, _mm_shuffle_ps(v, v, 0x00)), \
+        _mm_mul_ps(m1, _mm_shuffle_ps(v, v, 0x55))), \
+        _mm_mul_ps(m2, _mm_shuffle_ps(v, v, 0xAA))), \
+        _mm_mul_ps(m3, _mm_shuffle_ps(v, v, 0xFF)))
+#endif
+#define MAT4_VEC4_LOOP(load, store) \
+    for (i = 0; i < count; i++, src += stride, dst += stride) { \
+        __m128 v = load((const numeric_t *)src); \
+        store((numeric_t *)dst, MAT4_VEC4_PRODUCT(v)); \
+    }
+
+    // Checked once for the whole batch: if every vector is 16 byte aligned,
+    // aligned loads and stores are used throughout
+    if (((size_t)src | (size_t)dst | stride) % 16 == 0) {
+        MAT4_VEC4_LOOP(_mm_load_ps, _mm_store_ps)
+    } else {
+        MAT4_VEC4_LOOP(_mm_loadu_ps, _mm_storeu_ps)
+    }
+#undef MAT4_VEC4_LOOP
+#undef MAT4_VEC4_PRODUCT
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+    float32x4_t m0 = vld1q_f32(mat), m1 = vld1q_f32(mat + 4),
+        m2 = vld1q_f32(mat + 8), m3 = vld1q_f32(mat + 12);
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        float32x4_t v = vld1q_f32((const numeric_t *)src),
+            r = vmulq_lane_f32(m0, vget_low_f32(v), 0);
+        r = vmlaq_lane_f32(r, m1, vget_low_f32(v), 1);
+        r = vmlaq_lane_f32(r, m2, vget_high_f32(v), 0);
+        r = vmlaq_lane_f32(r, m3, vget_high_f32(v), 1);
+        vst1q_f32((numeric_t *)dst, r);
+    }
+#else
+    numeric_t m00 = mat[0], m01 = mat[1], m02 = mat[2], m03 = mat[3],
+        m10 = mat[4], m11 = mat[5], m12 = mat[6], m13 = mat[7],
+        m20 = mat[8], m21 = mat[9], m22 = mat[10], m23 = mat[11],
+        m30 = mat[12], m31 = mat[13], m32 = mat[14], m33 = mat[15];
+
+    for (i = 0; i < count; i++, src += stride, dst += stride) {
+        const numeric_t *v = (const numeric_t *)src;
+        numeric_t *d = (numeric_t *)dst;
+        numeric_t x = v[0], y = v[1], z = v[2], w = v[3];
+
+        d[0] = m00 * x + m10 * y + m20 * z + m30 * w;
+        d[1] = m01 * x + m11 * y + m21 * z + m31 * w;
+        d[2] = m02 * x + m12 * y + m22 * z + m32 * w;
+        d[3] = m03 * x + m13 * y + m23 * z + m33 * w;
+    }
+#endif
 
     return dest;
 }
 
-mat4_t mat4_translate(mat4_t mat, vec3_t vec, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_translate(mat4_t mat, vec3_t vec, mat4_t dest) {
     numeric_t x = vec[0], y = vec[1], z = vec[2],
         a00, a01, a02, a03,
         a10, a11, a12, a13,
@@ -332,7 +794,7 @@ mat4_t mat4_translate(mat4_t mat, vec3_t vec, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_scale(mat4_t mat, vec3_t vec, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_scale(mat4_t mat, vec3_t vec, mat4_t dest) {
     numeric_t x = vec[0], y = vec[1], z = vec[2];
 
     if (!dest || mat == dest) {
@@ -370,7 +832,7 @@ mat4_t mat4_scale(mat4_t mat, vec3_t vec, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_scale_scalar(mat4_t mat, numeric_t scalar, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_scale_scalar(mat4_t mat, numeric_t scalar, mat4_t dest) {
     if (!dest || mat == dest) {
         mat[0] *= scalar;
         mat[1] *= scalar;
@@ -406,9 +868,9 @@ mat4_t mat4_scale_scalar(mat4_t mat, numeric_t scalar, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_rotate(mat4_t mat, numeric_t angle, vec3_t axis, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_rotate(mat4_t mat, numeric_t angle, vec3_t axis, mat4_t dest) {
     numeric_t x = axis[0], y = axis[1], z = axis[2],
-        len = sqrt(x * x + y * y + z * z),
+        len = glm_sqrt(x * x + y * y + z * z),
         s, c, t,
         a00, a01, a02, a03,
         a10, a11, a12, a13,
@@ -425,8 +887,8 @@ mat4_t mat4_rotate(mat4_t mat, numeric_t angle, vec3_t axis, mat4_t dest) {
         z *= len;
     }
 
-    s = sin(angle);
-    c = cos(angle);
+    s = glm_sin(angle);
+    c = glm_cos(angle);
     t = 1 - c;
 
     a00 = mat[0]; a01 = mat[1]; a02 = mat[2]; a03 = mat[3];
@@ -465,9 +927,9 @@ mat4_t mat4_rotate(mat4_t mat, numeric_t angle, vec3_t axis, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_rotateX(mat4_t mat, numeric_t angle, mat4_t dest) {
-    numeric_t s = sin(angle),
-        c = cos(angle),
+GL_MATRIX_API mat4_t mat4_rotateX(mat4_t mat, numeric_t angle, mat4_t dest) {
+    numeric_t s = glm_sin(angle),
+        c = glm_cos(angle),
         a10 = mat[4],
         a11 = mat[5],
         a12 = mat[6],
@@ -504,9 +966,9 @@ mat4_t mat4_rotateX(mat4_t mat, numeric_t angle, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_rotateY(mat4_t mat, numeric_t angle, mat4_t dest) {
-    numeric_t s = sin(angle),
-        c = cos(angle),
+GL_MATRIX_API mat4_t mat4_rotateY(mat4_t mat, numeric_t angle, mat4_t dest) {
+    numeric_t s = glm_sin(angle),
+        c = glm_cos(angle),
         a00 = mat[0],
         a01 = mat[1],
         a02 = mat[2],
@@ -543,9 +1005,9 @@ mat4_t mat4_rotateY(mat4_t mat, numeric_t angle, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_rotateZ(mat4_t mat, numeric_t angle, mat4_t dest) {
-    numeric_t s = sin(angle),
-        c = cos(angle),
+GL_MATRIX_API mat4_t mat4_rotateZ(mat4_t mat, numeric_t angle, mat4_t dest) {
+    numeric_t s = glm_sin(angle),
+        c = glm_cos(angle),
         a00 = mat[0],
         a01 = mat[1],
         a02 = mat[2],
@@ -583,7 +1045,7 @@ mat4_t mat4_rotateZ(mat4_t mat, numeric_t angle, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest) {
     if (!dest) { dest = mat4_create(NULL); }
     numeric_t rl = (right - left),
         tb = (top - bottom),
@@ -607,13 +1069,13 @@ mat4_t mat4_frustum(numeric_t left, numeric_t right, numeric_t bottom, numeric_t
     return dest;
 }
 
-mat4_t mat4_perspective(numeric_t fovy, numeric_t aspect, numeric_t near, numeric_t far, mat4_t dest) {
-    numeric_t top = near * tan(fovy * 3.14159265358979323846 / 360.0),
+GL_MATRIX_API mat4_t mat4_perspective(numeric_t fovy, numeric_t aspect, numeric_t near, numeric_t far, mat4_t dest) {
+    numeric_t top = near * glm_tan(fovy * (numeric_t)(3.14159265358979323846 / 360.0)),
         right = top * aspect;
     return mat4_frustum(-right, right, -top, top, near, far, dest);
 }
 
-mat4_t mat4_ortho(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_ortho(numeric_t left, numeric_t right, numeric_t bottom, numeric_t top, numeric_t near, numeric_t far, mat4_t dest) {
     if (!dest) { dest = mat4_create(NULL); }
     numeric_t rl = (right - left),
         tb = (top - bottom),
@@ -637,7 +1099,7 @@ mat4_t mat4_ortho(numeric_t left, numeric_t right, numeric_t bottom, numeric_t t
     return dest;
 }
 
-mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest) {
     if (!dest) { dest = mat4_create(NULL); }
 
     numeric_t x0, x1, x2, y0, y1, y2, z0, z1, z2, len,
@@ -661,7 +1123,7 @@ mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest) {
     z2 = eyez - centerz;
 
     // normalize (no check needed for 0 because of early return)
-    len = 1 / sqrt(z0 * z0 + z1 * z1 + z2 * z2);
+    len = 1 / glm_sqrt(z0 * z0 + z1 * z1 + z2 * z2);
     z0 *= len;
     z1 *= len;
     z2 *= len;
@@ -670,7 +1132,7 @@ mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest) {
     x0 = upy * z2 - upz * z1;
     x1 = upz * z0 - upx * z2;
     x2 = upx * z1 - upy * z0;
-    len = sqrt(x0 * x0 + x1 * x1 + x2 * x2);
+    len = glm_sqrt(x0 * x0 + x1 * x1 + x2 * x2);
     if (!len) {
         x0 = 0;
         x1 = 0;
@@ -687,7 +1149,7 @@ mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest) {
     y1 = z2 * x0 - z0 * x2;
     y2 = z0 * x1 - z1 * x0;
 
-    len = sqrt(y0 * y0 + y1 * y1 + y2 * y2);
+    len = glm_sqrt(y0 * y0 + y1 * y1 + y2 * y2);
     if (!len) {
         y0 = 0;
         y1 = 0;
@@ -719,7 +1181,7 @@ mat4_t mat4_lookAt(vec3_t eye, vec3_t center, vec3_t up, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_fromRotationTranslation(quat_t quat, vec3_t vec, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_fromRotationTranslation(quat_t quat, vec3_t vec, mat4_t dest) {
     if (!dest) { dest = mat4_create(NULL); }
 
     // Quaternion math
@@ -758,19 +1220,19 @@ mat4_t mat4_fromRotationTranslation(quat_t quat, vec3_t vec, mat4_t dest) {
     return dest;
 }
 
-mat4_t mat4_alignVectors(vec3_t from, vec3_t to, mat4_t dest) {
+GL_MATRIX_API mat4_t mat4_alignVectors(vec3_t from, vec3_t to, mat4_t dest) {
 	// Adapted from https://gist.github.com/kevinmoran/b45980723e53edeb8a5a43c49f134724
 
-	float axis[3];
-	float cosA = vec3_dot(from, to);
+	numeric_t axis[3];
+	numeric_t cosA = vec3_dot(from, to);
 
 	// See https://www.j3d.org/matrix_faq/matrfaq_latest.html#Q39
 	// If the angles are nearly opposite (dot product == -1) then the cross product will be zero
 	// and won't be usable as an axis, so we rotate `from` with an arbitrary 90 degrees
-	if(fabs(cosA + 1.f) < 0.001) {
+	if(glm_fabs(cosA + 1.f) < 0.001f) {
 		// http://www.gamedev.net/forums/topic/357797-rotate-a-vector-by-90-degrees/3348469/
-		float alt[3] = {from[0], -from[2], from[1]}; //x, -z, y
-		if(fabs(vec3_dot(alt, to) + 1.f) < 0.001) {
+		numeric_t alt[3] = {from[0], -from[2], from[1]}; //x, -z, y
+		if(glm_fabs(vec3_dot(alt, to) + 1.f) < 0.001f) {
 			// Still to close, use a different axis
 			alt[0] = -from[2], alt[1] = from[1], alt[2] = from[0];
 		}
@@ -779,7 +1241,7 @@ mat4_t mat4_alignVectors(vec3_t from, vec3_t to, mat4_t dest) {
 		vec3_cross(from, to, axis);
 	}
 
-	const float k = 1.0f / (1.0f + cosA);
+	const numeric_t k = 1.0f / (1.0f + cosA);
 
 	dest[ 0] = (axis[0] * axis[0] * k) + cosA;
 	dest[ 4] = (axis[1] * axis[0] * k) - axis[2];
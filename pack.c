@@ -0,0 +1,268 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "gl-matrix.h"
+
+// 1 / sqrt(2), the largest magnitude of any but the largest component of a
+// unit quaternion
+#define PACK_SQRT1_2 0.70710678118654752440
+
+// Splits a unit quaternion into the index of its largest component and the
+// other three, mapped from [-1/sqrt(2), 1/sqrt(2)] to integers in [0, max].
+// The largest component is made positive, as q and -q are the same rotation.
+static unsigned int pack_smallestThree(quat_t quat, uint32_t max, uint32_t *values) {
+    unsigned int i, j, largest = 0;
+    numeric_t scale = (numeric_t)(max / (2 * PACK_SQRT1_2)), half = (numeric_t)max / 2, v;
+
+    for (i = 1; i < 4; i++) {
+        if (glm_fabs(quat[i]) > glm_fabs(quat[largest])) { largest = i; }
+    }
+    if (quat[largest] < 0) { scale = -scale; }
+
+    for (i = 0, j = 0; i < 4; i++) {
+        if (i == largest) { continue; }
+        v = quat[i] * scale + half;
+        if (v < 0) { v = 0; }
+        if (v > max) { v = (numeric_t)max; }
+        values[j++] = (uint32_t)(v + (numeric_t)0.5);
+    }
+    return largest;
+}
+
+static quat_t pack_unsmallestThree(unsigned int largest, uint32_t max, const uint32_t *values, quat_t dest) {
+    numeric_t scale = (numeric_t)(2 * PACK_SQRT1_2 / max), sum = 0, v;
+    unsigned int i, j;
+
+    for (i = 0, j = 0; i < 4; i++) {
+        if (i == largest) { continue; }
+        v = values[j++] * scale - (numeric_t)PACK_SQRT1_2;
+        dest[i] = v;
+        sum += v * v;
+    }
+    dest[largest] = sum < 1 ? glm_sqrt(1 - sum) : 0;
+    return dest;
+}
+
+GL_MATRIX_API uint32_t quat_pack32(quat_t quat) {
+    uint32_t values[3];
+    unsigned int largest = pack_smallestThree(quat, 1023, values);
+
+    return (uint32_t)largest << 30 | values[0] << 20 | values[1] << 10 | values[2];
+}
+
+GL_MATRIX_API quat_t quat_unpack32(uint32_t packed, quat_t dest) {
+    uint32_t values[3];
+
+    values[0] = (packed >> 20) & 1023;
+    values[1] = (packed >> 10) & 1023;
+    values[2] = packed & 1023;
+    return pack_unsmallestThree(packed >> 30, 1023, values, dest);
+}
+
+GL_MATRIX_API uint16_t *quat_pack48(quat_t quat, uint16_t *dest) {
+    uint32_t values[3];
+    unsigned int largest = pack_smallestThree(quat, 32767, values);
+
+    // 2 bits of index and 3 * 15 bits of components, from the top bit down
+    dest[0] = (uint16_t)(largest << 14 | values[0] >> 1);
+    dest[1] = (uint16_t)((values[0] & 1) << 15 | values[1]);
+    dest[2] = (uint16_t)values[2];
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_unpack48(const uint16_t *packed, quat_t dest) {
+    uint32_t values[3];
+
+    values[0] = (uint32_t)(packed[0] & 0x3FFF) << 1 | packed[1] >> 15;
+    values[1] = packed[1] & 0x7FFF;
+    values[2] = packed[2] & 0x7FFF;
+    return pack_unsmallestThree(packed[0] >> 14, 32767, values, dest);
+}
+
+GL_MATRIX_API uint32_t *quat_pack32_array(quat_t quat, size_t count, uint32_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = quat_pack32(quat + i * 4);
+    }
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_unpack32_array(const uint32_t *packed, size_t count, quat_t dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        quat_unpack32(packed[i], dest + i * 4);
+    }
+    return dest;
+}
+
+GL_MATRIX_API uint16_t *quat_pack48_array(quat_t quat, size_t count, uint16_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        quat_pack48(quat + i * 4, dest + i * 3);
+    }
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_unpack48_array(const uint16_t *packed, size_t count, quat_t dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        quat_unpack48(packed + i * 3, dest + i * 4);
+    }
+    return dest;
+}
+
+// IEEE 754 binary16, rounding to nearest even
+static uint16_t pack_toHalf(float value) {
+    uint32_t bits, sign, result, rest, shift;
+
+    memcpy(&bits, &value, sizeof bits);
+    sign = (bits >> 16) & 0x8000;
+    bits &= 0x7FFFFFFF;
+
+    // NaN stays a (quiet) NaN; 65520 and up round to infinity
+    if (bits > 0x7F800000) { return (uint16_t)(sign | 0x7E00); }
+    if (bits >= 0x477FF000) { return (uint16_t)(sign | 0x7C00); }
+
+    if (bits >= 0x38800000) {
+        // Normal: rebias the exponent from 127 to 15 and round off 13 bits
+        result = (bits - 0x38000000) >> 13;
+        rest = bits & 0x1FFF;
+    } else {
+        // Subnormal, in units of 2^-24. Below 2^-25 everything rounds to 0.
+        if (bits < 0x33000000) { return (uint16_t)sign; }
+        shift = 126 - (bits >> 23);
+        bits = (bits & 0x7FFFFF) | 0x800000;
+        result = bits >> shift;
+        rest = bits & ((1u << shift) - 1);
+        if (rest > 1u << (shift - 1) || (rest == 1u << (shift - 1) && (result & 1))) { result++; }
+        return (uint16_t)(sign | result);
+    }
+
+    if (rest > 0x1000 || (rest == 0x1000 && (result & 1))) { result++; }
+    return (uint16_t)(sign | result);
+}
+
+static float pack_fromHalf(uint16_t half) {
+    uint32_t sign = (uint32_t)(half & 0x8000) << 16, exponent = (half >> 10) & 0x1F, mantissa = half & 0x3FF, bits;
+    float value;
+
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000 | mantissa << 13;
+    } else if (exponent) {
+        bits = sign | (exponent + 112) << 23 | mantissa << 13;
+    } else {
+        // Subnormal or zero: mantissa * 2^-24 is exact in a float
+        value = (float)mantissa * 5.9604644775390625e-8f;
+        return sign ? -value : value;
+    }
+
+    memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+GL_MATRIX_API uint16_t *half_pack(const numeric_t *values, size_t count, uint16_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = pack_toHalf((float)values[i]);
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *half_unpack(const uint16_t *packed, size_t count, numeric_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        dest[i] = pack_fromHalf(packed[i]);
+    }
+    return dest;
+}
+
+GL_MATRIX_API mat4_trs_t *mat4_packTRS(mat4_t mat, mat4_trs_t *dest) {
+    numeric_t scale[3], r[9], q[4], cross[3], trace, s;
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        numeric_t *column = mat + i * 4;
+        scale[i] = glm_sqrt(column[0] * column[0] + column[1] * column[1] + column[2] * column[2]);
+        s = scale[i] ? 1 / scale[i] : 0;
+        r[i * 3] = column[0] * s;
+        r[i * 3 + 1] = column[1] * s;
+        r[i * 3 + 2] = column[2] * s;
+        dest->translation[i] = (float)mat[12 + i];
+    }
+
+    // A mirroring matrix is a rotation with a negative scale
+    vec3_cross(r, r + 3, cross);
+    if (vec3_dot(cross, r + 6) < 0) {
+        scale[0] = -scale[0];
+        r[0] = -r[0];
+        r[1] = -r[1];
+        r[2] = -r[2];
+    }
+
+    // Rotation matrix to quaternion, dividing by the largest of 4w, 4x, 4y
+    // and 4z for accuracy. r is column major: r[c * 3 + row].
+    trace = r[0] + r[4] + r[8];
+    if (trace > 0) {
+        s = glm_sqrt(trace + 1) * 2;
+        q[3] = s / 4;
+        q[0] = (r[5] - r[7]) / s;
+        q[1] = (r[6] - r[2]) / s;
+        q[2] = (r[1] - r[3]) / s;
+    } else if (r[0] > r[4] && r[0] > r[8]) {
+        s = glm_sqrt(1 + r[0] - r[4] - r[8]) * 2;
+        q[3] = (r[5] - r[7]) / s;
+        q[0] = s / 4;
+        q[1] = (r[3] + r[1]) / s;
+        q[2] = (r[6] + r[2]) / s;
+    } else if (r[4] > r[8]) {
+        s = glm_sqrt(1 + r[4] - r[0] - r[8]) * 2;
+        q[3] = (r[6] - r[2]) / s;
+        q[0] = (r[3] + r[1]) / s;
+        q[1] = s / 4;
+        q[2] = (r[7] + r[5]) / s;
+    } else {
+        s = glm_sqrt(1 + r[8] - r[0] - r[4]) * 2;
+        q[3] = (r[1] - r[3]) / s;
+        q[0] = (r[6] + r[2]) / s;
+        q[1] = (r[7] + r[5]) / s;
+        q[2] = s / 4;
+    }
+
+    quat_normalize(q, NULL);
+    quat_pack48(q, dest->rotation);
+    half_pack(scale, 3, dest->scale);
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_unpackTRS(const mat4_trs_t *trs, mat4_t dest) {
+    numeric_t q[4], t[3], scale[3];
+
+    t[0] = trs->translation[0];
+    t[1] = trs->translation[1];
+    t[2] = trs->translation[2];
+    quat_unpack48(trs->rotation, q);
+    half_unpack(trs->scale, 3, scale);
+
+    mat4_fromRotationTranslation(q, t, dest);
+    return mat4_scale(dest, scale, NULL);
+}
+
+GL_MATRIX_API mat4_trs_t *mat4_packTRS_array(mat4_t mat, size_t count, mat4_trs_t *dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        mat4_packTRS(mat + i * 16, dest + i);
+    }
+    return dest;
+}
+
+GL_MATRIX_API mat4_t mat4_unpackTRS_array(const mat4_trs_t *trs, size_t count, mat4_t dest) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        mat4_unpackTRS(trs + i, dest + i * 16);
+    }
+    return dest;
+}
+
+#undef PACK_SQRT1_2
@@ -0,0 +1,562 @@
+#include <string.h>
+#include <stdint.h>
+
+#include "gl-matrix.h"
+
+/*
+ * Number parsing, the counterpart of format.c.
+ *
+ * The digits are gathered into a 64 bit integer w and a decimal exponent q,
+ * and w * 10^q is rounded to a float or double with the Eisel-Lemire
+ * algorithm (Daniel Lemire, "Number Parsing at a Gigabyte per Second",
+ * 2021): w is multiplied by a 128 bit approximation of 5^q, and the result
+ * is correctly rounded unless it is too close to a tie to tell. Those rare
+ * cases, numbers of more than 19 digits, exponents outside the table and
+ * subnormal results go to the slow path instead: the simple decimal
+ * conversion used by Go's strconv and by fast_float (Nigel Tao, "The Simple
+ * Decimal Conversion Algorithm", 2020). It holds the digits in a fixed
+ * buffer and shifts them by powers of two until the binary exponent and
+ * mantissa fall out, so it doesn't depend on the locale or allocate.
+ */
+
+#define PARSE_MIN_POWER (-64)
+#define PARSE_MAX_POWER 64
+
+// Digits the slow path keeps. Enough to decide every tie, the rest only
+// count as nonzero or not.
+#define PARSE_DIGITS 800
+// Largest shift at once, so the slow path's arithmetic fits 64 bits
+#define PARSE_MAX_SHIFT 60
+
+// 5^q for q in [PARSE_MIN_POWER, PARSE_MAX_POWER], normalized to 128 bits:
+// the high and then the low 64 bits
+static const uint64_t glm_parse_pow5[] = {
+    0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL,
+    0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL,
+    0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL,
+    0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL,
+    0xCDB02555653131B6ULL, 0x3792F412CB06794DULL,
+    0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL,
+    0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL,
+    0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL,
+    0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL,
+    0x9CED737BB6C4183DULL, 0x55464DD69685606BULL,
+    0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL,
+    0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL,
+    0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL,
+    0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL,
+    0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL,
+    0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL,
+    0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL,
+    0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL,
+    0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL,
+    0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL,
+    0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL,
+    0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL,
+    0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL,
+    0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL,
+    0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL,
+    0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL,
+    0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL,
+    0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL,
+    0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL,
+    0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL,
+    0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL,
+    0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL,
+    0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL,
+    0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL,
+    0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL,
+    0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL,
+    0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL,
+    0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL,
+    0xC612062576589DDAULL, 0x95364AFE032A819EULL,
+    0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL,
+    0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL,
+    0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL,
+    0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL,
+    0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL,
+    0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL,
+    0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL,
+    0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL,
+    0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL,
+    0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL,
+    0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL,
+    0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL,
+    0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL,
+    0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL,
+    0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL,
+    0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL,
+    0x89705F4136B4A597ULL, 0x31680A88F8953031ULL,
+    0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL,
+    0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL,
+    0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL,
+    0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL,
+    0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL,
+    0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL,
+    0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL,
+    0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL,
+    0xA000000000000000ULL, 0x0000000000000000ULL,
+    0xC800000000000000ULL, 0x0000000000000000ULL,
+    0xFA00000000000000ULL, 0x0000000000000000ULL,
+    0x9C40000000000000ULL, 0x0000000000000000ULL,
+    0xC350000000000000ULL, 0x0000000000000000ULL,
+    0xF424000000000000ULL, 0x0000000000000000ULL,
+    0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xBEBC200000000000ULL, 0x0000000000000000ULL,
+    0xEE6B280000000000ULL, 0x0000000000000000ULL,
+    0x9502F90000000000ULL, 0x0000000000000000ULL,
+    0xBA43B74000000000ULL, 0x0000000000000000ULL,
+    0xE8D4A51000000000ULL, 0x0000000000000000ULL,
+    0x9184E72A00000000ULL, 0x0000000000000000ULL,
+    0xB5E620F480000000ULL, 0x0000000000000000ULL,
+    0xE35FA931A0000000ULL, 0x0000000000000000ULL,
+    0x8E1BC9BF04000000ULL, 0x0000000000000000ULL,
+    0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL,
+    0xDE0B6B3A76400000ULL, 0x0000000000000000ULL,
+    0x8AC7230489E80000ULL, 0x0000000000000000ULL,
+    0xAD78EBC5AC620000ULL, 0x0000000000000000ULL,
+    0xD8D726B7177A8000ULL, 0x0000000000000000ULL,
+    0x878678326EAC9000ULL, 0x0000000000000000ULL,
+    0xA968163F0A57B400ULL, 0x0000000000000000ULL,
+    0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL,
+    0x84595161401484A0ULL, 0x0000000000000000ULL,
+    0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL,
+    0xCECB8F27F4200F3AULL, 0x0000000000000000ULL,
+    0x813F3978F8940984ULL, 0x4000000000000000ULL,
+    0xA18F07D736B90BE5ULL, 0x5000000000000000ULL,
+    0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL,
+    0xFC6F7C4045812296ULL, 0x4D00000000000000ULL,
+    0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL,
+    0xC5371912364CE305ULL, 0x6C28000000000000ULL,
+    0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL,
+    0x9A130B963A6C115CULL, 0x3C7F400000000000ULL,
+    0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL,
+    0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL,
+    0x96769950B50D88F4ULL, 0x1314448000000000ULL,
+    0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL,
+    0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL,
+    0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL,
+    0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL,
+    0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL,
+    0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL,
+    0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL,
+    0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL,
+    0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL,
+    0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL,
+    0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL,
+    0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL,
+    0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL,
+    0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL,
+    0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL,
+    0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL,
+    0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL,
+    0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL,
+    0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL,
+    0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL,
+    0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL,
+    0x9F4F2726179A2245ULL, 0x01D762422C946590ULL,
+    0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL,
+    0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL,
+    0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL,
+    0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL
+};
+
+typedef struct {
+    uint64_t w;
+    int q;
+    int negative;
+    // More significant digits than fit in w, which the slow path handles
+    int truncated;
+    // 'i' for infinity, 'n' for NaN, 0 for a finite number
+    char special;
+} glm_parse_decimal;
+
+// Scans a number: an optional sign, digits with an optional decimal point,
+// an optional exponent, or inf/infinity/nan in any case. Returns the end of
+// the number, NULL if there isn't one.
+static const char *glm_parse_scan(const char *str, glm_parse_decimal *d) {
+    const char *p = str, *digits;
+    uint64_t w = 0;
+    int significant = 0, exponent = 0, q = 0, truncated = 0;
+
+    d->w = 0;
+    d->q = 0;
+    d->truncated = 0;
+    d->special = 0;
+    d->negative = *p == '-';
+    if (*p == '-' || *p == '+') { p++; }
+
+    if ((p[0] | 0x20) == 'i' && (p[1] | 0x20) == 'n' && (p[2] | 0x20) == 'f') {
+        d->special = 'i';
+        p += 3;
+        if ((p[0] | 0x20) == 'i' && (p[1] | 0x20) == 'n' && (p[2] | 0x20) == 'i' &&
+            (p[3] | 0x20) == 't' && (p[4] | 0x20) == 'y') {
+            p += 5;
+        }
+        return p;
+    }
+    if ((p[0] | 0x20) == 'n' && (p[1] | 0x20) == 'a' && (p[2] | 0x20) == 'n') {
+        d->special = 'n';
+        return p + 3;
+    }
+
+    // Gathered in locals: stores through d could alias the text
+    digits = p;
+    for (; *p >= '0' && *p <= '9'; p++) {
+        if (significant < 19) {
+            w = w * 10 + (uint64_t)(*p - '0');
+            significant += w != 0;
+        } else {
+            q++;
+            truncated |= *p != '0';
+        }
+    }
+    if (*p == '.') {
+        for (p++; *p >= '0' && *p <= '9'; p++) {
+            if (significant < 19) {
+                w = w * 10 + (uint64_t)(*p - '0');
+                significant += w != 0;
+                q--;
+            } else {
+                truncated |= *p != '0';
+            }
+        }
+    }
+    // "." and "" aren't numbers
+    if (p == digits || (p == digits + 1 && *digits == '.')) { return NULL; }
+
+    if ((*p | 0x20) == 'e') {
+        const char *e = p + 1;
+        int negative = *e == '-';
+
+        if (*e == '-' || *e == '+') { e++; }
+        if (*e >= '0' && *e <= '9') {
+            for (; *e >= '0' && *e <= '9'; e++) {
+                // Large enough to overflow or underflow any double
+                if (exponent < 100000) { exponent = exponent * 10 + (*e - '0'); }
+            }
+            q += negative ? -exponent : exponent;
+            p = e;
+        }
+    }
+
+    d->w = w;
+    d->q = q;
+    d->truncated = truncated;
+    return p;
+}
+
+// The high 64 bits of a * b, and the low 64 in *low
+static uint64_t glm_parse_multiply(uint64_t a, uint64_t b, uint64_t *low) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+
+    *low = (uint64_t)product;
+    return (uint64_t)(product >> 64);
+#else
+    const uint64_t m32 = 0xFFFFFFFFULL;
+    uint64_t a0 = a & m32, a1 = a >> 32, b0 = b & m32, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t middle = (p00 >> 32) + (p01 & m32) + (p10 & m32);
+
+    *low = (middle << 32) | (p00 & m32);
+    return p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+#endif
+}
+
+// Eisel-Lemire. Rounds w * 10^q (w != 0) to a binary float with `bits`
+// explicit mantissa bits and exponent bias `bias`, and returns its bit
+// pattern without the sign, or 0 if the fallback is needed.
+static uint64_t glm_parse_eiselLemire(uint64_t w, int q, int bits, int bias) {
+    const uint64_t *power;
+    uint64_t high, low, secondHigh, secondLow, mantissa, mask;
+    int leading = 0, upper, shift, exponent;
+
+    if (q < PARSE_MIN_POWER || q > PARSE_MAX_POWER) { return 0; }
+    power = glm_parse_pow5 + 2 * (q - PARSE_MIN_POWER);
+
+#if defined(__GNUC__) || defined(__clang__)
+    leading = __builtin_clzll(w);
+    w <<= leading;
+#else
+    while (!(w & (1ULL << 63))) {
+        w <<= 1;
+        leading++;
+    }
+#endif
+
+    // The low half of 5^q only matters when the bits below the mantissa
+    // and its rounding bits are all ones
+    high = glm_parse_multiply(w, power[0], &low);
+    mask = 0xFFFFFFFFFFFFFFFFULL >> (bits + 3);
+    if ((high & mask) == mask) {
+        secondHigh = glm_parse_multiply(w, power[1], &secondLow);
+        low += secondHigh;
+        if (secondHigh > low) { high++; }
+    }
+
+    upper = (int)(high >> 63);
+    shift = upper + 64 - bits - 3;
+    mantissa = high >> shift;
+    // floor(q * log2(10)) + 63, with the shift rounding toward -infinity
+    exponent = ((217706 * q) >> 16) + 63 + upper - leading + bias;
+
+    // Subnormals, and exact ties, which the product can't tell apart from
+    // numbers just above or below them
+    if (exponent <= 0 || (low <= 1 && (mantissa & 3) == 1 && (mantissa << shift) == high)) { return 0; }
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= 2ULL << bits) {
+        mantissa = 1ULL << bits;
+        exponent++;
+    }
+    mantissa &= ~(1ULL << bits);
+
+    // Infinity
+    if (exponent >= 2 * bias + 1) { return (uint64_t)(2 * bias + 1) << bits; }
+    return mantissa | (uint64_t)exponent << bits;
+}
+
+// A decimal number 0.digits * 10^point for the slow path, with the digits
+// as values 0-9 and no trailing zeros. The slack past PARSE_DIGITS takes
+// the digits a left shift adds before they are trimmed.
+typedef struct {
+    unsigned char digits[PARSE_DIGITS + 20];
+    int count;
+    int point;
+    // Nonzero digits were dropped past PARSE_DIGITS
+    int truncated;
+} glm_parse_big;
+
+static void glm_parse_trim(glm_parse_big *b) {
+    while (b->count > 0 && b->digits[b->count - 1] == 0) { b->count--; }
+    if (!b->count) { b->point = 0; }
+}
+
+// Multiplies b by 2^shift, shift <= PARSE_MAX_SHIFT
+static void glm_parse_shiftLeft(glm_parse_big *b, int shift) {
+    // 2^shift has at most this many digits, and the product at most this
+    // many more than b
+    int grow = ((shift * 1233) >> 12) + 1, r = b->count, w = b->count + grow, i;
+    uint64_t n = 0;
+
+    while (r > 0) {
+        n += (uint64_t)b->digits[--r] << shift;
+        b->digits[--w] = (unsigned char)(n % 10);
+        n /= 10;
+    }
+    while (n > 0) {
+        b->digits[--w] = (unsigned char)(n % 10);
+        n /= 10;
+    }
+
+    // w is the number of unused leading places
+    b->count += grow - w;
+    b->point += grow - w;
+    if (w) { memmove(b->digits, b->digits + w, (size_t)b->count); }
+    if (b->count > PARSE_DIGITS) {
+        for (i = PARSE_DIGITS; i < b->count; i++) { b->truncated |= b->digits[i] != 0; }
+        b->count = PARSE_DIGITS;
+    }
+    glm_parse_trim(b);
+}
+
+// Divides b by 2^shift, shift <= PARSE_MAX_SHIFT
+static void glm_parse_shiftRight(glm_parse_big *b, int shift) {
+    uint64_t n = 0, mask = (1ULL << shift) - 1;
+    int r = 0, w = 0;
+
+    // Enough leading digits for the first digit of the quotient
+    while (!(n >> shift)) {
+        if (r < b->count) {
+            n = n * 10 + b->digits[r];
+        } else if (n) {
+            n *= 10;
+        } else {
+            b->count = 0;
+            b->point = 0;
+            return;
+        }
+        r++;
+    }
+    b->point -= r - 1;
+
+    for (; r < b->count; r++) {
+        unsigned char digit = b->digits[r];
+
+        b->digits[w++] = (unsigned char)(n >> shift);
+        n = (n & mask) * 10 + digit;
+    }
+    while (n > 0) {
+        if (w < PARSE_DIGITS) {
+            b->digits[w++] = (unsigned char)(n >> shift);
+        } else if (n >> shift) {
+            b->truncated = 1;
+        }
+        n = (n & mask) * 10;
+    }
+    b->count = w;
+    glm_parse_trim(b);
+}
+
+static void glm_parse_shift(glm_parse_big *b, int shift) {
+    if (!b->count) { return; }
+    for (; shift > PARSE_MAX_SHIFT; shift -= PARSE_MAX_SHIFT) { glm_parse_shiftLeft(b, PARSE_MAX_SHIFT); }
+    for (; shift < -PARSE_MAX_SHIFT; shift += PARSE_MAX_SHIFT) { glm_parse_shiftRight(b, PARSE_MAX_SHIFT); }
+    if (shift > 0) { glm_parse_shiftLeft(b, shift); }
+    if (shift < 0) { glm_parse_shiftRight(b, -shift); }
+}
+
+// The integer part of b, rounded half to even on the fraction
+static uint64_t glm_parse_round(const glm_parse_big *b) {
+    uint64_t n = 0;
+    int i, up;
+
+    for (i = 0; i < b->point; i++) { n = n * 10 + (i < b->count ? b->digits[i] : 0); }
+    if (b->point < 0 || b->point >= b->count) { return n; }
+
+    if (b->digits[b->point] == 5 && b->point + 1 == b->count) {
+        up = b->truncated || (b->point > 0 && (b->digits[b->point - 1] & 1));
+    } else {
+        up = b->digits[b->point] >= 5;
+    }
+    return n + (uint64_t)up;
+}
+
+// The slow path. Rounds the number glm_parse_scan accepted at str, which is
+// finite, to a binary float as glm_parse_eiselLemire does, including
+// subnormals, zero and infinity.
+static uint64_t glm_parse_slow(const char *str, int bits, int bias) {
+    // floor(n * log2(10)), and 1 for n = 0: shifts that bring a number with
+    // n integer digits, or n leading zeros, toward [0.5, 1) without
+    // overshooting
+    static const int powers[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53, 56, 59 };
+    const int count = (int)(sizeof powers / sizeof powers[0]);
+    glm_parse_big b;
+    const char *p = str;
+    uint64_t mantissa;
+    int exponent = 0, dot = 0, digits = 0, shift;
+
+    b.count = 0;
+    b.point = 0;
+    b.truncated = 0;
+    if (*p == '-' || *p == '+') { p++; }
+    for (; (*p >= '0' && *p <= '9') || (*p == '.' && !dot); p++) {
+        if (*p == '.') {
+            dot = 1;
+            b.point = digits;
+        } else if (*p == '0' && !digits) {
+            // Leading zeros
+            b.point--;
+        } else {
+            if (b.count < PARSE_DIGITS) {
+                b.digits[b.count++] = (unsigned char)(*p - '0');
+            } else {
+                b.truncated |= *p != '0';
+            }
+            digits++;
+        }
+    }
+    if (!dot) { b.point = digits; }
+    if ((*p | 0x20) == 'e') {
+        const char *e = p + 1;
+        int negative = *e == '-', value = 0;
+
+        if (*e == '-' || *e == '+') { e++; }
+        for (; *e >= '0' && *e <= '9'; e++) {
+            if (value < 100000) { value = value * 10 + (*e - '0'); }
+        }
+        b.point += negative ? -value : value;
+    }
+    glm_parse_trim(&b);
+
+    // Zero, and numbers far outside any double
+    if (!b.count || b.point < -330) { return 0; }
+    if (b.point > 310) { return (uint64_t)(2 * bias + 1) << bits; }
+
+    // Scale into [0.5, 1) by powers of two, counting them in exponent
+    while (b.point > 0) {
+        shift = b.point < count ? powers[b.point] : PARSE_MAX_SHIFT;
+        glm_parse_shift(&b, -shift);
+        exponent += shift;
+    }
+    while (b.point < 0 || (b.point == 0 && b.digits[0] < 5)) {
+        shift = -b.point < count ? powers[-b.point] : PARSE_MAX_SHIFT;
+        glm_parse_shift(&b, shift);
+        exponent -= shift;
+    }
+
+    // From [0.5, 1) to [1, 2), and up to the smallest exponent, where the
+    // number becomes subnormal
+    exponent--;
+    if (exponent < 1 - bias) {
+        glm_parse_shift(&b, exponent - (1 - bias));
+        exponent = 1 - bias;
+    }
+    if (exponent + bias >= 2 * bias + 1) { return (uint64_t)(2 * bias + 1) << bits; }
+
+    glm_parse_shift(&b, bits + 1);
+    mantissa = glm_parse_round(&b);
+    // Rounded up to the next power of two
+    if (mantissa == 2ULL << bits) {
+        mantissa >>= 1;
+        exponent++;
+        if (exponent + bias >= 2 * bias + 1) { return (uint64_t)(2 * bias + 1) << bits; }
+    }
+    // Subnormal
+    if (!(mantissa & (1ULL << bits))) { return mantissa; }
+    return (mantissa & ~(1ULL << bits)) | (uint64_t)(exponent + bias) << bits;
+}
+
+const char *glm_parseFloat(const char *str, float *dest) {
+    glm_parse_decimal d;
+    const char *end = glm_parse_scan(str, &d);
+    uint32_t bits;
+
+    if (!end) { return NULL; }
+
+    if (d.special == 'i') {
+        bits = 0x7F800000;
+    } else if (d.special == 'n') {
+        bits = 0x7FC00000;
+    } else if (d.w == 0) {
+        bits = 0;
+    } else {
+        uint64_t result = d.truncated ? 0 : glm_parse_eiselLemire(d.w, d.q, 23, 127);
+        bits = (uint32_t)(result ? result : glm_parse_slow(str, 23, 127));
+    }
+
+    if (d.negative) { bits |= 0x80000000; }
+    memcpy(dest, &bits, sizeof bits);
+    return end;
+}
+
+const char *glm_parseDouble(const char *str, double *dest) {
+    glm_parse_decimal d;
+    const char *end = glm_parse_scan(str, &d);
+    uint64_t bits;
+
+    if (!end) { return NULL; }
+
+    if (d.special == 'i') {
+        bits = 0x7FF0000000000000ULL;
+    } else if (d.special == 'n') {
+        bits = 0x7FF8000000000000ULL;
+    } else if (d.w == 0) {
+        bits = 0;
+    } else {
+        bits = d.truncated ? 0 : glm_parse_eiselLemire(d.w, d.q, 52, 1023);
+        if (!bits) { bits = glm_parse_slow(str, 52, 1023); }
+    }
+
+    if (d.negative) { bits |= 0x8000000000000000ULL; }
+    memcpy(dest, &bits, sizeof bits);
+    return end;
+}
+
+#undef PARSE_MAX_SHIFT
+#undef PARSE_DIGITS
+#undef PARSE_MAX_POWER
+#undef PARSE_MIN_POWER
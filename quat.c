@@ -1,22 +1,53 @@
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <assert.h>
 
 #include "gl-matrix.h"
 
-quat_t quat_create(quat_t quat) {
-    quat_t dest = calloc(4, sizeof(numeric_t));
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+GL_MATRIX_API quat_t quat_create(quat_t quat) {
+    quat_t dest = glm_alloc(4 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (quat) {
+        dest[0] = quat[0];
+        dest[1] = quat[1];
+        dest[2] = quat[2];
+        dest[3] = quat[3];
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_create_in(glm_arena *arena, quat_t quat) {
+    quat_t dest = glm_arena_alloc(arena, 4 * sizeof(numeric_t), 16);
+    if (!dest) { return NULL; }
 
     if (quat) {
         dest[0] = quat[0];
         dest[1] = quat[1];
         dest[2] = quat[2];
         dest[3] = quat[3];
+    } else {
+        memset(dest, 0, 4 * sizeof(numeric_t));
     }
 
     return dest;
 }
 
-quat_t quat_set(quat_t quat, quat_t dest) {
+GL_MATRIX_API quat_t quat_create_aligned(quat_t quat, size_t align) {
+    quat_t dest = glm_alloc_aligned(4 * sizeof(numeric_t), align);
+    if (!dest) { return NULL; }
+
+    if (quat) { memcpy(dest, quat, 4 * sizeof(numeric_t)); }
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_set(quat_t quat, quat_t dest) {
     dest[0] = quat[0];
     dest[1] = quat[1];
     dest[2] = quat[2];
@@ -25,27 +56,27 @@ quat_t quat_set(quat_t quat, quat_t dest) {
     return dest;
 }
 
-quat_t quat_calculateW(quat_t quat, quat_t dest) {
+GL_MATRIX_API quat_t quat_calculateW(quat_t quat, quat_t dest) {
     numeric_t x = quat[0], y = quat[1], z = quat[2];
 
     if (!dest || quat == dest) {
-        quat[3] = -sqrt(fabs(1.0 - x * x - y * y - z * z));
+        quat[3] = -glm_sqrt(glm_fabs(1 - x * x - y * y - z * z));
         return quat;
     }
     dest[0] = x;
     dest[1] = y;
     dest[2] = z;
-    dest[3] = -sqrt(fabs(1.0 - x * x - y * y - z * z));
+    dest[3] = -glm_sqrt(glm_fabs(1 - x * x - y * y - z * z));
     return dest;
 }
 
-numeric_t quat_dot(quat_t quat, quat_t quat2) {
+GL_MATRIX_API numeric_t quat_dot(quat_t quat, quat_t quat2) {
     return quat[0]*quat2[0] + quat[1]*quat2[1] + quat[2]*quat2[2] + quat[3]*quat2[3];
 }
 
-quat_t quat_inverse(quat_t quat, quat_t dest) {
+GL_MATRIX_API quat_t quat_inverse(quat_t quat, quat_t dest) {
     numeric_t dot = quat_dot(quat,quat),
-        invDot = 1.0/dot;
+        invDot = 1 / dot;
     if(!dest || quat == dest) {
         quat[0] *= -invDot;
         quat[1] *= -invDot;
@@ -60,7 +91,7 @@ quat_t quat_inverse(quat_t quat, quat_t dest) {
     return dest;
 }
 
-quat_t quat_conjugate(quat_t quat, quat_t dest) {
+GL_MATRIX_API quat_t quat_conjugate(quat_t quat, quat_t dest) {
     if (!dest || quat == dest) {
         quat[0] *= -1;
         quat[1] *= -1;
@@ -74,16 +105,16 @@ quat_t quat_conjugate(quat_t quat, quat_t dest) {
     return dest;
 }
 
-numeric_t quat_length(quat_t quat) {
+GL_MATRIX_API numeric_t quat_length(quat_t quat) {
     numeric_t x = quat[0], y = quat[1], z = quat[2], w = quat[3];
-    return sqrt(x * x + y * y + z * z + w * w);
+    return glm_sqrt(x * x + y * y + z * z + w * w);
 }
 
-quat_t quat_normalize(quat_t quat, quat_t dest) {
+GL_MATRIX_API quat_t quat_normalize(quat_t quat, quat_t dest) {
     if (!dest) { dest = quat; }
 
     numeric_t x = quat[0], y = quat[1], z = quat[2], w = quat[3],
-        len = sqrt(x * x + y * y + z * z + w * w);
+        len = glm_sqrt(x * x + y * y + z * z + w * w);
     if (len == 0) {
         dest[0] = 0;
         dest[1] = 0;
@@ -100,7 +131,7 @@ quat_t quat_normalize(quat_t quat, quat_t dest) {
     return dest;
 }
 
-quat_t quat_multiply(quat_t quat, quat_t quat2, quat_t dest) {
+GL_MATRIX_API quat_t quat_multiply(quat_t quat, quat_t quat2, quat_t dest) {
     if (!dest) { dest = quat; }
 
     numeric_t qax = quat[0], qay = quat[1], qaz = quat[2], qaw = quat[3],
@@ -114,7 +145,18 @@ quat_t quat_multiply(quat_t quat, quat_t quat2, quat_t dest) {
     return dest;
 }
 
-quat_t quat_multiplyVec3(quat_t quat, vec3_t vec, vec3_t dest) {
+GL_MATRIX_API quat_t quat_multiply_noalias(quat_t GL_MATRIX_RESTRICT quat, quat_t GL_MATRIX_RESTRICT quat2, quat_t GL_MATRIX_RESTRICT dest) {
+    assert(GL_MATRIX_DISJOINT(quat, 4, dest, 4) && GL_MATRIX_DISJOINT(quat2, 4, dest, 4));
+
+    dest[0] = quat[0] * quat2[3] + quat[3] * quat2[0] + quat[1] * quat2[2] - quat[2] * quat2[1];
+    dest[1] = quat[1] * quat2[3] + quat[3] * quat2[1] + quat[2] * quat2[0] - quat[0] * quat2[2];
+    dest[2] = quat[2] * quat2[3] + quat[3] * quat2[2] + quat[0] * quat2[1] - quat[1] * quat2[0];
+    dest[3] = quat[3] * quat2[3] - quat[0] * quat2[0] - quat[1] * quat2[1] - quat[2] * quat2[2];
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_multiplyVec3(quat_t quat, vec3_t vec, vec3_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0], y = vec[1], z = vec[2],
@@ -134,7 +176,7 @@ quat_t quat_multiplyVec3(quat_t quat, vec3_t vec, vec3_t dest) {
     return dest;
 }
 
-mat3_t quat_toMat3(quat_t quat, mat3_t dest) {
+GL_MATRIX_API mat3_t quat_toMat3(quat_t quat, mat3_t dest) {
     if (!dest) { dest = mat3_create(NULL); }
 
     numeric_t x = quat[0], y = quat[1], z = quat[2], w = quat[3],
@@ -167,7 +209,7 @@ mat3_t quat_toMat3(quat_t quat, mat3_t dest) {
     return dest;
 }
 
-quat_t quat_toMat4(quat_t quat, mat4_t dest) {
+GL_MATRIX_API quat_t quat_toMat4(quat_t quat, mat4_t dest) {
     if (!dest) { dest = mat4_create(NULL); }
 
     numeric_t x = quat[0], y = quat[1], z = quat[2], w = quat[3],
@@ -208,7 +250,7 @@ quat_t quat_toMat4(quat_t quat, mat4_t dest) {
     return dest;
 }
 
-quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest) {
+GL_MATRIX_API quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest) {
     if (!dest) { dest = quat; }
 
     numeric_t cosHalfTheta = quat[0] * quat2[0] + quat[1] * quat2[1] + quat[2] * quat2[2] + quat[3] * quat2[3],
@@ -217,7 +259,7 @@ quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest) {
         ratioA,
         ratioB;
 
-    if (fabs(cosHalfTheta) >= 1.0) {
+    if (glm_fabs(cosHalfTheta) >= 1) {
         if (dest != quat) {
             dest[0] = quat[0];
             dest[1] = quat[1];
@@ -227,19 +269,19 @@ quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest) {
         return dest;
     }
 
-    halfTheta = acos(cosHalfTheta);
-    sinHalfTheta = sqrt(1.0 - cosHalfTheta * cosHalfTheta);
+    halfTheta = glm_acos(cosHalfTheta);
+    sinHalfTheta = glm_sqrt(1 - cosHalfTheta * cosHalfTheta);
 
-    if (fabs(sinHalfTheta) < 0.001) {
-        dest[0] = (quat[0] * 0.5 + quat2[0] * 0.5);
-        dest[1] = (quat[1] * 0.5 + quat2[1] * 0.5);
-        dest[2] = (quat[2] * 0.5 + quat2[2] * 0.5);
-        dest[3] = (quat[3] * 0.5 + quat2[3] * 0.5);
+    if (glm_fabs(sinHalfTheta) < 0.001f) {
+        dest[0] = (quat[0] * 0.5f + quat2[0] * 0.5f);
+        dest[1] = (quat[1] * 0.5f + quat2[1] * 0.5f);
+        dest[2] = (quat[2] * 0.5f + quat2[2] * 0.5f);
+        dest[3] = (quat[3] * 0.5f + quat2[3] * 0.5f);
         return dest;
     }
 
-    ratioA = sin((1 - slerp) * halfTheta) / sinHalfTheta;
-    ratioB = sin(slerp * halfTheta) / sinHalfTheta;
+    ratioA = glm_sin((1 - slerp) * halfTheta) / sinHalfTheta;
+    ratioB = glm_sin(slerp * halfTheta) / sinHalfTheta;
 
     dest[0] = (quat[0] * ratioA + quat2[0] * ratioB);
     dest[1] = (quat[1] * ratioA + quat2[1] * ratioB);
@@ -249,7 +291,297 @@ quat_t quat_slerp(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest) {
     return dest;
 }
 
-quat_t quat_rotate(quat_t q, vec3_t p, quat_t dest) {
+GL_MATRIX_API quat_t quat_slerpFast(quat_t quat, quat_t quat2, numeric_t slerp, quat_t dest) {
+    numeric_t ax = quat[0], ay = quat[1], az = quat[2], aw = quat[3],
+        bx = quat2[0], by = quat2[1], bz = quat2[2], bw = quat2[3],
+        d = ax * bx + ay * by + az * bz + aw * bw,
+        ad = glm_fabs(d),
+
+        // Polynomial fit that corrects nlerp's uneven angular speed; see
+        // "Approximating slerp" by Arseny Kapoulkine
+        A = 1.0904f + ad * (-3.2452f + ad * (3.55645f - ad * 1.43519f)),
+        B = 0.848013f + ad * (-1.06021f + ad * 0.215638f),
+        h = slerp - 0.5f,
+        k = A * h * h + B,
+        t = slerp + slerp * h * (slerp - 1) * k,
+
+        // Interpolate towards -quat2 when that is the shorter way round
+        ratioA = 1 - t,
+        ratioB = d < 0 ? -t : t,
+        x = ax * ratioA + bx * ratioB,
+        y = ay * ratioA + by * ratioB,
+        z = az * ratioA + bz * ratioB,
+        w = aw * ratioA + bw * ratioB,
+        il = 1 / glm_sqrt(x * x + y * y + z * z + w * w);
+
+    if (!dest) { dest = quat; }
+
+    dest[0] = x * il;
+    dest[1] = y * il;
+    dest[2] = z * il;
+    dest[3] = w * il;
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_multiply_array(quat_t quat, quat_t quat2, size_t count, quat_t dest) {
+    size_t i;
+
+    if (!dest) { dest = quat; }
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    // Same products and summation order as quat_multiply, one quaternion per
+    // register: the w lane's minus signs are folded into the shuffled operands
+    const __m128 wsign = _mm_castsi128_ps(_mm_set_epi32((int)0x80000000, 0, 0, 0));
+
+#define QUAT_MULTIPLY_LOOP(load, store) \
+    for (i = 0; i < count; i++) { \
+        __m128 a = load(quat + i * 4), b = load(quat2 + i * 4), \
+            r = _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3))); \
+        \
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_xor_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 3, 3, 3)), wsign), \
+                                     _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 2, 1, 0)))); \
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_xor_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 2, 1)), wsign), \
+                                     _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 0, 2)))); \
+        r = _mm_sub_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 0, 2)), \
+                                     _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 0, 2, 1)))); \
+        store(dest + i * 4, r); \
+    }
+
+    // The quaternions are packed, so the arrays' alignment decides for all of them
+    if (((size_t)quat | (size_t)quat2 | (size_t)dest) % 16 == 0) {
+        QUAT_MULTIPLY_LOOP(_mm_load_ps, _mm_store_ps)
+    } else {
+        QUAT_MULTIPLY_LOOP(_mm_loadu_ps, _mm_storeu_ps)
+    }
+#undef QUAT_MULTIPLY_LOOP
+#else
+    for (i = 0; i < count; i++) {
+        const numeric_t *qa = quat + i * 4, *qb = quat2 + i * 4;
+        numeric_t qax = qa[0], qay = qa[1], qaz = qa[2], qaw = qa[3],
+            qbx = qb[0], qby = qb[1], qbz = qb[2], qbw = qb[3];
+        numeric_t *d = dest + i * 4;
+
+        d[0] = qax * qbw + qaw * qbx + qay * qbz - qaz * qby;
+        d[1] = qay * qbw + qaw * qby + qaz * qbx - qax * qbz;
+        d[2] = qaz * qbw + qaw * qbz + qax * qby - qay * qbx;
+        d[3] = qaw * qbw - qax * qbx - qay * qby - qaz * qbz;
+    }
+#endif
+
+    return dest;
+}
+
+// Number of slerp weights computed per pass of quat_slerp_array
+#define QUAT_SLERP_BLOCK 64
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+// pi as a float and the rest of it, so that pi - x keeps its precision
+#define QUAT_PI_HIGH 3.14159274f
+#define QUAT_PI_LOW (-8.74227766e-8f)
+
+static __m128 quat_select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// acos of four numbers in [-1, 1], from the asin polynomial of Cephes'
+// asinf: acos(x) = pi/2 - asin(x) for |x| <= 0.5, and
+// 2 * asin(sqrt((1 - x) / 2)) above
+static __m128 quat_acos4(__m128 x) {
+    const __m128 half = _mm_set1_ps(0.5f), sign = _mm_set1_ps(-0.0f);
+    __m128 a = _mm_andnot_ps(sign, x), big = _mm_cmpgt_ps(a, half),
+        z = quat_select4(big, _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1), a), half), _mm_mul_ps(a, a)),
+        r = quat_select4(big, _mm_sqrt_ps(z), a),
+        p = _mm_set1_ps(4.2163199048e-2f), result;
+
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(2.4181311049e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(4.5470025998e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(7.4953002686e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.6666752422e-1f));
+    p = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), r), r);
+
+    // acos(|x|), then acos(x) = pi - acos(|x|) for negative x
+    result = quat_select4(big, _mm_add_ps(p, p),
+                          _mm_add_ps(_mm_sub_ps(_mm_set1_ps(QUAT_PI_HIGH * 0.5f), p), _mm_set1_ps(QUAT_PI_LOW * 0.5f)));
+    return quat_select4(_mm_cmplt_ps(x, _mm_setzero_ps()),
+                        _mm_add_ps(_mm_sub_ps(_mm_set1_ps(QUAT_PI_HIGH), result), _mm_set1_ps(QUAT_PI_LOW)), result);
+}
+
+// sin of four numbers in [0, pi], folded onto [0, pi/2] and evaluated with
+// the Taylor series up to x^11, which is within 6e-8 there
+static __m128 quat_sin4(__m128 x) {
+    __m128 y = quat_select4(_mm_cmpgt_ps(x, _mm_set1_ps(QUAT_PI_HIGH * 0.5f)),
+                            _mm_add_ps(_mm_sub_ps(_mm_set1_ps(QUAT_PI_HIGH), x), _mm_set1_ps(QUAT_PI_LOW)), x),
+        z = _mm_mul_ps(y, y),
+        p = _mm_set1_ps(-2.50521084e-8f);
+
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(2.75573192e-6f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-1.98412698e-4f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(8.33333333e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-1.66666667e-1f));
+    return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), y), y);
+}
+#endif
+
+GL_MATRIX_API quat_t quat_slerp_array(quat_t quat, quat_t quat2, numeric_t slerp, size_t count, quat_t dest) {
+    numeric_t ratioA[QUAT_SLERP_BLOCK], ratioB[QUAT_SLERP_BLOCK];
+    size_t base = 0, i, n;
+
+    if (!dest) { dest = quat; }
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    // Four elements at a time, with the weights computed by polynomials and
+    // quat_slerp's special cases selected by masks instead of branches
+    for (; base + 4 <= count; base += 4) {
+        const numeric_t *qa = quat + base * 4, *qb = quat2 + base * 4;
+        __m128 a0 = _mm_loadu_ps(qa), a1 = _mm_loadu_ps(qa + 4), a2 = _mm_loadu_ps(qa + 8), a3 = _mm_loadu_ps(qa + 12),
+            b0 = _mm_loadu_ps(qb), b1 = _mm_loadu_ps(qb + 4), b2 = _mm_loadu_ps(qb + 8), b3 = _mm_loadu_ps(qb + 12),
+            ax = a0, ay = a1, az = a2, aw = a3, bx = b0, by = b1, bz = b2, bw = b3,
+            one = _mm_set1_ps(1), half = _mm_set1_ps(0.5f),
+            cosHalfTheta, halfTheta, sinHalfTheta, ra, rb, same, close;
+        numeric_t *d = dest + base * 4;
+
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+        // Same summation order as quat_slerp
+        cosHalfTheta = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                             _mm_mul_ps(az, bz)), _mm_mul_ps(aw, bw));
+        same = _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), cosHalfTheta), one);
+        cosHalfTheta = _mm_max_ps(_mm_min_ps(cosHalfTheta, one), _mm_set1_ps(-1));
+
+        halfTheta = quat_acos4(cosHalfTheta);
+        sinHalfTheta = _mm_sqrt_ps(_mm_sub_ps(one, _mm_mul_ps(cosHalfTheta, cosHalfTheta)));
+        close = _mm_cmplt_ps(sinHalfTheta, _mm_set1_ps(0.001f));
+
+        ra = _mm_div_ps(quat_sin4(_mm_mul_ps(_mm_set1_ps(1 - slerp), halfTheta)), sinHalfTheta);
+        rb = _mm_div_ps(quat_sin4(_mm_mul_ps(_mm_set1_ps(slerp), halfTheta)), sinHalfTheta);
+        ra = quat_select4(same, one, quat_select4(close, half, ra));
+        rb = quat_select4(same, _mm_setzero_ps(), quat_select4(close, half, rb));
+
+        _mm_storeu_ps(d, _mm_add_ps(_mm_mul_ps(a0, _mm_shuffle_ps(ra, ra, 0x00)), _mm_mul_ps(b0, _mm_shuffle_ps(rb, rb, 0x00))));
+        _mm_storeu_ps(d + 4, _mm_add_ps(_mm_mul_ps(a1, _mm_shuffle_ps(ra, ra, 0x55)), _mm_mul_ps(b1, _mm_shuffle_ps(rb, rb, 0x55))));
+        _mm_storeu_ps(d + 8, _mm_add_ps(_mm_mul_ps(a2, _mm_shuffle_ps(ra, ra, 0xAA)), _mm_mul_ps(b2, _mm_shuffle_ps(rb, rb, 0xAA))));
+        _mm_storeu_ps(d + 12, _mm_add_ps(_mm_mul_ps(a3, _mm_shuffle_ps(ra, ra, 0xFF)), _mm_mul_ps(b3, _mm_shuffle_ps(rb, rb, 0xFF))));
+    }
+#endif
+
+    for (; base < count; base += n) {
+        const numeric_t *qa = quat + base * 4, *qb = quat2 + base * 4;
+        numeric_t *d = dest + base * 4;
+
+        n = count - base < QUAT_SLERP_BLOCK ? count - base : QUAT_SLERP_BLOCK;
+
+        // The transcendental part of quat_slerp, with its special cases
+        // turned into weights so that the blend below has no branches
+        for (i = 0; i < n; i++) {
+            const numeric_t *a = qa + i * 4, *b = qb + i * 4;
+            numeric_t cosHalfTheta = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3],
+                halfTheta, sinHalfTheta;
+
+            if (glm_fabs(cosHalfTheta) >= 1) {
+                ratioA[i] = 1;
+                ratioB[i] = 0;
+                continue;
+            }
+
+            halfTheta = glm_acos(cosHalfTheta);
+            sinHalfTheta = glm_sqrt(1 - cosHalfTheta * cosHalfTheta);
+
+            if (glm_fabs(sinHalfTheta) < 0.001f) {
+                ratioA[i] = 0.5f;
+                ratioB[i] = 0.5f;
+                continue;
+            }
+
+            ratioA[i] = glm_sin((1 - slerp) * halfTheta) / sinHalfTheta;
+            ratioB[i] = glm_sin(slerp * halfTheta) / sinHalfTheta;
+        }
+
+        for (i = 0; i < n; i++) {
+            const numeric_t *a = qa + i * 4, *b = qb + i * 4;
+            numeric_t ra = ratioA[i], rb = ratioB[i];
+
+            d[i * 4] = a[0] * ra + b[0] * rb;
+            d[i * 4 + 1] = a[1] * ra + b[1] * rb;
+            d[i * 4 + 2] = a[2] * ra + b[2] * rb;
+            d[i * 4 + 3] = a[3] * ra + b[3] * rb;
+        }
+    }
+
+    return dest;
+}
+
+#undef QUAT_SLERP_BLOCK
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#undef QUAT_PI_LOW
+#undef QUAT_PI_HIGH
+#endif
+
+GL_MATRIX_API vec3_t quat_multiplyVec3_array(quat_t quat, vec3_t vec, size_t count, vec3_t dest) {
+    size_t i;
+
+    if (!dest) { dest = vec; }
+
+    // v' = v + w * t + cross(q, t) with t = 2 * cross(q, v) needs about half
+    // the operations of the q * v * q^-1 product used by quat_multiplyVec3
+    i = 0;
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+    // Four elements at a time, transposed so that each register holds one
+    // component of four quaternions or vectors
+    for (; i + 4 <= count; i += 4) {
+        const numeric_t *q = quat + i * 4, *v = vec + i * 3;
+        __m128 qx = _mm_loadu_ps(q), qy = _mm_loadu_ps(q + 4),
+            qz = _mm_loadu_ps(q + 8), qw = _mm_loadu_ps(q + 12),
+            x = _mm_set_ps(v[9], v[6], v[3], v[0]),
+            y = _mm_set_ps(v[10], v[7], v[4], v[1]),
+            z = _mm_set_ps(v[11], v[8], v[5], v[2]),
+            tx, ty, tz, rx, ry, rz;
+        numeric_t out[3][4];
+        int j;
+
+        _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+        tx = _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y));
+        ty = _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z));
+        tz = _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x));
+        tx = _mm_add_ps(tx, tx);
+        ty = _mm_add_ps(ty, ty);
+        tz = _mm_add_ps(tz, tz);
+
+        rx = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+        ry = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+        rz = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+
+        _mm_storeu_ps(out[0], rx);
+        _mm_storeu_ps(out[1], ry);
+        _mm_storeu_ps(out[2], rz);
+        for (j = 0; j < 4; j++) {
+            dest[(i + j) * 3] = out[0][j];
+            dest[(i + j) * 3 + 1] = out[1][j];
+            dest[(i + j) * 3 + 2] = out[2][j];
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        const numeric_t *q = quat + i * 4, *v = vec + i * 3;
+        numeric_t x = v[0], y = v[1], z = v[2],
+            qx = q[0], qy = q[1], qz = q[2], qw = q[3],
+
+            tx = 2 * (qy * z - qz * y),
+            ty = 2 * (qz * x - qx * z),
+            tz = 2 * (qx * y - qy * x);
+        numeric_t *d = dest + i * 3;
+
+        d[0] = x + qw * tx + (qy * tz - qz * ty);
+        d[1] = y + qw * ty + (qz * tx - qx * tz);
+        d[2] = z + qw * tz + (qx * ty - qy * tx);
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API quat_t quat_rotate(quat_t q, vec3_t p, quat_t dest) {
 
     if(!dest) {
         dest = q;
@@ -262,15 +594,15 @@ quat_t quat_rotate(quat_t q, vec3_t p, quat_t dest) {
     return dest;
 }
 
-quat_t quat_axisFromAngle(vec3_t axis, numeric_t angle, quat_t dest) {
+GL_MATRIX_API quat_t quat_axisFromAngle(vec3_t axis, numeric_t angle, quat_t dest) {
 	/*
 	ref: http://www.euclideanspace.com/maths/geometry/rotations/conversions/angleToQuaternion/index.htm
 	 */
 	numeric_t a[3];
 	vec3_normalize(axis, a);
-	dest[3] = cos(angle/2);
-	dest[0] = a[0] * sin(angle/2);
-	dest[1] = a[1] * sin(angle/2);
-	dest[2] = a[2] * sin(angle/2);
+	dest[3] = glm_cos(angle/2);
+	dest[0] = a[0] * glm_sin(angle/2);
+	dest[1] = a[1] * glm_sin(angle/2);
+	dest[2] = a[2] * glm_sin(angle/2);
 	return dest;
 }
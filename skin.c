@@ -0,0 +1,331 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include "gl-matrix.h"
+
+#ifndef GL_MATRIX_NO_THREADS
+#include <pthread.h>
+#endif
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2
+#include <immintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+#include <emmintrin.h>
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// Chunks handed to threads are multiples of this many vertices, so threads
+// never write to the same cache line of the outputs
+#define SKIN_CHUNK 64
+
+// Fewest vertices worth starting a thread for: a few thousand vertices take
+// about as long as creating and joining the thread
+#define SKIN_MIN_SHARE 4096
+
+typedef struct skin_job skin_job;
+
+struct skin_job {
+    void (*blend)(const skin_job *job);
+    numeric_t *bones;
+    unsigned short *indices;
+    numeric_t *weights;
+    vec3_t positions, normals;
+    vec3_t destPositions, destNormals;
+    size_t begin, end;
+};
+
+static void skin_blendRange(const skin_job *job) {
+    size_t i;
+
+    for (i = job->begin; i < job->end; i++) {
+        const unsigned short *bi = job->indices + i * 4;
+        const numeric_t *w = job->weights + i * 4, *p = job->positions + i * 3;
+        const numeric_t *b0 = job->bones + bi[0] * 16, *b1 = job->bones + bi[1] * 16,
+            *b2 = job->bones + bi[2] * 16, *b3 = job->bones + bi[3] * 16;
+        numeric_t *dp = job->destPositions + i * 3;
+
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+        // Blend the four bone matrices column by column, then transform with
+        // the blended matrix as mat4_multiplyVec3 does
+        __m128 w0 = _mm_set1_ps(w[0]), w1 = _mm_set1_ps(w[1]),
+            w2 = _mm_set1_ps(w[2]), w3 = _mm_set1_ps(w[3]), c[4], r;
+        int j;
+
+        for (j = 0; j < 4; j++) {
+            c[j] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(w0, _mm_loadu_ps(b0 + j * 4)),
+                _mm_mul_ps(w1, _mm_loadu_ps(b1 + j * 4))),
+                _mm_mul_ps(w2, _mm_loadu_ps(b2 + j * 4))),
+                _mm_mul_ps(w3, _mm_loadu_ps(b3 + j * 4)));
+        }
+
+        r = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(c[0], _mm_set1_ps(p[0])),
+            _mm_mul_ps(c[1], _mm_set1_ps(p[1]))),
+            _mm_mul_ps(c[2], _mm_set1_ps(p[2]))), c[3]);
+        _mm_storel_pi((__m64 *)dp, r);
+        _mm_store_ss(dp + 2, _mm_movehl_ps(r, r));
+
+        if (job->normals) {
+            const numeric_t *n = job->normals + i * 3;
+            numeric_t *dn = job->destNormals + i * 3;
+
+            r = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(c[0], _mm_set1_ps(n[0])),
+                _mm_mul_ps(c[1], _mm_set1_ps(n[1]))),
+                _mm_mul_ps(c[2], _mm_set1_ps(n[2])));
+            _mm_storel_pi((__m64 *)dn, r);
+            _mm_store_ss(dn + 2, _mm_movehl_ps(r, r));
+        }
+#elif GL_MATRIX_SIMD == GL_MATRIX_SIMD_NEON
+        float32x4_t c[4], r;
+        int j;
+
+        for (j = 0; j < 4; j++) {
+            c[j] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(
+                vld1q_f32(b0 + j * 4), w[0]),
+                vld1q_f32(b1 + j * 4), w[1]),
+                vld1q_f32(b2 + j * 4), w[2]),
+                vld1q_f32(b3 + j * 4), w[3]);
+        }
+
+        r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c[3], c[0], p[0]), c[1], p[1]), c[2], p[2]);
+        vst1_f32(dp, vget_low_f32(r));
+        vst1q_lane_f32(dp + 2, r, 2);
+
+        if (job->normals) {
+            const numeric_t *n = job->normals + i * 3;
+            numeric_t *dn = job->destNormals + i * 3;
+
+            r = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(c[0], n[0]), c[1], n[1]), c[2], n[2]);
+            vst1_f32(dn, vget_low_f32(r));
+            vst1q_lane_f32(dn + 2, r, 2);
+        }
+#else
+        numeric_t w0 = w[0], w1 = w[1], w2 = w[2], w3 = w[3], m[12],
+            x = p[0], y = p[1], z = p[2];
+        int j;
+
+        // Only the upper 3x4 of the bones is needed
+        for (j = 0; j < 4; j++) {
+            m[j * 3] = w0 * b0[j * 4] + w1 * b1[j * 4] + w2 * b2[j * 4] + w3 * b3[j * 4];
+            m[j * 3 + 1] = w0 * b0[j * 4 + 1] + w1 * b1[j * 4 + 1] + w2 * b2[j * 4 + 1] + w3 * b3[j * 4 + 1];
+            m[j * 3 + 2] = w0 * b0[j * 4 + 2] + w1 * b1[j * 4 + 2] + w2 * b2[j * 4 + 2] + w3 * b3[j * 4 + 2];
+        }
+
+        dp[0] = m[0] * x + m[3] * y + m[6] * z + m[9];
+        dp[1] = m[1] * x + m[4] * y + m[7] * z + m[10];
+        dp[2] = m[2] * x + m[5] * y + m[8] * z + m[11];
+
+        if (job->normals) {
+            const numeric_t *n = job->normals + i * 3;
+            numeric_t *dn = job->destNormals + i * 3;
+
+            x = n[0]; y = n[1]; z = n[2];
+            dn[0] = m[0] * x + m[3] * y + m[6] * z;
+            dn[1] = m[1] * x + m[4] * y + m[7] * z;
+            dn[2] = m[2] * x + m[5] * y + m[8] * z;
+        }
+#endif
+    }
+}
+
+static void skin_dualQuaternionRange(const skin_job *job) {
+    size_t i;
+
+    for (i = job->begin; i < job->end; i++) {
+        const unsigned short *bi = job->indices + i * 4;
+        const numeric_t *w = job->weights + i * 4, *p = job->positions + i * 3;
+        const numeric_t *q0 = job->bones + bi[0] * 8, *q1 = job->bones + bi[1] * 8,
+            *q2 = job->bones + bi[2] * 8, *q3 = job->bones + bi[3] * 8;
+        numeric_t *dp = job->destPositions + i * 3;
+
+        numeric_t b[8], il, rx, ry, rz, rw, tx, ty, tz, x, y, z, cx, cy, cz;
+
+        // q and -q are the same transform; flip each bone into the same
+        // hemisphere as the first before blending. The flips vary
+        // unpredictably from vertex to vertex, so avoid branching on them.
+#if GL_MATRIX_SIMD == GL_MATRIX_SIMD_AVX2 || GL_MATRIX_SIMD == GL_MATRIX_SIMD_SSE
+        {
+            __m128 r0 = _mm_loadu_ps(q0), r1 = _mm_loadu_ps(q1),
+                r2 = _mm_loadu_ps(q2), r3 = _mm_loadu_ps(q3),
+                signBit = _mm_set1_ps(-0.0f), d1, d2, d3, t, w1, w2, w3;
+
+            // Horizontal dot products; every lane ends up holding the sum
+#define SKIN_DOT4(a, b, out) \
+            t = _mm_mul_ps(a, b); \
+            t = _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 3, 0, 1))); \
+            out = _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 3, 2)))
+            SKIN_DOT4(r0, r1, d1);
+            SKIN_DOT4(r0, r2, d2);
+            SKIN_DOT4(r0, r3, d3);
+#undef SKIN_DOT4
+
+            // Copy the sign of each dot product onto its weight
+            w1 = _mm_xor_ps(_mm_set1_ps(w[1]), _mm_and_ps(d1, signBit));
+            w2 = _mm_xor_ps(_mm_set1_ps(w[2]), _mm_and_ps(d2, signBit));
+            w3 = _mm_xor_ps(_mm_set1_ps(w[3]), _mm_and_ps(d3, signBit));
+            t = _mm_set1_ps(w[0]);
+
+            _mm_storeu_ps(b, _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(t, r0), _mm_mul_ps(w1, r1)), _mm_mul_ps(w2, r2)), _mm_mul_ps(w3, r3)));
+            _mm_storeu_ps(b + 4, _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(t, _mm_loadu_ps(q0 + 4)), _mm_mul_ps(w1, _mm_loadu_ps(q1 + 4))),
+                _mm_mul_ps(w2, _mm_loadu_ps(q2 + 4))), _mm_mul_ps(w3, _mm_loadu_ps(q3 + 4))));
+        }
+#else
+        {
+            numeric_t w0 = w[0],
+                w1 = w[1] * (1 - 2 * (q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3] < 0)),
+                w2 = w[2] * (1 - 2 * (q0[0] * q2[0] + q0[1] * q2[1] + q0[2] * q2[2] + q0[3] * q2[3] < 0)),
+                w3 = w[3] * (1 - 2 * (q0[0] * q3[0] + q0[1] * q3[1] + q0[2] * q3[2] + q0[3] * q3[3] < 0));
+            int j;
+
+            for (j = 0; j < 8; j++) {
+                b[j] = w0 * q0[j] + w1 * q1[j] + w2 * q2[j] + w3 * q3[j];
+            }
+        }
+#endif
+
+        il = 1 / glm_sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3]);
+        rx = b[0] * il; ry = b[1] * il; rz = b[2] * il; rw = b[3] * il;
+
+        // Translation as in dquat_getTranslation, scaled by il once more for
+        // the dual part
+        il *= 2;
+        tx = (rw * b[4] - b[7] * rx + ry * b[6] - rz * b[5]) * il;
+        ty = (rw * b[5] - b[7] * ry + rz * b[4] - rx * b[6]) * il;
+        tz = (rw * b[6] - b[7] * rz + rx * b[5] - ry * b[4]) * il;
+
+        // Rotate with v + w * c + cross(r, c), c = 2 * cross(r, v)
+        x = p[0]; y = p[1]; z = p[2];
+        cx = 2 * (ry * z - rz * y);
+        cy = 2 * (rz * x - rx * z);
+        cz = 2 * (rx * y - ry * x);
+        dp[0] = x + rw * cx + (ry * cz - rz * cy) + tx;
+        dp[1] = y + rw * cy + (rz * cx - rx * cz) + ty;
+        dp[2] = z + rw * cz + (rx * cy - ry * cx) + tz;
+
+        if (job->normals) {
+            const numeric_t *n = job->normals + i * 3;
+            numeric_t *dn = job->destNormals + i * 3;
+
+            x = n[0]; y = n[1]; z = n[2];
+            cx = 2 * (ry * z - rz * y);
+            cy = 2 * (rz * x - rx * z);
+            cz = 2 * (rx * y - ry * x);
+            dn[0] = x + rw * cx + (ry * cz - rz * cy);
+            dn[1] = y + rw * cy + (rz * cx - rx * cz);
+            dn[2] = z + rw * cz + (rx * cy - ry * cx);
+        }
+    }
+}
+
+static void skin_initJob(skin_job *job, void (*blend)(const skin_job *job), numeric_t *bones,
+                         unsigned short *indices, numeric_t *weights, vec3_t positions, vec3_t normals,
+                         vec3_t destPositions, vec3_t destNormals) {
+    job->blend = blend;
+    job->bones = bones;
+    job->indices = indices;
+    job->weights = weights;
+    job->positions = positions;
+    job->normals = normals;
+    job->destPositions = destPositions ? destPositions : positions;
+    job->destNormals = destNormals ? destNormals : normals;
+}
+
+#ifndef GL_MATRIX_NO_THREADS
+static void *skin_thread(void *job) {
+    ((skin_job *)job)->blend(job);
+    return NULL;
+}
+#endif
+
+// Runs `job` over count vertices, split across up to `threads` threads
+static void skin_run(const skin_job *job, size_t count, unsigned int threads) {
+#ifndef GL_MATRIX_NO_THREADS
+    skin_job jobs[GL_MATRIX_SKIN_MAX_THREADS];
+    pthread_t tids[GL_MATRIX_SKIN_MAX_THREADS];
+    int started[GL_MATRIX_SKIN_MAX_THREADS];
+    size_t chunk, begin;
+    unsigned int t, n;
+
+    if (threads > GL_MATRIX_SKIN_MAX_THREADS) { threads = GL_MATRIX_SKIN_MAX_THREADS; }
+    // Give every thread at least SKIN_MIN_SHARE vertices; small meshes run on the calling thread
+    if (threads > count / SKIN_MIN_SHARE) { threads = (unsigned int)(count / SKIN_MIN_SHARE); }
+
+    // Round the per-thread share up to whole chunks; small meshes use fewer threads
+    chunk = threads > 1 ? (count + threads - 1) / threads : count;
+    chunk = (chunk + SKIN_CHUNK - 1) / SKIN_CHUNK * SKIN_CHUNK;
+    if (chunk < count) {
+        for (n = 0, begin = 0; begin < count; n++, begin += chunk) {
+            jobs[n] = *job;
+            jobs[n].begin = begin;
+            jobs[n].end = count - begin < chunk ? count : begin + chunk;
+        }
+
+        // The calling thread takes the first chunk. If a thread can't be
+        // started its chunk is done here too.
+        for (t = 1; t < n; t++) {
+            started[t] = pthread_create(&tids[t], NULL, skin_thread, &jobs[t]) == 0;
+        }
+        job->blend(&jobs[0]);
+        for (t = 1; t < n; t++) {
+            if (started[t]) {
+                pthread_join(tids[t], NULL);
+            } else {
+                job->blend(&jobs[t]);
+            }
+        }
+        return;
+    }
+#else
+    (void)threads;
+#endif
+    {
+        skin_job all = *job;
+        all.begin = 0;
+        all.end = count;
+        job->blend(&all);
+    }
+}
+
+GL_MATRIX_API void skin_linearBlend(mat4_t bones, unsigned short *indices, numeric_t *weights,
+                      vec3_t positions, vec3_t normals, size_t count,
+                      vec3_t destPositions, vec3_t destNormals) {
+    skin_job job;
+
+    skin_initJob(&job, skin_blendRange, bones, indices, weights, positions, normals, destPositions, destNormals);
+    skin_run(&job, count, 1);
+}
+
+GL_MATRIX_API void skin_linearBlendParallel(mat4_t bones, unsigned short *indices, numeric_t *weights,
+                              vec3_t positions, vec3_t normals, size_t count,
+                              vec3_t destPositions, vec3_t destNormals, unsigned int threads) {
+    skin_job job;
+
+    skin_initJob(&job, skin_blendRange, bones, indices, weights, positions, normals, destPositions, destNormals);
+    skin_run(&job, count, threads);
+}
+
+GL_MATRIX_API void skin_dualQuaternion(dquat_t bones, unsigned short *indices, numeric_t *weights,
+                         vec3_t positions, vec3_t normals, size_t count,
+                         vec3_t destPositions, vec3_t destNormals) {
+    skin_job job;
+
+    skin_initJob(&job, skin_dualQuaternionRange, bones, indices, weights, positions, normals, destPositions, destNormals);
+    skin_run(&job, count, 1);
+}
+
+GL_MATRIX_API void skin_dualQuaternionParallel(dquat_t bones, unsigned short *indices, numeric_t *weights,
+                                 vec3_t positions, vec3_t normals, size_t count,
+                                 vec3_t destPositions, vec3_t destNormals, unsigned int threads) {
+    skin_job job;
+
+    skin_initJob(&job, skin_dualQuaternionRange, bones, indices, weights, positions, normals, destPositions, destNormals);
+    skin_run(&job, count, threads);
+}
+
+#undef SKIN_CHUNK
+#undef SKIN_MIN_SHARE
@@ -0,0 +1,362 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "gl-matrix.h"
+
+// Number of vectors processed by one iteration of the stream kernels, and the
+// number every stream's component arrays are padded to
+#define SOA_LANES GL_MATRIX_SOA_LANES
+
+static size_t soa_padded(size_t count) {
+    return (count + SOA_LANES - 1) / SOA_LANES * SOA_LANES;
+}
+
+// Allocates `n` zeroed component arrays of `count` padded elements from one
+// block, each starting on a GL_MATRIX_SOA_ALIGNMENT boundary
+static void *soa_alloc(numeric_t **arrays, int n, size_t count) {
+    size_t stride = soa_padded(count) * sizeof(numeric_t);
+    unsigned char *block, *base;
+    int i;
+
+    stride = (stride + GL_MATRIX_SOA_ALIGNMENT - 1) / GL_MATRIX_SOA_ALIGNMENT * GL_MATRIX_SOA_ALIGNMENT;
+    block = glm_alloc(n * stride + GL_MATRIX_SOA_ALIGNMENT);
+    if (!block) { return NULL; }
+
+    base = block + (GL_MATRIX_SOA_ALIGNMENT - (size_t)block % GL_MATRIX_SOA_ALIGNMENT) % GL_MATRIX_SOA_ALIGNMENT;
+    for (i = 0; i < n; i++) {
+        arrays[i] = (numeric_t *)(base + i * stride);
+    }
+    return block;
+}
+
+static void soa_add(const numeric_t *a, const numeric_t *b, numeric_t *dest, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) { dest[i] = a[i] + b[i]; }
+}
+
+static void soa_subtract(const numeric_t *a, const numeric_t *b, numeric_t *dest, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) { dest[i] = a[i] - b[i]; }
+}
+
+static void soa_scale(const numeric_t *a, numeric_t val, numeric_t *dest, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) { dest[i] = a[i] * val; }
+}
+
+static void soa_lerp(const numeric_t *a, const numeric_t *b, numeric_t lerp, numeric_t *dest, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) { dest[i] = a[i] + lerp * (b[i] - a[i]); }
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_create(vec3_soa_t *soa, size_t count) {
+    numeric_t *arrays[3];
+
+    soa->block = soa_alloc(arrays, 3, count);
+    if (!soa->block) { return NULL; }
+
+    soa->x = arrays[0];
+    soa->y = arrays[1];
+    soa->z = arrays[2];
+    soa->count = count;
+    return soa;
+}
+
+GL_MATRIX_API void vec3_soa_free(vec3_soa_t *soa) {
+    glm_free(soa->block);
+    soa->block = NULL;
+    soa->x = soa->y = soa->z = NULL;
+    soa->count = 0;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_fromAoS(vec3_t vec, vec3_soa_t *dest) {
+    size_t i, n = dest->count;
+
+    for (i = 0; i < n; i++, vec += 3) {
+        dest->x[i] = vec[0];
+        dest->y[i] = vec[1];
+        dest->z[i] = vec[2];
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_soa_toAoS(vec3_soa_t *soa, vec3_t dest) {
+    size_t i, n = soa->count;
+    vec3_t d = dest;
+
+    for (i = 0; i < n; i++, d += 3) {
+        d[0] = soa->x[i];
+        d[1] = soa->y[i];
+        d[2] = soa->z[i];
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_add(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_add(soa->x, soa2->x, dest->x, n);
+    soa_add(soa->y, soa2->y, dest->y, n);
+    soa_add(soa->z, soa2->z, dest->z, n);
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_subtract(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_subtract(soa->x, soa2->x, dest->x, n);
+    soa_subtract(soa->y, soa2->y, dest->y, n);
+    soa_subtract(soa->z, soa2->z, dest->z, n);
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_scale(vec3_soa_t *soa, numeric_t val, vec3_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_scale(soa->x, val, dest->x, n);
+    soa_scale(soa->y, val, dest->y, n);
+    soa_scale(soa->z, val, dest->z, n);
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_lerp(vec3_soa_t *soa, vec3_soa_t *soa2, numeric_t lerp, vec3_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_lerp(soa->x, soa2->x, lerp, dest->x, n);
+    soa_lerp(soa->y, soa2->y, lerp, dest->y, n);
+    soa_lerp(soa->z, soa2->z, lerp, dest->z, n);
+    return dest;
+}
+
+// The kernels below read a whole block of lanes into locals before writing
+// anything, so dest may alias an operand and the compiler does not need
+// runtime overlap checks to vectorize the inner loops.
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_normalize(vec3_soa_t *soa, vec3_soa_t *dest) {
+    size_t i, j, n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t x[SOA_LANES], y[SOA_LANES], z[SOA_LANES], len[SOA_LANES];
+
+        for (j = 0; j < SOA_LANES; j++) { x[j] = soa->x[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { y[j] = soa->y[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { z[j] = soa->z[i + j]; }
+
+        for (j = 0; j < SOA_LANES; j++) {
+            len[j] = glm_sqrt(x[j] * x[j] + y[j] * y[j] + z[j] * z[j]);
+            len[j] = len[j] ? 1 / len[j] : 0;
+        }
+
+        for (j = 0; j < SOA_LANES; j++) { dest->x[i + j] = x[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->y[i + j] = y[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->z[i + j] = z[j] * len[j]; }
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec3_soa_t *vec3_soa_cross(vec3_soa_t *soa, vec3_soa_t *soa2, vec3_soa_t *dest) {
+    size_t i, j, n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t x[SOA_LANES], y[SOA_LANES], z[SOA_LANES], x2[SOA_LANES], y2[SOA_LANES], z2[SOA_LANES];
+
+        for (j = 0; j < SOA_LANES; j++) { x[j] = soa->x[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { y[j] = soa->y[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { z[j] = soa->z[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { x2[j] = soa2->x[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { y2[j] = soa2->y[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { z2[j] = soa2->z[i + j]; }
+
+        for (j = 0; j < SOA_LANES; j++) { dest->x[i + j] = y[j] * z2[j] - z[j] * y2[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->y[i + j] = z[j] * x2[j] - x[j] * z2[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->z[i + j] = x[j] * y2[j] - y[j] * x2[j]; }
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *vec3_soa_dot(vec3_soa_t *soa, vec3_soa_t *soa2, numeric_t *dest) {
+    size_t i, j, n = soa->count;
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t r[SOA_LANES];
+        size_t m = n - i < SOA_LANES ? n - i : SOA_LANES;
+
+        for (j = 0; j < SOA_LANES; j++) {
+            r[j] = soa->x[i + j] * soa2->x[i + j] + soa->y[i + j] * soa2->y[i + j] + soa->z[i + j] * soa2->z[i + j];
+        }
+        memcpy(dest + i, r, m * sizeof(numeric_t));
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *vec3_soa_length(vec3_soa_t *soa, numeric_t *dest) {
+    size_t i, j, n = soa->count;
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t r[SOA_LANES];
+        size_t m = n - i < SOA_LANES ? n - i : SOA_LANES;
+
+        for (j = 0; j < SOA_LANES; j++) {
+            numeric_t x = soa->x[i + j], y = soa->y[i + j], z = soa->z[i + j];
+            r[j] = glm_sqrt(x * x + y * y + z * z);
+        }
+        memcpy(dest + i, r, m * sizeof(numeric_t));
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_create(vec4_soa_t *soa, size_t count) {
+    numeric_t *arrays[4];
+
+    soa->block = soa_alloc(arrays, 4, count);
+    if (!soa->block) { return NULL; }
+
+    soa->x = arrays[0];
+    soa->y = arrays[1];
+    soa->z = arrays[2];
+    soa->w = arrays[3];
+    soa->count = count;
+    return soa;
+}
+
+GL_MATRIX_API void vec4_soa_free(vec4_soa_t *soa) {
+    glm_free(soa->block);
+    soa->block = NULL;
+    soa->x = soa->y = soa->z = soa->w = NULL;
+    soa->count = 0;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_fromAoS(vec4_t vec, vec4_soa_t *dest) {
+    size_t i, n = dest->count;
+
+    for (i = 0; i < n; i++, vec += 4) {
+        dest->x[i] = vec[0];
+        dest->y[i] = vec[1];
+        dest->z[i] = vec[2];
+        dest->w[i] = vec[3];
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_soa_toAoS(vec4_soa_t *soa, vec4_t dest) {
+    size_t i, n = soa->count;
+    vec4_t d = dest;
+
+    for (i = 0; i < n; i++, d += 4) {
+        d[0] = soa->x[i];
+        d[1] = soa->y[i];
+        d[2] = soa->z[i];
+        d[3] = soa->w[i];
+    }
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_add(vec4_soa_t *soa, vec4_soa_t *soa2, vec4_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_add(soa->x, soa2->x, dest->x, n);
+    soa_add(soa->y, soa2->y, dest->y, n);
+    soa_add(soa->z, soa2->z, dest->z, n);
+    soa_add(soa->w, soa2->w, dest->w, n);
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_subtract(vec4_soa_t *soa, vec4_soa_t *soa2, vec4_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_subtract(soa->x, soa2->x, dest->x, n);
+    soa_subtract(soa->y, soa2->y, dest->y, n);
+    soa_subtract(soa->z, soa2->z, dest->z, n);
+    soa_subtract(soa->w, soa2->w, dest->w, n);
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_scale(vec4_soa_t *soa, numeric_t val, vec4_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_scale(soa->x, val, dest->x, n);
+    soa_scale(soa->y, val, dest->y, n);
+    soa_scale(soa->z, val, dest->z, n);
+    soa_scale(soa->w, val, dest->w, n);
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_lerp(vec4_soa_t *soa, vec4_soa_t *soa2, numeric_t lerp, vec4_soa_t *dest) {
+    size_t n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    soa_lerp(soa->x, soa2->x, lerp, dest->x, n);
+    soa_lerp(soa->y, soa2->y, lerp, dest->y, n);
+    soa_lerp(soa->z, soa2->z, lerp, dest->z, n);
+    soa_lerp(soa->w, soa2->w, lerp, dest->w, n);
+    return dest;
+}
+
+GL_MATRIX_API vec4_soa_t *vec4_soa_normalize(vec4_soa_t *soa, vec4_soa_t *dest) {
+    size_t i, j, n = soa_padded(soa->count);
+    if (!dest) { dest = soa; }
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t x[SOA_LANES], y[SOA_LANES], z[SOA_LANES], w[SOA_LANES], len[SOA_LANES];
+
+        for (j = 0; j < SOA_LANES; j++) { x[j] = soa->x[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { y[j] = soa->y[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { z[j] = soa->z[i + j]; }
+        for (j = 0; j < SOA_LANES; j++) { w[j] = soa->w[i + j]; }
+
+        for (j = 0; j < SOA_LANES; j++) {
+            len[j] = glm_sqrt(x[j] * x[j] + y[j] * y[j] + z[j] * z[j] + w[j] * w[j]);
+            len[j] = len[j] ? 1 / len[j] : 0;
+        }
+
+        for (j = 0; j < SOA_LANES; j++) { dest->x[i + j] = x[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->y[i + j] = y[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->z[i + j] = z[j] * len[j]; }
+        for (j = 0; j < SOA_LANES; j++) { dest->w[i + j] = w[j] * len[j]; }
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *vec4_soa_dot(vec4_soa_t *soa, vec4_soa_t *soa2, numeric_t *dest) {
+    size_t i, j, n = soa->count;
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t r[SOA_LANES];
+        size_t m = n - i < SOA_LANES ? n - i : SOA_LANES;
+
+        for (j = 0; j < SOA_LANES; j++) {
+            r[j] = soa->x[i + j] * soa2->x[i + j] + soa->y[i + j] * soa2->y[i + j] +
+                soa->z[i + j] * soa2->z[i + j] + soa->w[i + j] * soa2->w[i + j];
+        }
+        memcpy(dest + i, r, m * sizeof(numeric_t));
+    }
+    return dest;
+}
+
+GL_MATRIX_API numeric_t *vec4_soa_length(vec4_soa_t *soa, numeric_t *dest) {
+    size_t i, j, n = soa->count;
+
+    for (i = 0; i < n; i += SOA_LANES) {
+        numeric_t r[SOA_LANES];
+        size_t m = n - i < SOA_LANES ? n - i : SOA_LANES;
+
+        for (j = 0; j < SOA_LANES; j++) {
+            numeric_t x = soa->x[i + j], y = soa->y[i + j], z = soa->z[i + j], w = soa->w[i + j];
+            r[j] = glm_sqrt(x * x + y * y + z * z + w * w);
+        }
+        memcpy(dest + i, r, m * sizeof(numeric_t));
+    }
+    return dest;
+}
+
+#undef SOA_LANES
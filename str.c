@@ -1,32 +1,236 @@
 #include <stdlib.h>
-#include <stdio.h>
+#include <string.h>
 
 #include "gl-matrix.h"
 
-void vec2_str(vec2_t vec, char *buffer) {
-    sprintf(buffer, "[%f, %f]", vec[0], vec[1]);
+#ifdef GL_MATRIX_DOUBLE
+#define str_number glm_formatDouble
+#define str_parseNumber glm_parseDouble
+#else
+#define str_number glm_formatFloat
+#define str_parseNumber glm_parseFloat
+#endif
+
+// Writes "[a, b, ...]" at buffer + len, where size is the size of the whole
+// buffer, and returns the new length. Output that doesn't fit is dropped, but
+// still counted; the caller terminates the string.
+static size_t str_values(const numeric_t *values, size_t count, char *buffer, size_t size, size_t len) {
+    char number[GL_MATRIX_FORMAT_MAX];
+    size_t i, n, room;
+
+    if (len < size) { buffer[len] = '['; }
+    len++;
+
+    for (i = 0; i < count; i++) {
+        if (i) {
+            if (len + 2 <= size) { memcpy(buffer + len, ", ", 2); }
+            else if (len < size) { buffer[len] = ','; }
+            len += 2;
+        }
+
+        // Format straight into the buffer while there is room for the
+        // longest number, and through a copy near the end
+        room = len < size ? size - len : 0;
+        if (room >= GL_MATRIX_FORMAT_MAX) {
+            len += str_number(values[i], buffer + len);
+        } else {
+            n = str_number(values[i], number);
+            if (room) { memcpy(buffer + len, number, n < room ? n : room); }
+            len += n;
+        }
+    }
+
+    if (len < size) { buffer[len] = ']'; }
+    return len + 1;
+}
+
+static size_t str_terminate(char *buffer, size_t size, size_t len) {
+    if (size) { buffer[len < size ? len : size - 1] = '\0'; }
+    return len;
+}
+
+GL_MATRIX_API size_t vec2_str_n(vec2_t vec, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(vec, 2, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t vec3_str_n(vec3_t vec, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(vec, 3, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t vec4_str_n(vec4_t vec, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(vec, 4, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t mat3_str_n(mat3_t mat, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(mat, 9, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t mat4_str_n(mat4_t mat, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(mat, 16, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t quat_str_n(quat_t quat, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(quat, 4, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t dquat_str_n(dquat_t dquat, char *buffer, size_t size) {
+    return str_terminate(buffer, size, str_values(dquat, 8, buffer, size, 0));
+}
+
+GL_MATRIX_API size_t mat4_str_array(mat4_t mat, size_t count, char *buffer, size_t size) {
+    size_t i, len = 0;
+
+    if (len < size) { buffer[len] = '['; }
+    len++;
+
+    for (i = 0; i < count; i++) {
+        if (i) {
+            if (len + 2 <= size) { memcpy(buffer + len, ", ", 2); }
+            else if (len < size) { buffer[len] = ','; }
+            len += 2;
+        }
+        len = str_values(mat + i * 16, 16, buffer, size, len);
+    }
+
+    if (len < size) { buffer[len] = ']'; }
+    return str_terminate(buffer, size, len + 1);
+}
+
+GL_MATRIX_API void vec2_str(vec2_t vec, char *buffer) {
+    vec2_str_n(vec, buffer, GL_MATRIX_STR_SIZE(2));
+}
+
+GL_MATRIX_API void vec3_str(vec3_t vec, char *buffer) {
+    vec3_str_n(vec, buffer, GL_MATRIX_STR_SIZE(3));
+}
+
+GL_MATRIX_API void vec4_str(vec4_t vec, char *buffer) {
+    vec4_str_n(vec, buffer, GL_MATRIX_STR_SIZE(4));
+}
+
+GL_MATRIX_API void mat3_str(mat3_t mat, char *buffer) {
+    mat3_str_n(mat, buffer, GL_MATRIX_STR_SIZE(9));
 }
 
-void vec3_str(vec3_t vec, char *buffer) {
-    sprintf(buffer, "[%f, %f, %f]", vec[0], vec[1], vec[2]);
+GL_MATRIX_API void mat4_str(mat4_t mat, char *buffer) {
+    mat4_str_n(mat, buffer, GL_MATRIX_STR_SIZE(16));
 }
 
-void vec4_str(vec4_t vec, char *buffer) {
-    sprintf(buffer, "[%f, %f, %f, %f]", vec[0], vec[1], vec[2], vec[3]);
+GL_MATRIX_API void quat_str(quat_t quat, char *buffer) {
+    quat_str_n(quat, buffer, GL_MATRIX_STR_SIZE(4));
 }
 
-void mat3_str(mat3_t mat, char *buffer) {
-    sprintf(buffer, "[%f, %f, %f, %f, %f, %f, %f, %f, %f]", mat[0], mat[1], mat[2], mat[3], mat[4], mat[5], mat[6], mat[7], mat[8]);
+GL_MATRIX_API void dquat_str(dquat_t dquat, char *buffer) {
+    dquat_str_n(dquat, buffer, GL_MATRIX_STR_SIZE(8));
 }
 
-void mat4_str(mat4_t mat, char *buffer) {
-    sprintf(buffer, "[%f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f]",
-        mat[0], mat[1], mat[2], mat[3],
-        mat[4], mat[5], mat[6], mat[7],
-        mat[8], mat[9], mat[10], mat[11],
-        mat[12], mat[13], mat[14], mat[15]);
+static int str_isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
 }
 
-void quat_str(quat_t quat, char *buffer) {
-    sprintf(buffer, "[%f, %f, %f, %f]", quat[0], quat[1], quat[2], quat[3]);
+static int str_isSeparator(char c) {
+    return c == ' ' || c == ',' || c == '\n' || c == '[' || c == ']' || c == '\t' || c == '\r';
 }
+
+static const char *str_skipSpace(const char *p) {
+    while (str_isSpace(*p)) { p++; }
+    return p;
+}
+
+// Reads "[a, b, ...]" with count numbers, as written by str_values, with any
+// whitespace around the brackets, commas and numbers. Returns the end of the
+// list, or NULL if str doesn't start with one.
+static const char *str_parseValues(const char *str, size_t count, numeric_t *dest) {
+    const char *p = str_skipSpace(str);
+    size_t i;
+
+    if (*p != '[') { return NULL; }
+    p++;
+
+    for (i = 0; i < count; i++) {
+        p = str_skipSpace(p);
+        if (i) {
+            if (*p != ',') { return NULL; }
+            p = str_skipSpace(p + 1);
+        }
+        p = str_parseNumber(p, dest + i);
+        if (!p) { return NULL; }
+    }
+
+    p = str_skipSpace(p);
+    return *p == ']' ? p + 1 : NULL;
+}
+
+GL_MATRIX_API const char *vec2_parse(const char *str, vec2_t dest) {
+    return str_parseValues(str, 2, dest);
+}
+
+GL_MATRIX_API const char *vec3_parse(const char *str, vec3_t dest) {
+    return str_parseValues(str, 3, dest);
+}
+
+GL_MATRIX_API const char *vec4_parse(const char *str, vec4_t dest) {
+    return str_parseValues(str, 4, dest);
+}
+
+GL_MATRIX_API const char *mat3_parse(const char *str, mat3_t dest) {
+    return str_parseValues(str, 9, dest);
+}
+
+GL_MATRIX_API const char *mat4_parse(const char *str, mat4_t dest) {
+    return str_parseValues(str, 16, dest);
+}
+
+GL_MATRIX_API const char *quat_parse(const char *str, quat_t dest) {
+    return str_parseValues(str, 4, dest);
+}
+
+GL_MATRIX_API const char *dquat_parse(const char *str, dquat_t dest) {
+    return str_parseValues(str, 8, dest);
+}
+
+GL_MATRIX_API const char *mat4_parse_array(const char *str, size_t count, mat4_t dest) {
+    const char *p = str_skipSpace(str);
+    size_t i;
+
+    if (*p != '[') { return NULL; }
+    p++;
+
+    for (i = 0; i < count; i++) {
+        if (i) {
+            p = str_skipSpace(p);
+            if (*p != ',') { return NULL; }
+            p++;
+        }
+        p = str_parseValues(p, 16, dest + i * 16);
+        if (!p) { return NULL; }
+    }
+
+    p = str_skipSpace(p);
+    return *p == ']' ? p + 1 : NULL;
+}
+
+GL_MATRIX_API const char *numbers_parse(const char *str, size_t length, numeric_t *dest, size_t max, size_t *count) {
+    const char *p = str, *last = str + length;
+    size_t n = 0;
+
+    // Only read up to the last separator in the chunk. A number that starts
+    // before it also ends there at the latest, so the parser never reads
+    // past the chunk, and a number the chunk cuts off is left for the next.
+    while (last > str && !str_isSeparator(last[-1])) { last--; }
+
+    for (;;) {
+        while (p < last && str_isSeparator(*p)) { p++; }
+        if (p == last || n == max) { break; }
+
+        p = str_parseNumber(p, dest + n);
+        if (!p || !str_isSeparator(*p)) { return NULL; }
+        n++;
+    }
+
+    *count = n;
+    return p;
+}
+
+#undef str_parseNumber
+#undef str_number
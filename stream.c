@@ -0,0 +1,385 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "gl-matrix.h"
+
+#ifndef GL_MATRIX_NO_MMAP
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#endif
+
+/*
+ * File layout. The header is 64 bytes, so the data that follows it is cache
+ * line aligned in the mapping:
+ *
+ *  0  "GLMX"
+ *  4  version, 1
+ *  5  element type, GL_MATRIX_STREAM_*
+ *  6  bytes per number for GL_MATRIX_STREAM_RAW: 4 for float, 8 for double;
+ *     0 for the quantized encodings
+ *  7  encoding of the elements, GL_MATRIX_STREAM_RAW etc.
+ *  8  0x01020304 as a 32 bit integer in the writer's byte order
+ * 16  element count, 64 bit, in the writer's byte order
+ * 24  zeroes up to byte 64
+ */
+#define STREAM_HEADER 64
+#define STREAM_VERSION 1
+#define STREAM_ORDER 0x01020304UL
+#define STREAM_ORDER_SWAPPED 0x04030201UL
+
+// Elements encoded at a time by stream_writeEncoded
+#define STREAM_BATCH 256
+// Bytes of the largest encoded element, a GL_MATRIX_STREAM_MAT4 of halves
+#define STREAM_MAX_ENCODED 32
+
+static size_t stream_components(int type) {
+    static const unsigned char components[] = { 0, 2, 3, 4, 9, 16, 4, 8 };
+    return type > 0 && type <= GL_MATRIX_STREAM_DQUAT ? components[type] : 0;
+}
+
+// Bytes per element in a file, 0 if the encoding can't hold the type
+static size_t stream_elementSize(int type, int encoding, size_t precision) {
+    size_t components = stream_components(type);
+
+    if (!components) { return 0; }
+    switch (encoding) {
+    case GL_MATRIX_STREAM_RAW: return precision == 4 || precision == 8 ? components * precision : 0;
+    case GL_MATRIX_STREAM_HALF: return components * 2;
+    case GL_MATRIX_STREAM_QUAT32: return type == GL_MATRIX_STREAM_QUAT ? 4 : 0;
+    case GL_MATRIX_STREAM_QUAT48: return type == GL_MATRIX_STREAM_QUAT ? 6 : 0;
+    case GL_MATRIX_STREAM_TRS: return type == GL_MATRIX_STREAM_MAT4 ? 24 : 0;
+    default: return 0;
+    }
+}
+
+static uint16_t stream_swap16(uint16_t x) {
+    return (uint16_t)((x >> 8) | (x << 8));
+}
+
+static uint32_t stream_swap32(uint32_t x) {
+    return (x >> 24) | ((x >> 8) & 0xFF00) | ((x << 8) & 0xFF0000) | (x << 24);
+}
+
+static uint64_t stream_swap64(uint64_t x) {
+    return ((uint64_t)stream_swap32((uint32_t)x) << 32) | stream_swap32((uint32_t)(x >> 32));
+}
+
+// Maps the whole file copy-on-write, so the data can be modified in place
+// without touching the file
+static int stream_map(const char *path, unsigned char **base, size_t *size) {
+#if defined(GL_MATRIX_NO_MMAP)
+    FILE *file = fopen(path, "rb");
+    long length;
+
+    if (!file) { return 0; }
+    if (fseek(file, 0, SEEK_END) || (length = ftell(file)) <= 0 || fseek(file, 0, SEEK_SET)) {
+        fclose(file);
+        return 0;
+    }
+
+    // Aligned like a mapping, so the data after the header is cache line
+    // aligned here too
+    *size = (size_t)length;
+    *base = glm_alloc_aligned(*size, STREAM_HEADER);
+    if (*base && fread(*base, 1, *size, file) != *size) {
+        glm_free_aligned(*base);
+        *base = NULL;
+    }
+    fclose(file);
+    return *base != NULL;
+#elif defined(_WIN32)
+    HANDLE file, mapping;
+    LARGE_INTEGER length;
+
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) { return 0; }
+    if (!GetFileSizeEx(file, &length) || length.QuadPart <= 0 || (unsigned long long)length.QuadPart > (size_t)-1) {
+        CloseHandle(file);
+        return 0;
+    }
+
+    // The view keeps the mapping, and the mapping the file, open
+    mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) { return 0; }
+    *base = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+
+    *size = (size_t)length.QuadPart;
+    return *base != NULL;
+#else
+    struct stat st;
+    void *mapping;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) { return 0; }
+    if (fstat(fd, &st) || st.st_size <= 0 || (unsigned long long)st.st_size > (size_t)-1) {
+        close(fd);
+        return 0;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    mapping = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) { return 0; }
+
+    *base = mapping;
+    *size = (size_t)st.st_size;
+    return 1;
+#endif
+}
+
+static void stream_unmap(unsigned char *base, size_t size) {
+#if defined(GL_MATRIX_NO_MMAP)
+    (void)size;
+    glm_free_aligned(base);
+#elif defined(_WIN32)
+    (void)size;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, size);
+#endif
+}
+
+// Converts numbers written in another precision or byte order to numeric_t
+static void stream_convert(const unsigned char *src, size_t precision, int swap, size_t count, numeric_t *dest) {
+    size_t i;
+
+    for (i = 0; i < count; i++, src += precision) {
+        if (precision == 4) {
+            uint32_t bits;
+            float value;
+
+            memcpy(&bits, src, 4);
+            if (swap) { bits = stream_swap32(bits); }
+            memcpy(&value, &bits, 4);
+            dest[i] = (numeric_t)value;
+        } else {
+            uint64_t bits;
+            double value;
+
+            memcpy(&bits, src, 8);
+            if (swap) { bits = stream_swap64(bits); }
+            memcpy(&value, &bits, 8);
+            dest[i] = (numeric_t)value;
+        }
+    }
+}
+
+// Reads count half floats from src, swapping their bytes if swap is set
+static void stream_readHalves(const unsigned char *src, int swap, size_t count, numeric_t *dest) {
+    uint16_t halves[64];
+    size_t i, n;
+
+    for (; count; count -= n, src += n * 2, dest += n) {
+        n = count < 64 ? count : 64;
+        memcpy(halves, src, n * 2);
+        if (swap) {
+            for (i = 0; i < n; i++) { halves[i] = stream_swap16(halves[i]); }
+        }
+        half_unpack(halves, n, dest);
+    }
+}
+
+// Decodes the quantized elements of a file into numeric_t
+static void stream_decode(const unsigned char *src, int type, int encoding, int swap, size_t count, numeric_t *dest) {
+    size_t i, j, components = stream_components(type);
+
+    if (encoding == GL_MATRIX_STREAM_HALF) {
+        stream_readHalves(src, swap, count * components, dest);
+        return;
+    }
+
+    for (i = 0; i < count; i++, dest += components) {
+        if (encoding == GL_MATRIX_STREAM_QUAT32) {
+            uint32_t packed;
+
+            memcpy(&packed, src + i * 4, 4);
+            quat_unpack32(swap ? stream_swap32(packed) : packed, dest);
+        } else if (encoding == GL_MATRIX_STREAM_QUAT48) {
+            uint16_t packed[3];
+
+            memcpy(packed, src + i * 6, 6);
+            for (j = 0; swap && j < 3; j++) { packed[j] = stream_swap16(packed[j]); }
+            quat_unpack48(packed, dest);
+        } else {
+            const unsigned char *element = src + i * 24;
+            mat4_trs_t trs;
+            uint32_t bits;
+
+            for (j = 0; j < 3; j++) {
+                memcpy(&bits, element + j * 4, 4);
+                if (swap) { bits = stream_swap32(bits); }
+                memcpy(&trs.translation[j], &bits, 4);
+            }
+            memcpy(trs.rotation, element + 12, 6);
+            memcpy(trs.scale, element + 18, 6);
+            for (j = 0; swap && j < 3; j++) {
+                trs.rotation[j] = stream_swap16(trs.rotation[j]);
+                trs.scale[j] = stream_swap16(trs.scale[j]);
+            }
+            mat4_unpackTRS(&trs, dest);
+        }
+    }
+}
+
+// Encodes up to STREAM_BATCH elements into buffer and returns its length
+static size_t stream_encode(const numeric_t *data, int type, int encoding, size_t count, unsigned char *buffer) {
+    size_t i, components = stream_components(type);
+
+    for (i = 0; i < count; i++, data += components) {
+        if (encoding == GL_MATRIX_STREAM_HALF) {
+            uint16_t halves[16];
+
+            half_pack(data, components, halves);
+            memcpy(buffer + i * components * 2, halves, components * 2);
+        } else if (encoding == GL_MATRIX_STREAM_QUAT32) {
+            uint32_t packed = quat_pack32((numeric_t *)data);
+
+            memcpy(buffer + i * 4, &packed, 4);
+        } else if (encoding == GL_MATRIX_STREAM_QUAT48) {
+            uint16_t packed[3];
+
+            quat_pack48((numeric_t *)data, packed);
+            memcpy(buffer + i * 6, packed, 6);
+        } else {
+            mat4_trs_t trs;
+
+            mat4_packTRS((numeric_t *)data, &trs);
+            memcpy(buffer + i * 24, trs.translation, 12);
+            memcpy(buffer + i * 24 + 12, trs.rotation, 6);
+            memcpy(buffer + i * 24 + 18, trs.scale, 6);
+        }
+    }
+    return count * stream_elementSize(type, encoding, 0);
+}
+
+GL_MATRIX_API int stream_write(const char *path, int type, const numeric_t *data, size_t count) {
+    return stream_writeEncoded(path, type, GL_MATRIX_STREAM_RAW, data, count);
+}
+
+GL_MATRIX_API int stream_writeEncoded(const char *path, int type, int encoding, const numeric_t *data, size_t count) {
+    unsigned char header[STREAM_HEADER], buffer[STREAM_BATCH * STREAM_MAX_ENCODED];
+    uint32_t order = STREAM_ORDER;
+    uint64_t elements = count;
+    size_t i, n, numbers = stream_components(type) * count;
+    FILE *file;
+    int ok;
+
+    if (!stream_elementSize(type, encoding, sizeof(numeric_t))) { return 0; }
+
+    memset(header, 0, sizeof header);
+    memcpy(header, "GLMX", 4);
+    header[4] = STREAM_VERSION;
+    header[5] = (unsigned char)type;
+    header[6] = encoding == GL_MATRIX_STREAM_RAW ? sizeof(numeric_t) : 0;
+    header[7] = (unsigned char)encoding;
+    memcpy(header + 8, &order, 4);
+    memcpy(header + 16, &elements, 8);
+
+    file = fopen(path, "wb");
+    if (!file) { return 0; }
+    ok = fwrite(header, 1, sizeof header, file) == sizeof header;
+
+    if (encoding == GL_MATRIX_STREAM_RAW) {
+        ok = ok && fwrite(data, sizeof(numeric_t), numbers, file) == numbers;
+    } else {
+        // Encoded a batch at a time, so nothing is allocated
+        for (i = 0; ok && i < count; i += n) {
+            n = count - i < STREAM_BATCH ? count - i : STREAM_BATCH;
+            n = stream_encode(data + i * stream_components(type), type, encoding, n, buffer);
+            ok = fwrite(buffer, 1, n, file) == n;
+            n /= stream_elementSize(type, encoding, 0);
+        }
+    }
+
+    if (fclose(file)) { ok = 0; }
+    return ok;
+}
+
+GL_MATRIX_API stream_t *stream_open(stream_t *stream, const char *path) {
+    unsigned char *base;
+    size_t size, precision, components, element, numbers;
+    uint32_t order;
+    uint64_t count;
+    int swap, encoding;
+
+    if (!stream_map(path, &base, &size)) { return NULL; }
+
+    if (size < STREAM_HEADER || memcmp(base, "GLMX", 4) || base[4] != STREAM_VERSION) {
+        stream_unmap(base, size);
+        return NULL;
+    }
+
+    components = stream_components(base[5]);
+    precision = base[6];
+    encoding = base[7];
+    element = stream_elementSize(base[5], encoding, precision);
+    memcpy(&order, base + 8, 4);
+    memcpy(&count, base + 16, 8);
+    swap = order == STREAM_ORDER_SWAPPED;
+    if (swap) { count = stream_swap64(count); }
+
+    // Also rejects files cut short, and counts that overflow size_t
+    if (!element || (!swap && order != STREAM_ORDER) || count > (size - STREAM_HEADER) / element) {
+        stream_unmap(base, size);
+        return NULL;
+    }
+
+    numbers = (size_t)count * components;
+    stream->count = (size_t)count;
+    stream->type = base[5];
+    stream->encoding = encoding;
+
+    if (encoding == GL_MATRIX_STREAM_RAW && !swap && precision == sizeof(numeric_t)) {
+        // Zero copy: the elements are used where they lie in the mapping
+        stream->data = (numeric_t *)(base + STREAM_HEADER);
+        stream->mapping = base;
+        stream->size = size;
+        stream->copy = NULL;
+        return stream;
+    }
+
+    stream->copy = glm_alloc(numbers ? numbers * sizeof(numeric_t) : 1);
+    if (stream->copy && encoding == GL_MATRIX_STREAM_RAW) {
+        stream_convert(base + STREAM_HEADER, precision, swap, numbers, stream->copy);
+    } else if (stream->copy) {
+        stream_decode(base + STREAM_HEADER, stream->type, encoding, swap, stream->count, stream->copy);
+    }
+    stream_unmap(base, size);
+    if (!stream->copy) { return NULL; }
+
+    stream->data = stream->copy;
+    stream->mapping = NULL;
+    stream->size = 0;
+    return stream;
+}
+
+GL_MATRIX_API numeric_t *stream_data(stream_t *stream, int type) {
+    return stream->type == type ? stream->data : NULL;
+}
+
+GL_MATRIX_API void stream_close(stream_t *stream) {
+    if (stream->mapping) { stream_unmap(stream->mapping, stream->size); }
+    glm_free(stream->copy);
+    stream->data = stream->copy = NULL;
+    stream->mapping = NULL;
+    stream->count = stream->size = 0;
+    stream->type = stream->encoding = 0;
+}
+
+#undef STREAM_ORDER_SWAPPED
+#undef STREAM_ORDER
+#undef STREAM_MAX_ENCODED
+#undef STREAM_BATCH
+#undef STREAM_VERSION
+#undef STREAM_HEADER
@@ -0,0 +1,237 @@
+/*
+ * Precision test for the float build
+ *
+ * Checks the bounds documented next to glm_sqrt etc. in gl-matrix.h: each
+ * math function is within 1 ULP of the correctly rounded double result, and
+ * the composite functions that call them stay within PRECISION_BOUND of what
+ * libgl-matrix-d.a computes from the same inputs, relative to the largest
+ * element of the result.
+ *
+ * This file is compiled twice: once as is, and once with GL_MATRIX_DOUBLE
+ * (`make test` does both), which gives precision_run_double, a copy of
+ * precision_run calling the double library. main() is only in the float
+ * copy.
+ *
+ * Usage: precision [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <stdint.h>
+
+#include "gl-matrix.h"
+
+#define PRECISION_BOUND (8 * FLT_EPSILON)
+
+// Below this sin(theta / 2), the float and double builds of quat_slerp may
+// take different branches
+#define PRECISION_SLERP_MIN 0.002
+
+enum {
+    CASE_MAT4_ROTATE,
+    CASE_MAT4_ROTATEX,
+    CASE_MAT4_ROTATEY,
+    CASE_MAT4_ROTATEZ,
+    CASE_MAT4_PERSPECTIVE,
+    CASE_MAT4_LOOKAT,
+    CASE_QUAT_SLERP,
+    CASE_QUAT_SLERP_ARRAY,
+    CASE_QUAT_AXISFROMANGLE,
+    CASE_QUAT_NORMALIZE,
+    CASE_VEC3_NORMALIZE,
+    CASE_COUNT
+};
+
+#ifdef GL_MATRIX_DOUBLE
+#define precision_run precision_run_double
+#else
+#define precision_run precision_run_float
+#endif
+
+// Runs one case on the inputs `in` and writes the result to `out`. Returns
+// the number of elements of the result.
+size_t precision_run(int which, const double *in, double *out) {
+    numeric_t a[16], b[16], d[16];
+    size_t i, n = 0;
+
+    for (i = 0; i < 16; i++) {
+        a[i] = (numeric_t)in[i];
+        b[i] = (numeric_t)in[16 + i];
+    }
+
+    switch (which) {
+    case CASE_MAT4_ROTATE: mat4_rotate(a, b[0], b + 1, d); n = 16; break;
+    case CASE_MAT4_ROTATEX: mat4_rotateX(a, b[0], d); n = 16; break;
+    case CASE_MAT4_ROTATEY: mat4_rotateY(a, b[0], d); n = 16; break;
+    case CASE_MAT4_ROTATEZ: mat4_rotateZ(a, b[0], d); n = 16; break;
+    case CASE_MAT4_PERSPECTIVE: mat4_perspective(b[0], b[1], b[2], b[3], d); n = 16; break;
+    case CASE_MAT4_LOOKAT: mat4_lookAt(a, a + 3, a + 6, d); n = 16; break;
+    case CASE_QUAT_SLERP: quat_slerp(a, b, b[4], d); n = 4; break;
+    case CASE_QUAT_SLERP_ARRAY:
+        // Four copies, so the SIMD loop rather than the remainder runs
+        for (i = 4; i < 16; i++) {
+            a[i] = a[i % 4];
+            b[i] = b[i % 4];
+        }
+        quat_slerp_array(a, b, (numeric_t)in[20], 4, d);
+        n = 4;
+        break;
+    case CASE_QUAT_AXISFROMANGLE: quat_axisFromAngle(a, b[0], d); n = 4; break;
+    case CASE_QUAT_NORMALIZE: quat_normalize(a, d); n = 4; break;
+    case CASE_VEC3_NORMALIZE: vec3_normalize(a, d); n = 3; break;
+    }
+
+    for (i = 0; i < n; i++) { out[i] = d[i]; }
+    return n;
+}
+
+#ifndef GL_MATRIX_DOUBLE
+size_t precision_run_double(int which, const double *in, double *out);
+
+static const char *names[CASE_COUNT] = {
+    "mat4_rotate", "mat4_rotateX", "mat4_rotateY", "mat4_rotateZ", "mat4_perspective",
+    "mat4_lookAt", "quat_slerp", "quat_slerp_array", "quat_axisFromAngle", "quat_normalize", "vec3_normalize"
+};
+
+// Uniform in [lo, hi], rounded to float so both builds get the same input
+static double uniform(double lo, double hi) {
+    return (float)(lo + (hi - lo) * (rand() / (double)RAND_MAX));
+}
+
+static void normalize(double *v, size_t n) {
+    double len = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++) { len += v[i] * v[i]; }
+    len = sqrt(len);
+    for (i = 0; i < n; i++) { v[i] = (float)(v[i] / len); }
+}
+
+// Random inputs in each case's domain: a[] in in[0..15], b[] in in[16..31]
+static void inputs(int which, double *in) {
+    double *b = in + 16;
+    size_t i;
+
+    for (i = 0; i < 32; i++) { in[i] = uniform(-1, 1); }
+
+    switch (which) {
+    case CASE_MAT4_ROTATE:
+    case CASE_MAT4_ROTATEX:
+    case CASE_MAT4_ROTATEY:
+    case CASE_MAT4_ROTATEZ:
+    case CASE_QUAT_AXISFROMANGLE:
+        b[0] = uniform(-3.14159265, 3.14159265);
+        break;
+    case CASE_MAT4_PERSPECTIVE:
+        b[0] = uniform(10, 170);
+        b[1] = uniform(0.5, 2);
+        b[2] = uniform(0.1, 1);
+        b[3] = uniform(10, 1000);
+        break;
+    case CASE_MAT4_LOOKAT:
+        // eye and center apart, up not along the view direction
+        for (i = 0; i < 3; i++) { in[i] = uniform(-10, 10); }
+        in[3] = in[0] + 5;
+        in[6] = 0;
+        in[7] = 1;
+        in[8] = 0;
+        break;
+    case CASE_QUAT_SLERP:
+    case CASE_QUAT_SLERP_ARRAY:
+        // Half the pairs close together, where slerp is least accurate
+        normalize(in, 4);
+        if (rand() & 1) {
+            double spread = pow(10, -uniform(1, 3));
+            for (i = 0; i < 4; i++) { b[i] = in[i] + spread * uniform(-1, 1); }
+        }
+        normalize(b, 4);
+        b[4] = uniform(0, 1);
+        break;
+    }
+}
+
+// Distance in units in the last place between two floats
+static uint32_t ulps(float x, float y) {
+    int32_t a, b;
+
+    memcpy(&a, &x, sizeof a);
+    memcpy(&b, &y, sizeof b);
+    if (a < 0) { a = (int32_t)(0x80000000u - (uint32_t)a); }
+    if (b < 0) { b = (int32_t)(0x80000000u - (uint32_t)b); }
+    return a > b ? (uint32_t)a - (uint32_t)b : (uint32_t)b - (uint32_t)a;
+}
+
+static int check_math(long iterations) {
+    uint32_t worst[6] = { 0 }, u;
+    const char *math[6] = { "glm_sqrt", "glm_sin", "glm_cos", "glm_tan", "glm_acos", "glm_fabs" };
+    int i, failed = 0;
+    long k;
+
+    for (k = 0; k < iterations; k++) {
+        float x = (float)uniform(-100, 100), unit = (float)uniform(-1, 1), positive = (float)fabs(x);
+
+        u = ulps(glm_sqrt(positive), (float)sqrt(positive)); if (u > worst[0]) { worst[0] = u; }
+        u = ulps(glm_sin(x), (float)sin(x)); if (u > worst[1]) { worst[1] = u; }
+        u = ulps(glm_cos(x), (float)cos(x)); if (u > worst[2]) { worst[2] = u; }
+        u = ulps(glm_tan(x), (float)tan(x)); if (u > worst[3]) { worst[3] = u; }
+        u = ulps(glm_acos(unit), (float)acos(unit)); if (u > worst[4]) { worst[4] = u; }
+        u = ulps(glm_fabs(x), (float)fabs(x)); if (u > worst[5]) { worst[5] = u; }
+    }
+
+    for (i = 0; i < 6; i++) {
+        printf("%-20s %u ulp%s\n", math[i], (unsigned)worst[i], worst[i] > 1 ? "  FAILED" : "");
+        failed |= worst[i] > 1;
+    }
+    return failed;
+}
+
+static int check_composite(long iterations) {
+    double in[32], f[16], d[16], err, scale, worst;
+    int which, failed = 0;
+    size_t i, n;
+    long k;
+
+    for (which = 0; which < CASE_COUNT; which++) {
+        worst = 0;
+        for (k = 0; k < iterations; k++) {
+            inputs(which, in);
+            n = precision_run_float(which, in, f);
+            precision_run_double(which, in, d);
+
+            scale = err = 0;
+            for (i = 0; i < n; i++) {
+                if (fabs(d[i]) > scale) { scale = fabs(d[i]); }
+                if (fabs(f[i] - d[i]) > err) { err = fabs(f[i] - d[i]); }
+            }
+
+            // The angle comes from acos of the dot product and the result is
+            // divided by sin(theta / 2), so the error grows as the quaternions
+            // approach each other or each other's opposite
+            if (which == CASE_QUAT_SLERP || which == CASE_QUAT_SLERP_ARRAY) {
+                double dot = in[0] * in[16] + in[1] * in[17] + in[2] * in[18] + in[3] * in[19],
+                    sine = sqrt(fabs(1 - dot * dot));
+                if (sine < PRECISION_SLERP_MIN) { continue; }
+                err *= sine * sine;
+            }
+            if (scale && err / scale > worst) { worst = err / scale; }
+        }
+
+        printf("%-20s %.2f * FLT_EPSILON%s\n", names[which], worst / FLT_EPSILON,
+               worst > PRECISION_BOUND ? "  FAILED" : "");
+        failed |= worst > PRECISION_BOUND;
+    }
+    return failed;
+}
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 100000;
+    int failed;
+
+    srand(1);
+    failed = check_math(iterations);
+    failed |= check_composite(iterations);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Round trip test for stream files
+ *
+ * Writes every element type in every encoding with stream_writeEncoded,
+ * reads it back with stream_open and checks that the elements match what
+ * the pack.c functions give for the same input, exactly. Pairs an encoding
+ * can't hold must be rejected. More elements than stream.c encodes at once
+ * are written, so the batching is exercised too.
+ *
+ * Usage: stream [file]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "gl-matrix.h"
+
+#define STREAM_TEST_COUNT 1000
+
+static const char *types[] = { NULL, "vec2", "vec3", "vec4", "mat3", "mat4", "quat", "dquat" };
+static const char *encodings[] = { "raw", "half", "quat32", "quat48", "trs" };
+static const size_t components[] = { 0, 2, 3, 4, 9, 16, 4, 8 };
+
+static numeric_t uniform(void) {
+    return (numeric_t)rand() / RAND_MAX * 2 - 1;
+}
+
+// Elements every encoding accepts: unit quaternions and affine matrices
+static void inputs(int type, numeric_t *data) {
+    size_t i, n = components[type];
+
+    for (i = 0; i < STREAM_TEST_COUNT * n; i++) { data[i] = uniform(); }
+    for (i = 0; i < STREAM_TEST_COUNT; i++, data += n) {
+        if (type == GL_MATRIX_STREAM_QUAT) {
+            quat_normalize(data, NULL);
+        } else if (type == GL_MATRIX_STREAM_MAT4) {
+            numeric_t rotation[4], translation[3];
+
+            quat_normalize(data, rotation);
+            vec3_set(data + 4, translation);
+            mat4_fromRotationTranslation(rotation, translation, data);
+        }
+    }
+}
+
+// What the encoding turns data into, through the pack.c functions
+static int expected(int type, int encoding, const numeric_t *data, numeric_t *dest) {
+    size_t i, n = components[type];
+
+    for (i = 0; i < STREAM_TEST_COUNT; i++, data += n, dest += n) {
+        switch (encoding) {
+        case GL_MATRIX_STREAM_RAW:
+            memcpy(dest, data, n * sizeof(numeric_t));
+            break;
+        case GL_MATRIX_STREAM_HALF: {
+            uint16_t halves[16];
+
+            half_pack(data, n, halves);
+            half_unpack(halves, n, dest);
+            break;
+        }
+        case GL_MATRIX_STREAM_QUAT32:
+            if (type != GL_MATRIX_STREAM_QUAT) { return 0; }
+            quat_unpack32(quat_pack32((numeric_t *)data), dest);
+            break;
+        case GL_MATRIX_STREAM_QUAT48: {
+            uint16_t packed[3];
+
+            if (type != GL_MATRIX_STREAM_QUAT) { return 0; }
+            quat_unpack48(quat_pack48((numeric_t *)data, packed), dest);
+            break;
+        }
+        case GL_MATRIX_STREAM_TRS: {
+            mat4_trs_t trs;
+
+            if (type != GL_MATRIX_STREAM_MAT4) { return 0; }
+            mat4_unpackTRS(mat4_packTRS((numeric_t *)data, &trs), dest);
+            break;
+        }
+        }
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    static numeric_t data[STREAM_TEST_COUNT * 16], want[STREAM_TEST_COUNT * 16];
+    const char *path = argc > 1 ? argv[1] : "test/stream.tmp";
+    int type, encoding, failed = 0;
+
+    srand(1);
+    for (type = GL_MATRIX_STREAM_VEC2; type <= GL_MATRIX_STREAM_DQUAT; type++) {
+        for (encoding = GL_MATRIX_STREAM_RAW; encoding <= GL_MATRIX_STREAM_TRS; encoding++) {
+            size_t size = STREAM_TEST_COUNT * components[type] * sizeof(numeric_t);
+            int valid, written, ok;
+            stream_t stream;
+
+            inputs(type, data);
+            valid = expected(type, encoding, data, want);
+            written = stream_writeEncoded(path, type, encoding, data, STREAM_TEST_COUNT);
+
+            if (!valid) {
+                ok = !written;
+            } else if (!written || !stream_open(&stream, path)) {
+                ok = 0;
+            } else {
+                ok = stream.count == STREAM_TEST_COUNT && stream.type == type && stream.encoding == encoding &&
+                     !memcmp(stream.data, want, size);
+                stream_close(&stream);
+            }
+
+            if (valid || !ok) {
+                printf("%-6s %-7s %s\n", types[type], encodings[encoding], ok ? "ok" : "FAILED");
+            }
+            failed |= !ok;
+        }
+    }
+
+    remove(path);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
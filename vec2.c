@@ -1,10 +1,12 @@
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "gl-matrix.h"
 
-vec2_t vec2_create(vec2_t vec) {
-    vec2_t dest = calloc(2, sizeof(numeric_t));
+GL_MATRIX_API vec2_t vec2_create(vec2_t vec) {
+    vec2_t dest = glm_alloc(2 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
 
     if (vec) {
         dest[0] = vec[0];
@@ -16,25 +18,39 @@ vec2_t vec2_create(vec2_t vec) {
     return dest;
 }
 
-vec2_t vec2_set(vec2_t vec, vec2_t dest) {
+GL_MATRIX_API vec2_t vec2_create_in(glm_arena *arena, vec2_t vec) {
+    vec2_t dest = glm_arena_alloc(arena, 2 * sizeof(numeric_t), sizeof(numeric_t) * 2);
+    if (!dest) { return NULL; }
+
+    if (vec) {
+        dest[0] = vec[0];
+        dest[1] = vec[1];
+    } else {
+        memset(dest, 0, 2 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API vec2_t vec2_set(vec2_t vec, vec2_t dest) {
     dest[0] = vec[0];
     dest[1] = vec[1];
     return dest;
 }
 
-vec2_t vec2_zeroes(vec2_t vec) {
+GL_MATRIX_API vec2_t vec2_zeroes(vec2_t vec) {
     vec[0] = 0;
     vec[1] = 0;
     return vec;
 }
 
-vec2_t vec2_ones(vec2_t vec) {
+GL_MATRIX_API vec2_t vec2_ones(vec2_t vec) {
     vec[0] = 1;
     vec[1] = 1;
     return vec;
 }
 
-vec2_t vec2_add(vec2_t vec, vec2_t vec2, vec2_t dest) {
+GL_MATRIX_API vec2_t vec2_add(vec2_t vec, vec2_t vec2, vec2_t dest) {
     if (!dest || vec == dest) {
         vec[0] += vec2[0];
         vec[1] += vec2[1];
@@ -47,7 +63,7 @@ vec2_t vec2_add(vec2_t vec, vec2_t vec2, vec2_t dest) {
     return dest;
 }
 
-vec2_t vec2_subtract(vec2_t vec, vec2_t vec2, vec2_t dest) {
+GL_MATRIX_API vec2_t vec2_subtract(vec2_t vec, vec2_t vec2, vec2_t dest) {
     if (!dest || vec == dest) {
         vec[0] -= vec2[0];
         vec[1] -= vec2[1];
@@ -59,7 +75,7 @@ vec2_t vec2_subtract(vec2_t vec, vec2_t vec2, vec2_t dest) {
     return dest;
 }
 
-vec2_t vec2_negate(vec2_t vec, vec2_t dest) {
+GL_MATRIX_API vec2_t vec2_negate(vec2_t vec, vec2_t dest) {
     if (!dest) { dest = vec; }
 
     dest[0] = -vec[0];
@@ -67,7 +83,7 @@ vec2_t vec2_negate(vec2_t vec, vec2_t dest) {
     return dest;
 }
 
-vec2_t vec2_scale(vec2_t vec, numeric_t val, vec2_t dest) {
+GL_MATRIX_API vec2_t vec2_scale(vec2_t vec, numeric_t val, vec2_t dest) {
     if (!dest || vec == dest) {
         vec[0] *= val;
         vec[1] *= val;
@@ -79,11 +95,11 @@ vec2_t vec2_scale(vec2_t vec, numeric_t val, vec2_t dest) {
     return dest;
 }
 
-vec2_t vec2_normalize(vec2_t vec, vec2_t dest) {
+GL_MATRIX_API vec2_t vec2_normalize(vec2_t vec, vec2_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0], y = vec[1],
-        len = sqrt(x * x + y * y);
+        len = glm_sqrt(x * x + y * y);
 
     if (!len) {
         dest[0] = 0;
@@ -101,21 +117,21 @@ vec2_t vec2_normalize(vec2_t vec, vec2_t dest) {
     return dest;
 }
 
-numeric_t vec2_length(vec2_t vec) {
+GL_MATRIX_API numeric_t vec2_length(vec2_t vec) {
     numeric_t x = vec[0], y = vec[1];
-    return sqrt(x * x + y * y);
+    return glm_sqrt(x * x + y * y);
 }
 
-numeric_t vec2_dot(vec2_t vec, vec2_t vec2) {
+GL_MATRIX_API numeric_t vec2_dot(vec2_t vec, vec2_t vec2) {
     return vec[0] * vec2[0] + vec[1] * vec2[1];
 }
 
-vec2_t vec2_direction (vec2_t vec, vec2_t vec2, vec2_t dest) {
+GL_MATRIX_API vec2_t vec2_direction (vec2_t vec, vec2_t vec2, vec2_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0] - vec2[0],
         y = vec[1] - vec2[1],
-        len = sqrt(x * x + y * y);
+        len = glm_sqrt(x * x + y * y);
 
     if (!len) {
         dest[0] = 0;
@@ -129,16 +145,16 @@ vec2_t vec2_direction (vec2_t vec, vec2_t vec2, vec2_t dest) {
     return dest;
 }
 
-vec2_t vec2_lerp(vec2_t vec, vec2_t vec2, numeric_t lerp, vec2_t dest) {
+GL_MATRIX_API vec2_t vec2_lerp(vec2_t vec, vec2_t vec2, numeric_t lerp, vec2_t dest) {
     if (!dest) { dest = vec; }
     dest[0] = vec[0] + lerp * (vec2[0] - vec[0]);
     dest[1] = vec[1] + lerp * (vec2[1] - vec[1]);
     return dest;
 }
 
-numeric_t vec2_dist(vec2_t vec, vec2_t vec2) {
+GL_MATRIX_API numeric_t vec2_dist(vec2_t vec, vec2_t vec2) {
     numeric_t x = vec2[0] - vec[0],
         y = vec2[1] - vec[1];
 
-    return sqrt(x*x + y*y);
+    return glm_sqrt(x*x + y*y);
 }
\ No newline at end of file
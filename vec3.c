@@ -1,10 +1,13 @@
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <assert.h>
 
 #include "gl-matrix.h"
 
-vec3_t vec3_create(vec3_t vec) {
-    vec3_t dest = calloc(3, sizeof(numeric_t));
+GL_MATRIX_API vec3_t vec3_create(vec3_t vec) {
+    vec3_t dest = glm_alloc(3 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
 
     if (vec) {
         dest[0] = vec[0];
@@ -17,7 +20,22 @@ vec3_t vec3_create(vec3_t vec) {
     return dest;
 }
 
-vec3_t vec3_set(vec3_t vec, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_create_in(glm_arena *arena, vec3_t vec) {
+    vec3_t dest = glm_arena_alloc(arena, 3 * sizeof(numeric_t), sizeof(numeric_t));
+    if (!dest) { return NULL; }
+
+    if (vec) {
+        dest[0] = vec[0];
+        dest[1] = vec[1];
+        dest[2] = vec[2];
+    } else {
+        memset(dest, 0, 3 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API vec3_t vec3_set(vec3_t vec, vec3_t dest) {
     dest[0] = vec[0];
     dest[1] = vec[1];
     dest[2] = vec[2];
@@ -25,21 +43,21 @@ vec3_t vec3_set(vec3_t vec, vec3_t dest) {
     return dest;
 }
 
-vec3_t vec3_zeroes(vec3_t vec) {
+GL_MATRIX_API vec3_t vec3_zeroes(vec3_t vec) {
     vec[0] = 0;
     vec[1] = 0;
     vec[2] = 0;
     return vec;
 }
 
-vec3_t vec3_ones(vec3_t vec) {
+GL_MATRIX_API vec3_t vec3_ones(vec3_t vec) {
     vec[0] = 1;
     vec[1] = 1;
     vec[2] = 1;
     return vec;
 }
 
-vec3_t vec3_add(vec3_t vec, vec3_t vec2, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_add(vec3_t vec, vec3_t vec2, vec3_t dest) {
     if (!dest || vec == dest) {
         vec[0] += vec2[0];
         vec[1] += vec2[1];
@@ -54,7 +72,7 @@ vec3_t vec3_add(vec3_t vec, vec3_t vec2, vec3_t dest) {
     return dest;
 }
 
-vec3_t vec3_subtract(vec3_t vec, vec3_t vec2, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_subtract(vec3_t vec, vec3_t vec2, vec3_t dest) {
     if (!dest || vec == dest) {
         vec[0] -= vec2[0];
         vec[1] -= vec2[1];
@@ -68,7 +86,7 @@ vec3_t vec3_subtract(vec3_t vec, vec3_t vec2, vec3_t dest) {
     return dest;
 }
 
-vec3_t vec3_multiply(vec3_t vec, vec3_t vec2, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_multiply(vec3_t vec, vec3_t vec2, vec3_t dest) {
     if (!dest || vec == dest) {
         vec[0] *= vec2[0];
         vec[1] *= vec2[1];
@@ -82,7 +100,7 @@ vec3_t vec3_multiply(vec3_t vec, vec3_t vec2, vec3_t dest) {
     return dest;
 }
 
-vec3_t vec3_negate(vec3_t vec, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_negate(vec3_t vec, vec3_t dest) {
     if (!dest) { dest = vec; }
 
     dest[0] = -vec[0];
@@ -91,7 +109,7 @@ vec3_t vec3_negate(vec3_t vec, vec3_t dest) {
     return dest;
 }
 
-vec3_t vec3_scale(vec3_t vec, numeric_t val, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_scale(vec3_t vec, numeric_t val, vec3_t dest) {
     if (!dest || vec == dest) {
         vec[0] *= val;
         vec[1] *= val;
@@ -105,11 +123,11 @@ vec3_t vec3_scale(vec3_t vec, numeric_t val, vec3_t dest) {
     return dest;
 }
 
-vec3_t vec3_normalize(vec3_t vec, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_normalize(vec3_t vec, vec3_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0], y = vec[1], z = vec[2],
-        len = sqrt(x * x + y * y + z * z);
+        len = glm_sqrt(x * x + y * y + z * z);
 
     if (!len) {
         dest[0] = 0;
@@ -130,7 +148,7 @@ vec3_t vec3_normalize(vec3_t vec, vec3_t dest) {
     return dest;
 }
 
-vec3_t vec3_cross (vec3_t vec, vec3_t vec2, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_cross (vec3_t vec, vec3_t vec2, vec3_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0], y = vec[1], z = vec[2],
@@ -142,22 +160,31 @@ vec3_t vec3_cross (vec3_t vec, vec3_t vec2, vec3_t dest) {
     return dest;
 }
 
-numeric_t vec3_length(vec3_t vec) {
+GL_MATRIX_API vec3_t vec3_cross_noalias(vec3_t GL_MATRIX_RESTRICT vec, vec3_t GL_MATRIX_RESTRICT vec2, vec3_t GL_MATRIX_RESTRICT dest) {
+    assert(GL_MATRIX_DISJOINT(vec, 3, dest, 3) && GL_MATRIX_DISJOINT(vec2, 3, dest, 3));
+
+    dest[0] = vec[1] * vec2[2] - vec[2] * vec2[1];
+    dest[1] = vec[2] * vec2[0] - vec[0] * vec2[2];
+    dest[2] = vec[0] * vec2[1] - vec[1] * vec2[0];
+    return dest;
+}
+
+GL_MATRIX_API numeric_t vec3_length(vec3_t vec) {
     numeric_t x = vec[0], y = vec[1], z = vec[2];
-    return sqrt(x * x + y * y + z * z);
+    return glm_sqrt(x * x + y * y + z * z);
 }
 
-numeric_t vec3_dot(vec3_t vec, vec3_t vec2) {
+GL_MATRIX_API numeric_t vec3_dot(vec3_t vec, vec3_t vec2) {
     return vec[0] * vec2[0] + vec[1] * vec2[1] + vec[2] * vec2[2];
 }
 
-vec3_t vec3_direction (vec3_t vec, vec3_t vec2, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_direction (vec3_t vec, vec3_t vec2, vec3_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0] - vec2[0],
         y = vec[1] - vec2[1],
         z = vec[2] - vec2[2],
-        len = sqrt(x * x + y * y + z * z);
+        len = glm_sqrt(x * x + y * y + z * z);
 
     if (!len) {
         dest[0] = 0;
@@ -173,7 +200,7 @@ vec3_t vec3_direction (vec3_t vec, vec3_t vec2, vec3_t dest) {
     return dest;
 }
 
-vec3_t vec3_lerp(vec3_t vec, vec3_t vec2, numeric_t lerp, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_lerp(vec3_t vec, vec3_t vec2, numeric_t lerp, vec3_t dest) {
     if (!dest) { dest = vec; }
 
     dest[0] = vec[0] + lerp * (vec2[0] - vec[0]);
@@ -183,30 +210,29 @@ vec3_t vec3_lerp(vec3_t vec, vec3_t vec2, numeric_t lerp, vec3_t dest) {
     return dest;
 }
 
-numeric_t vec3_dist(vec3_t vec, vec3_t vec2) {
+GL_MATRIX_API numeric_t vec3_dist(vec3_t vec, vec3_t vec2) {
     numeric_t x = vec2[0] - vec[0],
         y = vec2[1] - vec[1],
         z = vec2[2] - vec[2];
 
-    return sqrt(x*x + y*y + z*z);
+    return glm_sqrt(x*x + y*y + z*z);
 }
 
-vec3_t vec3_unproject(vec3_t vec, mat4_t view, mat4_t proj, vec4_t viewport, vec3_t dest) {
+GL_MATRIX_API vec3_t vec3_unproject(vec3_t vec, mat4_t view, mat4_t proj, vec4_t viewport, vec3_t dest) {
     if (!dest) { dest = vec; }
 
-    mat4_t m = mat4_create(NULL);
-    numeric_t *v = malloc(sizeof(numeric_t) * 4);
+    numeric_t m[16], v[4];
 
-    v[0] = (vec[0] - viewport[0]) * 2.0 / viewport[2] - 1.0;
-    v[1] = (vec[1] - viewport[1]) * 2.0 / viewport[3] - 1.0;
-    v[2] = 2.0 * vec[2] - 1.0;
-    v[3] = 1.0;
+    v[0] = (vec[0] - viewport[0]) * 2 / viewport[2] - 1;
+    v[1] = (vec[1] - viewport[1]) * 2 / viewport[3] - 1;
+    v[2] = 2 * vec[2] - 1;
+    v[3] = 1;
 
     mat4_multiply(proj, view, m);
     if(!mat4_inverse(m, NULL)) { return NULL; }
 
     mat4_multiplyVec4(m, v, NULL);
-    if(v[3] == 0.0) { return NULL; }
+    if(v[3] == 0) { return NULL; }
 
     dest[0] = v[0] / v[3];
     dest[1] = v[1] / v[3];
@@ -214,3 +240,39 @@ vec3_t vec3_unproject(vec3_t vec, mat4_t view, mat4_t proj, vec4_t viewport, vec
 
     return dest;
 }
+
+GL_MATRIX_API vec3_t vec3_unproject_array(vec3_t vec, size_t count, mat4_t view, mat4_t proj, vec4_t viewport, mat4_t invViewProj, vec3_t dest) {
+    numeric_t m[16], sx, sy, ox, oy, x, y, z, w;
+    size_t i;
+
+    if (!dest) { dest = vec; }
+
+    if (invViewProj) {
+        mat4_set(invViewProj, m);
+    } else {
+        mat4_multiply(proj, view, m);
+        if(!mat4_inverse(m, NULL)) { return NULL; }
+    }
+
+    // Fold the viewport transform into a scale and offset per axis
+    sx = 2 / viewport[2];
+    sy = 2 / viewport[3];
+    ox = -viewport[0] * sx - 1;
+    oy = -viewport[1] * sy - 1;
+
+    for (i = 0; i < count; i++) {
+        x = vec[3 * i] * sx + ox;
+        y = vec[3 * i + 1] * sy + oy;
+        z = 2 * vec[3 * i + 2] - 1;
+
+        w = m[3] * x + m[7] * y + m[11] * z + m[15];
+        if (w == 0) { continue; }
+        w = 1 / w;
+
+        dest[3 * i] = (m[0] * x + m[4] * y + m[8] * z + m[12]) * w;
+        dest[3 * i + 1] = (m[1] * x + m[5] * y + m[9] * z + m[13]) * w;
+        dest[3 * i + 2] = (m[2] * x + m[6] * y + m[10] * z + m[14]) * w;
+    }
+
+    return dest;
+}
@@ -1,10 +1,12 @@
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "gl-matrix.h"
 
-vec4_t vec4_create(vec4_t vec) {
-    vec4_t dest = calloc(4, sizeof(numeric_t));
+GL_MATRIX_API vec4_t vec4_create(vec4_t vec) {
+    vec4_t dest = glm_alloc(4 * sizeof(numeric_t));
+    if (!dest) { return NULL; }
 
     if (vec) {
         dest[0] = vec[0];
@@ -18,7 +20,31 @@ vec4_t vec4_create(vec4_t vec) {
     return dest;
 }
 
-vec4_t vec4_set(vec4_t vec, vec4_t dest) {
+GL_MATRIX_API vec4_t vec4_create_in(glm_arena *arena, vec4_t vec) {
+    vec4_t dest = glm_arena_alloc(arena, 4 * sizeof(numeric_t), 16);
+    if (!dest) { return NULL; }
+
+    if (vec) {
+        dest[0] = vec[0];
+        dest[1] = vec[1];
+        dest[2] = vec[2];
+        dest[3] = vec[3];
+    } else {
+        memset(dest, 0, 4 * sizeof(numeric_t));
+    }
+
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_create_aligned(vec4_t vec, size_t align) {
+    vec4_t dest = glm_alloc_aligned(4 * sizeof(numeric_t), align);
+    if (!dest) { return NULL; }
+
+    if (vec) { memcpy(dest, vec, 4 * sizeof(numeric_t)); }
+    return dest;
+}
+
+GL_MATRIX_API vec4_t vec4_set(vec4_t vec, vec4_t dest) {
     dest[0] = vec[0];
     dest[1] = vec[1];
     dest[2] = vec[2];
@@ -26,7 +52,7 @@ vec4_t vec4_set(vec4_t vec, vec4_t dest) {
     return dest;
 }
 
-vec4_t vec4_zeroes(vec4_t vec) {
+GL_MATRIX_API vec4_t vec4_zeroes(vec4_t vec) {
     vec[0] = 0;
     vec[1] = 0;
     vec[2] = 0;
@@ -34,7 +60,7 @@ vec4_t vec4_zeroes(vec4_t vec) {
     return vec;
 }
 
-vec4_t vec4_ones(vec4_t vec) {
+GL_MATRIX_API vec4_t vec4_ones(vec4_t vec) {
     vec[0] = 1;
     vec[1] = 1;
     vec[2] = 1;
@@ -42,7 +68,7 @@ vec4_t vec4_ones(vec4_t vec) {
     return vec;
 }
 
-vec4_t vec4_add(vec4_t vec, vec4_t vec2, vec4_t dest) {
+GL_MATRIX_API vec4_t vec4_add(vec4_t vec, vec4_t vec2, vec4_t dest) {
     if (!dest || vec == dest) {
         vec[0] += vec2[0];
         vec[1] += vec2[1];
@@ -59,7 +85,7 @@ vec4_t vec4_add(vec4_t vec, vec4_t vec2, vec4_t dest) {
     return dest;
 }
 
-vec4_t vec4_subtract(vec4_t vec, vec4_t vec2, vec4_t dest) {
+GL_MATRIX_API vec4_t vec4_subtract(vec4_t vec, vec4_t vec2, vec4_t dest) {
     if (!dest || vec == dest) {
         vec[0] -= vec2[0];
         vec[1] -= vec2[1];
@@ -75,7 +101,7 @@ vec4_t vec4_subtract(vec4_t vec, vec4_t vec2, vec4_t dest) {
     return dest;
 }
 
-vec4_t vec4_negate(vec4_t vec, vec4_t dest) {
+GL_MATRIX_API vec4_t vec4_negate(vec4_t vec, vec4_t dest) {
     if (!dest) { dest = vec; }
 
     dest[0] = -vec[0];
@@ -85,7 +111,7 @@ vec4_t vec4_negate(vec4_t vec, vec4_t dest) {
     return dest;
 }
 
-vec4_t vec4_scale(vec4_t vec, numeric_t val, vec4_t dest) {
+GL_MATRIX_API vec4_t vec4_scale(vec4_t vec, numeric_t val, vec4_t dest) {
     if (!dest || vec == dest) {
         vec[0] *= val;
         vec[1] *= val;
@@ -101,11 +127,11 @@ vec4_t vec4_scale(vec4_t vec, numeric_t val, vec4_t dest) {
     return dest;
 }
 
-vec4_t vec4_normalize(vec4_t vec, vec4_t dest) {
+GL_MATRIX_API vec4_t vec4_normalize(vec4_t vec, vec4_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0], y = vec[1], z = vec[2], w = vec[3],
-        len = sqrt(x * x + y * y + z * z + w * w);
+        len = glm_sqrt(x * x + y * y + z * z + w * w);
 
     if (!len) {
         dest[0] = 0;
@@ -129,23 +155,23 @@ vec4_t vec4_normalize(vec4_t vec, vec4_t dest) {
     return dest;
 }
 
-numeric_t vec4_length(vec4_t vec) {
+GL_MATRIX_API numeric_t vec4_length(vec4_t vec) {
     numeric_t x = vec[0], y = vec[1], z = vec[2], w = vec[3];
-    return sqrt(x * x + y * y + z * z + w * w);
+    return glm_sqrt(x * x + y * y + z * z + w * w);
 }
 
-numeric_t vec4_dot(vec4_t vec, vec4_t vec2) {
+GL_MATRIX_API numeric_t vec4_dot(vec4_t vec, vec4_t vec2) {
     return vec[0] * vec2[0] + vec[1] * vec2[1] + vec[2] * vec2[2] + vec[3] * vec2[3];
 }
 
-vec4_t vec4_direction (vec4_t vec, vec4_t vec2, vec4_t dest) {
+GL_MATRIX_API vec4_t vec4_direction (vec4_t vec, vec4_t vec2, vec4_t dest) {
     if (!dest) { dest = vec; }
 
     numeric_t x = vec[0] - vec2[0],
         y = vec[1] - vec2[1],
         z = vec[2] - vec2[2],
         w = vec[3] - vec2[3],
-        len = sqrt(x * x + y * y + z * z + w * w);
+        len = glm_sqrt(x * x + y * y + z * z + w * w);
 
     if (!len) {
         dest[0] = 0;
@@ -163,7 +189,7 @@ vec4_t vec4_direction (vec4_t vec, vec4_t vec2, vec4_t dest) {
     return dest;
 }
 
-vec4_t vec4_lerp(vec4_t vec, vec4_t vec2, numeric_t lerp, vec4_t dest) {
+GL_MATRIX_API vec4_t vec4_lerp(vec4_t vec, vec4_t vec2, numeric_t lerp, vec4_t dest) {
     if (!dest) { dest = vec; }
 
     dest[0] = vec[0] + lerp * (vec2[0] - vec[0]);
@@ -174,11 +200,11 @@ vec4_t vec4_lerp(vec4_t vec, vec4_t vec2, numeric_t lerp, vec4_t dest) {
     return dest;
 }
 
-numeric_t vec4_dist(vec4_t vec, vec4_t vec2) {
+GL_MATRIX_API numeric_t vec4_dist(vec4_t vec, vec4_t vec2) {
     numeric_t x = vec2[0] - vec[0],
         y = vec2[1] - vec[1],
         z = vec2[2] - vec[2],
         w = vec2[3] - vec[3];
 
-    return sqrt(x*x + y*y + z*z + w*w);
+    return glm_sqrt(x*x + y*y + z*z + w*w);
 }